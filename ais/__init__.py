@@ -5,7 +5,12 @@ import logging
 logging.basicConfig()
 
 from _ais import decode
+from _ais import decode_lazy
+from _ais import decode_many
+from _ais import decode_positions
+from _ais import decode_spans
 from _ais import DecodeError
+from _ais import VdmStream
 from ais.io import open
 from ais.io import NmeaFile
 
@@ -0,0 +1,390 @@
+// Google Benchmark suite for the decoder hot paths.
+//
+// Items are messages (or fields for the bitset accessors) and bytes are
+// armored payload or NMEA text, so the output reports messages/sec and
+// bytes/sec for each path.
+//
+// The CreateAisMsg benchmarks run over the single sentence messages in
+// test/data, one benchmark per message type.
+//
+// Usage: decode_benchmark [--benchmark_filter=regex] [...]
+
+#include <cstddef>
+#include <cstdint>
+#include <fstream>
+#include <map>
+#include <memory>
+#include <random>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include "benchmark/benchmark.h"
+
+#include "ais.h"
+#include "ais_alloc.h"
+#include "decode_body.h"
+#include "spatial_index.h"
+#include "track_store.h"
+#include "vdm.h"
+#include "vessel_state.h"
+
+namespace libais {
+namespace {
+
+// Type 1 and 5 payloads as they come off of the wire.
+const char kType1Payload[] = "15N1u<PP1FJuvSRHOE6QIwwh0HQ6";
+const char kType5Payload[] =
+    "53eaFL02?;fwTPm7V219E@R1@PE8E<622222221@9hG1A7?@NCPSlm3kc5DhH8888888880";
+
+const char kSingleLine[] = "!AIVDM,1,1,,B,15MuTpPP00INJMh@vq`00?vJ00S0,0*12";
+const char *const kMultiLine[] = {
+    "!SAVDM,2,1,1,A,54a=3b027kft?HISV20@thF0<u=@618T<6222216A0b<?4wk0BAm@F@"
+    "DEBC8,0*17",
+    "!SAVDM,2,2,1,A,88888888880,2*3F",
+};
+
+struct Payload {
+  std::string body;
+  int pad;
+};
+
+// Lines of NMEA from the test data with any metadata after the checksum
+// removed.
+std::vector<std::string> LoadLines() {
+  std::vector<std::string> lines;
+  for (const char *filename : {LIBAIS_TEST_DATA_DIR "/test.aivdm",
+                               LIBAIS_TEST_DATA_DIR "/typeexamples.nmea"}) {
+    std::ifstream in(filename);
+    std::string line;
+    while (std::getline(in, line)) {
+      const size_t star = line.find('*');
+      if (line.empty() || line[0] != '!' || star == std::string::npos ||
+          star + 3 > line.size()) {
+        continue;
+      }
+      lines.push_back(line.substr(0, star + 3));
+    }
+  }
+  return lines;
+}
+
+const std::vector<std::string> &Lines() {
+  static const auto *lines = new std::vector<std::string>(LoadLines());
+  return *lines;
+}
+
+// Single sentence payloads grouped by message type.
+std::map<int, std::vector<Payload>> LoadPayloads() {
+  std::map<int, std::vector<Payload>> payloads;
+  for (const auto &line : Lines()) {
+    NmeaSentenceView sentence;
+    if (!ParseNmeaSentence(line, &sentence) || sentence.sentence_total != 1) {
+      continue;
+    }
+    int message_id;
+    int dac;
+    int fi;
+    if (!PeekAisHeader(sentence.body, sentence.fill_bits, &message_id, &dac,
+                       &fi) ||
+        message_id > 27) {
+      continue;
+    }
+    payloads[message_id].push_back(
+        {std::string(sentence.body), sentence.fill_bits});
+  }
+  return payloads;
+}
+
+const std::map<int, std::vector<Payload>> &Payloads() {
+  static const auto *payloads =
+      new std::map<int, std::vector<Payload>>(LoadPayloads());
+  return *payloads;
+}
+
+size_t TotalBytes(const std::vector<Payload> &payloads) {
+  size_t bytes = 0;
+  for (const auto &payload : payloads) {
+    bytes += payload.body.size();
+  }
+  return bytes;
+}
+
+void BM_ParseNmeaPayload(benchmark::State &state, const char *payload) {
+  const size_t size = std::char_traits<char>::length(payload);
+  const int pad = state.range(0);
+  AisBitset bits;
+  for (auto _ : state) {
+    benchmark::DoNotOptimize(bits.ParseNmeaPayload(payload, size, pad));
+  }
+  state.SetItemsProcessed(state.iterations());
+  state.SetBytesProcessed(state.iterations() * size);
+}
+BENCHMARK_CAPTURE(BM_ParseNmeaPayload, type1, kType1Payload)->Arg(0);
+BENCHMARK_CAPTURE(BM_ParseNmeaPayload, type5, kType5Payload)->Arg(2);
+
+// The fields of a position report.
+void BM_ToUnsignedInt(benchmark::State &state) {
+  AisBitset bits;
+  bits.ParseNmeaPayload(kType1Payload, 0);
+  const int kFields[][2] = {{0, 6},    {6, 2},    {8, 30},   {38, 4},
+                            {42, 8},   {50, 10},  {60, 1},   {61, 28},
+                            {89, 27},  {116, 12}, {128, 9},  {137, 6},
+                            {143, 2},  {145, 3},  {148, 1},  {149, 19}};
+  for (auto _ : state) {
+    bits.SeekTo(0);
+    for (const auto &field : kFields) {
+      benchmark::DoNotOptimize(bits.ToUnsignedInt(field[0], field[1]));
+    }
+  }
+  state.SetItemsProcessed(state.iterations() * std::size(kFields));
+}
+BENCHMARK(BM_ToUnsignedInt);
+
+// The text fields of a ship static report.
+void BM_ToString(benchmark::State &state) {
+  AisBitset bits;
+  bits.ParseNmeaPayload(kType5Payload, 2);
+  const int kFields[][2] = {{70, 42}, {112, 120}, {302, 120}};
+  for (auto _ : state) {
+    for (const auto &field : kFields) {
+      bits.SeekTo(field[0]);
+      benchmark::DoNotOptimize(bits.ToString(field[0], field[1]));
+    }
+  }
+  state.SetItemsProcessed(state.iterations() * std::size(kFields));
+}
+BENCHMARK(BM_ToString);
+
+void BM_CreateAisMsg(benchmark::State &state,
+                     const std::vector<Payload> *payloads) {
+  for (auto _ : state) {
+    for (const auto &payload : *payloads) {
+      benchmark::DoNotOptimize(CreateAisMsg(payload.body, payload.pad));
+    }
+  }
+  state.SetItemsProcessed(state.iterations() * payloads->size());
+  state.SetBytesProcessed(state.iterations() * TotalBytes(*payloads));
+}
+
+// Decodes the whole corpus into a batch, then frees the batch.
+void BM_CreateAisMsgAllocator(benchmark::State &state) {
+  std::vector<Payload> corpus;
+  for (const auto &entry : Payloads()) {
+    corpus.insert(corpus.end(), entry.second.begin(), entry.second.end());
+  }
+  AisMsgPool pool;
+  AisMsgArena arena;
+  AisMsgAllocator *allocator = nullptr;
+  switch (state.range(0)) {
+    case 1:
+      allocator = &pool;
+      state.SetLabel("pool");
+      break;
+    case 2:
+      allocator = &arena;
+      state.SetLabel("arena");
+      break;
+    default:
+      state.SetLabel("heap");
+  }
+
+  std::vector<std::unique_ptr<AisMsg>> msgs;
+  msgs.reserve(corpus.size());
+  for (auto _ : state) {
+    for (const auto &payload : corpus) {
+      msgs.push_back(CreateAisMsg(payload.body, payload.pad, allocator));
+    }
+    msgs.clear();
+    if (allocator == &arena) {
+      arena.Reset();
+    }
+  }
+  state.SetItemsProcessed(state.iterations() * corpus.size());
+  state.SetBytesProcessed(state.iterations() * TotalBytes(corpus));
+}
+BENCHMARK(BM_CreateAisMsgAllocator)->Arg(0)->Arg(1)->Arg(2);
+
+void BM_NmeaSentenceCreate(benchmark::State &state) {
+  const std::string line(state.range(0) ? kMultiLine[0] : kSingleLine);
+  for (auto _ : state) {
+    benchmark::DoNotOptimize(NmeaSentence::Create(line, 1));
+  }
+  state.SetLabel(state.range(0) ? "multi" : "single");
+  state.SetItemsProcessed(state.iterations());
+  state.SetBytesProcessed(state.iterations() * line.size());
+}
+BENCHMARK(BM_NmeaSentenceCreate)->Arg(0)->Arg(1);
+
+// Items are decoded messages.
+void BM_VdmStreamAddLine(benchmark::State &state) {
+  std::vector<std::string> lines;
+  if (state.range(0)) {
+    lines.assign(std::begin(kMultiLine), std::end(kMultiLine));
+  } else {
+    lines.push_back(kSingleLine);
+  }
+  size_t bytes = 0;
+  for (const auto &line : lines) {
+    bytes += line.size();
+  }
+
+  VdmStream stream;
+  for (auto _ : state) {
+    for (const auto &line : lines) {
+      stream.AddLine(line);
+    }
+    benchmark::DoNotOptimize(stream.PopOldestMessage());
+  }
+  state.SetLabel(state.range(0) ? "multi" : "single");
+  state.SetItemsProcessed(state.iterations());
+  state.SetBytesProcessed(state.iterations() * bytes);
+}
+BENCHMARK(BM_VdmStreamAddLine)->Arg(0)->Arg(1);
+
+void BM_PayloadHash(benchmark::State &state, const char *payload) {
+  const size_t size = std::char_traits<char>::length(payload);
+  for (auto _ : state) {
+    benchmark::DoNotOptimize(PayloadHash({payload, size}, 0));
+  }
+  state.SetItemsProcessed(state.iterations());
+  state.SetBytesProcessed(state.iterations() * size);
+}
+BENCHMARK_CAPTURE(BM_PayloadHash, type1, kType1Payload);
+BENCHMARK_CAPTURE(BM_PayloadHash, type5, kType5Payload);
+
+// All of the test data as one block.  Items are decoded messages.  With an
+// argument of 1, duplicates are dropped, which here is every message after
+// the first pass.
+void BM_VdmStreamAddBuffer(benchmark::State &state) {
+  std::string buffer;
+  for (const auto &line : Lines()) {
+    buffer += line + "\n";
+  }
+  VdmStream stream;
+  if (state.range(0)) {
+    stream.DropDuplicates();
+    state.SetLabel("dedup");
+  }
+  std::vector<std::unique_ptr<AisMsg>> msgs;
+  std::vector<VdmLineStatus> line_status;
+  size_t count = 0;
+  for (auto _ : state) {
+    stream.AddBuffer(buffer.data(), buffer.data() + buffer.size(), &msgs,
+                     &line_status);
+    count += msgs.size();
+  }
+  state.SetItemsProcessed(count);
+  state.SetBytesProcessed(state.iterations() * buffer.size());
+}
+BENCHMARK(BM_VdmStreamAddBuffer)->Arg(0)->Arg(1);
+
+// Position reports spread over 500k vessels, as from a busy feed.  Items are
+// updates.
+void BM_VesselStateTableUpdate(benchmark::State &state) {
+  constexpr int kVessels = 500000;
+  std::unique_ptr<AisMsg> msg = CreateAisMsg(kType1Payload, 0);
+  VesselStateTable table(kVessels);
+  for (int i = 0; i < kVessels; i++) {
+    msg->mmsi = 200000000 + i * 7;
+    table.Update(*msg);
+  }
+  int i = 0;
+  for (auto _ : state) {
+    msg->mmsi = 200000000 + i * 7;
+    benchmark::DoNotOptimize(table.Update(*msg, i));
+    i = i + 1 == kVessels ? 0 : i + 1;
+  }
+  state.SetItemsProcessed(state.iterations());
+}
+BENCHMARK(BM_VesselStateTableUpdate);
+
+// Ten million reports spread over a 10 degree square of coast.
+const SpatialIndex &BusyIndex() {
+  static const SpatialIndex *index = [] {
+    auto *index = new SpatialIndex;
+    std::mt19937 random(1);
+    std::uniform_real_distribution<double> lng(-75, -65);
+    std::uniform_real_distribution<double> lat(35, 45);
+    PositionReport report;
+    for (int i = 0; i < 10000000; i++) {
+      report.position = AisPoint(lng(random), lat(random));
+      report.time = i;
+      report.mmsi = i;
+      index->Insert(report);
+    }
+    return index;
+  }();
+  return *index;
+}
+
+// Items are reports found.
+void BM_SpatialIndexFindInBox(benchmark::State &state) {
+  const SpatialIndex &index = BusyIndex();
+  std::vector<PositionReport> found;
+  size_t count = 0;
+  for (auto _ : state) {
+    found.clear();
+    index.FindInBox(AisPoint(-70.1, 40.1), AisPoint(-70, 40.2), 0, &found);
+    count += found.size();
+  }
+  state.SetItemsProcessed(count);
+}
+BENCHMARK(BM_SpatialIndexFindInBox);
+
+// Items are reports found within 5 km.
+void BM_SpatialIndexFindInRadius(benchmark::State &state) {
+  const SpatialIndex &index = BusyIndex();
+  std::vector<PositionReport> found;
+  size_t count = 0;
+  for (auto _ : state) {
+    found.clear();
+    index.FindInRadius(AisPoint(-70, 40), 5000, 0, &found);
+    count += found.size();
+  }
+  state.SetItemsProcessed(count);
+}
+BENCHMARK(BM_SpatialIndexFindInRadius);
+
+// Fixes for 100k vessels in turn.  Items are fixes.
+void BM_TrackStoreAdd(benchmark::State &state) {
+  constexpr int kVessels = 100000;
+  TrackStore store;
+  const AisPoint position(-70, 40);
+  for (int vessel = 0; vessel < kVessels; vessel++) {
+    store.Add(vessel, 0, position, 10, 90);
+  }
+  int64_t time = 1;
+  int vessel = 0;
+  for (auto _ : state) {
+    benchmark::DoNotOptimize(store.Add(vessel, time, position, 10, 90));
+    if (++vessel == kVessels) {
+      vessel = 0;
+      time++;
+    }
+  }
+  state.SetItemsProcessed(state.iterations());
+}
+BENCHMARK(BM_TrackStoreAdd);
+
+void RegisterCreateAisMsgBenchmarks() {
+  for (const auto &entry : Payloads()) {
+    benchmark::RegisterBenchmark(
+        ("BM_CreateAisMsg/type:" + std::to_string(entry.first)).c_str(),
+        BM_CreateAisMsg, &entry.second);
+  }
+}
+
+}  // namespace
+}  // namespace libais
+
+int main(int argc, char **argv) {
+  benchmark::Initialize(&argc, argv);
+  if (benchmark::ReportUnrecognizedArguments(argc, argv)) {
+    return 1;
+  }
+  libais::RegisterCreateAisMsgBenchmarks();
+  benchmark::RunSpecifiedBenchmarks();
+  benchmark::Shutdown();
+  return 0;
+}
@@ -0,0 +1,93 @@
+#!/usr/bin/env python
+"""Time the Python decode entry points over the single line messages.
+
+Reports messages/sec for _ais.decode called once per payload, for
+_ais.decode_many on the whole batch and for _ais.decode_lazy reading only
+id and mmsi.  Build the extension first with
+python setup.py build_ext --inplace and run from the top of the tree.
+
+Usage: decode_py_benchmark.py [--repeat N] [nmea_file ...]
+"""
+
+import argparse
+import os
+import sys
+import timeit
+
+sys.path.insert(0, os.path.join(os.path.dirname(__file__), '..'))
+
+import _ais  # pylint: disable=g-import-not-at-top
+
+DEFAULT_FILE = os.path.join(
+    os.path.dirname(__file__), '..', 'test', 'data', 'typeexamples.nmea')
+
+
+def LoadPayloads(filenames):
+  """Returns a list of (payload, pad) for the single line VDM messages."""
+  payloads = []
+  for filename in filenames:
+    with open(filename) as f:
+      for line in f:
+        fields = line.split(',')
+        if len(fields) < 7 or not fields[0].endswith('VDM'):
+          continue
+        if fields[1] != '1':
+          continue
+        payloads.append((fields[5], int(fields[6][0])))
+  # Only keep what decodes so that both paths do the same work.
+  good = []
+  for payload, pad in payloads:
+    try:
+      _ais.decode(payload, pad)
+    except _ais.DecodeError:
+      continue
+    good.append((payload, pad))
+  return good
+
+
+def DecodeEach(payloads):
+  decode = _ais.decode
+  for payload, pad in payloads:
+    decode(payload, pad)
+
+
+def DecodeLazyHeader(payloads):
+  decode_lazy = _ais.decode_lazy
+  for payload, pad in payloads:
+    msg = decode_lazy(payload, pad)
+    msg['id'], msg['mmsi']  # pylint: disable=pointless-statement
+
+
+def Report(name, count, seconds):
+  print('%-12s %10.0f msgs/sec %8.3f us/msg' % (
+      name, count / seconds, seconds / count * 1e6))
+
+
+def main():
+  parser = argparse.ArgumentParser(description=__doc__.split('\n')[0])
+  parser.add_argument('--repeat', type=int, default=5)
+  parser.add_argument('files', nargs='*', default=[DEFAULT_FILE])
+  args = parser.parse_args()
+
+  payloads = LoadPayloads(args.files)
+  if not payloads:
+    sys.exit('No payloads')
+  # Enough copies that each timing is well above the timer resolution.
+  payloads *= max(1, 20000 // len(payloads))
+  bodies = [payload for payload, _ in payloads]
+  pads = [pad for _, pad in payloads]
+
+  print('%d payloads' % len(payloads))
+  seconds = min(timeit.repeat(
+      lambda: DecodeEach(payloads), number=1, repeat=args.repeat))
+  Report('decode', len(payloads), seconds)
+  seconds = min(timeit.repeat(
+      lambda: _ais.decode_many(bodies, pads), number=1, repeat=args.repeat))
+  Report('decode_many', len(payloads), seconds)
+  seconds = min(timeit.repeat(
+      lambda: DecodeLazyHeader(payloads), number=1, repeat=args.repeat))
+  Report('decode_lazy', len(payloads), seconds)
+
+
+if __name__ == '__main__':
+  main()
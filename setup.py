@@ -31,6 +31,10 @@ AIS_MODULE = Extension(
     'ais_py.cpp',
     'ais.cpp',
     'ais_bitset.cpp',
+    'decode_body.cpp',
+    'tag_block.cpp',  # TAG block groups for _ais.VdmStream
+    'uscg.cpp',  # USCG metadata for _ais.VdmStream
+    'vdm.cpp',  # Multi-line reassembly for _ais.VdmStream
     'ais1_2_3.cpp',  # Class A position
     'ais4_11.cpp',  # Basestation report, '=' - UTC time response
     'ais5.cpp',  # Static data report / ship name
@@ -91,6 +95,7 @@ setup(
     'Programming Language :: C++',
     'Programming Language :: Python :: 3.13',
     'Programming Language :: Python :: 3.14',
+    'Programming Language :: Python :: Free Threading :: 2 - Beta',
     'Programming Language :: Python :: Implementation :: CPython',
     'Topic :: Communications',
     'Topic :: Scientific/Engineering :: Information Analysis',
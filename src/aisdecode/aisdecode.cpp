@@ -0,0 +1,759 @@
+// Decode NMEA AIS VDM logs to newline delimited JSON or CSV.
+//
+// Usage: aisdecode [options] [FILE ...]
+//
+// Reads each FILE, or stdin if there are none or for "-".  Input may be
+// plain text or gzip compressed.  Lines may carry TAG blocks or USCG
+// metadata.  Multi-line messages are reassembled with VdmAssembler, the
+// same code that VdmStream uses, and decoded with CreateAisMsg.  Messages
+// that do not decode are skipped.
+//
+// Each message is written with its header fields and, for the common
+// position and static report types, the fields that ais.decode gives in
+// Python.  Other types only get the header.  CSV output has a fixed set of
+// columns that are left empty when a message does not have them.
+//
+// With --threads, decoding runs on a ParallelVdmStream.  The output is in
+// the same order, but the line status counts in --stats are not available
+// and the type filter is applied after decoding rather than before.
+
+#include <algorithm>
+#include <array>
+#include <bitset>
+#include <cerrno>
+#include <charconv>
+#include <chrono>
+#include <cmath>
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <memory>
+#include <string>
+#include <string_view>
+#include <tuple>
+#include <type_traits>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+#ifdef LIBAIS_HAVE_ZLIB
+#include <unistd.h>
+#include <zlib.h>
+#endif
+
+#include "ais.h"
+#include "ais_alloc.h"
+#include "ais_fields.h"
+#include "decode_body.h"
+#include "vdm.h"
+#include "vdm_parallel.h"
+
+namespace libais {
+namespace {
+
+// Bytes read from a file at a time.
+constexpr size_t kReadSize = 1 << 20;
+// Output is written once this many bytes are waiting.
+constexpr size_t kWriteSize = 1 << 16;
+
+constexpr char kUsage[] =
+    "Usage: aisdecode [options] [FILE ...]\n"
+    "\n"
+    "Decode NMEA AIS VDM lines to newline delimited JSON or CSV.  Reads\n"
+    "stdin if there are no files or for \"-\".  Files may be gzip compressed.\n"
+    "\n"
+    "Options:\n"
+    "  --format=json|csv  Output format.  Default json.\n"
+    "  --threads=N        Decode on N threads.  Default 0 decodes on the\n"
+    "                     reading thread.\n"
+    "  --types=LIST       Only write these message types, such as 1-3,5,18.\n"
+    "  --stats            Write counts and throughput to stderr on exit.\n"
+    "  --help             Show this message.\n";
+
+enum OutputFormat { FORMAT_JSON, FORMAT_CSV };
+
+struct Options {
+  OutputFormat format = FORMAT_JSON;
+  int threads = 0;
+  // Message types to write.  Index 0 is unused.
+  std::bitset<28> types;
+  bool stats = false;
+  std::vector<std::string> files;
+};
+
+// Parses a non-negative decimal number that fills the whole text.
+bool ParseCount(std::string_view text, int *value) {
+  const char *end = text.data() + text.size();
+  const auto result = std::from_chars(text.data(), end, *value);
+  return !text.empty() && result.ec == std::errc() && result.ptr == end &&
+         *value >= 0;
+}
+
+// Parses a list of message types and ranges such as "1-3,5,18".
+bool ParseTypes(std::string_view text, std::bitset<28> *types) {
+  while (true) {
+    const size_t comma = text.find(',');
+    const std::string_view item = text.substr(0, comma);
+    const size_t dash = item.find('-');
+    int first;
+    int last;
+    if (dash == std::string_view::npos) {
+      if (!ParseCount(item, &first)) {
+        return false;
+      }
+      last = first;
+    } else if (!ParseCount(item.substr(0, dash), &first) ||
+               !ParseCount(item.substr(dash + 1), &last)) {
+      return false;
+    }
+    if (first < 1 || last > 27 || first > last) {
+      return false;
+    }
+    for (int i = first; i <= last; i++) {
+      types->set(i);
+    }
+    if (comma == std::string_view::npos) {
+      return true;
+    }
+    text.remove_prefix(comma + 1);
+  }
+}
+
+// Returns 0 on success or the exit status.
+int ParseArgs(int argc, char *argv[], Options *options) {
+  bool more_options = true;
+  for (int i = 1; i < argc; i++) {
+    const std::string_view arg = argv[i];
+    if (!more_options || arg.size() < 2 || arg.substr(0, 2) != "--") {
+      options->files.emplace_back(arg);
+      continue;
+    }
+    const size_t equals = arg.find('=');
+    const std::string_view name = arg.substr(0, equals);
+    const std::string_view value =
+        equals == std::string_view::npos ? "" : arg.substr(equals + 1);
+    if (arg == "--") {
+      more_options = false;
+    } else if (arg == "--help") {
+      fputs(kUsage, stdout);
+      return -1;
+    } else if (arg == "--stats") {
+      options->stats = true;
+    } else if (name == "--format" && value == "json") {
+      options->format = FORMAT_JSON;
+    } else if (name == "--format" && value == "csv") {
+      options->format = FORMAT_CSV;
+    } else if (name == "--threads" && ParseCount(value, &options->threads)) {
+      // Done.
+    } else if (name == "--types" && ParseTypes(value, &options->types)) {
+      // Done.
+    } else {
+      fprintf(stderr, "aisdecode: bad option: %s\n%s", argv[i], kUsage);
+      return 2;
+    }
+  }
+  if (options->types.none()) {
+    options->types.set();
+  }
+  if (options->files.empty()) {
+    options->files.emplace_back("-");
+  }
+  return 0;
+}
+
+// Reads a file or stdin, uncompressing gzip input.
+class Input {
+ public:
+  Input() = default;
+  ~Input() { Close(); }
+
+  Input(const Input &) = delete;
+  Input &operator=(const Input &) = delete;
+
+  // Returns false and sets errno if the file could not be opened.
+  bool Open(const std::string &filename) {
+    Close();
+#ifdef LIBAIS_HAVE_ZLIB
+    file_ = filename == "-" ? gzdopen(dup(fileno(stdin)), "rb")
+                            : gzopen(filename.c_str(), "rb");
+    if (file_ != nullptr) {
+      gzbuffer(file_, kReadSize);
+    }
+#else
+    file_ = filename == "-" ? stdin : fopen(filename.c_str(), "rb");
+    check_gzip_ = true;
+#endif
+    return file_ != nullptr;
+  }
+
+  // Returns the number of bytes read, 0 at the end of the file or -1 on an
+  // error.
+  int64_t Read(char *buffer, size_t size) {
+#ifdef LIBAIS_HAVE_ZLIB
+    return gzread(file_, buffer, static_cast<unsigned int>(size));
+#else
+    const size_t count = fread(buffer, 1, size, file_);
+    if (check_gzip_ && count >= 2 && static_cast<uint8_t>(buffer[0]) == 0x1f &&
+        static_cast<uint8_t>(buffer[1]) == 0x8b) {
+      fputs("aisdecode: built without zlib, cannot read gzip input\n", stderr);
+      return -1;
+    }
+    check_gzip_ = false;
+    if (count == 0 && ferror(file_)) {
+      return -1;
+    }
+    return count;
+#endif
+  }
+
+  void Close() {
+    if (file_ == nullptr) {
+      return;
+    }
+#ifdef LIBAIS_HAVE_ZLIB
+    gzclose(file_);
+#else
+    if (file_ != stdin) {
+      fclose(file_);
+    }
+#endif
+    file_ = nullptr;
+  }
+
+ private:
+#ifdef LIBAIS_HAVE_ZLIB
+  gzFile file_ = nullptr;
+#else
+  FILE *file_ = nullptr;
+  // The first read of a file checks for the gzip magic number.
+  bool check_gzip_ = false;
+#endif
+};
+
+// Appends the shortest text that reads back as value.
+template <typename T>
+void AppendNumber(T value, std::string *out) {
+  char buffer[32];
+  const auto result = std::to_chars(buffer, buffer + sizeof(buffer), value);
+  out->append(buffer, result.ptr);
+}
+
+// Receives the fields of one message at a time and buffers the formatted
+// text for stdout.
+class Output {
+ public:
+  virtual ~Output() { Flush(); }
+
+  virtual void Begin() = 0;
+  virtual void Int(const char *name, int64_t value) = 0;
+  // Floats are written with the shortest text for a float.
+  virtual void Float(const char *name, float value) = 0;
+  virtual void Double(const char *name, double value) = 0;
+  virtual void Bool(const char *name, bool value) = 0;
+  virtual void Text(const char *name, std::string_view value) = 0;
+  virtual void End() = 0;
+
+  void Position(const AisPoint &position) {
+    Double("x", position.lng_deg);
+    Double("y", position.lat_deg);
+  }
+
+  // Dispatches on the type of a message member.
+  template <typename T>
+  void Value(const char *name, const T &value) {
+    if constexpr (std::is_same_v<T, bool>) {
+      Bool(name, value);
+    } else if constexpr (std::is_same_v<T, float>) {
+      Float(name, value);
+    } else if constexpr (std::is_floating_point_v<T>) {
+      Double(name, value);
+    } else if constexpr (std::is_same_v<T, std::string>) {
+      Text(name, value);
+    } else {
+      static_assert(std::is_integral_v<T> || std::is_enum_v<T>);
+      Int(name, static_cast<int64_t>(value));
+    }
+  }
+
+  // Returns false if writing failed.
+  bool Flush() {
+    if (buffer_.empty()) {
+      return ok_;
+    }
+    if (fwrite(buffer_.data(), 1, buffer_.size(), stdout) != buffer_.size()) {
+      ok_ = false;
+    }
+    buffer_.clear();
+    return ok_;
+  }
+
+ protected:
+  void MaybeFlush() {
+    if (buffer_.size() >= kWriteSize) {
+      Flush();
+    }
+  }
+
+  std::string buffer_;
+
+ private:
+  bool ok_ = true;
+};
+
+class JsonOutput : public Output {
+ public:
+  void Begin() override { buffer_ += '{'; }
+
+  void Int(const char *name, int64_t value) override {
+    Key(name);
+    AppendNumber(value, &buffer_);
+  }
+  void Float(const char *name, float value) override {
+    Key(name);
+    if (std::isfinite(value)) {
+      AppendNumber(value, &buffer_);
+    } else {
+      buffer_ += "null";
+    }
+  }
+  void Double(const char *name, double value) override {
+    Key(name);
+    if (std::isfinite(value)) {
+      AppendNumber(value, &buffer_);
+    } else {
+      buffer_ += "null";
+    }
+  }
+  void Bool(const char *name, bool value) override {
+    Key(name);
+    buffer_ += value ? "true" : "false";
+  }
+  void Text(const char *name, std::string_view value) override {
+    Key(name);
+    buffer_ += '"';
+    for (const char c : value) {
+      if (c == '"' || c == '\\') {
+        buffer_ += '\\';
+        buffer_ += c;
+      } else if (static_cast<unsigned char>(c) < 0x20) {
+        char escaped[8];
+        snprintf(escaped, sizeof(escaped), "\\u%04x", c);
+        buffer_ += escaped;
+      } else {
+        buffer_ += c;
+      }
+    }
+    buffer_ += '"';
+  }
+
+  void End() override {
+    buffer_ += "}\n";
+    MaybeFlush();
+  }
+
+ private:
+  void Key(const char *name) {
+    if (buffer_.back() != '{') {
+      buffer_ += ',';
+    }
+    buffer_ += '"';
+    buffer_ += name;
+    buffer_ += "\":";
+  }
+};
+
+constexpr std::array<const char *, 14> kCsvColumns = {
+    "id",          "repeat_indicator", "mmsi",     "x",
+    "y",           "sog",              "cog",      "true_heading",
+    "nav_status",  "timestamp",        "name",     "callsign",
+    "type_and_cargo", "destination"};
+
+class CsvOutput : public Output {
+ public:
+  CsvOutput() {
+    for (size_t i = 0; i < kCsvColumns.size(); i++) {
+      columns_[kCsvColumns[i]] = i;
+      buffer_ += i == 0 ? "" : ",";
+      buffer_ += kCsvColumns[i];
+    }
+    buffer_ += '\n';
+  }
+
+  void Begin() override {
+    for (std::string &cell : cells_) {
+      cell.clear();
+    }
+  }
+
+  void Int(const char *name, int64_t value) override {
+    if (std::string *cell = Cell(name)) {
+      AppendNumber(value, cell);
+    }
+  }
+  void Float(const char *name, float value) override {
+    if (std::string *cell = Cell(name)) {
+      AppendNumber(value, cell);
+    }
+  }
+  void Double(const char *name, double value) override {
+    if (std::string *cell = Cell(name)) {
+      AppendNumber(value, cell);
+    }
+  }
+  void Bool(const char *name, bool value) override {
+    if (std::string *cell = Cell(name)) {
+      *cell = value ? "1" : "0";
+    }
+  }
+  void Text(const char *name, std::string_view value) override {
+    std::string *cell = Cell(name);
+    if (cell == nullptr) {
+      return;
+    }
+    if (value.find_first_of(",\"\r\n") == std::string_view::npos) {
+      cell->assign(value);
+      return;
+    }
+    *cell = '"';
+    for (const char c : value) {
+      if (c == '"') {
+        *cell += '"';
+      }
+      *cell += c;
+    }
+    *cell += '"';
+  }
+
+  void End() override {
+    for (size_t i = 0; i < cells_.size(); i++) {
+      if (i != 0) {
+        buffer_ += ',';
+      }
+      buffer_ += cells_[i];
+    }
+    buffer_ += '\n';
+    MaybeFlush();
+  }
+
+ private:
+  std::string *Cell(const char *name) {
+    const auto found = columns_.find(name);
+    return found == columns_.end() ? nullptr : &cells_[found->second];
+  }
+
+  std::unordered_map<std::string_view, size_t> columns_;
+  std::array<std::string, kCsvColumns.size()> cells_;
+};
+
+template <typename Msg, typename Layout>
+void WriteLayout(const Msg &msg, const Layout &layout, Output *out) {
+  std::apply(
+      [&msg, out](const auto &...field) {
+        auto write = [&msg, out](const auto &field) {
+          if constexpr (std::decay_t<decltype(field)>::kind ==
+                        AIS_FIELD_POSITION) {
+            out->Position(msg.*field.member);
+          } else if (field.name != nullptr) {
+            out->Value(field.name, msg.*field.member);
+          }
+        };
+        (write(field), ...);
+      },
+      layout);
+}
+
+void WriteMessage(const AisMsg &msg, Output *out) {
+  out->Begin();
+  out->Int("id", msg.message_id);
+  out->Int("repeat_indicator", msg.repeat_indicator);
+  out->Int("mmsi", msg.mmsi);
+  switch (msg.message_id) {
+    case 1:
+    case 2:
+    case 3: {
+      const auto &m = static_cast<const Ais1_2_3 &>(msg);
+      WriteLayout(m, kAis1_2_3Layout, out);
+      out->Float("rot", m.rot);
+      out->Bool("rot_over_range", m.rot_over_range);
+      break;
+    }
+    case 4:
+    case 11:
+      WriteLayout(static_cast<const Ais4_11 &>(msg), kAis4_11Layout, out);
+      break;
+    case 5:
+      WriteLayout(static_cast<const Ais5 &>(msg), kAis5Layout, out);
+      break;
+    case 9:
+      WriteLayout(static_cast<const Ais9 &>(msg), kAis9Layout, out);
+      break;
+    case 18:
+      WriteLayout(static_cast<const Ais18 &>(msg), kAis18Layout, out);
+      break;
+    case 19:
+      WriteLayout(static_cast<const Ais19 &>(msg), kAis19Layout, out);
+      break;
+    case 21: {
+      const auto &m = static_cast<const Ais21 &>(msg);
+      WriteLayout(m, kAis21Layout, out);
+      WriteLayout(m, kAis21FlagsLayout, out);
+      break;
+    }
+    case 24: {
+      const auto &m = static_cast<const Ais24 &>(msg);
+      out->Int("part_num", m.part_num);
+      if (m.part_num == 0) {
+        out->Text("name", m.name);
+      } else if (m.part_num == 1) {
+        WriteLayout(m, kAis24PartBLayout, out);
+      }
+      break;
+    }
+    case 27:
+      WriteLayout(static_cast<const Ais27 &>(msg), kAis27Layout, out);
+      break;
+    default:
+      // Only the header for the other types.
+      break;
+  }
+  out->End();
+}
+
+struct Stats {
+  uint64_t bytes = 0;
+  uint64_t lines = 0;
+  uint64_t messages = 0;
+  uint64_t filtered = 0;
+  // Lines by VdmLineStatus.  Only counted without --threads.
+  std::array<uint64_t, VDM_LINE_UNDECODABLE + 1> line_status{};
+};
+
+// Decodes lines on the calling thread.  The type filter runs on the message
+// header before decoding.
+class SerialDecoder {
+ public:
+  SerialDecoder(const Options &options, Output *out, Stats *stats)
+      : options_(options), out_(out), stats_(stats) {}
+
+  // Handles the complete lines in [begin, end) and returns the start of the
+  // partial line at the end.
+  const char *AddBuffer(const char *begin, const char *end) {
+    const char *pos = begin;
+    std::string_view line;
+    while (NextLine(&pos, end, &line)) {
+      AddLine(line);
+    }
+    return pos;
+  }
+
+  void AddLine(std::string_view line) {
+    stats_->lines++;
+    std::string_view body;
+    int fill_bits;
+    VdmLineStatus status;
+    if (!assembler_.AddLine(line, &body, &fill_bits, &status)) {
+      stats_->line_status[status]++;
+      return;
+    }
+    int message_id;
+    int dac;
+    int fi;
+    if (!options_.types.all() &&
+        PeekAisHeader(body, fill_bits, &message_id, &dac, &fi) &&
+        (message_id >= static_cast<int>(options_.types.size()) ||
+         !options_.types[message_id])) {
+      stats_->filtered++;
+      return;
+    }
+    const auto msg = CreateAisMsg(body, fill_bits, &pool_);
+    if (msg == nullptr) {
+      stats_->line_status[VDM_LINE_UNDECODABLE]++;
+      return;
+    }
+    stats_->line_status[VDM_LINE_DECODED]++;
+    if (!options_.types[msg->message_id]) {
+      stats_->filtered++;
+      return;
+    }
+    stats_->messages++;
+    WriteMessage(*msg, out_);
+  }
+
+  void Finish() {}
+
+ private:
+  const Options &options_;
+  Output *out_;
+  Stats *stats_;
+  VdmAssembler assembler_;
+  AisMsgPool pool_;
+};
+
+// Decodes lines on a pool of threads.
+class ParallelDecoder {
+ public:
+  ParallelDecoder(const Options &options, Output *out, Stats *stats)
+      : options_(options), out_(out), stats_(stats),
+        stream_(options.threads) {}
+
+  const char *AddBuffer(const char *begin, const char *end) {
+    stats_->lines += std::count(begin, end, '\n');
+    const char *rest = stream_.AddBuffer(begin, end);
+    Drain();
+    return rest;
+  }
+
+  void AddLine(std::string_view line) {
+    stats_->lines++;
+    stream_.AddLine(line);
+    Drain();
+  }
+
+  void Finish() {
+    stream_.Flush();
+    Drain();
+  }
+
+ private:
+  void Drain() {
+    while (auto msg = stream_.PopOldestMessage()) {
+      if (!options_.types[msg->message_id]) {
+        stats_->filtered++;
+        continue;
+      }
+      stats_->messages++;
+      WriteMessage(*msg, out_);
+    }
+  }
+
+  const Options &options_;
+  Output *out_;
+  Stats *stats_;
+  ParallelVdmStream stream_;
+};
+
+// Feeds every line of a file to decoder.  Returns false on a read error.
+template <typename Decoder>
+bool DecodeFile(const std::string &filename, Decoder *decoder, Stats *stats) {
+  Input input;
+  if (!input.Open(filename)) {
+    fprintf(stderr, "aisdecode: %s: %s\n", filename.c_str(), strerror(errno));
+    return false;
+  }
+  std::vector<char> buffer(kReadSize);
+  size_t used = 0;
+  while (true) {
+    if (buffer.size() - used < kReadSize / 2) {
+      // A line longer than the buffer.
+      buffer.resize(buffer.size() * 2);
+    }
+    const int64_t count =
+        input.Read(buffer.data() + used, buffer.size() - used);
+    if (count < 0) {
+      fprintf(stderr, "aisdecode: %s: read failed\n", filename.c_str());
+      return false;
+    }
+    if (count == 0) {
+      break;
+    }
+    stats->bytes += count;
+    used += count;
+    const char *begin = buffer.data();
+    const char *rest = decoder->AddBuffer(begin, begin + used);
+    used -= rest - begin;
+    std::memmove(buffer.data(), rest, used);
+  }
+  if (used != 0) {
+    // A last line without a newline.
+    std::string_view line(buffer.data(), used);
+    if (line.back() == '\r') {
+      line.remove_suffix(1);
+    }
+    decoder->AddLine(line);
+  }
+  return true;
+}
+
+template <typename Decoder>
+int DecodeFiles(const Options &options, Decoder *decoder, Stats *stats) {
+  int status = 0;
+  for (const std::string &filename : options.files) {
+    if (!DecodeFile(filename, decoder, stats)) {
+      status = 1;
+    }
+  }
+  decoder->Finish();
+  return status;
+}
+
+void PrintStats(const Options &options, const Stats &stats, double seconds) {
+  fprintf(stderr,
+          "aisdecode: %llu lines, %llu bytes, %llu messages written, "
+          "%llu filtered in %.3f s\n",
+          static_cast<unsigned long long>(stats.lines),
+          static_cast<unsigned long long>(stats.bytes),
+          static_cast<unsigned long long>(stats.messages),
+          static_cast<unsigned long long>(stats.filtered), seconds);
+  if (seconds > 0) {
+    fprintf(stderr,
+            "aisdecode: %.0f lines/s, %.0f messages/s, %.1f MB/s\n",
+            stats.lines / seconds, stats.messages / seconds,
+            stats.bytes / seconds / 1e6);
+  }
+  if (options.threads == 0) {
+    fprintf(stderr,
+            "aisdecode: %llu partial, %llu bad, %llu out of order, "
+            "%llu undecodable lines\n",
+            static_cast<unsigned long long>(
+                stats.line_status[VDM_LINE_PARTIAL]),
+            static_cast<unsigned long long>(
+                stats.line_status[VDM_LINE_BAD_SENTENCE]),
+            static_cast<unsigned long long>(
+                stats.line_status[VDM_LINE_OUT_OF_ORDER]),
+            static_cast<unsigned long long>(
+                stats.line_status[VDM_LINE_UNDECODABLE]));
+  }
+}
+
+int Main(int argc, char *argv[]) {
+  Options options;
+  const int args_status = ParseArgs(argc, argv, &options);
+  if (args_status != 0) {
+    return args_status < 0 ? 0 : args_status;
+  }
+
+  std::unique_ptr<Output> out;
+  if (options.format == FORMAT_CSV) {
+    out = std::make_unique<CsvOutput>();
+  } else {
+    out = std::make_unique<JsonOutput>();
+  }
+
+  const auto start = std::chrono::steady_clock::now();
+  Stats stats;
+  int status;
+  if (options.threads > 0) {
+    ParallelDecoder decoder(options, out.get(), &stats);
+    status = DecodeFiles(options, &decoder, &stats);
+  } else {
+    SerialDecoder decoder(options, out.get(), &stats);
+    status = DecodeFiles(options, &decoder, &stats);
+  }
+  if (!out->Flush() || fflush(stdout) != 0) {
+    fprintf(stderr, "aisdecode: write failed: %s\n", strerror(errno));
+    status = 1;
+  }
+  const std::chrono::duration<double> elapsed =
+      std::chrono::steady_clock::now() - start;
+
+  if (options.stats) {
+    PrintStats(options, stats, elapsed.count());
+  }
+  return status;
+}
+
+}  // namespace
+}  // namespace libais
+
+int main(int argc, char *argv[]) { return libais::Main(argc, argv); }
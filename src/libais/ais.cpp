@@ -2,10 +2,12 @@
 #include <array>
 #include <cassert>
 #include <cstddef>
+#include <new>
 #include <ostream>
 #include <string>
 
 #include "ais.h"
+#include "ais_alloc.h"
 
 int LibAisVersionMajor() {
   return LIBAIS_VERSION_MAJOR;
@@ -70,28 +72,62 @@ const std::array<const char * const, AIS_STATUS_NUM_CODES> AIS_STATUS_STRINGS{
   "AIS_ERR_BAD_SUB_SUB_MSG",
 };
 
-AisMsg::AisMsg(const char *nmea_payload, const size_t pad)
+AisMsg::AisMsg(const AisBitset &bs)
     : message_id(0), repeat_indicator(0), mmsi(0), status(AIS_UNINITIALIZED),
-      num_chars(0), num_bits(0), bits() {
-  assert(nmea_payload);
-  assert(pad < 6);
-
-  const AIS_STATUS r = bits.ParseNmeaPayload(nmea_payload, pad);
-  if (r != AIS_OK) {
-    status = r;
+      num_chars(0), num_bits(0) {
+  if (bs.GetStatus() != AIS_OK && bs.GetStatus() != AIS_UNINITIALIZED) {
+    status = bs.GetStatus();
     return;
   }
-  num_bits = bits.GetNumBits();
-  num_chars = bits.GetNumChars();
+  num_bits = bs.GetNumBits();
+  num_chars = bs.GetNumChars();
 
-  if (bits.GetNumBits() < 38) {
+  if (bs.GetNumBits() < 38) {
     status = AIS_ERR_BAD_BIT_COUNT;
     return;
   }
 
-  message_id = bits.ToUnsignedInt(0, 6);
-  repeat_indicator = bits.ToUnsignedInt(6, 2);
-  mmsi = bits.ToUnsignedInt(8, 30);
+  bs.SeekTo(0);
+  message_id = bs.ToUnsignedInt(0, 6);
+  repeat_indicator = bs.ToUnsignedInt(6, 2);
+  mmsi = bs.ToUnsignedInt(8, 30);
+}
+
+namespace {
+
+// Prefix of every AisMsg allocation.  Padded so that the message keeps the
+// alignment of the underlying allocation.
+struct alignas(std::max_align_t) AllocHeader {
+  AisMsgAllocator *allocator;
+  size_t size;
+};
+
+}  // namespace
+
+void *AisMsg::operator new(const size_t size) {
+  return operator new(size, nullptr);
+}
+
+void *AisMsg::operator new(const size_t size, AisMsgAllocator *allocator) {
+  const size_t total = size + sizeof(AllocHeader);
+  void *base = allocator ? allocator->Allocate(total) : ::operator new(total);
+  return new (base) AllocHeader{allocator, total} + 1;
+}
+
+void AisMsg::operator delete(void *ptr) {
+  if (ptr == nullptr) {
+    return;
+  }
+  AllocHeader *header = static_cast<AllocHeader *>(ptr) - 1;
+  if (header->allocator == nullptr) {
+    ::operator delete(header);
+    return;
+  }
+  header->allocator->Deallocate(header, header->size);
+}
+
+void AisMsg::operator delete(void *ptr, AisMsgAllocator * /* allocator */) {
+  operator delete(ptr);
 }
 
 bool AisMsg::CheckStatus() const {
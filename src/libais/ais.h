@@ -376,12 +376,24 @@ std::ostream& operator<< (std::ostream &o, const AisPoint &position);
 //////////////////////////////////////////////////////////////////////
 static const int MAX_BITS = 1192;
 
-class AisBitset : protected std::bitset<MAX_BITS> {
+// The payload is stored MSB first in big-endian 64-bit words so that any
+// field of up to 32 bits can be pulled out of a two word window with a couple
+// of shifts rather than a bit by bit loop.
+class AisBitset {
  public:
   AisBitset();
+  // Parses nmea_payload.  GetStatus() returns the result.
+  AisBitset(const char *nmea_payload, int pad);
 
   AIS_STATUS ParseNmeaPayload(const char *nmea_payload, int pad);
-
+  // Same as above for a payload that is not null terminated.  On x86 the
+  // characters are de-armored 16 or 32 at a time with SSSE3 or AVX2 when the
+  // CPU supports it.
+  AIS_STATUS ParseNmeaPayload(const char *nmea_payload, size_t payload_size,
+                              int pad);
+
+  // Result of the last ParseNmeaPayload or AIS_UNINITIALIZED if there was none.
+  AIS_STATUS GetStatus() const { return status; }
   int GetNumBits() const { return num_bits; }
   int GetNumChars() const { return num_chars; }
   int GetPosition() const { return current_position; }
@@ -398,19 +410,38 @@ class AisBitset : protected std::bitset<MAX_BITS> {
 
   const AisPoint ToAisPoint(size_t start, size_t point_size) const;
 
+  // Returns the 64 bits starting at start, left aligned, without moving the
+  // position.  Used by DecodeFields in ais_fields.h.
+  uint64_t PeekWindow(size_t start) const { return Window(start); }
+
   // Visible for testing.
-  static bitset<6> Reverse(const bitset<6> &bits);
+  static std::bitset<6> Reverse(const std::bitset<6> &bits);
 
  protected:
+  // One spare word past MAX_BITS so that reading the second half of a window
+  // never needs a bounds check.
+  static const size_t kNumWords = MAX_BITS / 64 + 2;
+
+  // Returns 64 bits starting at bit start, left aligned.
+  uint64_t Window(size_t start) const {
+    const size_t word = start / 64;
+    const size_t shift = start % 64;
+    // The split shift of the second word keeps shift == 0 well defined.
+    return (words_[word] << shift) | ((words_[word + 1] >> 1) >> (63 - shift));
+  }
+
+  void reset() { words_.fill(0); }
+
+  std::array<uint64_t, kNumWords> words_;
+  AIS_STATUS status;
   int num_bits;
   int num_chars;
 
-  static bool nmea_ord_initialized_;
-  static std::array<bitset<6>, 128> nmea_ord_;
+  // Maps an armored character to its 6-bit value or 0xFF if the character is
+  // not allowed in a payload.
+  static const std::array<uint8_t, 256> nmea_ord_;
   static const char bits_to_char_tbl_[];
 
-  static void InitNmeaOrd();
-
  private:
   // This will help uncover dicontinuities when querying sequential bits, i.e.
   // when we query a bit sequence that is not in direct succession of the
@@ -424,6 +455,8 @@ class AisBitset : protected std::bitset<MAX_BITS> {
   mutable int current_position;
 };
 
+class AisMsgAllocator;
+
 class AisMsg {
  public:
   int message_id = 0;
@@ -436,14 +469,24 @@ class AisMsg {
 
   virtual ~AisMsg() = default;
 
+  // Messages can be placed in an allocator from ais_alloc.h with
+  // new (allocator) Ais1_2_3(...).  A nullptr allocator uses the heap.
+  // Each message remembers where its memory came from so that a plain delete
+  // gives it back to the right place.
+  static void *operator new(size_t size);
+  static void *operator new(size_t size, AisMsgAllocator *allocator);
+  static void operator delete(void *ptr);
+  // Only used if a constructor throws.
+  static void operator delete(void *ptr, AisMsgAllocator *allocator);
+
  protected:
   AIS_STATUS status;  // AIS_OK or error code
   int num_chars;  // Number of characters in the nmea_payload.
   size_t num_bits;  // Number of bits in the nmea_payload.
-  AisBitset bits;  // The bitset that was constructed out of the nmea_payload.
-
   AisMsg() : status(AIS_UNINITIALIZED), num_chars(0), num_bits(0) {}
-  AisMsg(const char *nmea_payload, size_t pad);
+  // Decodes the common header from an already parsed payload.  The bitset is
+  // only needed while the subclass constructor runs and is not kept.
+  explicit AisMsg(const AisBitset &bs);
 
   // Returns true if the msg is in a good state "so far", i.e. either AIS_OK or
   // AIS_UNINITIALIZED.
@@ -518,6 +561,7 @@ class Ais1_2_3 : public AisMsg {
   bool keep_flag;  // 3.3.7.3.2 Annex 2 ITDMA.  Table 20
 
   Ais1_2_3(const char *nmea_payload, size_t pad);
+  explicit Ais1_2_3(const AisBitset &bits);
 };
 std::ostream& operator<< (std::ostream &o, const Ais1_2_3 &msg);
 
@@ -558,6 +602,7 @@ class Ais4_11 : public AisMsg {
 
   // **NO** ITDMA
   Ais4_11(const char *nmea_payload, size_t pad);
+  explicit Ais4_11(const AisBitset &bits);
 };
 std::ostream& operator<< (std::ostream &o, const Ais4_11 &msg);
 
@@ -583,6 +628,7 @@ class Ais5 : public AisMsg {
   int spare;
 
   Ais5(const char *nmea_payload, size_t pad);
+  explicit Ais5(const AisBitset &bits);
 };
 std::ostream& operator<< (std::ostream &o, const Ais5 &msg);
 
@@ -598,6 +644,7 @@ class Ais6 : public AisMsg {
 
   // TODO(schwehr): how to make Ais6 protected?
   Ais6(const char *nmea_payload, size_t pad);
+  explicit Ais6(const AisBitset &bits);
 
  protected:
   Ais6() = default;
@@ -618,6 +665,7 @@ class Ais6_0_0 : public Ais6 {
   int spare2;
 
   Ais6_0_0(const char *nmea_payload, size_t pad);
+  explicit Ais6_0_0(const AisBitset &bits);
 };
 std::ostream& operator<< (std::ostream &o, const Ais6_0_0 &msg);
 
@@ -630,6 +678,7 @@ class Ais6_1_0 : public Ais6 {
   int spare2;
 
   Ais6_1_0(const char *nmea_payload, size_t pad);
+  explicit Ais6_1_0(const AisBitset &bits);
 };
 std::ostream& operator<< (std::ostream &o, const Ais6_1_0 &msg);
 
@@ -641,6 +690,7 @@ class Ais6_1_1 : public Ais6 {
   int spare2;
 
   Ais6_1_1(const char *nmea_payload, size_t pad);
+  explicit Ais6_1_1(const AisBitset &bits);
 };
 std::ostream& operator<< (std::ostream &o, const Ais6_1_1 &msg);
 
@@ -652,6 +702,7 @@ class Ais6_1_2 : public Ais6 {
   // TODO(schwehr): spare2?
 
   Ais6_1_2(const char *nmea_payload, size_t pad);
+  explicit Ais6_1_2(const AisBitset &bits);
 };
 std::ostream& operator<< (std::ostream &o, const Ais6_1_2 &msg);
 
@@ -664,6 +715,7 @@ class Ais6_1_3 : public Ais6 {
   unsigned int spare4;
 
   Ais6_1_3(const char *nmea_payload, size_t pad);
+  explicit Ais6_1_3(const AisBitset &bits);
 };
 std::ostream& operator<< (std::ostream &o, const Ais6_1_3 &msg);
 
@@ -681,6 +733,7 @@ class Ais6_1_4 : public Ais6 {
   int spare5;
 
   Ais6_1_4(const char *nmea_payload, size_t pad);
+  explicit Ais6_1_4(const AisBitset &bits);
 };
 std::ostream& operator<< (std::ostream &o, const Ais6_1_4 &msg);
 
@@ -697,6 +750,7 @@ class Ais6_1_5 : public Ais6 {
   int spare2;
 
   Ais6_1_5(const char *nmea_payload, size_t pad);
+  explicit Ais6_1_5(const AisBitset &bits);
 };
 
 // IMO Circ 236 Dangerous cargo indication
@@ -721,6 +775,7 @@ class Ais6_1_12 : public Ais6 {
   int spare2;
 
   Ais6_1_12(const char *nmea_payload, size_t pad);
+  explicit Ais6_1_12(const AisBitset &bits);
 };
 std::ostream& operator<< (std::ostream &o, const Ais6_1_12 &msg);
 
@@ -746,6 +801,7 @@ class Ais6_1_14 : public Ais6 {
   std::vector<Ais6_1_14_Window> windows;
 
   Ais6_1_14(const char *nmea_payload, size_t pad);
+  explicit Ais6_1_14(const AisBitset &bits);
 };
 std::ostream& operator<< (std::ostream &o, const Ais6_1_14 &msg);
 
@@ -764,6 +820,7 @@ class Ais6_1_18 : public Ais6 {
   std::array<int, 2> spare2;  // 32 bits per spare
 
   Ais6_1_18(const char *nmea_payload, size_t pad);
+  explicit Ais6_1_18(const AisBitset &bits);
 };
 std::ostream& operator<< (std::ostream &o, const Ais6_1_18 &msg);
 
@@ -786,6 +843,7 @@ class Ais6_1_20 : public Ais6 {
   AisPoint position;
 
   Ais6_1_20(const char *nmea_payload, size_t pad);
+  explicit Ais6_1_20(const AisBitset &bits);
 };
 std::ostream& operator<< (std::ostream &o, const Ais6_1_20 &msg);
 
@@ -819,6 +877,7 @@ class Ais6_1_25 : public Ais6 {
   std::vector<Ais6_1_25_Cargo> cargos;  // 0 to 17 cargo entries
 
   Ais6_1_25(const char *nmea_payload, size_t pad);
+  explicit Ais6_1_25(const AisBitset &bits);
 };
 std::ostream& operator<< (std::ostream &o, const Ais6_1_25 &msg);
 
@@ -852,6 +911,7 @@ class Ais6_1_32 : public Ais6 {
   std::vector<Ais6_1_32_Window> windows;
 
   Ais6_1_32(const char *nmea_payload, size_t pad);
+  explicit Ais6_1_32(const AisBitset &bits);
 };
 std::ostream& operator<< (std::ostream &o, const Ais6_1_32 &msg);
 
@@ -862,6 +922,7 @@ class Ais6_1_40 : public Ais6 {
   int spare2;
 
   Ais6_1_40(const char *nmea_payload, size_t pad);
+  explicit Ais6_1_40(const AisBitset &bits);
 };
 std::ostream& operator<< (std::ostream &o, const Ais6_1_40 &msg);
 
@@ -876,6 +937,7 @@ class Ais7_13 : public AisMsg {
   std::vector<int> seq_num;
 
   Ais7_13(const char *nmea_payload, size_t pad);
+  explicit Ais7_13(const AisBitset &bits);
 };
 std::ostream& operator<< (std::ostream &o, const Ais7_13 &msg);
 
@@ -889,6 +951,7 @@ class Ais8 : public AisMsg {
 
   // TODO(schwehr): make Ais8 protected
   Ais8(const char *nmea_payload, size_t pad);
+  explicit Ais8(const AisBitset &bits);
 
  protected:
   Ais8() = default;
@@ -904,6 +967,7 @@ class Ais8_1_0 : public Ais8 {
   int spare2;
 
   Ais8_1_0(const char *nmea_payload, size_t pad);
+  explicit Ais8_1_0(const AisBitset &bits);
 };
 std::ostream& operator<< (std::ostream &o, const Ais8_1_0 &msg);
 
@@ -955,6 +1019,7 @@ class Ais8_1_11 : public Ais8 {
   int extended_water_level;  // OHMEX uses this for extra water level precision
 
   Ais8_1_11(const char *nmea_payload, size_t pad);
+  explicit Ais8_1_11(const AisBitset &bits);
 };
 std::ostream& operator<< (std::ostream &o, const Ais8_1_11 &msg);
 
@@ -980,6 +1045,7 @@ class Ais8_1_13 : public Ais8 {
   int spare2;
 
   Ais8_1_13(const char *nmea_payload, size_t pad);
+  explicit Ais8_1_13(const AisBitset &bits);
 };
 std::ostream& operator<< (std::ostream &o, const Ais8_1_13 &msg);
 
@@ -991,6 +1057,7 @@ class Ais8_1_15 : public Ais8 {
   int spare2;
 
   Ais8_1_15(const char *nmea_payload, size_t pad);
+  explicit Ais8_1_15(const AisBitset &bits);
 };
 std::ostream& operator<< (std::ostream &o, const Ais8_1_15 &msg);
 
@@ -1001,6 +1068,7 @@ class Ais8_1_16 : public Ais8 {
   int spare2;
 
   Ais8_1_16(const char *nmea_payload, size_t pad);
+  explicit Ais8_1_16(const AisBitset &bits);
 };
 std::ostream& operator<< (std::ostream &o, const Ais8_1_16 &msg);
 
@@ -1023,6 +1091,7 @@ class Ais8_1_17 : public Ais8 {
   std::vector<Ais8_1_17_Target> targets;
 
   Ais8_1_17(const char *nmea_payload, size_t pad);
+  explicit Ais8_1_17(const AisBitset &bits);
 };
 std::ostream& operator<< (std::ostream &o, const Ais8_1_17 &msg);
 
@@ -1042,6 +1111,7 @@ class Ais8_1_19 : public Ais8 {
   std::array<int, 4> spare2;
 
   Ais8_1_19(const char *nmea_payload, size_t pad);
+  explicit Ais8_1_19(const AisBitset &bits);
 };
 std::ostream& operator<< (std::ostream &o, const Ais8_1_19 &msg);
 
@@ -1121,6 +1191,7 @@ class Ais8_1_21 : public Ais8 {
   int bearing_ice_edge;
 
   Ais8_1_21(const char *nmea_payload, size_t pad);
+  explicit Ais8_1_21(const AisBitset &bits);
 };
 std::ostream& operator<< (std::ostream &o, const Ais8_1_21 &msg);
 
@@ -1258,6 +1329,7 @@ class Ais8_1_22 : public Ais8 {
   std::vector<std::unique_ptr<Ais8_1_22_SubArea>> sub_areas;
 
   Ais8_1_22(const char *nmea_payload, size_t pad);
+  explicit Ais8_1_22(const AisBitset &bits);
 };
 std::ostream& operator<< (std::ostream& o, Ais8_1_22 const& msg);
 
@@ -1287,6 +1359,7 @@ class Ais8_1_24 : public Ais8 {
   int spare2;
 
   Ais8_1_24(const char *nmea_payload, size_t pad);
+  explicit Ais8_1_24(const AisBitset &bits);
 };
 std::ostream& operator<< (std::ostream &o, const Ais8_1_24 &msg);
 
@@ -1527,6 +1600,7 @@ class Ais8_1_26 : public Ais8 {
   std::vector<Ais8_1_26_SensorReport *> reports;
 
   Ais8_1_26(const char *nmea_payload, size_t pad);
+  explicit Ais8_1_26(const AisBitset &bits);
   ~Ais8_1_26() override;
 };
 std::ostream& operator<< (std::ostream &o, const Ais8_1_26 &msg);
@@ -1546,6 +1620,7 @@ class Ais8_1_27 : public Ais8 {
   std::vector<AisPoint> waypoints;
 
   Ais8_1_27(const char *nmea_payload, size_t pad);
+  explicit Ais8_1_27(const AisBitset &bits);
 };
 std::ostream& operator<< (std::ostream &o, const Ais8_1_27 &msg);
 
@@ -1561,6 +1636,7 @@ class Ais8_1_29 : public Ais8 {
   int spare2;
 
   Ais8_1_29(const char *nmea_payload, size_t pad);
+  explicit Ais8_1_29(const AisBitset &bits);
 };
 std::ostream& operator<< (std::ostream &o, const Ais8_1_29 &msg);
 
@@ -1614,6 +1690,7 @@ class Ais8_1_31 : public Ais8 {
   int spare2;
 
   Ais8_1_31(const char *nmea_payload, size_t pad);
+  explicit Ais8_1_31(const AisBitset &bits);
 };
 std::ostream& operator<< (std::ostream &o, const Ais8_1_31 &msg);
 
@@ -1637,6 +1714,7 @@ class Ais8_200_10 : public Ais8 {
   int spare2;
 
   Ais8_200_10(const char *nmea_payload, size_t pad);
+  explicit Ais8_200_10(const AisBitset &bits);
 };
 
 // http://www.ris.eu/docs/File/536/vessel_traking_and_tracing_standard_ed1-2_ccnr_23-apr_2013_en.pdf
@@ -1662,6 +1740,7 @@ class Ais8_200_21 : public Ais8 {
   int spare2;             // 5 bits  Not used, should be set to zero.
 
   Ais8_200_21(const char *nmea_payload, size_t pad);
+  explicit Ais8_200_21(const AisBitset &bits);
 };
 
 // vessel_traking_and_tracing_standard_ed1-2_ccnr_23-apr_2013_en.pdf
@@ -1689,6 +1768,7 @@ class Ais8_200_22 : public Ais8 {
   int spare2;             // Spare
 
   Ais8_200_22(const char *nmea_payload, size_t pad);
+  explicit Ais8_200_22(const AisBitset &bits);
 };
 
 // ECE-TRANS-SC3-2006-10e-RIS.pdf - River Information System
@@ -1715,6 +1795,7 @@ class Ais8_200_23 : public Ais8 {
   int spare2;
 
   Ais8_200_23(const char *nmea_payload, size_t pad);
+  explicit Ais8_200_23(const AisBitset &bits);
 };
 
 // ECE-TRANS-SC3-2006-10e-RIS.pdf - River Information System
@@ -1728,6 +1809,7 @@ class Ais8_200_24 : public Ais8 {
   std::array<float, 4> levels;  // m
 
   Ais8_200_24(const char *nmea_payload, size_t pad);
+  explicit Ais8_200_24(const AisBitset &bits);
 };
 
 // ECE-TRANS-SC3-2006-10e-RIS.pdf - River Information System
@@ -1743,6 +1825,7 @@ class Ais8_200_40 : public Ais8 {
   int spare2;
 
   Ais8_200_40(const char *nmea_payload, size_t pad);
+  explicit Ais8_200_40(const AisBitset &bits);
 };
 
 // ECE-TRANS-SC3-2006-10e-RIS.pdf - River Information System
@@ -1755,6 +1838,7 @@ class Ais8_200_55 : public Ais8 {
   std::array<int, 3> spare2;  // 51 spare bits.
 
   Ais8_200_55(const char *nmea_payload, size_t pad);
+  explicit Ais8_200_55(const AisBitset &bits);
 };
 
 enum Ais8_366_22_AreaShapeEnum : std::int8_t {
@@ -1879,6 +1963,7 @@ class Ais8_366_22 : public Ais8 {
   std::vector<std::unique_ptr<Ais8_366_22_SubArea>> sub_areas;
 
   Ais8_366_22(const char *nmea_payload, size_t pad);
+  explicit Ais8_366_22(const AisBitset &bits);
 };
 std::ostream& operator<< (std::ostream& o, Ais8_366_22 const& msg);
 
@@ -1894,6 +1979,7 @@ class Ais8_366_56 : public Ais8 {
   std::vector<unsigned char> encrypted;
 
   Ais8_366_56(const char *nmea_payload, size_t pad);
+  explicit Ais8_366_56(const AisBitset &bits);
 };
 
 class Ais8_367_22_SubArea {
@@ -1989,6 +2075,7 @@ class Ais8_367_22 : public Ais8 {
   std::vector<std::unique_ptr<Ais8_367_22_SubArea>> sub_areas;
 
   Ais8_367_22(const char *nmea_payload, size_t pad);
+  explicit Ais8_367_22(const AisBitset &bits);
 };
 std::ostream& operator<< (std::ostream& o, Ais8_367_22 const& msg);
 
@@ -2013,6 +2100,7 @@ class Ais8_367_23 : public Ais8 {
   int spare2 = 0;
 
   Ais8_367_23(const char *nmea_payload, size_t pad);
+  explicit Ais8_367_23(const AisBitset &bits);
 };
 std::ostream& operator<< (std::ostream &o, const Ais8_367_23 &msg);
 
@@ -2029,6 +2117,7 @@ class Ais8_367_24 : public Ais8 {
   unsigned int pressure = 0;  // hPa
 
   Ais8_367_24(const char *nmea_payload, size_t pad);
+  explicit Ais8_367_24(const AisBitset &bits);
 };
 std::ostream& operator<< (std::ostream &o, const Ais8_367_24 &msg);
 
@@ -2048,6 +2137,7 @@ class Ais8_367_25 : public Ais8 {
   int wind_dir = 0;  // Degrees
 
   Ais8_367_25(const char *nmea_payload, size_t pad);
+  explicit Ais8_367_25(const AisBitset &bits);
 };
 std::ostream& operator<< (std::ostream &o, const Ais8_367_25 &msg);
 
@@ -2360,6 +2450,7 @@ class Ais8_367_33 : public Ais8 {
   std::vector<std::unique_ptr<Ais8_367_33_SensorReport>> reports;
 
   Ais8_367_33(const char *nmea_payload, size_t pad);
+  explicit Ais8_367_33(const AisBitset &bits);
 };
 std::ostream& operator<< (std::ostream &o, const Ais8_367_33 &msg);
 
@@ -2411,6 +2502,7 @@ class Ais9 : public AisMsg {
   bool keep_flag;
 
   Ais9(const char *nmea_payload, size_t pad);
+  explicit Ais9(const AisBitset &bits);
 };
 std::ostream& operator<< (std::ostream &o, const Ais9 &msg);
 
@@ -2422,6 +2514,7 @@ class Ais10 : public AisMsg {
   int spare2;
 
   Ais10(const char *nmea_payload, size_t pad);
+  explicit Ais10(const AisBitset &bits);
 };
 std::ostream& operator<< (std::ostream &o, const Ais10 &msg);
 
@@ -2438,6 +2531,7 @@ class Ais12 : public AisMsg {
   int spare2;
 
   Ais12(const char *nmea_payload, size_t pad);
+  explicit Ais12(const AisBitset &bits);
 };
 std::ostream& operator<< (std::ostream &o, const Ais12 &msg);
 
@@ -2451,6 +2545,7 @@ class Ais14 : public AisMsg {
   int spare2;
 
   Ais14(const char *nmea_payload, size_t pad);
+  explicit Ais14(const AisBitset &bits);
 };
 std::ostream& operator<< (std::ostream &o, const Ais14 &msg);
 
@@ -2473,6 +2568,7 @@ class Ais15 : public AisMsg {
   int spare4;
 
   Ais15(const char *nmea_payload, size_t pad);
+  explicit Ais15(const AisBitset &bits);
 };
 std::ostream& operator<< (std::ostream &o, const Ais15 &msg);
 
@@ -2489,6 +2585,7 @@ class Ais16 : public AisMsg {
   int spare2;
 
   Ais16(const char *nmea_payload, size_t pad);
+  explicit Ais16(const AisBitset &bits);
 };
 std::ostream& operator<< (std::ostream &o, const Ais16 &msg);
 
@@ -2508,6 +2605,7 @@ class Ais17 : public AisMsg {
   // TODO(schwehr): Handle payload
 
   Ais17(const char *nmea_payload, size_t pad);
+  explicit Ais17(const AisBitset &bits);
 };
 std::ostream& operator<< (std::ostream &o, const Ais17 &msg);
 
@@ -2569,6 +2667,7 @@ class Ais18 : public AisMsg {
   int commstate_cs_fill;
 
   Ais18(const char *nmea_payload, size_t pad);
+  explicit Ais18(const AisBitset &bits);
 };
 std::ostream& operator<< (std::ostream &o, const Ais18 &msg);
 
@@ -2596,6 +2695,7 @@ class Ais19 : public AisMsg {
   int spare3;
 
   Ais19(const char *nmea_payload, size_t pad);
+  explicit Ais19(const AisBitset &bits);
 };
 std::ostream& operator<< (std::ostream &o, const Ais19 &msg);
 
@@ -2630,6 +2730,7 @@ class Ais20 : public AisMsg {
   int spare2;
 
   Ais20(const char *nmea_payload, size_t pad);
+  explicit Ais20(const AisBitset &bits);
 };
 std::ostream& operator<< (std::ostream &o, const Ais20 &msg);
 
@@ -2656,6 +2757,7 @@ class Ais21 : public AisMsg {
   int spare2;
 
   Ais21(const char *nmea_payload, size_t pad);
+  explicit Ais21(const AisBitset &bits);
 };
 std::ostream& operator<< (std::ostream &o, const Ais21 &msg);
 
@@ -2685,6 +2787,7 @@ class Ais22 : public AisMsg {
   int spare2;  // Lame that they make a huge spare here.  Bad bad bad
 
   Ais22(const char *nmea_payload, size_t pad);
+  explicit Ais22(const AisBitset &bits);
 };
 std::ostream& operator<< (std::ostream &o, const Ais22 &msg);
 
@@ -2705,6 +2808,7 @@ class Ais23 : public AisMsg {
   int spare3;
 
   Ais23(const char *nmea_payload, size_t pad);
+  explicit Ais23(const AisBitset &bits);
 };
 std::ostream& operator<< (std::ostream &o, const Ais23 &msg);
 
@@ -2730,6 +2834,7 @@ class Ais24 : public AisMsg {
   // Part D - Not defined by ITU 1371-5
 
   Ais24(const char *nmea_payload, size_t pad);
+  explicit Ais24(const AisBitset &bits);
 };
 std::ostream& operator<< (std::ostream &o, const Ais24 &msg);
 
@@ -2748,6 +2853,7 @@ class Ais25 : public AisMsg {
   int fi;
 
   Ais25(const char *nmea_payload, size_t pad);
+  explicit Ais25(const AisBitset &bits);
 };
 std::ostream& operator<< (std::ostream &o, const Ais25 &msg);
 
@@ -2798,6 +2904,7 @@ class Ais26 : public AisMsg {
   bool keep_flag;
 
   Ais26(const char *nmea_payload, size_t pad);
+  explicit Ais26(const AisBitset &bits);
 };
 std::ostream& operator<< (std::ostream &o, const Ais26 &msg);
 
@@ -2814,6 +2921,7 @@ class Ais27 : public AisMsg {
   int spare;
 
   Ais27(const char *nmea_payload, size_t pad);
+  explicit Ais27(const AisBitset &bits);
 };
 std::ostream& operator<< (std::ostream &o, const Ais27 &msg);
 
@@ -9,11 +9,14 @@
 namespace libais {
 
 Ais10::Ais10(const char *nmea_payload, const size_t pad)
-    : AisMsg(nmea_payload, pad), spare(0), dest_mmsi(0), spare2(0) {
+    : Ais10(AisBitset(nmea_payload, pad)) {}
+
+Ais10::Ais10(const AisBitset &bits)
+    : AisMsg(bits), spare(0), dest_mmsi(0), spare2(0) {
   if (!CheckStatus()) {
     return;
   }
-  if (pad != 0 || num_chars != 12) {
+  if (num_bits != 72) {
     status = AIS_ERR_BAD_BIT_COUNT;
     return;
   }
@@ -8,7 +8,10 @@
 namespace libais {
 
 Ais12::Ais12(const char *nmea_payload, const size_t pad)
-    : AisMsg(nmea_payload, pad), seq_num(0), dest_mmsi(0), retransmitted(false),
+    : Ais12(AisBitset(nmea_payload, pad)) {}
+
+Ais12::Ais12(const AisBitset &bits)
+    : AisMsg(bits), seq_num(0), dest_mmsi(0), retransmitted(false),
       spare(0), spare2(0) {
   if (!CheckStatus()) {
     return;
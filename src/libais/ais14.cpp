@@ -8,7 +8,10 @@
 namespace libais {
 
 Ais14::Ais14(const char *nmea_payload, const size_t pad)
-    : AisMsg(nmea_payload, pad), spare(0), spare2(0) {
+    : Ais14(AisBitset(nmea_payload, pad)) {}
+
+Ais14::Ais14(const AisBitset &bits)
+    : AisMsg(bits), spare(0), spare2(0) {
   if (!CheckStatus()) {
     return;
   }
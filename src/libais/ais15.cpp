@@ -8,7 +8,10 @@
 namespace libais {
 
 Ais15::Ais15(const char *nmea_payload, const size_t pad)
-    : AisMsg(nmea_payload, pad), spare(0), mmsi_1(0), msg_1_1(0),
+    : Ais15(AisBitset(nmea_payload, pad)) {}
+
+Ais15::Ais15(const AisBitset &bits)
+    : AisMsg(bits), spare(0), mmsi_1(0), msg_1_1(0),
       slot_offset_1_1(0), spare2(0), dest_msg_1_2(0), slot_offset_1_2(0),
       spare3(0), mmsi_2(0), msg_2(0), slot_offset_2(0), spare4(0) {
   if (!CheckStatus()) {
@@ -9,7 +9,10 @@
 namespace libais {
 
 Ais16::Ais16(const char *nmea_payload, const size_t pad)
-    : AisMsg(nmea_payload, pad),
+    : Ais16(AisBitset(nmea_payload, pad)) {}
+
+Ais16::Ais16(const AisBitset &bits)
+    : AisMsg(bits),
       spare(0),
       dest_mmsi_a(0),
       offset_a(0),
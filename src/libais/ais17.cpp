@@ -20,7 +20,10 @@
 namespace libais {
 
 Ais17::Ais17(const char *nmea_payload, const size_t pad)
-    : AisMsg(nmea_payload, pad), spare(0), spare2(0), gnss_type(0), z_cnt(0),
+    : Ais17(AisBitset(nmea_payload, pad)) {}
+
+Ais17::Ais17(const AisBitset &bits)
+    : AisMsg(bits), spare(0), spare2(0), gnss_type(0), z_cnt(0),
       station(0), seq(0), health(0) {
   if (!CheckStatus()) {
     return;
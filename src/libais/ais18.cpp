@@ -4,11 +4,15 @@
 #include <cstddef>
 
 #include "ais.h"
+#include "ais_fields.h"
 
 namespace libais {
 
 Ais18::Ais18(const char *nmea_payload, const size_t pad)
-    : AisMsg(nmea_payload, pad),
+    : Ais18(AisBitset(nmea_payload, pad)) {}
+
+Ais18::Ais18(const AisBitset &bits)
+    : AisMsg(bits),
       spare(0),
       sog(0.0),
       position_accuracy(0),
@@ -48,7 +52,7 @@ Ais18::Ais18(const char *nmea_payload, const size_t pad)
   if (!CheckStatus()) {
     return;
   }
-  if (pad != 0 || num_chars != 28) {
+  if (num_bits != 168) {
     status = AIS_ERR_BAD_BIT_COUNT;
     return;
   }
@@ -56,24 +60,7 @@ Ais18::Ais18(const char *nmea_payload, const size_t pad)
   assert(message_id == 18);
 
   bits.SeekTo(38);
-  spare = bits.ToUnsignedInt(38, 8);
-  sog = bits.ToUnsignedInt(46, 10) / 10.;
-
-  position_accuracy = bits[56];
-  position = bits.ToAisPoint(57, 55);
-
-  cog = bits.ToUnsignedInt(112, 12) / 10.;
-  true_heading = bits.ToUnsignedInt(124, 9);
-  timestamp = bits.ToUnsignedInt(133, 6);
-  spare2 = bits.ToUnsignedInt(139, 2);
-  unit_flag = bits[141];
-  display_flag = bits[142];
-  dsc_flag = bits[143];
-  band_flag = bits[144];
-  m22_flag = bits[145];
-  mode_flag = bits[146];
-  raim = bits[147];
-  commstate_flag = bits[148];  // 0 SOTDMA, 1 ITDMA
+  DecodeFields(bits, kAis18Layout, this);
 
   if (unit_flag == 0) {
     sync_state = bits.ToUnsignedInt(149, 2);
@@ -6,11 +6,15 @@
 #include <ostream>
 
 #include "ais.h"
+#include "ais_fields.h"
 
 namespace libais {
 
 Ais1_2_3::Ais1_2_3(const char *nmea_payload, const size_t pad)
-    : AisMsg(nmea_payload, pad), nav_status(AIS_NV_STATUS_UNDEFINED), rot_over_range(false),
+    : Ais1_2_3(AisBitset(nmea_payload, pad)) {}
+
+Ais1_2_3::Ais1_2_3(const AisBitset &bits)
+    : AisMsg(bits), nav_status(AIS_NV_STATUS_UNDEFINED), rot_over_range(false),
       rot_raw(0), rot(0.0), sog(0.0), position_accuracy(0),
       cog(0.0), true_heading(0), timestamp(0), special_manoeuvre(0), spare(0),
       raim(false), sync_state(0),
@@ -25,7 +29,7 @@ Ais1_2_3::Ais1_2_3(const char *nmea_payload, const size_t pad)
   if (!CheckStatus()) {
     return;
   }
-  if (pad != 0 || num_chars != 28) {
+  if (num_bits != 168) {
     status = AIS_ERR_BAD_BIT_COUNT;
     return;
   }
@@ -33,25 +37,12 @@ Ais1_2_3::Ais1_2_3(const char *nmea_payload, const size_t pad)
   assert(message_id >= 1 && message_id <= 3);
 
   bits.SeekTo(38);
-  nav_status = static_cast<AIS_NAVIGATIONAL_STATUS>(bits.ToUnsignedInt(38, 4));
+  DecodeFields(bits, kAis1_2_3Layout, this);
 
-  rot_raw = bits.ToInt(42, 8);
   rot_over_range = std::abs(rot_raw) > 126;
   rot = pow((rot_raw/4.733), 2);
   if (rot_raw < 0) rot = -rot;
 
-  sog = bits.ToUnsignedInt(50, 10) / 10.0F;  // Knots.
-  position_accuracy = bits[60];
-  position = bits.ToAisPoint(61, 55);
-  cog = bits.ToUnsignedInt(116, 12) / 10.0F;  // Degrees.
-  true_heading = bits.ToUnsignedInt(128, 9);
-  timestamp = bits.ToUnsignedInt(137, 6);
-  special_manoeuvre = bits.ToUnsignedInt(143, 2);
-  spare = bits.ToUnsignedInt(145, 3);
-  raim = bits[148];
-
-  sync_state = bits.ToUnsignedInt(149, 2);
-
   if (message_id == 1 || message_id == 2) {
     slot_timeout = bits.ToUnsignedInt(151, 3);
     slot_timeout_valid = true;
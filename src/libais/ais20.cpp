@@ -8,7 +8,10 @@
 namespace libais{
 
 Ais20::Ais20(const char *nmea_payload, const size_t pad)
-    : AisMsg(nmea_payload, pad), spare(0), offset_1(0), num_slots_1(0),
+    : Ais20(AisBitset(nmea_payload, pad)) {}
+
+Ais20::Ais20(const AisBitset &bits)
+    : AisMsg(bits), spare(0), offset_1(0), num_slots_1(0),
       timeout_1(0), incr_1(0), group_valid_2(false), offset_2(0),
       num_slots_2(0), timeout_2(0), incr_2(0), group_valid_3(false),
       offset_3(0), num_slots_3(0), timeout_3(0), incr_3(0),
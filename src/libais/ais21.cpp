@@ -4,11 +4,15 @@
 #include <cstddef>
 
 #include "ais.h"
+#include "ais_fields.h"
 
 namespace libais {
 
 Ais21::Ais21(const char *nmea_payload, const size_t pad)
-    : AisMsg(nmea_payload, pad), aton_type(0), position_accuracy(0), dim_a(0),
+    : Ais21(AisBitset(nmea_payload, pad)) {}
+
+Ais21::Ais21(const AisBitset &bits)
+    : AisMsg(bits), aton_type(0), position_accuracy(0), dim_a(0),
       dim_b(0), dim_c(0), dim_d(0), fix_type(0), timestamp(0), off_pos(false),
       aton_status(0), raim(false), virtual_aton(false), assigned_mode(false),
       spare(0), spare2(0) {
@@ -20,51 +24,30 @@ Ais21::Ais21(const char *nmea_payload, const size_t pad)
     return;
   }
 
-  AisBitset bs;
-  const AIS_STATUS r = bs.ParseNmeaPayload(nmea_payload, pad);
-  if (r != AIS_OK) {
-    status = r;
-    return;
-  }
-
-  bs.SeekTo(38);
-  aton_type = bs.ToUnsignedInt(38, 5);
-  name = bs.ToString(43, 120);
-  position_accuracy = bs[163];
-  position = bs.ToAisPoint(164, 55);
-  dim_a = bs.ToUnsignedInt(219, 9);
-  dim_b = bs.ToUnsignedInt(228, 9);
-  dim_c = bs.ToUnsignedInt(237, 6);
-  dim_d = bs.ToUnsignedInt(243, 6);
-  fix_type = bs.ToUnsignedInt(249, 4);
-  timestamp = bs.ToUnsignedInt(253, 6);
-  off_pos = bs[259];
-  aton_status = bs.ToUnsignedInt(260, 8);
+  bits.SeekTo(38);
+  DecodeFields(bits, kAis21Layout, this);
   if (num_bits == 268) {
     // Non-standard small message.
-    assert(bs.GetRemaining() == 0);
+    assert(bits.GetRemaining() == 0);
     status = AIS_OK;
     return;
   }
-  raim = bs[268];
-  virtual_aton = bs[269];
-  assigned_mode = bs[270];
-  spare = bs[271];
+  DecodeFields(bits, kAis21FlagsLayout, this);
 
-  const size_t extra_chars = bs.GetRemaining() / 6;
-  const size_t extra_bits = bs.GetRemaining() % 6;
+  const size_t extra_chars = bits.GetRemaining() / 6;
+  const size_t extra_bits = bits.GetRemaining() % 6;
 
   if (extra_chars > 0) {
-    name += bs.ToString(272, extra_chars * 6);
+    name += bits.ToString(272, extra_chars * 6);
   }
 
   if (extra_bits > 0) {
-    spare2 = bs.ToUnsignedInt(272 + extra_chars * 6, extra_bits);
+    spare2 = bits.ToUnsignedInt(272 + extra_chars * 6, extra_bits);
   } else {
     spare2 = 0;
   }
 
-  assert(bs.GetRemaining() == 0);
+  assert(bits.GetRemaining() == 0);
   status = AIS_OK;
 }
 
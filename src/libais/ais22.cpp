@@ -8,14 +8,17 @@
 namespace libais {
 
 Ais22::Ais22(const char *nmea_payload, const size_t pad)
-    : AisMsg(nmea_payload, pad), spare(0), chan_a(0), chan_b(0), txrx_mode(0),
+    : Ais22(AisBitset(nmea_payload, pad)) {}
+
+Ais22::Ais22(const AisBitset &bits)
+    : AisMsg(bits), spare(0), chan_a(0), chan_b(0), txrx_mode(0),
       power_low(false), pos_valid(false), dest_valid(false), dest_mmsi_1(0),
       dest_mmsi_2(0), chan_a_bandwidth(0), chan_b_bandwidth(0), zone_size(0),
       spare2(0) {
   if (!CheckStatus()) {
     return;
   }
-  if (pad != 0 || num_chars != 28) {
+  if (num_bits != 168) {
     status = AIS_ERR_BAD_BIT_COUNT;
     return;
   }
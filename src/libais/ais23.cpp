@@ -8,12 +8,15 @@
 namespace libais {
 
 Ais23::Ais23(const char *nmea_payload, const size_t pad)
-    : AisMsg(nmea_payload, pad), spare(0), station_type(0), type_and_cargo(0),
+    : Ais23(AisBitset(nmea_payload, pad)) {}
+
+Ais23::Ais23(const AisBitset &bits)
+    : AisMsg(bits), spare(0), station_type(0), type_and_cargo(0),
       spare2(3), txrx_mode(0), interval_raw(0), quiet(0), spare3(0) {
   if (!CheckStatus()) {
     return;
   }
-  if (pad != 2 || num_chars != 27) {
+  if (num_bits != 160) {
     status = AIS_ERR_BAD_BIT_COUNT;
     return;
   }
@@ -5,11 +5,15 @@
 #include <cstddef>
 
 #include "ais.h"
+#include "ais_fields.h"
 
 namespace libais {
 
 Ais24::Ais24(const char *nmea_payload, const size_t pad)
-    : AisMsg(nmea_payload, pad), part_num(0), type_and_cargo(0),
+    : Ais24(AisBitset(nmea_payload, pad)) {}
+
+Ais24::Ais24(const AisBitset &bits)
+    : AisMsg(bits), part_num(0), type_and_cargo(0),
       dim_a(0), dim_b(0), dim_c(0), dim_d(0), spare(0) {
   if (!CheckStatus()) {
     return;
@@ -39,14 +43,7 @@ Ais24::Ais24(const char *nmea_payload, const size_t pad)
       part_num = 0;
       break;
     }
-    type_and_cargo = bits.ToUnsignedInt(40, 8);
-    vendor_id = bits.ToString(48, 42);
-    callsign = bits.ToString(90, 42);
-    dim_a = bits.ToUnsignedInt(132, 9);
-    dim_b = bits.ToUnsignedInt(141, 9);
-    dim_c = bits.ToUnsignedInt(150, 6);
-    dim_d = bits.ToUnsignedInt(156, 6);
-    spare = bits.ToUnsignedInt(162, 6);
+    DecodeFields(bits, kAis24PartBLayout, this);
     break;
   case 2:  // FALLTHROUGH - Not defined by ITU 1371-5
   case 3:  // FALLTHROUGH - Not defined by ITU 1371-5
@@ -0,0 +1,113 @@
+// Pair up parts A and B of Class B static data reports.
+
+#include "ais24_assembler.h"
+
+#include <cassert>
+#include <cstddef>
+#include <cstdint>
+#include <list>
+#include <string>
+#include <unordered_map>
+#include <utility>
+
+#include "ais.h"
+
+namespace libais {
+
+Ais24Assembler::Ais24Assembler(const int64_t ttl, const size_t max_pending)
+    : ttl_(ttl), max_pending_(max_pending) {
+  assert(ttl >= 0);
+  assert(max_pending > 0);
+}
+
+size_t Ais24Assembler::memory_used() const {
+  // A hash node holds the next pointer and the cached hash beside the value.
+  // A list node holds two pointers beside the MMSI.
+  constexpr size_t kEntryBytes = sizeof(std::pair<const int, Pending>) +
+                                 2 * sizeof(void *) + 3 * sizeof(void *);
+  return sizeof(*this) + pending_.bucket_count() * sizeof(void *) +
+         pending_.size() * kEntryBytes;
+}
+
+void Ais24Assembler::Drop(std::unordered_map<int, Pending>::iterator it) {
+  if (it->second.has_part_a) {
+    unmatched_part_a_++;
+  }
+  if (it->second.has_part_b) {
+    unmatched_part_b_++;
+  }
+  order_.erase(it->second.order);
+  pending_.erase(it);
+}
+
+void Ais24Assembler::Expire(const int64_t time) {
+  while (!order_.empty()) {
+    auto it = pending_.find(order_.front());
+    assert(it != pending_.end());
+    if (time - it->second.last_time < ttl_) {
+      return;
+    }
+    Drop(it);
+  }
+}
+
+bool Ais24Assembler::Add(const Ais24 &msg, const int64_t time,
+                         Ais24Static *record) {
+  assert(record);
+  if (msg.had_error() || (msg.part_num != 0 && msg.part_num != 1)) {
+    return false;
+  }
+  Expire(time);
+
+  auto it = pending_.find(msg.mmsi);
+  if (it == pending_.end()) {
+    if (pending_.size() >= max_pending_) {
+      evicted_++;
+      Drop(pending_.find(order_.front()));
+    }
+    it = pending_.emplace(msg.mmsi, Pending()).first;
+    it->second.order = order_.insert(order_.end(), msg.mmsi);
+  } else {
+    order_.splice(order_.end(), order_, it->second.order);
+  }
+
+  Pending &pending = it->second;
+  pending.last_time = time;
+  if (msg.part_num == 0) {
+    pending.has_part_a = true;
+    pending.part_a_time = time;
+    pending.name.Assign(msg.name);
+  } else {
+    pending.has_part_b = true;
+    pending.part_b_time = time;
+    pending.vendor_id.Assign(msg.vendor_id);
+    pending.callsign.Assign(msg.callsign);
+    pending.type_and_cargo = msg.type_and_cargo;
+    pending.dim_a = msg.dim_a;
+    pending.dim_b = msg.dim_b;
+    pending.dim_c = msg.dim_c;
+    pending.dim_d = msg.dim_d;
+  }
+  if (!pending.has_part_a || !pending.has_part_b) {
+    return false;
+  }
+
+  record->mmsi = msg.mmsi;
+  record->name.assign(pending.name.view());
+  record->part_a_time = pending.part_a_time;
+  record->type_and_cargo = pending.type_and_cargo;
+  record->vendor_id.assign(pending.vendor_id.view());
+  record->callsign.assign(pending.callsign.view());
+  record->dim_a = pending.dim_a;
+  record->dim_b = pending.dim_b;
+  record->dim_c = pending.dim_c;
+  record->dim_d = pending.dim_d;
+  record->part_b_time = pending.part_b_time;
+  completed_++;
+
+  order_.erase(pending.order);
+  pending_.erase(it);
+  return true;
+}
+
+}  // namespace libais
@@ -0,0 +1,132 @@
+// -*- c++ -*-
+
+// Pair up the halves of Class B static data reports.
+//
+// Message 24 comes in two parts that are decoded as separate messages: part
+// A with the name and part B with the type and cargo, vendor id, callsign and
+// dimensions.  Ais24Assembler holds each half by MMSI until the other half
+// arrives and then gives back one Ais24Static with both.
+//
+// Memory is bounded.  A half that waits longer than the ttl for its partner
+// is dropped, and when max_pending MMSIs are waiting the one that was added
+// to least recently is dropped to make room.  The pending halves are kept in
+// order of when they were last added to, so expiring them is cheap.
+
+#ifndef LIBAIS_AIS24_ASSEMBLER_H_
+#define LIBAIS_AIS24_ASSEMBLER_H_
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <list>
+#include <string>
+#include <string_view>
+#include <unordered_map>
+
+#include "ais.h"
+
+namespace libais {
+
+// The most MMSIs that an Ais24Assembler holds halves for by default.
+constexpr size_t kMaxPendingAis24 = 65536;
+
+// Parts A and B of a message 24.  The text fields are as decoded by Ais24.
+struct Ais24Static {
+  int mmsi = 0;
+
+  // Part A.
+  std::string name;
+  int64_t part_a_time = -1;
+
+  // Part B.
+  int type_and_cargo = 0;
+  std::string vendor_id;
+  std::string callsign;
+  int dim_a = 0;
+  int dim_b = 0;
+  int dim_c = 0;
+  int dim_d = 0;
+  int64_t part_b_time = -1;
+};
+
+class Ais24Assembler {
+ public:
+  // A half is dropped when a message at least ttl newer arrives before its
+  // partner.  ttl is in the same units as the time passed to Add.
+  explicit Ais24Assembler(int64_t ttl, size_t max_pending = kMaxPendingAis24);
+
+  Ais24Assembler(const Ais24Assembler &) = delete;
+  Ais24Assembler &operator=(const Ais24Assembler &) = delete;
+
+  // Adds part A or B of a message 24 received at time.  Returns true and
+  // fills record when this completes the pair for the MMSI, which then starts
+  // over.  A half that repeats before its partner arrives replaces the
+  // earlier copy.  Returns false for messages with errors or other parts.
+  // time should not go backwards.
+  bool Add(const Ais24 &msg, int64_t time, Ais24Static *record);
+
+  // Drops the halves that have waited longer than the ttl as of time.  Add
+  // does this itself.
+  void Expire(int64_t time);
+
+  // The number of MMSIs waiting for their other half.
+  size_t pending() const { return pending_.size(); }
+  // An estimate of the bytes held for pending halves.
+  size_t memory_used() const;
+
+  // Pairs that Add completed.
+  uint64_t completed() const { return completed_; }
+  // Halves dropped without a partner, either for the ttl or for room.
+  uint64_t unmatched_part_a() const { return unmatched_part_a_; }
+  uint64_t unmatched_part_b() const { return unmatched_part_b_; }
+  // The MMSIs dropped for room rather than the ttl.
+  uint64_t evicted() const { return evicted_; }
+
+ private:
+  // Fixed size text so that a pending half does not allocate.
+  template <size_t N>
+  struct Text {
+    std::array<char, N> chars;
+    uint8_t size = 0;
+
+    void Assign(const std::string &text) {
+      size = static_cast<uint8_t>(text.copy(chars.data(), N));
+    }
+    std::string_view view() const { return {chars.data(), size}; }
+  };
+
+  struct Pending {
+    bool has_part_a = false;
+    bool has_part_b = false;
+    int64_t part_a_time = 0;
+    int64_t part_b_time = 0;
+    int64_t last_time = 0;
+    Text<20> name;
+    Text<7> vendor_id;
+    Text<7> callsign;
+    int type_and_cargo = 0;
+    int dim_a = 0;
+    int dim_b = 0;
+    int dim_c = 0;
+    int dim_d = 0;
+    std::list<int>::iterator order;
+  };
+
+  // Counts the unmatched halves and forgets the MMSI.
+  void Drop(std::unordered_map<int, Pending>::iterator it);
+
+  const int64_t ttl_;
+  const size_t max_pending_;
+  std::unordered_map<int, Pending> pending_;
+  // MMSIs from the least to the most recently added to.
+  std::list<int> order_;
+
+  uint64_t completed_ = 0;
+  uint64_t unmatched_part_a_ = 0;
+  uint64_t unmatched_part_b_ = 0;
+  uint64_t evicted_ = 0;
+};
+
+}  // namespace libais
+
+#endif  // LIBAIS_AIS24_ASSEMBLER_H_
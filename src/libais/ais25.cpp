@@ -10,7 +10,10 @@
 namespace libais {
 
 Ais25::Ais25(const char *nmea_payload, const size_t pad)
-    : AisMsg(nmea_payload, pad), use_app_id(false),  dest_mmsi_valid(false),
+    : Ais25(AisBitset(nmea_payload, pad)) {}
+
+Ais25::Ais25(const AisBitset &bits)
+    : AisMsg(bits), use_app_id(false),  dest_mmsi_valid(false),
       dest_mmsi(false), dac(0), fi(0) {
   if (!CheckStatus()) {
     return;
@@ -12,7 +12,10 @@
 namespace libais {
 
 Ais26::Ais26(const char *nmea_payload, const size_t pad)
-    : AisMsg(nmea_payload, pad), use_app_id(false), dest_mmsi_valid(false),
+    : Ais26(AisBitset(nmea_payload, pad)) {}
+
+Ais26::Ais26(const AisBitset &bits)
+    : AisMsg(bits), use_app_id(false), dest_mmsi_valid(false),
       dest_mmsi(0), dac(0), fi(0), commstate_flag(0), sync_state(0),
       slot_timeout_valid(false), slot_timeout(0),
       received_stations_valid(false), received_stations(0),
@@ -40,6 +43,10 @@ Ais26::Ais26(const char *nmea_payload, const size_t pad)
   const bool addressed = bits[38];
   use_app_id = bits[39];
   if (addressed) {
+    if (num_bits < 70) {
+      status = AIS_ERR_BAD_BIT_COUNT;
+      return;
+    }
     dest_mmsi_valid = true;
     dest_mmsi = bits.ToUnsignedInt(40, 30);
     if (use_app_id) {
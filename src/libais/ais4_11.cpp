@@ -5,11 +5,15 @@
 #include <ostream>
 
 #include "ais.h"
+#include "ais_fields.h"
 
 namespace libais {
 
 Ais4_11::Ais4_11(const char *nmea_payload, const size_t pad)
-    : AisMsg(nmea_payload, pad), year(0), month(0), day(0), hour(0), minute(0),
+    : Ais4_11(AisBitset(nmea_payload, pad)) {}
+
+Ais4_11::Ais4_11(const AisBitset &bits)
+    : AisMsg(bits), year(0), month(0), day(0), hour(0), minute(0),
       second(0), position_accuracy(0), fix_type(0),
       transmission_ctl(0), spare(0), raim(false), sync_state(0),
       slot_timeout(0), received_stations_valid(false), received_stations(0),
@@ -18,7 +22,7 @@ Ais4_11::Ais4_11(const char *nmea_payload, const size_t pad)
   if (!CheckStatus()) {
     return;
   }
-  if (pad != 0 || num_chars != 28) {
+  if (num_bits != 168) {
     status = AIS_ERR_BAD_BIT_COUNT;
     return;
   }
@@ -26,23 +30,9 @@ Ais4_11::Ais4_11(const char *nmea_payload, const size_t pad)
   assert(message_id == 4 || message_id == 11);
 
   bits.SeekTo(38);
-  year = bits.ToUnsignedInt(38, 14);
-  month = bits.ToUnsignedInt(52, 4);
-  day = bits.ToUnsignedInt(56, 5);
-  hour = bits.ToUnsignedInt(61, 5);
-  minute = bits.ToUnsignedInt(66, 6);
-  second = bits.ToUnsignedInt(72, 6);
-
-  position_accuracy = bits[78];
-  position = bits.ToAisPoint(79, 55);
-
-  fix_type = bits.ToUnsignedInt(134, 4);
-  transmission_ctl = bits[138];
-  spare = bits.ToUnsignedInt(139, 9);
-  raim = bits[148];
+  DecodeFields(bits, kAis4_11Layout, this);
 
   // SOTDMA commstate
-  sync_state = bits.ToUnsignedInt(149, 2);
   slot_timeout = bits.ToUnsignedInt(151, 3);
 
   switch (slot_timeout) {
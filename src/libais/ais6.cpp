@@ -9,15 +9,16 @@
 namespace libais {
 
 Ais6::Ais6(const char *nmea_payload, const size_t pad)
-    : AisMsg(nmea_payload, pad) {
+    : Ais6(AisBitset(nmea_payload, pad)) {}
+
+Ais6::Ais6(const AisBitset &bits)
+    : AisMsg(bits) {
 
   if (!CheckStatus()) {
     return;
   }
 
-  // TODO(olafsinram): 46 or rather 56??
-  const int payload_len = num_bits - 46;  // in bits w/o DAC/FI
-  if (num_bits < 88 || payload_len < 0 || payload_len > 952) {
+  if (num_bits < 88) {
     status = AIS_ERR_BAD_BIT_COUNT;
     return;
   }
@@ -31,11 +32,23 @@ Ais6::Ais6(const char *nmea_payload, const size_t pad)
   spare = bits[71];
   dac = bits.ToUnsignedInt(72, 10);
   fi = bits.ToUnsignedInt(82, 6);
+
+  // Checked after the DAC and FI are set so that they always match what
+  // CreateAisMsg dispatched on.
+  // TODO(olafsinram): 46 or rather 56??
+  const int payload_len = num_bits - 46;  // in bits w/o DAC/FI
+  if (payload_len > 952) {
+    status = AIS_ERR_BAD_BIT_COUNT;
+    return;
+  }
 }
 
 // http://www.e-navigation.nl/content/monitoring-aids-navigation
 Ais6_0_0::Ais6_0_0(const char *nmea_payload, const size_t pad)
-    : Ais6(nmea_payload, pad),
+    : Ais6_0_0(AisBitset(nmea_payload, pad)) {}
+
+Ais6_0_0::Ais6_0_0(const AisBitset &bits)
+    : Ais6(bits),
       sub_id(1),
       voltage(0.0),
       current(0.0),
@@ -72,7 +85,10 @@ Ais6_0_0::Ais6_0_0(const char *nmea_payload, const size_t pad)
 }
 
 Ais6_1_0::Ais6_1_0(const char *nmea_payload, const size_t pad)
-    : Ais6(nmea_payload, pad), ack_required(false), msg_seq(0),
+    : Ais6_1_0(AisBitset(nmea_payload, pad)) {}
+
+Ais6_1_0::Ais6_1_0(const AisBitset &bits)
+    : Ais6(bits), ack_required(false), msg_seq(0),
       spare2(0) {
   assert(dac == 1);
   assert(fi == 0);
@@ -106,7 +122,10 @@ Ais6_1_0::Ais6_1_0(const char *nmea_payload, const size_t pad)
 }
 
 Ais6_1_1::Ais6_1_1(const char *nmea_payload, const size_t pad)
-    : Ais6(nmea_payload, pad), ack_dac(0), msg_seq(0), spare2(0) {
+    : Ais6_1_1(AisBitset(nmea_payload, pad)) {}
+
+Ais6_1_1::Ais6_1_1(const AisBitset &bits)
+    : Ais6(bits), ack_dac(0), msg_seq(0), spare2(0) {
   assert(dac == 1);
   assert(fi == 1);
 
@@ -129,7 +148,10 @@ Ais6_1_1::Ais6_1_1(const char *nmea_payload, const size_t pad)
 }
 
 Ais6_1_2::Ais6_1_2(const char *nmea_payload, const size_t pad)
-    : Ais6(nmea_payload, pad), req_dac(0), req_fi(0) {
+    : Ais6_1_2(AisBitset(nmea_payload, pad)) {}
+
+Ais6_1_2::Ais6_1_2(const AisBitset &bits)
+    : Ais6(bits), req_dac(0), req_fi(0) {
   assert(dac == 1);
   assert(fi == 2);
 
@@ -152,7 +174,10 @@ Ais6_1_2::Ais6_1_2(const char *nmea_payload, const size_t pad)
 
 // IFM 3: Capability interrogation - OLD ITU 1371-1
 Ais6_1_3::Ais6_1_3(const char *nmea_payload, const size_t pad)
-    : Ais6(nmea_payload, pad), req_dac(0), spare2(0), spare3(0), spare4(0) {
+    : Ais6_1_3(AisBitset(nmea_payload, pad)) {}
+
+Ais6_1_3::Ais6_1_3(const AisBitset &bits)
+    : Ais6(bits), req_dac(0), spare2(0), spare3(0), spare4(0) {
   assert(dac == 1);
   assert(fi == 3);
 
@@ -185,7 +210,10 @@ Ais6_1_3::Ais6_1_3(const char *nmea_payload, const size_t pad)
 // IFM 4: Capability reply - OLD ITU 1371-4
 // TODO(schwehr): WTF?  10 + 128 + 6 == 80  Is this 168 or 232 bits?
 Ais6_1_4::Ais6_1_4(const char *nmea_payload, const size_t pad)
-    : Ais6(nmea_payload, pad), ack_dac(0), capabilities(),
+    : Ais6_1_4(AisBitset(nmea_payload, pad)) {}
+
+Ais6_1_4::Ais6_1_4(const AisBitset &bits)
+    : Ais6(bits), ack_dac(0), capabilities(),
       cap_reserved(), spare2(0), spare3(0), spare4(0), spare5(0) {
   assert(dac == 1);
   assert(fi == 4);
@@ -220,7 +248,10 @@ Ais6_1_4::Ais6_1_4(const char *nmea_payload, const size_t pad)
 
 // IMO 1371-5 Ack
 Ais6_1_5::Ais6_1_5(const char *nmea_payload, const size_t pad)
-    : Ais6(nmea_payload, pad), ack_dac(0), ack_fi(0), seq_num(0),
+    : Ais6_1_5(AisBitset(nmea_payload, pad)) {}
+
+Ais6_1_5::Ais6_1_5(const AisBitset &bits)
+    : Ais6(bits), ack_dac(0), ack_fi(0), seq_num(0),
       ai_available(false), ai_response(0), spare(0), spare2(0) {
   assert(dac == 1);
   assert(fi == 5);
@@ -251,7 +282,10 @@ Ais6_1_5::Ais6_1_5(const char *nmea_payload, const size_t pad)
 // IMO Circ 289 - Dangerous cargo
 // See also Circ 236
 Ais6_1_12::Ais6_1_12(const char *nmea_payload, const size_t pad)
-    : Ais6(nmea_payload, pad), utc_month_dep(0), utc_day_dep(0),
+    : Ais6_1_12(AisBitset(nmea_payload, pad)) {}
+
+Ais6_1_12::Ais6_1_12(const AisBitset &bits)
+    : Ais6(bits), utc_month_dep(0), utc_day_dep(0),
       utc_hour_dep(0), utc_min_dep(0), utc_month_next(0),
       utc_day_next(0), utc_hour_next(0), utc_min_next(0),
       un(0), value(0), value_unit(0), spare2(0) {
@@ -299,7 +333,10 @@ Ais6_1_12::Ais6_1_12(const char *nmea_payload, const size_t pad)
 // IMO Circ 289 - Tidal Window
 // See also Circ 236
 Ais6_1_14::Ais6_1_14(const char *nmea_payload, const size_t pad)
-    : Ais6(nmea_payload, pad), utc_month(0), utc_day(0) {
+    : Ais6_1_14(AisBitset(nmea_payload, pad)) {}
+
+Ais6_1_14::Ais6_1_14(const AisBitset &bits)
+    : Ais6(bits), utc_month(0), utc_day(0) {
   // TODO(schwehr): untested - no sample of the correct length yet
   assert(dac == 1);
   assert(fi == 14);
@@ -340,7 +377,10 @@ Ais6_1_14::Ais6_1_14(const char *nmea_payload, const size_t pad)
 
 // IMO Circ 289 - Clearance time to enter port
 Ais6_1_18::Ais6_1_18(const char *nmea_payload, const size_t pad)
-    : Ais6(nmea_payload, pad), link_id(0), utc_month(0), utc_day(0),
+    : Ais6_1_18(AisBitset(nmea_payload, pad)) {}
+
+Ais6_1_18::Ais6_1_18(const AisBitset &bits)
+    : Ais6(bits), link_id(0), utc_month(0), utc_day(0),
       utc_hour(0), utc_min(0), spare2() {
   assert(dac == 1);
   assert(fi == 18);
@@ -371,7 +411,10 @@ Ais6_1_18::Ais6_1_18(const char *nmea_payload, const size_t pad)
 
 // IMO Circ 289 - Berthing data
 Ais6_1_20::Ais6_1_20(const char *nmea_payload, const size_t pad)
-    : Ais6(nmea_payload, pad), link_id(0), length(0), depth(0.0),
+    : Ais6_1_20(AisBitset(nmea_payload, pad)) {}
+
+Ais6_1_20::Ais6_1_20(const AisBitset &bits)
+    : Ais6(bits), link_id(0), length(0), depth(0.0),
       mooring_position(0), utc_month(0), utc_day(0), utc_hour(0), utc_min(0),
       services_known(false), services() {
   assert(dac == 1);
@@ -416,7 +459,10 @@ Ais6_1_25_Cargo::Ais6_1_25_Cargo()
 // IMO Circ 289 - Dangerous cargo indication 2
 // See also Circ 236
 Ais6_1_25::Ais6_1_25(const char *nmea_payload, const size_t pad)
-    : Ais6(nmea_payload, pad), amount_unit(0), amount(0) {
+    : Ais6_1_25(AisBitset(nmea_payload, pad)) {}
+
+Ais6_1_25::Ais6_1_25(const AisBitset &bits)
+    : Ais6(bits), amount_unit(0), amount(0) {
   assert(dac == 1);
   assert(fi == 25);
 
@@ -500,7 +546,10 @@ Ais6_1_32_Window::Ais6_1_32_Window()
 // IMO Circ 289 - Tidal window
 // See also Circ 236
 Ais6_1_32::Ais6_1_32(const char *nmea_payload, const size_t pad)
-    : Ais6(nmea_payload, pad), utc_month(0), utc_day(0) {
+    : Ais6_1_32(AisBitset(nmea_payload, pad)) {}
+
+Ais6_1_32::Ais6_1_32(const AisBitset &bits)
+    : Ais6(bits), utc_month(0), utc_day(0) {
   assert(dac == 1);
   assert(fi == 32);
 
@@ -537,19 +586,19 @@ Ais6_1_32::Ais6_1_32(const char *nmea_payload, const size_t pad)
 
 // IFM 40: people on board - OLD ITU 1371-4
 Ais6_1_40::Ais6_1_40(const char *nmea_payload, const size_t pad)
-    : Ais6(nmea_payload, pad), persons(0), spare2(0) {
+    : Ais6_1_40(AisBitset(nmea_payload, pad)) {}
+
+Ais6_1_40::Ais6_1_40(const AisBitset &bits)
+    : Ais6(bits), persons(0), spare2(0) {
   assert(dac == 1);
   assert(fi == 40);
 
-  if (num_bits != 104) {
-    status = AIS_ERR_BAD_BIT_COUNT;
+  if (!CheckStatus()) {
     return;
   }
 
-  AisBitset const bs;
-  const AIS_STATUS r = bits.ParseNmeaPayload(nmea_payload, pad);
-  if (r != AIS_OK) {
-    status = r;
+  if (num_bits != 104) {
+    status = AIS_ERR_BAD_BIT_COUNT;
     return;
   }
 
@@ -8,7 +8,10 @@
 namespace libais {
 
 Ais7_13::Ais7_13(const char *nmea_payload, const size_t pad)
-    : AisMsg(nmea_payload, pad), spare(0) {
+    : Ais7_13(AisBitset(nmea_payload, pad)) {}
+
+Ais7_13::Ais7_13(const AisBitset &bits)
+    : AisMsg(bits), spare(0) {
 
   if (!CheckStatus()) {
     return;
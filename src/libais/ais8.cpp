@@ -11,7 +11,10 @@
 namespace libais {
 
 Ais8::Ais8(const char *nmea_payload, const size_t pad)
-    : AisMsg(nmea_payload, pad), spare(0), dac(0), fi(0) {
+    : Ais8(AisBitset(nmea_payload, pad)) {}
+
+Ais8::Ais8(const AisBitset &bits)
+    : AisMsg(bits), spare(0), dac(0), fi(0) {
   if (!CheckStatus()) {
     return;
   }
@@ -19,7 +22,7 @@ Ais8::Ais8(const char *nmea_payload, const size_t pad)
   // in bits w/o DAC/FI
   // TODO(schwehr): Verify if this is 46 or 56 (accumulated bits below).
   const int payload_len = num_bits - 56;
-  if (payload_len < 0 || payload_len > 952) {
+  if (payload_len < 0) {
     status = AIS_ERR_BAD_BIT_COUNT;
     return;
   }
@@ -30,10 +33,20 @@ Ais8::Ais8(const char *nmea_payload, const size_t pad)
   spare = bits.ToUnsignedInt(38, 2);
   dac = bits.ToUnsignedInt(40, 10);
   fi = bits.ToUnsignedInt(50, 6);
+
+  // Checked after the DAC and FI are set so that they always match what
+  // CreateAisMsg dispatched on.
+  if (payload_len > 952) {
+    status = AIS_ERR_BAD_BIT_COUNT;
+    return;
+  }
 }
 
 Ais8_1_0::Ais8_1_0(const char *nmea_payload, const size_t pad)
-    : Ais8(nmea_payload, pad), ack_required(false), msg_seq(0), text(),
+    : Ais8_1_0(AisBitset(nmea_payload, pad)) {}
+
+Ais8_1_0::Ais8_1_0(const AisBitset &bits)
+    : Ais8(bits), ack_required(false), msg_seq(0), text(),
       spare2(0) {
   assert(dac == 1);
   assert(fi == 0);
@@ -67,7 +80,10 @@ Ais8_1_0::Ais8_1_0(const char *nmea_payload, const size_t pad)
 }
 
 Ais8_1_11::Ais8_1_11(const char *nmea_payload, const size_t pad)
-    : Ais8(nmea_payload, pad), day(0), hour(0), minute(0), wind_ave(0),
+    : Ais8_1_11(AisBitset(nmea_payload, pad)) {}
+
+Ais8_1_11::Ais8_1_11(const AisBitset &bits)
+    : Ais8(bits), day(0), hour(0), minute(0), wind_ave(0),
       wind_gust(0), wind_dir(0), wind_gust_dir(0), air_temp(0.0), rel_humid(0),
       dew_point(0.0), air_pres(0.0), air_pres_trend(0), horz_vis(0.0),
       water_level(0.0), water_level_trend(0), surf_cur_speed(0.0),
@@ -149,7 +165,10 @@ Ais8_1_11::Ais8_1_11(const char *nmea_payload, const size_t pad)
 // IMO Circ 289 - Fairway Closed
 // See also Circ 236
 Ais8_1_13::Ais8_1_13(const char *nmea_payload, const size_t pad)
-    : Ais8(nmea_payload, pad), reason(), location_from(), location_to(),
+    : Ais8_1_13(AisBitset(nmea_payload, pad)) {}
+
+Ais8_1_13::Ais8_1_13(const AisBitset &bits)
+    : Ais8(bits), reason(), location_from(), location_to(),
       radius(0), units(0), day_from(0), month_from(0), hour_from(0),
       minute_from(0), day_to(0), month_to(0), hour_to(0), minute_to(0),
       spare2(0) {
@@ -189,7 +208,10 @@ Ais8_1_13::Ais8_1_13(const char *nmea_payload, const size_t pad)
 // IMO Circ 289 - Extended Shipdata - Air gap
 // See also Circ 236
 Ais8_1_15::Ais8_1_15(const char *nmea_payload, const size_t pad)
-    : Ais8(nmea_payload, pad), air_draught(0.0), spare2(0) {
+    : Ais8_1_15(AisBitset(nmea_payload, pad)) {}
+
+Ais8_1_15::Ais8_1_15(const AisBitset &bits)
+    : Ais8(bits), air_draught(0.0), spare2(0) {
   assert(dac == 1);
   assert(fi == 15);
 
@@ -213,7 +235,10 @@ Ais8_1_15::Ais8_1_15(const char *nmea_payload, const size_t pad)
 // See also Circ 236
 // TODO(schwehr): there might also be an addressed version?
 Ais8_1_16::Ais8_1_16(const char *nmea_payload, const size_t pad)
-    : Ais8(nmea_payload, pad), persons(0), spare2(0) {
+    : Ais8_1_16(AisBitset(nmea_payload, pad)) {}
+
+Ais8_1_16::Ais8_1_16(const AisBitset &bits)
+    : Ais8(bits), persons(0), spare2(0) {
   assert(dac == 1);
   assert(fi == 16);
 
@@ -239,7 +264,10 @@ Ais8_1_17_Target::Ais8_1_17_Target()
 // IMO Circ 289 - VTS Generated/Synthetic Targets
 // See also Circ 236
 Ais8_1_17::Ais8_1_17(const char *nmea_payload, const size_t pad)
-    : Ais8(nmea_payload, pad) {
+    : Ais8_1_17(AisBitset(nmea_payload, pad)) {}
+
+Ais8_1_17::Ais8_1_17(const AisBitset &bits)
+    : Ais8(bits) {
   assert(dac == 1);
   assert(fi == 17);
 
@@ -280,7 +308,10 @@ Ais8_1_17::Ais8_1_17(const char *nmea_payload, const size_t pad)
 
 // IMO Circ 289 - Marine traffic signal
 Ais8_1_19::Ais8_1_19(const char *nmea_payload, const size_t pad)
-    : Ais8(nmea_payload, pad), link_id(0), name(), status(0), signal(0),
+    : Ais8_1_19(AisBitset(nmea_payload, pad)) {}
+
+Ais8_1_19::Ais8_1_19(const AisBitset &bits)
+    : Ais8(bits), link_id(0), name(), status(0), signal(0),
       utc_hour_next(0), utc_min_next(0), spare2() {
   assert(dac == 1);
   assert(fi == 19);
@@ -320,7 +351,10 @@ Ais8_1_19::Ais8_1_19(const char *nmea_payload, const size_t pad)
 // IMO Circ 289 - Weather observation report from ship
 // See also Circ 236
 Ais8_1_21::Ais8_1_21(const char *nmea_payload, const size_t pad)
-    : Ais8(nmea_payload, pad), type_wx_report(0), location(), utc_day(0),
+    : Ais8_1_21(AisBitset(nmea_payload, pad)) {}
+
+Ais8_1_21::Ais8_1_21(const AisBitset &bits)
+    : Ais8(bits), type_wx_report(0), location(), utc_day(0),
       utc_hour(), utc_min(), horz_viz(0.0), humidity(0), wind_speed(0),
       wind_dir(0), pressure(0.0), pressure_tendency(0), air_temp(0.0),
       water_temp(0.0), wave_period(0), wave_height(0.0), wave_dir(0),
@@ -438,7 +472,10 @@ Ais8_1_21::Ais8_1_21(const char *nmea_payload, const size_t pad)
 // IMO Circ 289 - Extended ship static and voyage-related
 // See also Circ 236
 Ais8_1_24::Ais8_1_24(const char *nmea_payload, const size_t pad)
-    : Ais8(nmea_payload, pad), link_id(0), air_draught(0.0), last_port(),
+    : Ais8_1_24(AisBitset(nmea_payload, pad)) {}
+
+Ais8_1_24::Ais8_1_24(const AisBitset &bits)
+    : Ais8(bits), link_id(0), air_draught(0.0), last_port(),
       next_ports(), solas_status(), ice_class(0), shaft_power(0), vhf(0),
       lloyds_ship_type(), gross_tonnage(0), laden_ballast(0), heavy_oil(0),
       light_oil(0), diesel(0), bunker_oil(0), persons(0), spare2(0) {
@@ -489,7 +526,10 @@ Ais8_1_24::Ais8_1_24(const char *nmea_payload, const size_t pad)
 // IMO Circ 289 - Route information
 // See also Circ 236
 Ais8_1_27::Ais8_1_27(const char *nmea_payload, const size_t pad)
-    : Ais8(nmea_payload, pad), link_id(0), sender_type(0), route_type(0),
+    : Ais8_1_27(AisBitset(nmea_payload, pad)) {}
+
+Ais8_1_27::Ais8_1_27(const AisBitset &bits)
+    : Ais8(bits), link_id(0), sender_type(0), route_type(0),
       utc_month(0), utc_day(0), utc_hour(0), utc_min(0), duration(0) {
   assert(dac == 1);
   assert(fi == 27);
@@ -531,7 +571,10 @@ Ais8_1_27::Ais8_1_27(const char *nmea_payload, const size_t pad)
 // IMO Circ 289 - Text description
 // See also Circ 236
 Ais8_1_29::Ais8_1_29(const char *nmea_payload, const size_t pad)
-    : Ais8(nmea_payload, pad), link_id(0), spare2(0) {
+    : Ais8_1_29(AisBitset(nmea_payload, pad)) {}
+
+Ais8_1_29::Ais8_1_29(const AisBitset &bits)
+    : Ais8(bits), link_id(0), spare2(0) {
   assert(dac == 1);
   assert(fi == 29);
 
@@ -562,7 +605,10 @@ Ais8_1_29::Ais8_1_29(const char *nmea_payload, const size_t pad)
 // IMO Circ 289 - Meteorological and Hydrographic data
 // See also Circ 236
 Ais8_1_31::Ais8_1_31(const char *nmea_payload, const size_t pad)
-    : Ais8(nmea_payload, pad), position_accuracy(0), utc_day(0), utc_hour(0),
+    : Ais8_1_31(AisBitset(nmea_payload, pad)) {}
+
+Ais8_1_31::Ais8_1_31(const AisBitset &bits)
+    : Ais8(bits), position_accuracy(0), utc_day(0), utc_hour(0),
       utc_min(0), wind_ave(0), wind_gust(0), wind_dir(0), wind_gust_dir(0),
       air_temp(0.0), rel_humid(0), dew_point(0.0), air_pres(0.0),
       air_pres_trend(0), horz_vis(0.0), water_level(0.0),
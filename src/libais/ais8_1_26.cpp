@@ -221,7 +221,10 @@ ais8_1_26_sensor_report_factory(const AisBitset &bits,
 }
 
 Ais8_1_26::Ais8_1_26(const char *nmea_payload, const size_t pad)
-    : Ais8(nmea_payload, pad) {
+    : Ais8_1_26(AisBitset(nmea_payload, pad)) {}
+
+Ais8_1_26::Ais8_1_26(const AisBitset &bits)
+    : Ais8(bits) {
   assert(dac == 1);
   assert(fi == 26);
 
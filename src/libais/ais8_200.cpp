@@ -10,7 +10,10 @@ namespace libais {
 
 // Inland ship static and voyage related data
 Ais8_200_10::Ais8_200_10(const char *nmea_payload, const size_t pad)
-    : Ais8(nmea_payload, pad), length(0.0), beam(0.0), ship_type(0),
+    : Ais8_200_10(AisBitset(nmea_payload, pad)) {}
+
+Ais8_200_10::Ais8_200_10(const AisBitset &bits)
+    : Ais8(bits), length(0.0), beam(0.0), ship_type(0),
       haz_cargo(0), draught(0.0), loaded(0), speed_qual(0), course_qual(0),
       heading_qual(0), spare2(0) {
   assert(dac == 200);
@@ -43,7 +46,10 @@ Ais8_200_10::Ais8_200_10(const char *nmea_payload, const size_t pad)
 
 // ETA report
 Ais8_200_21::Ais8_200_21(const char *nmea_payload, const size_t pad)
-    : Ais8(nmea_payload, pad), eta_month(0), eta_day(0), eta_hour(0),
+    : Ais8_200_21(AisBitset(nmea_payload, pad)) {}
+
+Ais8_200_21::Ais8_200_21(const AisBitset &bits)
+    : Ais8(bits), eta_month(0), eta_day(0), eta_hour(0),
       eta_minute(0), tugboats(0), air_draught(0.0) // TODO : add missing fields
 {
   assert(dac == 200);
@@ -94,7 +100,10 @@ Ais8_200_21::Ais8_200_21(const char *nmea_payload, const size_t pad)
 
 // RTA report
 Ais8_200_22::Ais8_200_22(const char *nmea_payload, const size_t pad)
-    : Ais8(nmea_payload, pad), rta_month(0), rta_day(0), rta_hour(0),
+    : Ais8_200_22(AisBitset(nmea_payload, pad)) {}
+
+Ais8_200_22::Ais8_200_22(const AisBitset &bits)
+    : Ais8(bits), rta_month(0), rta_day(0), rta_hour(0),
       rta_minute(0) // TODO : add missing fields
 {
   assert(dac == 200);
@@ -142,7 +151,10 @@ Ais8_200_22::Ais8_200_22(const char *nmea_payload, const size_t pad)
 
 // River Information Systems ECE-TRANS-SC3-2006-10r-RIS.pdf
 Ais8_200_23::Ais8_200_23(const char *nmea_payload, const size_t pad)
-    : Ais8(nmea_payload, pad), utc_year_start(0), utc_month_start(0),
+    : Ais8_200_23(AisBitset(nmea_payload, pad)) {}
+
+Ais8_200_23::Ais8_200_23(const AisBitset &bits)
+    : Ais8(bits), utc_year_start(0), utc_month_start(0),
       utc_day_start(0), utc_year_end(0), utc_month_end(0), utc_day_end(0),
       utc_hour_start(0), utc_min_start(0), utc_hour_end(0), utc_min_end(0),
       type(0), min(0), max(0), classification(0), wind_dir(0), spare2(0) {
@@ -198,7 +210,10 @@ Ais8_200_23::Ais8_200_23(const char *nmea_payload, const size_t pad)
 // River Information Systems ECE-TRANS-SC3-2006-10r-RIS.pdf
 // Water level
 Ais8_200_24::Ais8_200_24(const char *nmea_payload, const size_t pad)
-    : Ais8(nmea_payload, pad) {
+    : Ais8_200_24(AisBitset(nmea_payload, pad)) {}
+
+Ais8_200_24::Ais8_200_24(const AisBitset &bits)
+    : Ais8(bits) {
   assert(dac == 200);
   assert(fi == 24);
 
@@ -226,7 +241,10 @@ Ais8_200_24::Ais8_200_24(const char *nmea_payload, const size_t pad)
 
 // River Information Systems ECE-TRANS-SC3-2006-10r-RIS.pdf
 Ais8_200_40::Ais8_200_40(const char *nmea_payload, const size_t pad)
-    : Ais8(nmea_payload, pad), form(0), dir(0), stream_dir(0), status_raw(0),
+    : Ais8_200_40(AisBitset(nmea_payload, pad)) {}
+
+Ais8_200_40::Ais8_200_40(const AisBitset &bits)
+    : Ais8(bits), form(0), dir(0), stream_dir(0), status_raw(0),
       spare2(0) {
   assert(dac == 200);
   assert(fi == 40);
@@ -260,7 +278,10 @@ Ais8_200_40::Ais8_200_40(const char *nmea_payload, const size_t pad)
 // TODO(schwehr): Search the logs for the various possible sizes and make
 //   tests based on those messages.
 Ais8_200_55::Ais8_200_55(const char *nmea_payload, const size_t pad)
-    : Ais8(nmea_payload, pad), crew(0), passengers(0), yet_more_personnel(0) {
+    : Ais8_200_55(AisBitset(nmea_payload, pad)) {}
+
+Ais8_200_55::Ais8_200_55(const AisBitset &bits)
+    : Ais8(bits), crew(0), passengers(0), yet_more_personnel(0) {
   assert(dac == 200);
   assert(fi == 55);
 
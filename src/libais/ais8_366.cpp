@@ -20,7 +20,10 @@ namespace libais {
 //
 // (FIPS) 140-2 and 197 for data communications encryption
 Ais8_366_56::Ais8_366_56(const char *nmea_payload, const size_t pad)
-    : Ais8(nmea_payload, pad) {
+    : Ais8_366_56(AisBitset(nmea_payload, pad)) {}
+
+Ais8_366_56::Ais8_366_56(const AisBitset &bits)
+    : Ais8(bits) {
   assert(dac == 366);
   assert(fi == 56);
 
@@ -126,7 +126,10 @@ ais8_367_22_subarea_factory(const AisBitset &bits,
 }
 
 Ais8_367_22::Ais8_367_22(const char *nmea_payload, const size_t pad)
-    : Ais8(nmea_payload, pad), version(0), link_id(0), notice_type(0),
+    : Ais8_367_22(AisBitset(nmea_payload, pad)) {}
+
+Ais8_367_22::Ais8_367_22(const AisBitset &bits)
+    : Ais8(bits), version(0), link_id(0), notice_type(0),
       month(0), day(0), hour(0), minute(0), duration_minutes(0), spare2(0) {
   assert(dac == 367);
   assert(fi == 22);
@@ -177,7 +180,10 @@ Ais8_367_22::Ais8_367_22(const char *nmea_payload, const size_t pad)
 
 // SSW FI23 Satellite Ship Weather 1-Slot Version
 Ais8_367_23::Ais8_367_23(const char *nmea_payload, const size_t pad)
-    : Ais8(nmea_payload, pad) {
+    : Ais8_367_23(AisBitset(nmea_payload, pad)) {}
+
+Ais8_367_23::Ais8_367_23(const AisBitset &bits)
+    : Ais8(bits) {
   assert(dac == 367);
   assert(fi == 23);
 
@@ -216,7 +222,10 @@ std::ostream& operator<< (std::ostream &o, const Ais8_367_23 &msg) {
 
 // SSW FI24 Satellite Ship Weather Small - Less than 1-Slot Version
 Ais8_367_24::Ais8_367_24(const char *nmea_payload, const size_t pad)
-    : Ais8(nmea_payload, pad) {
+    : Ais8_367_24(AisBitset(nmea_payload, pad)) {}
+
+Ais8_367_24::Ais8_367_24(const AisBitset &bits)
+    : Ais8(bits) {
   assert(dac == 367);
   assert(fi == 24);
 
@@ -247,7 +256,10 @@ std::ostream& operator<< (std::ostream &o, const Ais8_367_24 &msg) {
 
 // SSW FI25 Satellite Ship Weather Tiny Version
 Ais8_367_25::Ais8_367_25(const char *nmea_payload, const size_t pad)
-    : Ais8(nmea_payload, pad) {
+    : Ais8_367_25(AisBitset(nmea_payload, pad)) {}
+
+Ais8_367_25::Ais8_367_25(const AisBitset &bits)
+    : Ais8(bits) {
   assert(dac == 367);
   assert(fi == 25);
 
@@ -570,7 +582,10 @@ ais8_367_33_sensor_report_factory(const AisBitset &bits,
 }
 
 Ais8_367_33::Ais8_367_33(const char *nmea_payload, const size_t pad)
-    : Ais8(nmea_payload, pad) {
+    : Ais8_367_33(AisBitset(nmea_payload, pad)) {}
+
+Ais8_367_33::Ais8_367_33(const AisBitset &bits)
+    : Ais8(bits) {
   assert(dac == 367);
   assert(fi == 33);
 
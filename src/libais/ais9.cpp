@@ -1,11 +1,15 @@
 #include "ais.h"
+#include "ais_fields.h"
 #include <cstddef>
 #include <cassert>
 
 namespace libais {
 
 Ais9::Ais9(const char *nmea_payload, const size_t pad)
-    : AisMsg(nmea_payload, pad), alt(0), sog(0.0), position_accuracy(0),
+    : Ais9(AisBitset(nmea_payload, pad)) {}
+
+Ais9::Ais9(const AisBitset &bits)
+    : AisMsg(bits), alt(0), sog(0.0), position_accuracy(0),
       cog(0.0), timestamp(0), alt_sensor(0), spare(0), dte(0), spare2(0),
       assigned_mode(0), raim(false), commstate_flag(0), sync_state(0),
       slot_timeout_valid(false), slot_timeout(0),
@@ -19,7 +23,7 @@ Ais9::Ais9(const char *nmea_payload, const size_t pad)
   if (!CheckStatus()) {
     return;
   }
-  if (pad != 0 || num_chars != 28) {
+  if (num_bits != 168) {
     status = AIS_ERR_BAD_BIT_COUNT;
     return;
   }
@@ -27,23 +31,7 @@ Ais9::Ais9(const char *nmea_payload, const size_t pad)
   assert(message_id == 9);
 
   bits.SeekTo(38);
-  alt = bits.ToUnsignedInt(38, 12);
-  sog = bits.ToUnsignedInt(50, 10);  // Type 9: Speed over ground is in knots.
-
-  position_accuracy = bits[60];
-  position = bits.ToAisPoint(61, 55);
-
-  cog = bits.ToUnsignedInt(116, 12) / 10.;
-  timestamp = bits.ToUnsignedInt(128, 6);
-  alt_sensor = bits[134];
-  spare = bits.ToUnsignedInt(135, 7);
-  dte = bits[142];
-  spare2 = bits.ToUnsignedInt(143, 3);
-  assigned_mode = bits[146];
-  raim = bits[147];
-  commstate_flag = bits[148];  // 0 SOTDMA, 1 ITDMA
-
-  sync_state = bits.ToUnsignedInt(149, 2);
+  DecodeFields(bits, kAis9Layout, this);
 
   if (commstate_flag == 0) {
     // SOTDMA
@@ -0,0 +1,112 @@
+// Pool and arena allocators for decoded messages.
+
+#include "ais_alloc.h"
+
+#include <cassert>
+#include <cstddef>
+#include <memory>
+#include <vector>
+
+namespace libais {
+
+AisMsgPool::AisMsgPool(const size_t objects_per_slab)
+    : objects_per_slab_(objects_per_slab),
+      free_lists_(kMaxPooledSize / kGranularity + 1, nullptr),
+      num_live_(0),
+      bytes_reserved_(0) {
+  assert(objects_per_slab_ > 0);
+}
+
+AisMsgPool::~AisMsgPool() {
+  assert(num_live_ == 0);
+}
+
+void *AisMsgPool::Allocate(const size_t size) {
+  assert(size > 0);
+  num_live_++;
+  if (size > kMaxPooledSize) {
+    return ::operator new(size);
+  }
+
+  const size_t size_class = (size + kGranularity - 1) / kGranularity;
+  FreeNode *node = free_lists_[size_class];
+  if (node == nullptr) {
+    // Carve a new slab into free nodes for this size class.
+    const size_t object_size = size_class * kGranularity;
+    const size_t slab_size = object_size * objects_per_slab_;
+    slabs_.emplace_back(new char[slab_size]);
+    bytes_reserved_ += slab_size;
+    char *slab = slabs_.back().get();
+    for (size_t i = objects_per_slab_; i > 0; i--) {
+      FreeNode *next = node;
+      node = reinterpret_cast<FreeNode *>(slab + (i - 1) * object_size);
+      node->next = next;
+    }
+  }
+  free_lists_[size_class] = node->next;
+  return node;
+}
+
+void AisMsgPool::Deallocate(void *ptr, const size_t size) {
+  assert(ptr);
+  assert(num_live_ > 0);
+  num_live_--;
+  if (size > kMaxPooledSize) {
+    ::operator delete(ptr);
+    return;
+  }
+
+  const size_t size_class = (size + kGranularity - 1) / kGranularity;
+  FreeNode *node = static_cast<FreeNode *>(ptr);
+  node->next = free_lists_[size_class];
+  free_lists_[size_class] = node;
+}
+
+AisMsgArena::AisMsgArena(const size_t block_size)
+    : block_size_(block_size),
+      block_idx_(0),
+      offset_(0),
+      num_live_(0),
+      bytes_reserved_(0) {
+  assert(block_size_ >= kAlignment);
+}
+
+AisMsgArena::~AisMsgArena() {
+  assert(num_live_ == 0);
+}
+
+void *AisMsgArena::Allocate(const size_t size) {
+  assert(size > 0);
+  num_live_++;
+  const size_t aligned = (size + kAlignment - 1) / kAlignment * kAlignment;
+  if (aligned > block_size_) {
+    large_.emplace_back(new char[aligned]);
+    return large_.back().get();
+  }
+
+  if (block_idx_ < blocks_.size() && offset_ + aligned > block_size_) {
+    block_idx_++;
+    offset_ = 0;
+  }
+  if (block_idx_ == blocks_.size()) {
+    blocks_.emplace_back(new char[block_size_]);
+    bytes_reserved_ += block_size_;
+  }
+  void *result = blocks_[block_idx_].get() + offset_;
+  offset_ += aligned;
+  return result;
+}
+
+void AisMsgArena::Deallocate(void * /* ptr */, const size_t /* size */) {
+  assert(num_live_ > 0);
+  num_live_--;
+}
+
+void AisMsgArena::Reset() {
+  assert(num_live_ == 0);
+  large_.clear();
+  block_idx_ = 0;
+  offset_ = 0;
+}
+
+}  // namespace libais
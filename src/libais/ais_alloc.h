@@ -0,0 +1,115 @@
+// -*- c++ -*-
+
+// Allocators for decoded AisMsg instances.
+//
+// By default CreateAisMsg and VdmStream put each message on the heap with
+// new.  At high message rates the malloc and free calls show up in profiles,
+// so a caller may instead hand them an AisMsgAllocator:
+//
+//   AisMsgPool - Keeps a free list for each message size (and thus for each
+//                message class) and recycles the memory of deleted messages.
+//   AisMsgArena - Bump allocates from large blocks and gives all of the
+//                memory back at once with Reset().
+//
+// Messages are still returned as std::unique_ptr<AisMsg> and are destroyed
+// with delete.  AisMsg records which allocator a message came from, so the
+// memory goes back to the right place.  An allocator must outlive every
+// message that it holds.
+//
+// Neither allocator is thread safe.
+
+#ifndef LIBAIS_AIS_ALLOC_H_
+#define LIBAIS_AIS_ALLOC_H_
+
+#include <cstddef>
+#include <memory>
+#include <vector>
+
+namespace libais {
+
+// Interface for the memory behind decoded messages.
+class AisMsgAllocator {
+ public:
+  virtual ~AisMsgAllocator() = default;
+
+  // Returns size bytes aligned for any AisMsg.  Never returns nullptr.
+  virtual void *Allocate(size_t size) = 0;
+  // Gives back memory from Allocate.  size is the size that was allocated.
+  virtual void Deallocate(void *ptr, size_t size) = 0;
+};
+
+// Free lists per 16 byte size class.  Memory is carved out of slabs that are
+// only returned to the system when the pool is destroyed.  Allocation and
+// deallocation are O(1).
+class AisMsgPool : public AisMsgAllocator {
+ public:
+  // Each slab holds this many objects of one size class.
+  explicit AisMsgPool(size_t objects_per_slab = 256);
+  ~AisMsgPool() override;
+
+  AisMsgPool(const AisMsgPool &) = delete;
+  AisMsgPool &operator=(const AisMsgPool &) = delete;
+
+  void *Allocate(size_t size) override;
+  void Deallocate(void *ptr, size_t size) override;
+
+  // Number of allocations that have not been given back.
+  size_t num_live() const { return num_live_; }
+  // Bytes held in slabs, whether in use or on a free list.
+  size_t bytes_reserved() const { return bytes_reserved_; }
+
+ private:
+  static const size_t kGranularity = 16;
+  // Larger requests go straight to the heap.
+  static const size_t kMaxPooledSize = 2048;
+
+  struct FreeNode {
+    FreeNode *next;
+  };
+
+  const size_t objects_per_slab_;
+  std::vector<FreeNode *> free_lists_;
+  std::vector<std::unique_ptr<char[]>> slabs_;
+  size_t num_live_;
+  size_t bytes_reserved_;
+};
+
+// Bump allocator over a list of blocks.  Deallocate only does bookkeeping.
+// Reset() makes all of the blocks available again in O(1) once every message
+// from the arena has been deleted.
+class AisMsgArena : public AisMsgAllocator {
+ public:
+  explicit AisMsgArena(size_t block_size = 64 * 1024);
+  ~AisMsgArena() override;
+
+  AisMsgArena(const AisMsgArena &) = delete;
+  AisMsgArena &operator=(const AisMsgArena &) = delete;
+
+  void *Allocate(size_t size) override;
+  void Deallocate(void *ptr, size_t size) override;
+
+  // Rewinds to the first block.  Blocks are kept for reuse.
+  // All messages from the arena must have been deleted.
+  void Reset();
+
+  // Number of allocations that have not been given back.
+  size_t num_live() const { return num_live_; }
+  // Bytes held in blocks.
+  size_t bytes_reserved() const { return bytes_reserved_; }
+
+ private:
+  static const size_t kAlignment = 16;
+
+  const size_t block_size_;
+  std::vector<std::unique_ptr<char[]>> blocks_;
+  // Oversized allocations that do not fit in a block.
+  std::vector<std::unique_ptr<char[]>> large_;
+  size_t block_idx_;
+  size_t offset_;
+  size_t num_live_;
+  size_t bytes_reserved_;
+};
+
+}  // namespace libais
+
+#endif  // LIBAIS_AIS_ALLOC_H_
@@ -2,56 +2,208 @@
 #include <bitset>
 #include <cassert>
 #include <cstddef>
+#include <cstdint>
 #include <cstring>
 #include <iostream>
 #include <string>
 
 #include "ais.h"
 
+#if !defined(LIBAIS_NO_SIMD) && (defined(__x86_64__) || defined(__i386__)) && \
+    (defined(__GNUC__) || defined(__clang__))
+#define LIBAIS_X86_SIMD 1
+#include <immintrin.h>
+#endif
+
 namespace libais {
 
-AisBitset::AisBitset() : num_bits(0), num_chars(0), current_position(0) {}
+namespace {
+
+// De-armoring kernels convert as many whole blocks of armored characters as
+// they can into packed big-endian bytes, 4 characters to 3 bytes.  They
+// return the number of characters consumed or -1 if any character is outside
+// of the armoring ranges '0'..'W' and '`'..'w'.  The caller finishes the
+// remaining characters.
+using DearmorFn = int (*)(const char *payload, int num_chars,
+                          unsigned char *out);
+
+int DearmorNone(const char * /* payload */, int /* num_chars */,
+                unsigned char * /* out */) {
+  return 0;
+}
+
+#ifdef LIBAIS_X86_SIMD
+
+// 16 characters at a time.  Writes 16 bytes for every 12 that are valid.
+__attribute__((target("ssse3")))
+int DearmorSsse3(const char *payload, int num_chars, unsigned char *out) {
+  int idx = 0;
+  for (; idx + 16 <= num_chars; idx += 16, out += 12) {
+    const __m128i c =
+        _mm_loadu_si128(reinterpret_cast<const __m128i *>(payload + idx));
+    // Signed compares also reject bytes >= 128.
+    const __m128i ge48 = _mm_cmpgt_epi8(c, _mm_set1_epi8(47));
+    const __m128i le87 = _mm_cmpgt_epi8(_mm_set1_epi8(88), c);
+    const __m128i ge96 = _mm_cmpgt_epi8(c, _mm_set1_epi8(95));
+    const __m128i le119 = _mm_cmpgt_epi8(_mm_set1_epi8(120), c);
+    const __m128i valid = _mm_or_si128(_mm_and_si128(ge48, le87),
+                                       _mm_and_si128(ge96, le119));
+    if (_mm_movemask_epi8(valid) != 0xFFFF) {
+      return -1;
+    }
+    __m128i v = _mm_sub_epi8(c, _mm_set1_epi8(48));
+    v = _mm_sub_epi8(v, _mm_and_si128(ge96, _mm_set1_epi8(8)));
+    // Merge pairs of 6-bit values to 12 bits and then pairs of those to 24.
+    v = _mm_maddubs_epi16(v, _mm_set1_epi32(0x01400140));
+    v = _mm_madd_epi16(v, _mm_set1_epi32(0x00011000));
+    v = _mm_shuffle_epi8(
+        v, _mm_setr_epi8(2, 1, 0, 6, 5, 4, 10, 9, 8, 14, 13, 12, -1, -1, -1, -1));
+    _mm_storeu_si128(reinterpret_cast<__m128i *>(out), v);
+  }
+  return idx;
+}
+
+// 32 characters at a time.  Hands the last 16 character block to SSSE3.
+__attribute__((target("avx2")))
+int DearmorAvx2(const char *payload, int num_chars, unsigned char *out) {
+  int idx = 0;
+  for (; idx + 32 <= num_chars; idx += 32, out += 24) {
+    const __m256i c =
+        _mm256_loadu_si256(reinterpret_cast<const __m256i *>(payload + idx));
+    const __m256i ge48 = _mm256_cmpgt_epi8(c, _mm256_set1_epi8(47));
+    const __m256i le87 = _mm256_cmpgt_epi8(_mm256_set1_epi8(88), c);
+    const __m256i ge96 = _mm256_cmpgt_epi8(c, _mm256_set1_epi8(95));
+    const __m256i le119 = _mm256_cmpgt_epi8(_mm256_set1_epi8(120), c);
+    const __m256i valid = _mm256_or_si256(_mm256_and_si256(ge48, le87),
+                                          _mm256_and_si256(ge96, le119));
+    if (_mm256_movemask_epi8(valid) != -1) {
+      return -1;
+    }
+    __m256i v = _mm256_sub_epi8(c, _mm256_set1_epi8(48));
+    v = _mm256_sub_epi8(v, _mm256_and_si256(ge96, _mm256_set1_epi8(8)));
+    v = _mm256_maddubs_epi16(v, _mm256_set1_epi32(0x01400140));
+    v = _mm256_madd_epi16(v, _mm256_set1_epi32(0x00011000));
+    // The shuffle works within each 128-bit lane, so store the lanes apart.
+    v = _mm256_shuffle_epi8(
+        v, _mm256_setr_epi8(2, 1, 0, 6, 5, 4, 10, 9, 8, 14, 13, 12, -1, -1, -1,
+                            -1, 2, 1, 0, 6, 5, 4, 10, 9, 8, 14, 13, 12, -1, -1,
+                            -1, -1));
+    _mm_storeu_si128(reinterpret_cast<__m128i *>(out),
+                     _mm256_castsi256_si128(v));
+    _mm_storeu_si128(reinterpret_cast<__m128i *>(out + 12),
+                     _mm256_extracti128_si256(v, 1));
+  }
+  const int rest = DearmorSsse3(payload + idx, num_chars - idx, out);
+  return rest < 0 ? -1 : idx + rest;
+}
+
+#endif  // LIBAIS_X86_SIMD
+
+DearmorFn SelectDearmor() {
+#ifdef LIBAIS_X86_SIMD
+  __builtin_cpu_init();
+  if (__builtin_cpu_supports("avx2")) {
+    return DearmorAvx2;
+  }
+  if (__builtin_cpu_supports("ssse3")) {
+    return DearmorSsse3;
+  }
+#endif
+  return DearmorNone;
+}
+
+uint64_t LoadBigEndian64(const unsigned char *bytes) {
+  uint64_t result = 0;
+  for (int i = 0; i < 8; i++) {
+    result = (result << 8) | bytes[i];
+  }
+  return result;
+}
+
+}  // namespace
+
+AisBitset::AisBitset()
+    : words_(), status(AIS_UNINITIALIZED), num_bits(0), num_chars(0),
+      current_position(0) {}
+
+AisBitset::AisBitset(const char *nmea_payload, const int pad)
+    : status(AIS_UNINITIALIZED), num_bits(0), num_chars(0),
+      current_position(0) {
+  ParseNmeaPayload(nmea_payload, pad);
+}
 
 AIS_STATUS AisBitset::ParseNmeaPayload(const char *nmea_payload, int pad) {
   assert(nmea_payload);
+  return ParseNmeaPayload(nmea_payload, strlen(nmea_payload), pad);
+}
+
+AIS_STATUS AisBitset::ParseNmeaPayload(const char *nmea_payload,
+                                       size_t payload_size, int pad) {
+  assert(nmea_payload);
   assert(pad >= 0 && pad < 6);
 
-  InitNmeaOrd();
+  static const DearmorFn dearmor_blocks = SelectDearmor();
 
   num_bits = 0;
   current_position = 0;
-  reset();
 
-  num_chars = strlen(nmea_payload);
-
-  const size_t max_chars = size()/6;
-  if (static_cast<size_t>(num_chars) > max_chars) {
+  const size_t max_chars = MAX_BITS / 6;
+  if (payload_size > max_chars) {
 #ifdef LIBAIS_DEBUG
     std::cerr << "ERROR: message longer than max allowed size (" << max_chars
-              << "): found " << num_chars << " characters in "
+              << "): found " << payload_size << " characters in "
               << nmea_payload << std::endl;
 #endif
+    reset();
     num_chars = 0;  // Don't leave an impression that there are any valid chars.
-    return AIS_ERR_MSG_TOO_LONG;
+    status = AIS_ERR_MSG_TOO_LONG;
+    return status;
   }
-
-  size_t bit = 0;
-  for (size_t idx = 0; nmea_payload[idx] != '\0' && idx < max_chars; idx++) {
-    int const c = static_cast<int>(nmea_payload[idx]);
-    if (c < 48 || c > 119 || (c >= 88 && c <= 95)) {
-      // Make it clear that nothing valuable is in here.
-      reset();
-      num_chars = 0;
-      return AIS_ERR_BAD_NMEA_CHR;
+  num_chars = payload_size;
+
+  // Pack the payload as big-endian bytes in the storage of words_ and then
+  // swap each word into host order.
+  unsigned char *bytes = reinterpret_cast<unsigned char *>(words_.data());
+  int idx = dearmor_blocks(nmea_payload, num_chars, bytes);
+
+  size_t byte_idx = idx / 4 * 3;
+  for (; idx >= 0 && idx < num_chars; idx += 4, byte_idx += 3) {
+    uint32_t group = 0;
+    uint8_t check = 0;
+    for (int i = 0; i < 4; i++) {
+      const uint8_t val =
+          idx + i < num_chars
+              ? nmea_ord_[static_cast<unsigned char>(nmea_payload[idx + i])]
+              : 0;
+      check |= val;
+      group = (group << 6) | val;
     }
-    for (size_t offset = 0; offset < 6; offset++) {
-      set(bit++, nmea_ord_[c].test(offset));
+    if (check > 63) {
+      idx = -1;
+      break;
     }
+    bytes[byte_idx] = group >> 16;
+    bytes[byte_idx + 1] = group >> 8;
+    bytes[byte_idx + 2] = group;
+  }
+  if (idx < 0) {
+    // Make it clear that nothing valuable is in here.
+    reset();
+    num_chars = 0;
+    status = AIS_ERR_BAD_NMEA_CHR;
+    return status;
+  }
+
+  const size_t used_words = (byte_idx + 7) / 8;
+  memset(bytes + byte_idx, 0, kNumWords * 8 - byte_idx);
+  for (size_t word = 0; word < used_words; word++) {
+    words_[word] = LoadBigEndian64(bytes + word * 8);
   }
 
   num_bits = num_chars * 6 - pad;
 
-  return AIS_OK;
+  status = AIS_OK;
+  return status;
 }
 
 const AisBitset& AisBitset::SeekRelative(int d) const {
@@ -61,7 +213,8 @@ const AisBitset& AisBitset::SeekRelative(int d) const {
 }
 
 const AisBitset& AisBitset::SeekTo(size_t pos) const {
-  assert(pos < num_bits);
+  // Seeking to num_bits is the same as having read the last field.
+  assert(pos <= num_bits);
   current_position = pos;
   return *this;
 }
@@ -73,7 +226,7 @@ bool AisBitset::operator[](size_t pos) const {
   assert(current_position == pos);
 
   current_position = pos + 1;
-  return bitset<MAX_BITS>::operator[](pos);
+  return (words_[pos / 64] >> (63 - pos % 64)) & 1;
 }
 
 unsigned int AisBitset::ToUnsignedInt(const size_t start,
@@ -84,16 +237,11 @@ unsigned int AisBitset::ToUnsignedInt(const size_t start,
 
   assert(current_position == start);
 
-  unsigned int result = 0;
-  size_t const end = start + len;
-  for (size_t i = start; i < end; ++i) {
-    result <<= 1;
-    if (test(i))
-      result |= 1;
+  current_position = start + len;
+  if (len == 0) {
+    return 0;
   }
-
-  current_position = end;
-  return result;
+  return static_cast<unsigned int>(Window(start) >> (64 - len));
 }
 
 int AisBitset::ToInt(const size_t start, const size_t len)  const {
@@ -103,18 +251,13 @@ int AisBitset::ToInt(const size_t start, const size_t len)  const {
 
   assert(current_position == start);
 
-  // Converting the sub-bitset to a signed number, per "Two's complement":
-  // - If negative, invert all the bits, then add 1.
-  bool const is_positive = (len == 32 || !test(start));
-  int result = 0;
-  size_t const end = start + len;
-  for (size_t i = start; i < end; ++i) {
-    result <<= 1;
-    if (test(i) == is_positive)
-      result |= 1;
+  current_position = start + len;
+  if (len == 0) {
+    return 0;
   }
-  current_position = end;
-  return is_positive ? result : -(result + 1);
+  // An arithmetic shift of the left aligned window sign extends the field
+  // per "Two's complement".
+  return static_cast<int>(static_cast<int64_t>(Window(start)) >> (64 - len));
 }
 
 std::string AisBitset::ToString(const size_t start, const size_t len) const {
@@ -127,9 +270,9 @@ std::string AisBitset::ToString(const size_t start, const size_t len) const {
   const size_t num_char = len / 6;
   std::string result(num_char, '@');
   for (size_t char_idx = 0; char_idx < num_char; char_idx++) {
-    const int char_num = ToUnsignedInt(start + char_idx*6, 6);
-    result[char_idx] = bits_to_char_tbl_[char_num];
+    result[char_idx] = bits_to_char_tbl_[Window(start + char_idx * 6) >> 58];
   }
+  current_position = start + len;
   return result;
 }
 
@@ -167,33 +310,31 @@ const AisPoint AisBitset::ToAisPoint(const size_t start,
 
 // static private
 
-void AisBitset::InitNmeaOrd() {
-  if (nmea_ord_initialized_) {
-    return;
-  }
+std::bitset<6> AisBitset::Reverse(const std::bitset<6> &bits) {
+  std::bitset<6> out;
+  for (size_t i = 0; i < 6; i++)
+    out[5 - i] = bits[i];
+  return out;
+}
+
+namespace {
 
+std::array<uint8_t, 256> BuildNmeaOrd() {
+  std::array<uint8_t, 256> ord;
+  ord.fill(0xFF);
   for (int c = 48; c < 88; c++) {
-    int const val = c - 48;
-    nmea_ord_[c] = Reverse(bitset<6>(val));
+    ord[c] = c - 48;
   }
-  for (int c = 88; c < 128; c++) {
-    int val = c - 48;
-    val -= 8;
-    nmea_ord_[c] = Reverse(bitset<6>(val));
+  for (int c = 96; c < 120; c++) {
+    ord[c] = c - 56;
   }
-  nmea_ord_initialized_ = true;
+  return ord;
 }
 
-std::bitset<6> AisBitset::Reverse(const bitset<6> &bits) {
-  bitset<6> out;
-  for (size_t i = 0; i < 6; i++)
-    out[5 - i] = bits[i];
-  return out;
-}
+}  // namespace
 
-bool AisBitset::nmea_ord_initialized_ = false;
+const std::array<uint8_t, 256> AisBitset::nmea_ord_ = BuildNmeaOrd();
 
-std::array<std::bitset<6>, 128> AisBitset::nmea_ord_;
 // For decoding str bits inside of a binary message.
 const char AisBitset::bits_to_char_tbl_[] = "@ABCDEFGHIJKLMNOPQRSTUVWXYZ"
     "[\\]^- !\"#$%&`()*+,-./0123456789:;<=>?";
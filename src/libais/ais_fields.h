@@ -0,0 +1,402 @@
+// -*- c++ -*-
+
+// Tables of the fixed position fields in the message types that have them:
+// 1-3, 4/11, 5, 9, 18, 19, 21, 24 part B and 27.
+//
+// Each field gives the member of the message class that it fills, where it
+// sits in the payload and how to convert the bits:
+//
+//   AisUnsigned - Unsigned integer, optionally divided by a scale.
+//   AisSigned - Two's complement integer.
+//   AisFlag - Single bit.
+//   AisText - Six bit characters.
+//   AisPosition - Longitude then latitude in 35, 49 or 55 bits.
+//
+// A layout is a std::tuple of fields in payload order.  Layouts are
+// constexpr, so static_assert with AisLayoutIsContiguous catches overlapping
+// fields and gaps at compile time.  DecodeFields fills a message from a
+// layout and reads fields that fall in the same 64 bits from one window of
+// the bitset.  ais_py.cpp walks the same layouts to build the Python dicts.
+//
+// Fields that depend on other fields, such as the communication state and
+// the name extension of message 21, are still decoded by hand in the message
+// constructors.  The binary messages 6, 8, 25 and 26 and the variable length
+// messages have no layouts.
+
+#ifndef LIBAIS_AIS_FIELDS_H_
+#define LIBAIS_AIS_FIELDS_H_
+
+#include <cassert>
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <tuple>
+#include <type_traits>
+
+#include "ais.h"
+
+namespace libais {
+
+enum AisFieldKind : uint8_t {
+  AIS_FIELD_UNSIGNED,
+  AIS_FIELD_SIGNED,
+  AIS_FIELD_FLAG,
+  AIS_FIELD_TEXT,
+  AIS_FIELD_POSITION,
+};
+
+// The kind is part of the type so that DecodeFields only instantiates the
+// conversion that each field needs.
+template <AisFieldKind Kind, typename Msg, typename T>
+struct AisField {
+  static constexpr AisFieldKind kind = Kind;
+  T Msg::*member;
+  size_t start;
+  size_t len;
+  // Unsigned fields are divided by scale when it is not zero.
+  float scale;
+  // Key in the Python dict or nullptr if the field is not exported.  Positions
+  // are always exported as "x" and "y".
+  const char *name;
+};
+
+template <typename Msg, typename T>
+constexpr AisField<AIS_FIELD_UNSIGNED, Msg, T> AisUnsigned(
+    T Msg::*member, size_t start, size_t len, const char *name,
+    float scale = 0) {
+  return {member, start, len, scale, name};
+}
+
+template <typename Msg, typename T>
+constexpr AisField<AIS_FIELD_SIGNED, Msg, T> AisSigned(
+    T Msg::*member, size_t start, size_t len, const char *name) {
+  return {member, start, len, 0, name};
+}
+
+template <typename Msg, typename T>
+constexpr AisField<AIS_FIELD_FLAG, Msg, T> AisFlag(
+    T Msg::*member, size_t start, const char *name) {
+  return {member, start, 1, 0, name};
+}
+
+template <typename Msg>
+constexpr AisField<AIS_FIELD_TEXT, Msg, std::string> AisText(
+    std::string Msg::*member, size_t start, size_t len, const char *name) {
+  return {member, start, len, 0, name};
+}
+
+template <typename Msg>
+constexpr AisField<AIS_FIELD_POSITION, Msg, AisPoint> AisPosition(
+    AisPoint Msg::*member, size_t start, size_t len) {
+  return {member, start, len, 0, "x"};
+}
+
+template <AisFieldKind Kind, typename Msg, typename T>
+constexpr bool AisFieldIsValid(const AisField<Kind, Msg, T> &field) {
+  if (field.scale != 0 && !std::is_floating_point<T>::value) {
+    return false;
+  }
+  switch (Kind) {
+    case AIS_FIELD_UNSIGNED:
+      return field.len >= 1 && field.len <= 32;
+    case AIS_FIELD_SIGNED:
+      return field.len >= 2 && field.len <= 32 && field.scale == 0;
+    case AIS_FIELD_FLAG:
+      return field.len == 1 && field.scale == 0;
+    case AIS_FIELD_TEXT:
+      return std::is_same<T, std::string>::value && field.len >= 6 &&
+             field.len % 6 == 0;
+    case AIS_FIELD_POSITION:
+      return std::is_same<T, AisPoint>::value &&
+             (field.len == 35 || field.len == 49 || field.len == 55);
+  }
+  return false;
+}
+
+// True if the fields of layout are valid, start at start, follow each other
+// without gaps and end at end.
+template <typename Layout>
+constexpr bool AisLayoutIsContiguous(const Layout &layout, size_t start,
+                                     size_t end) {
+  return std::apply(
+      [start, end](const auto &... fields) {
+        size_t pos = start;
+        bool valid = true;
+        ((valid = valid && fields.start == pos && AisFieldIsValid(fields),
+          pos += fields.len), ...);
+        return valid && pos == end;
+      },
+      layout);
+}
+
+// First bit after the last field of layout.
+template <typename Layout>
+constexpr size_t AisLayoutEnd(const Layout &layout) {
+  const auto &last = std::get<std::tuple_size<Layout>::value - 1>(layout);
+  return last.start + last.len;
+}
+
+// Ais1_2_3 from nav_status through sync_state.  rot is derived from rot_raw
+// by hand.
+inline constexpr auto kAis1_2_3Layout = std::make_tuple(
+    AisUnsigned(&Ais1_2_3::nav_status, 38, 4, "nav_status"),
+    AisSigned(&Ais1_2_3::rot_raw, 42, 8, nullptr),
+    AisUnsigned(&Ais1_2_3::sog, 50, 10, "sog", 10.0F),  // Knots.
+    AisFlag(&Ais1_2_3::position_accuracy, 60, "position_accuracy"),
+    AisPosition(&Ais1_2_3::position, 61, 55),
+    AisUnsigned(&Ais1_2_3::cog, 116, 12, "cog", 10.0F),  // Degrees.
+    AisUnsigned(&Ais1_2_3::true_heading, 128, 9, "true_heading"),
+    AisUnsigned(&Ais1_2_3::timestamp, 137, 6, "timestamp"),
+    AisUnsigned(&Ais1_2_3::special_manoeuvre, 143, 2, "special_manoeuvre"),
+    AisUnsigned(&Ais1_2_3::spare, 145, 3, "spare"),
+    AisFlag(&Ais1_2_3::raim, 148, "raim"),
+    AisUnsigned(&Ais1_2_3::sync_state, 149, 2, "sync_state"));
+static_assert(AisLayoutIsContiguous(kAis1_2_3Layout, 38, 151),
+              "Ais1_2_3 fields");
+
+// Ais4_11 from year through sync_state.
+inline constexpr auto kAis4_11Layout = std::make_tuple(
+    AisUnsigned(&Ais4_11::year, 38, 14, "year"),
+    AisUnsigned(&Ais4_11::month, 52, 4, "month"),
+    AisUnsigned(&Ais4_11::day, 56, 5, "day"),
+    AisUnsigned(&Ais4_11::hour, 61, 5, "hour"),
+    AisUnsigned(&Ais4_11::minute, 66, 6, "minute"),
+    AisUnsigned(&Ais4_11::second, 72, 6, "second"),
+    AisFlag(&Ais4_11::position_accuracy, 78, "position_accuracy"),
+    AisPosition(&Ais4_11::position, 79, 55),
+    AisUnsigned(&Ais4_11::fix_type, 134, 4, "fix_type"),
+    AisFlag(&Ais4_11::transmission_ctl, 138, "transmission_ctl"),
+    AisUnsigned(&Ais4_11::spare, 139, 9, "spare"),
+    AisFlag(&Ais4_11::raim, 148, "raim"),
+    AisUnsigned(&Ais4_11::sync_state, 149, 2, "sync_state"));
+static_assert(AisLayoutIsContiguous(kAis4_11Layout, 38, 151),
+              "Ais4_11 fields");
+
+// All of Ais5 after the header.
+inline constexpr auto kAis5Layout = std::make_tuple(
+    AisUnsigned(&Ais5::ais_version, 38, 2, "ais_version"),
+    AisUnsigned(&Ais5::imo_num, 40, 30, "imo_num"),
+    AisText(&Ais5::callsign, 70, 42, "callsign"),
+    AisText(&Ais5::name, 112, 120, "name"),
+    AisUnsigned(&Ais5::type_and_cargo, 232, 8, "type_and_cargo"),
+    AisUnsigned(&Ais5::dim_a, 240, 9, "dim_a"),
+    AisUnsigned(&Ais5::dim_b, 249, 9, "dim_b"),
+    AisUnsigned(&Ais5::dim_c, 258, 6, "dim_c"),
+    AisUnsigned(&Ais5::dim_d, 264, 6, "dim_d"),
+    AisUnsigned(&Ais5::fix_type, 270, 4, "fix_type"),
+    AisUnsigned(&Ais5::eta_month, 274, 4, "eta_month"),
+    AisUnsigned(&Ais5::eta_day, 278, 5, "eta_day"),
+    AisUnsigned(&Ais5::eta_hour, 283, 5, "eta_hour"),
+    AisUnsigned(&Ais5::eta_minute, 288, 6, "eta_minute"),
+    AisUnsigned(&Ais5::draught, 294, 8, "draught", 10.0F),  // m.
+    AisText(&Ais5::destination, 302, 120, "destination"),
+    AisFlag(&Ais5::dte, 422, "dte"),
+    AisFlag(&Ais5::spare, 423, "spare"));
+static_assert(AisLayoutIsContiguous(kAis5Layout, 38, 424), "Ais5 fields");
+
+// Ais9 from alt through sync_state.
+inline constexpr auto kAis9Layout = std::make_tuple(
+    AisUnsigned(&Ais9::alt, 38, 12, "alt"),  // m.
+    AisUnsigned(&Ais9::sog, 50, 10, "sog"),  // Knots, not tenths.
+    AisFlag(&Ais9::position_accuracy, 60, "position_accuracy"),
+    AisPosition(&Ais9::position, 61, 55),
+    AisUnsigned(&Ais9::cog, 116, 12, "cog", 10.0F),
+    AisUnsigned(&Ais9::timestamp, 128, 6, "timestamp"),
+    AisFlag(&Ais9::alt_sensor, 134, "alt_sensor"),
+    AisUnsigned(&Ais9::spare, 135, 7, "spare"),
+    AisFlag(&Ais9::dte, 142, "dte"),
+    AisUnsigned(&Ais9::spare2, 143, 3, "spare2"),
+    AisFlag(&Ais9::assigned_mode, 146, "assigned_mode"),
+    AisFlag(&Ais9::raim, 147, "raim"),
+    AisFlag(&Ais9::commstate_flag, 148, nullptr),  // 0 SOTDMA.
+    AisUnsigned(&Ais9::sync_state, 149, 2, "sync_state"));
+static_assert(AisLayoutIsContiguous(kAis9Layout, 38, 151), "Ais9 fields");
+
+// Ais18 from spare through commstate_flag.
+inline constexpr auto kAis18Layout = std::make_tuple(
+    AisUnsigned(&Ais18::spare, 38, 8, "spare"),
+    AisUnsigned(&Ais18::sog, 46, 10, "sog", 10.0F),
+    AisFlag(&Ais18::position_accuracy, 56, "position_accuracy"),
+    AisPosition(&Ais18::position, 57, 55),
+    AisUnsigned(&Ais18::cog, 112, 12, "cog", 10.0F),
+    AisUnsigned(&Ais18::true_heading, 124, 9, "true_heading"),
+    AisUnsigned(&Ais18::timestamp, 133, 6, "timestamp"),
+    AisUnsigned(&Ais18::spare2, 139, 2, "spare2"),
+    AisFlag(&Ais18::unit_flag, 141, "unit_flag"),
+    AisFlag(&Ais18::display_flag, 142, "display_flag"),
+    AisFlag(&Ais18::dsc_flag, 143, "dsc_flag"),
+    AisFlag(&Ais18::band_flag, 144, "band_flag"),
+    AisFlag(&Ais18::m22_flag, 145, "m22_flag"),
+    AisFlag(&Ais18::mode_flag, 146, "mode_flag"),
+    AisFlag(&Ais18::raim, 147, "raim"),
+    AisFlag(&Ais18::commstate_flag, 148, "commstate_flag"));  // 0 SOTDMA.
+static_assert(AisLayoutIsContiguous(kAis18Layout, 38, 149), "Ais18 fields");
+
+// All of Ais19 after the header.
+inline constexpr auto kAis19Layout = std::make_tuple(
+    AisUnsigned(&Ais19::spare, 38, 8, "spare"),
+    AisUnsigned(&Ais19::sog, 46, 10, "sog", 10.0F),
+    AisFlag(&Ais19::position_accuracy, 56, "position_accuracy"),
+    AisPosition(&Ais19::position, 57, 55),
+    AisUnsigned(&Ais19::cog, 112, 12, "cog", 10.0F),
+    AisUnsigned(&Ais19::true_heading, 124, 9, "true_heading"),
+    AisUnsigned(&Ais19::timestamp, 133, 6, "timestamp"),
+    AisUnsigned(&Ais19::spare2, 139, 4, "spare2"),
+    AisText(&Ais19::name, 143, 120, "name"),
+    AisUnsigned(&Ais19::type_and_cargo, 263, 8, "type_and_cargo"),
+    AisUnsigned(&Ais19::dim_a, 271, 9, "dim_a"),
+    AisUnsigned(&Ais19::dim_b, 280, 9, "dim_b"),
+    AisUnsigned(&Ais19::dim_c, 289, 6, "dim_c"),
+    AisUnsigned(&Ais19::dim_d, 295, 6, "dim_d"),
+    AisUnsigned(&Ais19::fix_type, 301, 4, "fix_type"),
+    AisFlag(&Ais19::raim, 305, "raim"),
+    AisFlag(&Ais19::dte, 306, "dte"),
+    AisFlag(&Ais19::assigned_mode, 307, "assigned_mode"),
+    AisUnsigned(&Ais19::spare3, 308, 4, "spare3"));
+static_assert(AisLayoutIsContiguous(kAis19Layout, 38, 312), "Ais19 fields");
+
+// Ais21 from aton_type through aton_status.  That is all of the short 268 bit
+// form of the message.
+inline constexpr auto kAis21Layout = std::make_tuple(
+    AisUnsigned(&Ais21::aton_type, 38, 5, "aton_type"),
+    AisText(&Ais21::name, 43, 120, "name"),
+    AisFlag(&Ais21::position_accuracy, 163, "position_accuracy"),
+    AisPosition(&Ais21::position, 164, 55),
+    AisUnsigned(&Ais21::dim_a, 219, 9, "dim_a"),
+    AisUnsigned(&Ais21::dim_b, 228, 9, "dim_b"),
+    AisUnsigned(&Ais21::dim_c, 237, 6, "dim_c"),
+    AisUnsigned(&Ais21::dim_d, 243, 6, "dim_d"),
+    AisUnsigned(&Ais21::fix_type, 249, 4, "fix_type"),
+    AisUnsigned(&Ais21::timestamp, 253, 6, "timestamp"),
+    AisFlag(&Ais21::off_pos, 259, "off_pos"),
+    AisUnsigned(&Ais21::aton_status, 260, 8, "aton_status"));
+static_assert(AisLayoutIsContiguous(kAis21Layout, 38, 268), "Ais21 fields");
+
+// The Ais21 flags that follow in the standard 272 or more bit form.
+inline constexpr auto kAis21FlagsLayout = std::make_tuple(
+    AisFlag(&Ais21::raim, 268, "raim"),
+    AisFlag(&Ais21::virtual_aton, 269, "virtual_aton"),
+    AisFlag(&Ais21::assigned_mode, 270, "assigned_mode"),
+    AisFlag(&Ais21::spare, 271, "spare"));
+static_assert(AisLayoutIsContiguous(kAis21FlagsLayout, 268, 272),
+              "Ais21 flags");
+
+// Ais24 part B after part_num.
+inline constexpr auto kAis24PartBLayout = std::make_tuple(
+    AisUnsigned(&Ais24::type_and_cargo, 40, 8, "type_and_cargo"),
+    AisText(&Ais24::vendor_id, 48, 42, "vendor_id"),
+    AisText(&Ais24::callsign, 90, 42, "callsign"),
+    AisUnsigned(&Ais24::dim_a, 132, 9, "dim_a"),
+    AisUnsigned(&Ais24::dim_b, 141, 9, "dim_b"),
+    AisUnsigned(&Ais24::dim_c, 150, 6, "dim_c"),
+    AisUnsigned(&Ais24::dim_d, 156, 6, "dim_d"),
+    AisUnsigned(&Ais24::spare, 162, 6, "spare"));
+static_assert(AisLayoutIsContiguous(kAis24PartBLayout, 40, 168),
+              "Ais24 part B fields");
+
+// Ais27 up to the inverted gnss bit.
+inline constexpr auto kAis27Layout = std::make_tuple(
+    AisFlag(&Ais27::position_accuracy, 38, "position_accuracy"),
+    AisFlag(&Ais27::raim, 39, "raim"),
+    AisUnsigned(&Ais27::nav_status, 40, 4, "nav_status"),
+    AisPosition(&Ais27::position, 44, 35),
+    AisUnsigned(&Ais27::sog, 79, 6, "sog"),  // Knots.
+    AisUnsigned(&Ais27::cog, 85, 9, "cog"));  // Degrees.
+static_assert(AisLayoutIsContiguous(kAis27Layout, 38, 94), "Ais27 fields");
+
+namespace internal {
+
+// Hands out fields from a cached 64 bit window of a bitset.  A new window is
+// only read when a field does not fit in the current one.
+class AisFieldReader {
+ public:
+  AisFieldReader(const AisBitset &bits, size_t start)
+      : bits_(bits), base_(start), window_(bits.PeekWindow(start)) {}
+
+  // Returns the field left aligned in 64 bits.
+  uint64_t Get(size_t start, size_t len) {
+    assert(start >= base_);
+    if (start + len > base_ + 64) {
+      base_ = start;
+      window_ = bits_.PeekWindow(start);
+    }
+    return window_ << (start - base_);
+  }
+
+  unsigned int Unsigned(size_t start, size_t len) {
+    return static_cast<unsigned int>(Get(start, len) >> (64 - len));
+  }
+
+  // An arithmetic shift sign extends the field.
+  int Signed(size_t start, size_t len) {
+    return static_cast<int>(static_cast<int64_t>(Get(start, len)) >>
+                            (64 - len));
+  }
+
+  const AisBitset &bits() const { return bits_; }
+
+ private:
+  const AisBitset &bits_;
+  size_t base_;
+  uint64_t window_;
+};
+
+template <AisFieldKind Kind, typename Msg, typename T>
+void DecodeField(AisFieldReader *reader, const AisField<Kind, Msg, T> &field,
+                 Msg *msg) {
+  T &value = msg->*field.member;
+  if constexpr (Kind == AIS_FIELD_UNSIGNED) {
+    const unsigned int raw = reader->Unsigned(field.start, field.len);
+    if constexpr (std::is_floating_point<T>::value) {
+      value = field.scale != 0 ? raw / field.scale : raw;
+    } else {
+      value = static_cast<T>(raw);
+    }
+  } else if constexpr (Kind == AIS_FIELD_SIGNED) {
+    value = static_cast<T>(reader->Signed(field.start, field.len));
+  } else if constexpr (Kind == AIS_FIELD_FLAG) {
+    value = static_cast<T>(reader->Unsigned(field.start, 1));
+  } else if constexpr (Kind == AIS_FIELD_TEXT) {
+    reader->bits().SeekTo(field.start);
+    value = reader->bits().ToString(field.start, field.len);
+  } else {
+    static_assert(Kind == AIS_FIELD_POSITION, "Unknown field kind");
+    // Matches AisBitset::ToAisPoint.
+    size_t lng_bits = 28;
+    double divisor = 600000.0;
+    if (field.len == 35) {
+      lng_bits = 18;
+      divisor = 600.0;
+    } else if (field.len == 49) {
+      lng_bits = 25;
+      divisor = 60000.0;
+    }
+    const double lng = reader->Signed(field.start, lng_bits);
+    const double lat =
+        reader->Signed(field.start + lng_bits, field.len - lng_bits);
+    value = AisPoint(lng / divisor, lat / divisor);
+  }
+}
+
+}  // namespace internal
+
+// Fills the fields of layout in msg from bits.  The bitset must be positioned
+// at the first field and is left just after the last one.
+template <typename Msg, typename Layout>
+void DecodeFields(const AisBitset &bits, const Layout &layout, Msg *msg) {
+  assert(bits.GetPosition() ==
+         static_cast<int>(std::get<0>(layout).start));
+  assert(AisLayoutEnd(layout) <=
+         static_cast<size_t>(bits.GetNumChars()) * 6);
+  internal::AisFieldReader reader(bits, std::get<0>(layout).start);
+  std::apply(
+      [&reader, msg](const auto &... fields) {
+        (internal::DecodeField(&reader, fields, msg), ...);
+      },
+      layout);
+  bits.SeekTo(AisLayoutEnd(layout));
+}
+
+}  // namespace libais
+
+#endif  // LIBAIS_AIS_FIELDS_H_
@@ -1,13 +1,35 @@
 // TODO(schwehr): check for reference counting leaks
 // TODO(schwehr): better error handling for all messages
+#include <algorithm>
+#include <array>
 #include <cassert>
+#include <cmath>
 #include <cstddef>
-#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <deque>
+#include <memory>
+#include <mutex>
 #include <string>
+#include <string_view>
+#include <tuple>
+#include <type_traits>
+#include <utility>
+#include <vector>
 
 #include <Python.h>
 
 #include "ais.h"
+#include "ais_fields.h"
+#include "decode_body.h"
+#include "vdm.h"
+
+// Critical sections only exist from 3.13, where they are no-ops unless the
+// interpreter is free-threaded.
+#if PY_VERSION_HEX < 0x030D0000
+#define Py_BEGIN_CRITICAL_SECTION(op) {
+#define Py_END_CRITICAL_SECTION() }
+#endif
 
 namespace libais {
 
@@ -71,102 +93,130 @@ enum AIS_FI {
   AIS_FI_8_367_33_ENVIRONMENTAL = 33, // Environmental Message
 };
 
+// The text of a dictionary key as a template argument.
+template <size_t N>
+struct KeyText {
+  constexpr KeyText(const char (&text)[N]) {  // NOLINT(runtime/explicit)
+    std::copy_n(text, N, chars);
+  }
+  char chars[N];
+};
+
+// One interned str per key.  They are made when the module is loaded and
+// held for the life of the process, so adding a field to a dict does no
+// lookup and takes no lock.
+template <KeyText Text>
+PyObject *const kKey = PyUnicode_InternFromString(Text.chars);
+
+// "name"_key is the dictionary key for a field.
+template <KeyText Text>
+PyObject *
+operator""_key() {
+  return kKey<Text>;
+}
+
 void
-DictSafeSetItem(
-    PyObject *dict, const std::string &key, const long val) {  // NOLINT
-  PyObject *val_obj = PyLong_FromLong(val);
+DictSafeSetItem(PyObject *dict, PyObject *key, PyObject *val_obj) {
+  // When we need to add dictionaries and such to a dictionary
+  assert(dict);
   assert(val_obj);
-  PyDict_SetItemString(dict, key.c_str(), val_obj);
-  Py_DECREF(val_obj);
+  PyDict_SetItem(dict, key, val_obj);
 }
 
+// Takes ownership of val_obj.
 void
-DictSafeSetItem(PyObject *dict, const std::string &key, const int val) {
-  PyObject *val_obj = PyLong_FromLong(val);
+DictSafeSetNewItem(PyObject *dict, PyObject *key, PyObject *val_obj) {
   assert(val_obj);
-  PyDict_SetItemString(dict, key.c_str(), val_obj);
+  PyDict_SetItem(dict, key, val_obj);
   Py_DECREF(val_obj);
 }
 
 void
 DictSafeSetItem(
-    PyObject *dict, const std::string &key, const unsigned int val) {
-  PyObject *val_obj = PyLong_FromLong(val);
-  assert(val_obj);
-  PyDict_SetItemString(dict, key.c_str(), val_obj);
-  Py_DECREF(val_obj);
+    PyObject *dict, PyObject *key, const long val) {  // NOLINT
+  DictSafeSetNewItem(dict, key, PyLong_FromLong(val));
 }
 
 void
-DictSafeSetItem(PyObject *dict, const std::string &key, const std::string &val) {
-  PyObject *val_obj = PyUnicode_FromString(val.c_str());
-  assert(val_obj);
-  PyDict_SetItemString(dict, key.c_str(), val_obj);
-  Py_DECREF(val_obj);
+DictSafeSetItem(PyObject *dict, PyObject *key, const int val) {
+  DictSafeSetNewItem(dict, key, PyLong_FromLong(val));
 }
 
-
 void
-DictSafeSetItem(PyObject *dict, const std::string &key, const char *val) {
-  PyObject *val_obj = PyUnicode_FromString(val);
-  assert(val_obj);
-  PyDict_SetItemString(dict, key.c_str(), val_obj);
-  Py_DECREF(val_obj);
+DictSafeSetItem(
+    PyObject *dict, PyObject *key, const unsigned int val) {
+  DictSafeSetNewItem(dict, key, PyLong_FromLong(val));
 }
 
+void
+DictSafeSetItem(PyObject *dict, PyObject *key, const std::string &val) {
+  DictSafeSetNewItem(dict, key, PyUnicode_FromString(val.c_str()));
+}
 
-#if 0
 void
-DictSafeSetItem(PyObject *dict, const std::string &key, const bool val) {
-  PyObject *key_obj = PyUnicode_FromString(key.c_str());
-  PyObject *val_obj = PyBool_FromLong(val);
-  assert(key_obj);
-  assert(val_obj);
-  PyDict_SetItem(dict, key_obj, val_obj);
-  Py_DECREF(key_obj);
-  Py_DECREF(val_obj);
+DictSafeSetItem(PyObject *dict, PyObject *key, const char *val) {
+  DictSafeSetNewItem(dict, key, PyUnicode_FromString(val));
 }
-#else
+
 void
-DictSafeSetItem(PyObject *dict, const std::string &key, const bool val) {
-  if (val) {
-    PyDict_SetItemString(dict, key.c_str(), Py_True);
-  } else {
-    PyDict_SetItemString(dict, key.c_str(), Py_False);
-  }
+DictSafeSetItem(PyObject *dict, PyObject *key, const bool val) {
+  DictSafeSetItem(dict, key, val ? Py_True : Py_False);
 }
-#endif
 
 void
-DictSafeSetItem(PyObject *dict, const std::string &key, const float val) {
-  PyObject *val_obj = PyFloat_FromDouble(val);
-  assert(val_obj);
-  PyDict_SetItemString(dict, key.c_str(), val_obj);
-  Py_DECREF(val_obj);
+DictSafeSetItem(PyObject *dict, PyObject *key, const float val) {
+  DictSafeSetNewItem(dict, key, PyFloat_FromDouble(val));
 }
 
 // Python Floats are IEE-754 double precision.
 void
-DictSafeSetItem(PyObject *dict, const std::string &key, const double val) {
-  PyObject *val_obj = PyFloat_FromDouble(val);
-  assert(val_obj);
-  PyDict_SetItemString(dict, key.c_str(), val_obj);
-  Py_DECREF(val_obj);
+DictSafeSetItem(PyObject *dict, PyObject *key, const double val) {
+  DictSafeSetNewItem(dict, key, PyFloat_FromDouble(val));
 }
 
 void
-DictSafeSetItem(PyObject *dict, const std::string &x_key, const std::string& y_key,
+DictSafeSetItem(PyObject *dict, PyObject *x_key, PyObject *y_key,
                 const AisPoint& position) {
   DictSafeSetItem(dict, x_key, position.lng_deg);
   DictSafeSetItem(dict, y_key, position.lat_deg);
 }
 
+// The key of each field of a layout from ais_fields.h, in the order of the
+// fields, or nullptr for a field without a name.
+template <typename Layout>
+auto
+MakeLayoutKeys(const Layout &layout) {
+  return std::apply([](const auto &... fields) {
+    return std::array<PyObject *, sizeof...(fields)>{
+        (fields.name != nullptr ? PyUnicode_InternFromString(fields.name)
+                                : nullptr)...};
+  }, layout);
+}
+
+// Made when the module is loaded, like kKey.
+template <const auto &Layout>
+const auto kLayoutKeys = MakeLayoutKeys(Layout);
+
+template <AisFieldKind Kind, typename Msg, typename T>
 void
-DictSafeSetItem(PyObject *dict, const std::string &key, PyObject *val_obj) {
-  // When we need to add dictionaries and such to a dictionary
-  assert(dict);
-  assert(val_obj);
-  PyDict_SetItemString(dict, key.c_str(), val_obj);
+DictSafeSetField(PyObject *dict, const Msg &msg,
+                 const AisField<Kind, Msg, T> &field, PyObject *key) {
+  if constexpr (Kind == AIS_FIELD_POSITION) {
+    DictSafeSetItem(dict, "x"_key, "y"_key, msg.*field.member);
+  } else if (key != nullptr) {
+    DictSafeSetItem(dict, key, msg.*field.member);
+  }
+}
+
+// Adds the fields of a layout from ais_fields.h that have a name.
+template <const auto &Layout, typename Msg>
+void
+DictSafeSetFields(PyObject *dict, const Msg &msg) {
+  const auto &keys = kLayoutKeys<Layout>;
+  std::apply([dict, &msg, &keys](const auto &... fields) {
+    size_t i = 0;
+    (DictSafeSetField(dict, msg, fields, keys[i++]), ...);
+  }, Layout);
 }
 
 
@@ -175,19 +225,16 @@ ais_msg_to_pydict(const AisMsg* msg) {
   assert(msg);
 
   PyObject *dict = PyDict_New();
-  DictSafeSetItem(dict, "id", msg->message_id);
-  DictSafeSetItem(dict, "repeat_indicator", msg->repeat_indicator);
-  DictSafeSetItem(dict, "mmsi", msg->mmsi);
+  DictSafeSetItem(dict, "id"_key, msg->message_id);
+  DictSafeSetItem(dict, "repeat_indicator"_key, msg->repeat_indicator);
+  DictSafeSetItem(dict, "mmsi"_key, msg->mmsi);
 
   return dict;
 }
 
 // Class A position report
 PyObject *
-ais1_2_3_to_pydict(const char *nmea_payload, const size_t pad) {
-  assert(nmea_payload);
-
-  Ais1_2_3 msg(nmea_payload, pad);
+ais1_2_3_to_pydict(const Ais1_2_3 &msg) {
   if (msg.had_error()) {
     PyErr_Format(ais_py_exception, "Ais1_2_3: %s",
                  AIS_STATUS_STRINGS[msg.get_error()]);
@@ -196,50 +243,39 @@ ais1_2_3_to_pydict(const char *nmea_payload, const size_t pad) {
 
   PyObject *dict = ais_msg_to_pydict(&msg);
 
-  DictSafeSetItem(dict, "nav_status", msg.nav_status);
-  DictSafeSetItem(dict, "rot_over_range", msg.rot_over_range);
-  DictSafeSetItem(dict, "rot", msg.rot);
-  DictSafeSetItem(dict, "sog", msg.sog);
-  DictSafeSetItem(dict, "position_accuracy", msg.position_accuracy);
-  DictSafeSetItem(dict, "x", "y", msg.position);
-  DictSafeSetItem(dict, "cog", msg.cog);
-  DictSafeSetItem(dict, "true_heading", msg.true_heading);
-  DictSafeSetItem(dict, "timestamp", msg.timestamp);
-  DictSafeSetItem(dict, "special_manoeuvre", msg.special_manoeuvre);
-  DictSafeSetItem(dict, "spare", msg.spare);
-  DictSafeSetItem(dict, "raim", msg.raim);
-
-  // COMM States
-  DictSafeSetItem(dict, "sync_state", msg.sync_state);  // Both SOTDMA & ITDMA
+  // Includes sync_state from the COMM state for both SOTDMA & ITDMA.
+  DictSafeSetFields<kAis1_2_3Layout>(dict, msg);
+  DictSafeSetItem(dict, "rot_over_range"_key, msg.rot_over_range);
+  DictSafeSetItem(dict, "rot"_key, msg.rot);
 
   // SOTDMA
   if (msg.message_id == 1 || msg.message_id == 2) {
     if (msg.slot_timeout_valid) {
-      DictSafeSetItem(dict, "slot_timeout", msg.slot_timeout);
+      DictSafeSetItem(dict, "slot_timeout"_key, msg.slot_timeout);
     }
 
     if (msg.received_stations_valid) {
-      DictSafeSetItem(dict, "received_stations", msg.received_stations);
+      DictSafeSetItem(dict, "received_stations"_key, msg.received_stations);
     }
     if (msg.slot_number_valid) {
-      DictSafeSetItem(dict, "slot_number", msg.slot_number);
+      DictSafeSetItem(dict, "slot_number"_key, msg.slot_number);
     }
     if (msg.utc_valid) {
-      DictSafeSetItem(dict, "utc_hour", msg.utc_hour);
-      DictSafeSetItem(dict, "utc_min", msg.utc_min);
-      DictSafeSetItem(dict, "utc_spare", msg.utc_spare);
+      DictSafeSetItem(dict, "utc_hour"_key, msg.utc_hour);
+      DictSafeSetItem(dict, "utc_min"_key, msg.utc_min);
+      DictSafeSetItem(dict, "utc_spare"_key, msg.utc_spare);
     }
 
     if (msg.slot_offset_valid) {
-      DictSafeSetItem(dict, "slot_offset", msg.slot_offset);
+      DictSafeSetItem(dict, "slot_offset"_key, msg.slot_offset);
     }
   }
 
   // ITDMA
   if (msg.slot_increment_valid) {
-    DictSafeSetItem(dict, "slot_increment", msg.slot_increment);
-    DictSafeSetItem(dict, "slots_to_allocate", msg.slots_to_allocate);
-    DictSafeSetItem(dict, "keep_flag", msg.keep_flag);
+    DictSafeSetItem(dict, "slot_increment"_key, msg.slot_increment);
+    DictSafeSetItem(dict, "slots_to_allocate"_key, msg.slots_to_allocate);
+    DictSafeSetItem(dict, "keep_flag"_key, msg.keep_flag);
   }
 
   return dict;
@@ -247,10 +283,7 @@ ais1_2_3_to_pydict(const char *nmea_payload, const size_t pad) {
 
 // Basestation report and ';' time report
 PyObject *
-ais4_11_to_pydict(const char *nmea_payload, const size_t pad) {
-  assert(nmea_payload);
-
-  Ais4_11 msg(nmea_payload, pad);
+ais4_11_to_pydict(const Ais4_11 &msg) {
   if (msg.had_error()) {
     PyErr_Format(ais_py_exception, "Ais4_11: %s",
                  AIS_STATUS_STRINGS[msg.get_error()]);
@@ -259,46 +292,30 @@ ais4_11_to_pydict(const char *nmea_payload, const size_t pad) {
 
   PyObject *dict = ais_msg_to_pydict(&msg);
 
-  DictSafeSetItem(dict, "year", msg.year);
-  DictSafeSetItem(dict, "month", msg.month);
-  DictSafeSetItem(dict, "day", msg.day);
-  DictSafeSetItem(dict, "hour", msg.hour);
-  DictSafeSetItem(dict, "minute", msg.minute);
-  DictSafeSetItem(dict, "second", msg.second);
-
-  DictSafeSetItem(dict, "position_accuracy", msg.position_accuracy);
-  DictSafeSetItem(dict, "x", "y", msg.position);
-
-  DictSafeSetItem(dict, "fix_type", msg.fix_type);
-  DictSafeSetItem(dict, "transmission_ctl", msg.transmission_ctl);
-  DictSafeSetItem(dict, "spare", msg.spare);
-  DictSafeSetItem(dict, "raim", msg.raim);
+  DictSafeSetFields<kAis4_11Layout>(dict, msg);
 
   // SOTDMA
-  DictSafeSetItem(dict, "sync_state", msg.sync_state);
-  DictSafeSetItem(dict, "slot_timeout", msg.slot_timeout);
+  DictSafeSetItem(dict, "slot_timeout"_key, msg.slot_timeout);
 
   if (msg.received_stations_valid)
-    DictSafeSetItem(dict, "received_stations", msg.received_stations);
+    DictSafeSetItem(dict, "received_stations"_key, msg.received_stations);
   if (msg.slot_number_valid)
-    DictSafeSetItem(dict, "slot_number", msg.slot_number);
+    DictSafeSetItem(dict, "slot_number"_key, msg.slot_number);
   if (msg.utc_valid) {
-    DictSafeSetItem(dict, "utc_hour", msg.utc_hour);
-    DictSafeSetItem(dict, "utc_min", msg.utc_min);
-    DictSafeSetItem(dict, "utc_spare", msg.utc_spare);
+    DictSafeSetItem(dict, "utc_hour"_key, msg.utc_hour);
+    DictSafeSetItem(dict, "utc_min"_key, msg.utc_min);
+    DictSafeSetItem(dict, "utc_spare"_key, msg.utc_spare);
   }
 
   if (msg.slot_offset_valid)
-    DictSafeSetItem(dict, "slot_offset", msg.slot_offset);
+    DictSafeSetItem(dict, "slot_offset"_key, msg.slot_offset);
 
   return dict;
 }
 
 // Class A ship data
 PyObject *
-ais5_to_pydict(const char *nmea_payload, const size_t pad) {
-  assert(nmea_payload);
-  Ais5 msg(nmea_payload, pad);
+ais5_to_pydict(const Ais5 &msg) {
   if (msg.had_error()) {
     PyErr_Format(ais_py_exception, "Ais5: %s",
                  AIS_STATUS_STRINGS[msg.get_error()]);
@@ -307,115 +324,86 @@ ais5_to_pydict(const char *nmea_payload, const size_t pad) {
 
   PyObject *dict = ais_msg_to_pydict(&msg);
 
-  DictSafeSetItem(dict, "ais_version", msg.ais_version);
-  DictSafeSetItem(dict, "imo_num", msg.imo_num);
-  DictSafeSetItem(dict, "callsign", msg.callsign);
-  DictSafeSetItem(dict, "name", msg.name);
-  DictSafeSetItem(dict, "type_and_cargo", msg.type_and_cargo);
-  DictSafeSetItem(dict, "dim_a", msg.dim_a);
-  DictSafeSetItem(dict, "dim_b", msg.dim_b);
-  DictSafeSetItem(dict, "dim_c", msg.dim_c);
-  DictSafeSetItem(dict, "dim_d", msg.dim_d);
-  DictSafeSetItem(dict, "fix_type", msg.fix_type);
-  DictSafeSetItem(dict, "eta_month", msg.eta_month);
-  DictSafeSetItem(dict, "eta_day", msg.eta_day);
-  DictSafeSetItem(dict, "eta_hour", msg.eta_hour);
-  DictSafeSetItem(dict, "eta_minute", msg.eta_minute);
-  DictSafeSetItem(dict, "draught", msg.draught);
-  DictSafeSetItem(dict, "destination", msg.destination);
-  DictSafeSetItem(dict, "dte", msg.dte);
-  DictSafeSetItem(dict, "spare", msg.spare);
+  DictSafeSetFields<kAis5Layout>(dict, msg);
 
   return dict;
 }
 
+// The message for the DAC and FI of a 6 or 8 made by CreateAisMsg.
+template <typename T>
+const T &
+SubMsg(const AisMsg *sub) {
+  assert(sub != nullptr);
+  return static_cast<const T &>(*sub);
+}
+
 // Address binary message
 AIS_STATUS
-ais6_1_0_append_pydict(const char *nmea_payload, PyObject *dict,
-                       const size_t pad) {
-  assert(nmea_payload);
+ais6_1_0_append_pydict(const Ais6_1_0 &msg, PyObject *dict) {
   assert(dict);
-  assert(pad < 6);
-  Ais6_1_0 msg(nmea_payload, pad);
   if (msg.had_error()) {
     return msg.get_error();
   }
 
-  DictSafeSetItem(dict, "ack_required",  msg.ack_required);
-  DictSafeSetItem(dict, "msg_seq",  msg.msg_seq);
-  DictSafeSetItem(dict, "text", msg.text);
-  DictSafeSetItem(dict, "spare2", msg.spare2);
+  DictSafeSetItem(dict, "ack_required"_key,  msg.ack_required);
+  DictSafeSetItem(dict, "msg_seq"_key,  msg.msg_seq);
+  DictSafeSetItem(dict, "text"_key, msg.text);
+  DictSafeSetItem(dict, "spare2"_key, msg.spare2);
 
   return AIS_OK;
 }
 
 AIS_STATUS
-ais6_1_1_append_pydict(const char *nmea_payload, PyObject *dict,
-                       const size_t pad) {
-  assert(nmea_payload);
+ais6_1_1_append_pydict(const Ais6_1_1 &msg, PyObject *dict) {
   assert(dict);
-  assert(pad < 6);
-  Ais6_1_1 msg(nmea_payload, pad);
   if (msg.had_error()) {
     return msg.get_error();
   }
 
-  DictSafeSetItem(dict, "ack_dac", msg.ack_dac);
-  DictSafeSetItem(dict, "msg_seq", msg.msg_seq);
-  DictSafeSetItem(dict, "spare2", msg.spare2);
+  DictSafeSetItem(dict, "ack_dac"_key, msg.ack_dac);
+  DictSafeSetItem(dict, "msg_seq"_key, msg.msg_seq);
+  DictSafeSetItem(dict, "spare2"_key, msg.spare2);
 
   return AIS_OK;
 }
 
 AIS_STATUS
-ais6_1_2_append_pydict(const char *nmea_payload, PyObject *dict,
-                       const size_t pad) {
-  assert(nmea_payload);
+ais6_1_2_append_pydict(const Ais6_1_2 &msg, PyObject *dict) {
   assert(dict);
-  assert(pad < 6);
-  Ais6_1_2 msg(nmea_payload, pad);
   if (msg.had_error()) {
     return msg.get_error();
   }
 
-  DictSafeSetItem(dict, "req_dac", msg.req_dac);
-  DictSafeSetItem(dict, "req_fi", msg.req_fi);
+  DictSafeSetItem(dict, "req_dac"_key, msg.req_dac);
+  DictSafeSetItem(dict, "req_fi"_key, msg.req_fi);
 
   return AIS_OK;
 }
 
 AIS_STATUS
-ais6_1_3_append_pydict(const char *nmea_payload, PyObject *dict,
-                       const size_t pad) {
-  assert(nmea_payload);
+ais6_1_3_append_pydict(const Ais6_1_3 &msg, PyObject *dict) {
   assert(dict);
-  assert(pad < 6);
 
-  Ais6_1_3 msg(nmea_payload, pad);
   if (msg.had_error()) {
     return msg.get_error();
   }
 
-  DictSafeSetItem(dict, "req_dac", msg.req_dac);
-  DictSafeSetItem(dict, "spare2", msg.spare2);
-  DictSafeSetItem(dict, "spare3", msg.spare3);
-  DictSafeSetItem(dict, "spare4", msg.spare4);
+  DictSafeSetItem(dict, "req_dac"_key, msg.req_dac);
+  DictSafeSetItem(dict, "spare2"_key, msg.spare2);
+  DictSafeSetItem(dict, "spare3"_key, msg.spare3);
+  DictSafeSetItem(dict, "spare4"_key, msg.spare4);
 
   return AIS_OK;
 }
 
 AIS_STATUS
-ais6_1_4_append_pydict(const char *nmea_payload, PyObject *dict,
-                       const size_t pad) {
-  assert(nmea_payload);
+ais6_1_4_append_pydict(const Ais6_1_4 &msg, PyObject *dict) {
   assert(dict);
-  assert(pad < 6);
-  Ais6_1_4 msg(nmea_payload, pad);
   if (msg.had_error()) {
     return msg.get_error();
   }
 
-  DictSafeSetItem(dict, "ack_dac", msg.ack_dac);
+  DictSafeSetItem(dict, "ack_dac"_key, msg.ack_dac);
   constexpr int kNumFI = 64;
   PyObject *cap_list = PyList_New(kNumFI);
   PyObject *res_list = PyList_New(kNumFI);
@@ -426,65 +414,57 @@ ais6_1_4_append_pydict(const char *nmea_payload, PyObject *dict,
     PyObject *res = PyLong_FromLong(long(msg.cap_reserved[cap_num]));  // NOLINT
     PyList_SetItem(res_list, cap_num, res);
   }
-  DictSafeSetItem(dict, "capabilities", cap_list);
+  DictSafeSetItem(dict, "capabilities"_key, cap_list);
   Py_DECREF(cap_list);
-  DictSafeSetItem(dict, "cap_reserved", res_list);
+  DictSafeSetItem(dict, "cap_reserved"_key, res_list);
   Py_DECREF(res_list);
-  DictSafeSetItem(dict, "spare2", msg.spare2);
-  DictSafeSetItem(dict, "spare3", msg.spare2);
-  DictSafeSetItem(dict, "spare4", msg.spare2);
-  DictSafeSetItem(dict, "spare5", msg.spare2);
+  DictSafeSetItem(dict, "spare2"_key, msg.spare2);
+  DictSafeSetItem(dict, "spare3"_key, msg.spare2);
+  DictSafeSetItem(dict, "spare4"_key, msg.spare2);
+  DictSafeSetItem(dict, "spare5"_key, msg.spare2);
 
   return AIS_OK;
 }
 
 AIS_STATUS
-ais6_1_5_append_pydict(const char *nmea_payload, PyObject *dict,
-                       const size_t pad) {
-  assert(nmea_payload);
+ais6_1_5_append_pydict(const Ais6_1_5 &msg, PyObject *dict) {
   assert(dict);
-  assert(pad < 6);
-  Ais6_1_5 msg(nmea_payload, pad);
   if (msg.had_error()) {
     return msg.get_error();
   }
 
-  DictSafeSetItem(dict, "ack_dac", msg.ack_dac);
-  DictSafeSetItem(dict, "ack_fi", msg.ack_dac);
-  DictSafeSetItem(dict, "seq_num", msg.ack_dac);
-  DictSafeSetItem(dict, "ai_available", msg.ack_dac);
-  DictSafeSetItem(dict, "ai_response", msg.ack_dac);
-  DictSafeSetItem(dict, "spare", msg.ack_dac);
+  DictSafeSetItem(dict, "ack_dac"_key, msg.ack_dac);
+  DictSafeSetItem(dict, "ack_fi"_key, msg.ack_dac);
+  DictSafeSetItem(dict, "seq_num"_key, msg.ack_dac);
+  DictSafeSetItem(dict, "ai_available"_key, msg.ack_dac);
+  DictSafeSetItem(dict, "ai_response"_key, msg.ack_dac);
+  DictSafeSetItem(dict, "spare"_key, msg.ack_dac);
 
   return AIS_OK;
 }
 
 AIS_STATUS
-ais6_1_12_append_pydict(const char *nmea_payload, PyObject *dict,
-                        const size_t pad) {
-  assert(nmea_payload);
-  assert(pad < 6);
-  Ais6_1_12 msg(nmea_payload, pad);
+ais6_1_12_append_pydict(const Ais6_1_12 &msg, PyObject *dict) {
   if (msg.had_error()) {
     return msg.get_error();
   }
 
-  DictSafeSetItem(dict, "last_port", msg.last_port);
-  DictSafeSetItem(dict, "utc_month_dep", msg.utc_month_dep);  // actual
-  DictSafeSetItem(dict, "utc_day_dep", msg.utc_day_dep);
-  DictSafeSetItem(dict, "utc_hour_dep", msg.utc_hour_dep);
-  DictSafeSetItem(dict, "utc_min_dep", msg.utc_min_dep);
-  DictSafeSetItem(dict, "next_port", msg.next_port);
-  DictSafeSetItem(dict, "utc_month_next", msg.utc_month_next);  // estimated
-  DictSafeSetItem(dict, "utc_day_next", msg.utc_day_next);
-  DictSafeSetItem(dict, "utc_hour_next", msg.utc_hour_next);
-  DictSafeSetItem(dict, "utc_min_next", msg.utc_min_next);
-  DictSafeSetItem(dict, "main_danger", msg.main_danger);
-  DictSafeSetItem(dict, "imo_cat", msg.imo_cat);
-  DictSafeSetItem(dict, "un", msg.un);
-  DictSafeSetItem(dict, "value", msg.value);  // TODO(schwehr): units?
-  DictSafeSetItem(dict, "value_unit", msg.value_unit);
-  DictSafeSetItem(dict, "spare2", msg.spare2);
+  DictSafeSetItem(dict, "last_port"_key, msg.last_port);
+  DictSafeSetItem(dict, "utc_month_dep"_key, msg.utc_month_dep);  // actual
+  DictSafeSetItem(dict, "utc_day_dep"_key, msg.utc_day_dep);
+  DictSafeSetItem(dict, "utc_hour_dep"_key, msg.utc_hour_dep);
+  DictSafeSetItem(dict, "utc_min_dep"_key, msg.utc_min_dep);
+  DictSafeSetItem(dict, "next_port"_key, msg.next_port);
+  DictSafeSetItem(dict, "utc_month_next"_key, msg.utc_month_next);  // estimated
+  DictSafeSetItem(dict, "utc_day_next"_key, msg.utc_day_next);
+  DictSafeSetItem(dict, "utc_hour_next"_key, msg.utc_hour_next);
+  DictSafeSetItem(dict, "utc_min_next"_key, msg.utc_min_next);
+  DictSafeSetItem(dict, "main_danger"_key, msg.main_danger);
+  DictSafeSetItem(dict, "imo_cat"_key, msg.imo_cat);
+  DictSafeSetItem(dict, "un"_key, msg.un);
+  DictSafeSetItem(dict, "value"_key, msg.value);  // TODO(schwehr): units?
+  DictSafeSetItem(dict, "value_unit"_key, msg.value_unit);
+  DictSafeSetItem(dict, "spare2"_key, msg.spare2);
 
   return AIS_OK;
 }
@@ -493,17 +473,13 @@ ais6_1_12_append_pydict(const char *nmea_payload, PyObject *dict,
 
 // IMO Circ 289 - Tidal Window
 AIS_STATUS
-ais6_1_14_append_pydict(const char *nmea_payload, PyObject *dict,
-                        const size_t pad) {
-  assert(nmea_payload);
-  assert(pad < 6);
-  Ais6_1_14 msg(nmea_payload, pad);
+ais6_1_14_append_pydict(const Ais6_1_14 &msg, PyObject *dict) {
   if (msg.had_error()) {
     return msg.get_error();
   }
 
-  DictSafeSetItem(dict, "utc_month", msg.utc_month);
-  DictSafeSetItem(dict, "utc_day", msg.utc_day);
+  DictSafeSetItem(dict, "utc_month"_key, msg.utc_month);
+  DictSafeSetItem(dict, "utc_day"_key, msg.utc_day);
 
   if (!msg.windows.size())
     return AIS_ERR_BAD_SUB_MSG;
@@ -511,16 +487,18 @@ ais6_1_14_append_pydict(const char *nmea_payload, PyObject *dict,
   PyObject *window_list = PyList_New(msg.windows.size());
   for (size_t w_num = 0; w_num < msg.windows.size(); w_num++) {
     PyObject *window = PyDict_New();
-    DictSafeSetItem(window, "x", "y", msg.windows[w_num].position);
-    DictSafeSetItem(window, "utc_hour_from", msg.windows[w_num].utc_hour_from);
-    DictSafeSetItem(window, "utc_min_from", msg.windows[w_num].utc_min_from);
-    DictSafeSetItem(window, "utc_hour_to", msg.windows[w_num].utc_hour_to);
-    DictSafeSetItem(window, "utc_min_to", msg.windows[w_num].utc_min_to);
-    DictSafeSetItem(window, "cur_dir", msg.windows[w_num].cur_dir);
-    DictSafeSetItem(window, "cur_speed", msg.windows[w_num].cur_speed);
+    DictSafeSetItem(window, "x"_key, "y"_key, msg.windows[w_num].position);
+    DictSafeSetItem(window, "utc_hour_from"_key,
+                    msg.windows[w_num].utc_hour_from);
+    DictSafeSetItem(window, "utc_min_from"_key,
+                    msg.windows[w_num].utc_min_from);
+    DictSafeSetItem(window, "utc_hour_to"_key, msg.windows[w_num].utc_hour_to);
+    DictSafeSetItem(window, "utc_min_to"_key, msg.windows[w_num].utc_min_to);
+    DictSafeSetItem(window, "cur_dir"_key, msg.windows[w_num].cur_dir);
+    DictSafeSetItem(window, "cur_speed"_key, msg.windows[w_num].cur_speed);
     PyList_SetItem(window_list, w_num, window);
   }
-  PyDict_SetItemString(dict, "windows", window_list);
+  DictSafeSetItem(dict, "windows"_key, window_list);
   Py_DECREF(window_list);
 
   return AIS_OK;
@@ -530,25 +508,21 @@ ais6_1_14_append_pydict(const char *nmea_payload, PyObject *dict,
 
 // IMO Circ 289 - Clearance time to enter port
 AIS_STATUS
-ais6_1_18_append_pydict(const char *nmea_payload, PyObject *dict,
-                        const size_t pad) {
-  assert(nmea_payload);
-  assert(pad < 6);
-  Ais6_1_18 msg(nmea_payload, pad);
+ais6_1_18_append_pydict(const Ais6_1_18 &msg, PyObject *dict) {
   if (msg.had_error()) {
     return msg.get_error();
   }
 
-  DictSafeSetItem(dict, "link_id", msg.link_id);
-  DictSafeSetItem(dict, "utc_month", msg.utc_month);
-  DictSafeSetItem(dict, "utc_day", msg.utc_day);
-  DictSafeSetItem(dict, "utc_hour", msg.utc_hour);
-  DictSafeSetItem(dict, "utc_min", msg.utc_min);
-  DictSafeSetItem(dict, "port_berth", msg.port_berth);
-  DictSafeSetItem(dict, "dest", msg.dest);
-  DictSafeSetItem(dict, "x", "y", msg.position);
-  DictSafeSetItem(dict, "spare2_0", msg.spare2[0]);
-  DictSafeSetItem(dict, "spare2_1", msg.spare2[1]);
+  DictSafeSetItem(dict, "link_id"_key, msg.link_id);
+  DictSafeSetItem(dict, "utc_month"_key, msg.utc_month);
+  DictSafeSetItem(dict, "utc_day"_key, msg.utc_day);
+  DictSafeSetItem(dict, "utc_hour"_key, msg.utc_hour);
+  DictSafeSetItem(dict, "utc_min"_key, msg.utc_min);
+  DictSafeSetItem(dict, "port_berth"_key, msg.port_berth);
+  DictSafeSetItem(dict, "dest"_key, msg.dest);
+  DictSafeSetItem(dict, "x"_key, "y"_key, msg.position);
+  DictSafeSetItem(dict, "spare2_0"_key, msg.spare2[0]);
+  DictSafeSetItem(dict, "spare2_1"_key, msg.spare2[1]);
 
   return AIS_OK;
 }
@@ -557,34 +531,30 @@ ais6_1_18_append_pydict(const char *nmea_payload, PyObject *dict,
 
 // IMO Circ 289 - Berthing data
 AIS_STATUS
-ais6_1_20_append_pydict(const char *nmea_payload, PyObject *dict,
-                        const size_t pad) {
-  assert(nmea_payload);
-  assert(pad < 6);
-  Ais6_1_20 msg(nmea_payload, pad);
+ais6_1_20_append_pydict(const Ais6_1_20 &msg, PyObject *dict) {
   if (msg.had_error()) {
     return msg.get_error();
   }
 
-  DictSafeSetItem(dict, "link_id", msg.link_id);
-  DictSafeSetItem(dict, "length", msg.length);
-  DictSafeSetItem(dict, "depth", msg.depth);
-  DictSafeSetItem(dict, "position", msg.mooring_position);
-  DictSafeSetItem(dict, "utc_month", msg.utc_month);
-  DictSafeSetItem(dict, "utc_day", msg.utc_day);
-  DictSafeSetItem(dict, "utc_hour", msg.utc_hour);
-  DictSafeSetItem(dict, "utc_min", msg.utc_min);
+  DictSafeSetItem(dict, "link_id"_key, msg.link_id);
+  DictSafeSetItem(dict, "length"_key, msg.length);
+  DictSafeSetItem(dict, "depth"_key, msg.depth);
+  DictSafeSetItem(dict, "position"_key, msg.mooring_position);
+  DictSafeSetItem(dict, "utc_month"_key, msg.utc_month);
+  DictSafeSetItem(dict, "utc_day"_key, msg.utc_day);
+  DictSafeSetItem(dict, "utc_hour"_key, msg.utc_hour);
+  DictSafeSetItem(dict, "utc_min"_key, msg.utc_min);
   if (msg.services_known) {
     PyObject *serv_list = PyList_New(26);
     for (size_t serv_num = 0; serv_num < 26; serv_num++) {
       PyObject *serv = PyLong_FromLong(long(msg.services[serv_num]));  // NOLINT
       PyList_SetItem(serv_list, serv_num, serv);
     }
-    DictSafeSetItem(dict, "services", serv_list);
+    DictSafeSetItem(dict, "services"_key, serv_list);
     Py_DECREF(serv_list);
   }
-  DictSafeSetItem(dict, "name", msg.name);
-  DictSafeSetItem(dict, "x", "y", msg.position);
+  DictSafeSetItem(dict, "name"_key, msg.name);
+  DictSafeSetItem(dict, "x"_key, "y"_key, msg.position);
 
   return AIS_OK;
 }
@@ -592,18 +562,14 @@ ais6_1_20_append_pydict(const char *nmea_payload, PyObject *dict,
 // 6_1_21, 6_1_22, 6_1_23 and 6_1_24 Do not exist (yet?)
 
 AIS_STATUS
-ais6_1_25_append_pydict(const char *nmea_payload, PyObject *dict,
-                        const size_t pad) {
-  assert(nmea_payload);
+ais6_1_25_append_pydict(const Ais6_1_25 &msg, PyObject *dict) {
   assert(dict);
-  assert(pad < 6);
-  Ais6_1_25 msg(nmea_payload, pad);
   if (msg.had_error()) {
     return msg.get_error();
   }
 
-  DictSafeSetItem(dict, "amount_unit", msg.amount_unit);
-  DictSafeSetItem(dict, "amount", msg.amount);
+  DictSafeSetItem(dict, "amount_unit"_key, msg.amount_unit);
+  DictSafeSetItem(dict, "amount"_key, msg.amount);
 
   if (0 == msg.cargos.size())
     return AIS_ERR_BAD_SUB_MSG;
@@ -612,20 +578,22 @@ ais6_1_25_append_pydict(const char *nmea_payload, PyObject *dict,
   for (size_t cargo_num = 0; cargo_num < msg.cargos.size(); cargo_num++) {
     PyObject *cargo = PyDict_New();
     if (msg.cargos[cargo_num].imdg_valid)
-      DictSafeSetItem(cargo, "imdg", msg.cargos[cargo_num].imdg);
+      DictSafeSetItem(cargo, "imdg"_key, msg.cargos[cargo_num].imdg);
     if (msg.cargos[cargo_num].spare_valid)
-      DictSafeSetItem(cargo, "spare", msg.cargos[cargo_num].spare);
+      DictSafeSetItem(cargo, "spare"_key, msg.cargos[cargo_num].spare);
     if (msg.cargos[cargo_num].un_valid)
-      DictSafeSetItem(cargo, "un", msg.cargos[cargo_num].un);
+      DictSafeSetItem(cargo, "un"_key, msg.cargos[cargo_num].un);
     if (msg.cargos[cargo_num].bc_valid)
-      DictSafeSetItem(cargo, "bc", msg.cargos[cargo_num].bc);
+      DictSafeSetItem(cargo, "bc"_key, msg.cargos[cargo_num].bc);
     if (msg.cargos[cargo_num].marpol_oil_valid)
-      DictSafeSetItem(cargo, "marpol_oil", msg.cargos[cargo_num].marpol_oil);
+      DictSafeSetItem(cargo, "marpol_oil"_key,
+                      msg.cargos[cargo_num].marpol_oil);
     if (msg.cargos[cargo_num].marpol_cat_valid)
-      DictSafeSetItem(cargo, "marpol_cat", msg.cargos[cargo_num].marpol_cat);
+      DictSafeSetItem(cargo, "marpol_cat"_key,
+                      msg.cargos[cargo_num].marpol_cat);
     PyList_SetItem(cargo_list, cargo_num, cargo);
   }
-  PyDict_SetItemString(dict, "cargos", cargo_list);
+  DictSafeSetItem(dict, "cargos"_key, cargo_list);
   Py_DECREF(cargo_list);
 
   return AIS_OK;
@@ -639,57 +607,50 @@ ais6_1_25_append_pydict(const char *nmea_payload, PyObject *dict,
 // 6_1_31
 
 AIS_STATUS
-ais6_1_32_append_pydict(const char *nmea_payload, PyObject *dict,
-                        const size_t pad) {
-  assert(nmea_payload);
+ais6_1_32_append_pydict(const Ais6_1_32 &msg, PyObject *dict) {
   assert(dict);
-  assert(pad < 6);
-  Ais6_1_32 msg(nmea_payload, pad);
   if (msg.had_error()) {
     return msg.get_error();
   }
 
-  DictSafeSetItem(dict, "utc_month", msg.utc_month);
-  DictSafeSetItem(dict, "utc_day", msg.utc_day);
+  DictSafeSetItem(dict, "utc_month"_key, msg.utc_month);
+  DictSafeSetItem(dict, "utc_day"_key, msg.utc_day);
 
   PyObject *window_list = PyList_New(msg.windows.size());
   for (size_t win_num = 0; win_num < msg.windows.size(); win_num++) {
     PyObject *win = PyDict_New();
-    DictSafeSetItem(win, "x", "y", msg.windows[win_num].position);
-    DictSafeSetItem(win, "from_utc_hour", msg.windows[win_num].from_utc_hour);
-    DictSafeSetItem(win, "from_utc_min", msg.windows[win_num].from_utc_min);
-    DictSafeSetItem(win, "to_utc_hour", msg.windows[win_num].to_utc_hour);
-    DictSafeSetItem(win, "to_utc_min", msg.windows[win_num].to_utc_min);
-    DictSafeSetItem(win, "cur_dir", msg.windows[win_num].cur_dir);
-    DictSafeSetItem(win, "cur_speed", msg.windows[win_num].cur_speed);
+    DictSafeSetItem(win, "x"_key, "y"_key, msg.windows[win_num].position);
+    DictSafeSetItem(win, "from_utc_hour"_key,
+                    msg.windows[win_num].from_utc_hour);
+    DictSafeSetItem(win, "from_utc_min"_key, msg.windows[win_num].from_utc_min);
+    DictSafeSetItem(win, "to_utc_hour"_key, msg.windows[win_num].to_utc_hour);
+    DictSafeSetItem(win, "to_utc_min"_key, msg.windows[win_num].to_utc_min);
+    DictSafeSetItem(win, "cur_dir"_key, msg.windows[win_num].cur_dir);
+    DictSafeSetItem(win, "cur_speed"_key, msg.windows[win_num].cur_speed);
     PyList_SetItem(window_list, win_num, win);
   }
-  PyDict_SetItemString(dict, "windows", window_list);
+  DictSafeSetItem(dict, "windows"_key, window_list);
   Py_DECREF(window_list);
 
   return AIS_OK;
 }
 
 AIS_STATUS
-ais6_1_40_append_pydict(const char *nmea_payload, PyObject *dict,
-                        const size_t pad) {
-  assert(nmea_payload);
+ais6_1_40_append_pydict(const Ais6_1_40 &msg, PyObject *dict) {
   assert(dict);
-  assert(pad < 6);
-  Ais6_1_40 msg(nmea_payload, pad);
   if (msg.had_error()) {
     return msg.get_error();
   }
-  DictSafeSetItem(dict, "persons", msg.persons);
-  DictSafeSetItem(dict, "spare2", msg.spare2);
+  DictSafeSetItem(dict, "persons"_key, msg.persons);
+  DictSafeSetItem(dict, "spare2"_key, msg.spare2);
 
   return AIS_OK;
 }
 
+// sub is the message for the DAC and FI from CreateAisMsg or nullptr if it
+// does not handle them.
 PyObject*
-ais6_to_pydict(const char *nmea_payload, const size_t pad) {
-  assert(nmea_payload);
-  Ais6 msg(nmea_payload, pad);
+ais6_to_pydict(const Ais6 &msg, const AisMsg *sub) {
   if (msg.had_error() && msg.get_error() != AIS_UNINITIALIZED) {
     PyErr_Format(ais_py_exception, "Ais6: %s",
                  AIS_STATUS_STRINGS[msg.get_error()]);
@@ -698,70 +659,70 @@ ais6_to_pydict(const char *nmea_payload, const size_t pad) {
 
   PyObject *dict = ais_msg_to_pydict(&msg);
 
-  DictSafeSetItem(dict, "seq", msg.seq);
-  DictSafeSetItem(dict, "mmsi_dest", msg.mmsi_dest);
-  DictSafeSetItem(dict, "retransmit", msg.retransmit);
-  DictSafeSetItem(dict, "spare", msg.spare);
-  DictSafeSetItem(dict, "dac", msg.dac);
-  DictSafeSetItem(dict, "fi", msg.fi);
+  DictSafeSetItem(dict, "seq"_key, msg.seq);
+  DictSafeSetItem(dict, "mmsi_dest"_key, msg.mmsi_dest);
+  DictSafeSetItem(dict, "retransmit"_key, msg.retransmit);
+  DictSafeSetItem(dict, "spare"_key, msg.spare);
+  DictSafeSetItem(dict, "dac"_key, msg.dac);
+  DictSafeSetItem(dict, "fi"_key, msg.fi);
 
   // TODO(schwehr): manage all the submessage types
 
   AIS_STATUS status = AIS_UNINITIALIZED;
 
-  switch (msg.dac) {
+  switch (sub == nullptr ? -1 : msg.dac) {
   case AIS_DAC_1_INTERNATIONAL:  // IMO.
     switch (msg.fi) {
     case AIS_FI_6_1_0_TEXT:  // OLD ITU 1371-1.
-      status = ais6_1_0_append_pydict(nmea_payload, dict, pad);
+      status = ais6_1_0_append_pydict(SubMsg<Ais6_1_0>(sub), dict);
       break;
     case AIS_FI_6_1_1_ACK:  // OLD ITU 1371-1.
-      status = ais6_1_1_append_pydict(nmea_payload, dict, pad);
+      status = ais6_1_1_append_pydict(SubMsg<Ais6_1_1>(sub), dict);
       break;
     case AIS_FI_6_1_2_FI_INTERROGATE:  // OLD ITU 1371-1.
-      status = ais6_1_2_append_pydict(nmea_payload, dict, pad);
+      status = ais6_1_2_append_pydict(SubMsg<Ais6_1_2>(sub), dict);
       break;
     case AIS_FI_6_1_3_CAPABILITY_INTERROGATE:  // OLD ITU 1371-1.
-      status = ais6_1_3_append_pydict(nmea_payload, dict, pad);
+      status = ais6_1_3_append_pydict(SubMsg<Ais6_1_3>(sub), dict);
       break;
     case AIS_FI_6_1_4_CAPABILITY_REPLY:  // OLD ITU 1371-1.
-      status = ais6_1_4_append_pydict(nmea_payload, dict, pad);
+      status = ais6_1_4_append_pydict(SubMsg<Ais6_1_4>(sub), dict);
       break;
     case AIS_FI_6_1_5_ACK:  // ITU 1371-5.
-      status = ais6_1_5_append_pydict(nmea_payload, dict, pad);
+      status = ais6_1_5_append_pydict(SubMsg<Ais6_1_5>(sub), dict);
       break;
     case AIS_FI_6_1_12_DANGEROUS_CARGO:  // Not to be used after 1 Jan 2013.
-      status = ais6_1_12_append_pydict(nmea_payload, dict, pad);
+      status = ais6_1_12_append_pydict(SubMsg<Ais6_1_12>(sub), dict);
       break;
     case AIS_FI_6_1_14_TIDAL_WINDOW:  // Not to be used after 1 Jan 2013.
-      status = ais6_1_14_append_pydict(nmea_payload, dict, pad);
+      status = ais6_1_14_append_pydict(SubMsg<Ais6_1_14>(sub), dict);
       break;
     case AIS_FI_6_1_18_ENTRY_TIME:
-      status = ais6_1_18_append_pydict(nmea_payload, dict, pad);
+      status = ais6_1_18_append_pydict(SubMsg<Ais6_1_18>(sub), dict);
       break;
     case AIS_FI_6_1_20_BERTHING:
-      status = ais6_1_20_append_pydict(nmea_payload, dict, pad);
+      status = ais6_1_20_append_pydict(SubMsg<Ais6_1_20>(sub), dict);
       break;
     case AIS_FI_6_1_25_DANGEROUS_CARGO:
-      status = ais6_1_25_append_pydict(nmea_payload, dict, pad);
+      status = ais6_1_25_append_pydict(SubMsg<Ais6_1_25>(sub), dict);
       break;
       // TODO(schwehr): AIS_FI_6_1_28_ROUTE.
       // TODO(schwehr): AIS_FI_6_1_30_TEXT.
     case AIS_FI_6_1_32_TIDAL_WINDOW:  // IMO Circ 289
-      status = ais6_1_32_append_pydict(nmea_payload, dict, pad);
+      status = ais6_1_32_append_pydict(SubMsg<Ais6_1_32>(sub), dict);
       break;
     case AIS_FI_6_1_40_PERSONS_ON_BOARD:  // OLD ITU 1371-1.
-      status = ais6_1_40_append_pydict(nmea_payload, dict, pad);
+      status = ais6_1_40_append_pydict(SubMsg<Ais6_1_40>(sub), dict);
       break;
     default:
       // TODO(schwehr): Raise an exception?
-      DictSafeSetItem(dict, "not_parsed", true);
+      DictSafeSetItem(dict, "not_parsed"_key, true);
     }
     break;
 
     default:
       // TODO(schwehr): Raise an exception?
-      DictSafeSetItem(dict, "not_parsed", true);
+      DictSafeSetItem(dict, "not_parsed"_key, true);
   }
 
   if (status != AIS_OK) {
@@ -779,9 +740,7 @@ ais6_to_pydict(const char *nmea_payload, const size_t pad) {
 
 // Acknowledgement
 PyObject*
-ais7_13_to_pydict(const char *nmea_payload, const size_t pad) {
-  assert(nmea_payload);
-  const Ais7_13 msg(nmea_payload, pad);
+ais7_13_to_pydict(const Ais7_13 &msg) {
   if (msg.had_error()) {
     PyErr_Format(ais_py_exception, "Ais7_13: %s",
                  AIS_STATUS_STRINGS[msg.get_error()]);
@@ -797,26 +756,22 @@ ais7_13_to_pydict(const char *nmea_payload, const size_t pad) {
     PyTuple_SetItem(tuple, 1, PyLong_FromLong(msg.seq_num[i]));  // Steals ref
     PyList_SetItem(list, i, tuple);  // Steals ref
   }
-  PyDict_SetItemString(dict, "acks", list);
+  DictSafeSetItem(dict, "acks"_key, list);
   Py_DECREF(list);
   return dict;
 }
 
 AIS_STATUS
-ais8_1_0_append_pydict(const char *nmea_payload, PyObject *dict,
-                       const size_t pad) {
-  assert(nmea_payload);
+ais8_1_0_append_pydict(const Ais8_1_0 &msg, PyObject *dict) {
   assert(dict);
-  assert(pad < 6);
-  Ais8_1_0 msg(nmea_payload, pad);
   if (msg.had_error()) {
     return msg.get_error();
   }
 
-  DictSafeSetItem(dict, "ack_required",  msg.ack_required);
-  DictSafeSetItem(dict, "msg_seq",  msg.msg_seq);
-  DictSafeSetItem(dict, "text", msg.text);
-  DictSafeSetItem(dict, "spare2", msg.spare2);
+  DictSafeSetItem(dict, "ack_required"_key,  msg.ack_required);
+  DictSafeSetItem(dict, "msg_seq"_key,  msg.msg_seq);
+  DictSafeSetItem(dict, "text"_key, msg.text);
+  DictSafeSetItem(dict, "spare2"_key, msg.spare2);
 
   return AIS_OK;
 }
@@ -824,60 +779,56 @@ ais8_1_0_append_pydict(const char *nmea_payload, PyObject *dict,
 // ais 8_1_[1..10] do not exist
 
 AIS_STATUS
-ais8_1_11_append_pydict(const char *nmea_payload, PyObject *dict,
-                        const size_t pad) {
-  assert(nmea_payload);
+ais8_1_11_append_pydict(const Ais8_1_11 &msg, PyObject *dict) {
   assert(dict);
-  assert(pad < 6);
-  Ais8_1_11 msg(nmea_payload, pad);
   if (msg.had_error()) {
     return msg.get_error();
   }
 
-  DictSafeSetItem(dict, "x", "y", msg.position);
+  DictSafeSetItem(dict, "x"_key, "y"_key, msg.position);
 
-  DictSafeSetItem(dict, "wind_ave", msg.wind_ave);
-  DictSafeSetItem(dict, "wind_gust", msg.wind_gust);
-  DictSafeSetItem(dict, "wind_dir", msg.wind_dir);
-  DictSafeSetItem(dict, "wind_gust_dir", msg.wind_gust);
+  DictSafeSetItem(dict, "wind_ave"_key, msg.wind_ave);
+  DictSafeSetItem(dict, "wind_gust"_key, msg.wind_gust);
+  DictSafeSetItem(dict, "wind_dir"_key, msg.wind_dir);
+  DictSafeSetItem(dict, "wind_gust_dir"_key, msg.wind_gust);
 
-  DictSafeSetItem(dict, "air_temp", msg.air_temp);
-  DictSafeSetItem(dict, "rel_humid", msg.rel_humid);
-  DictSafeSetItem(dict, "dew_point", msg.dew_point);
-  DictSafeSetItem(dict, "air_pres", msg.air_pres);
-  DictSafeSetItem(dict, "air_pres_trend", msg.air_pres_trend);
-  DictSafeSetItem(dict, "horz_vis", msg.horz_vis);
+  DictSafeSetItem(dict, "air_temp"_key, msg.air_temp);
+  DictSafeSetItem(dict, "rel_humid"_key, msg.rel_humid);
+  DictSafeSetItem(dict, "dew_point"_key, msg.dew_point);
+  DictSafeSetItem(dict, "air_pres"_key, msg.air_pres);
+  DictSafeSetItem(dict, "air_pres_trend"_key, msg.air_pres_trend);
+  DictSafeSetItem(dict, "horz_vis"_key, msg.horz_vis);
 
-  DictSafeSetItem(dict, "water_level", msg.water_level);
-  DictSafeSetItem(dict, "water_level_trend", msg.water_level_trend);
+  DictSafeSetItem(dict, "water_level"_key, msg.water_level);
+  DictSafeSetItem(dict, "water_level_trend"_key, msg.water_level_trend);
 
-  DictSafeSetItem(dict, "surf_cur_speed", msg.surf_cur_speed);
-  DictSafeSetItem(dict, "surf_cur_dir", msg.surf_cur_dir);
+  DictSafeSetItem(dict, "surf_cur_speed"_key, msg.surf_cur_speed);
+  DictSafeSetItem(dict, "surf_cur_dir"_key, msg.surf_cur_dir);
 
-  DictSafeSetItem(dict, "cur_speed_2", msg.cur_speed_2);
-  DictSafeSetItem(dict, "cur_dir_2",   msg.cur_dir_2);
-  DictSafeSetItem(dict, "cur_depth_2", msg.cur_depth_2);
+  DictSafeSetItem(dict, "cur_speed_2"_key, msg.cur_speed_2);
+  DictSafeSetItem(dict, "cur_dir_2"_key,   msg.cur_dir_2);
+  DictSafeSetItem(dict, "cur_depth_2"_key, msg.cur_depth_2);
 
-  DictSafeSetItem(dict, "cur_speed_3", msg.cur_speed_3);
-  DictSafeSetItem(dict, "cur_dir_3",   msg.cur_dir_3);
-  DictSafeSetItem(dict, "cur_depth_3", msg.cur_depth_3);
+  DictSafeSetItem(dict, "cur_speed_3"_key, msg.cur_speed_3);
+  DictSafeSetItem(dict, "cur_dir_3"_key,   msg.cur_dir_3);
+  DictSafeSetItem(dict, "cur_depth_3"_key, msg.cur_depth_3);
 
-  DictSafeSetItem(dict, "wave_height", msg.wave_height);
-  DictSafeSetItem(dict, "wave_period", msg.wave_period);
-  DictSafeSetItem(dict, "wave_dir", msg.wave_dir);
+  DictSafeSetItem(dict, "wave_height"_key, msg.wave_height);
+  DictSafeSetItem(dict, "wave_period"_key, msg.wave_period);
+  DictSafeSetItem(dict, "wave_dir"_key, msg.wave_dir);
 
-  DictSafeSetItem(dict, "swell_height", msg.swell_height);
-  DictSafeSetItem(dict, "swell_period", msg.swell_period);
-  DictSafeSetItem(dict, "swell_dir", msg.swell_dir);
+  DictSafeSetItem(dict, "swell_height"_key, msg.swell_height);
+  DictSafeSetItem(dict, "swell_period"_key, msg.swell_period);
+  DictSafeSetItem(dict, "swell_dir"_key, msg.swell_dir);
 
-  DictSafeSetItem(dict, "sea_state", msg.sea_state);
-  DictSafeSetItem(dict, "water_temp", msg.water_temp);
-  DictSafeSetItem(dict, "precip_type", msg.precip_type);
-  DictSafeSetItem(dict, "ice", msg.ice);  // Grr... ice
+  DictSafeSetItem(dict, "sea_state"_key, msg.sea_state);
+  DictSafeSetItem(dict, "water_temp"_key, msg.water_temp);
+  DictSafeSetItem(dict, "precip_type"_key, msg.precip_type);
+  DictSafeSetItem(dict, "ice"_key, msg.ice);  // Grr... ice
 
   // Or could be spare
-  DictSafeSetItem(dict, "ext_water_level", msg.extended_water_level);
-  DictSafeSetItem(dict, "spare2", msg.extended_water_level);
+  DictSafeSetItem(dict, "ext_water_level"_key, msg.extended_water_level);
+  DictSafeSetItem(dict, "spare2"_key, msg.extended_water_level);
 
   return AIS_OK;
 }
@@ -885,30 +836,26 @@ ais8_1_11_append_pydict(const char *nmea_payload, PyObject *dict,
 // 12 is addressed
 
 AIS_STATUS
-ais8_1_13_append_pydict(const char *nmea_payload, PyObject *dict,
-                        const size_t pad) {
-  assert(nmea_payload);
+ais8_1_13_append_pydict(const Ais8_1_13 &msg, PyObject *dict) {
   assert(dict);
-  assert(pad < 6);
-  Ais8_1_13 msg(nmea_payload, pad);
   if (msg.had_error()) {
     return msg.get_error();
   }
 
-  DictSafeSetItem(dict, "reason", msg.reason);
-  DictSafeSetItem(dict, "location_from", msg.location_from);
-  DictSafeSetItem(dict, "location_to", msg.location_to);
-  DictSafeSetItem(dict, "radius", msg.radius);
-  DictSafeSetItem(dict, "units", msg.units);
-  DictSafeSetItem(dict, "day_from", msg.day_from);
-  DictSafeSetItem(dict, "month_from", msg.month_from);
-  DictSafeSetItem(dict, "hour_from", msg.hour_from);
-  DictSafeSetItem(dict, "minute_from", msg.minute_from);
-  DictSafeSetItem(dict, "day_to", msg.day_to);
-  DictSafeSetItem(dict, "month_to", msg.month_to);
-  DictSafeSetItem(dict, "hour_to", msg.hour_to);
-  DictSafeSetItem(dict, "minute_to", msg.minute_to);
-  DictSafeSetItem(dict, "spare2", msg.spare2);
+  DictSafeSetItem(dict, "reason"_key, msg.reason);
+  DictSafeSetItem(dict, "location_from"_key, msg.location_from);
+  DictSafeSetItem(dict, "location_to"_key, msg.location_to);
+  DictSafeSetItem(dict, "radius"_key, msg.radius);
+  DictSafeSetItem(dict, "units"_key, msg.units);
+  DictSafeSetItem(dict, "day_from"_key, msg.day_from);
+  DictSafeSetItem(dict, "month_from"_key, msg.month_from);
+  DictSafeSetItem(dict, "hour_from"_key, msg.hour_from);
+  DictSafeSetItem(dict, "minute_from"_key, msg.minute_from);
+  DictSafeSetItem(dict, "day_to"_key, msg.day_to);
+  DictSafeSetItem(dict, "month_to"_key, msg.month_to);
+  DictSafeSetItem(dict, "hour_to"_key, msg.hour_to);
+  DictSafeSetItem(dict, "minute_to"_key, msg.minute_to);
+  DictSafeSetItem(dict, "spare2"_key, msg.spare2);
 
   return AIS_OK;
 }
@@ -916,46 +863,34 @@ ais8_1_13_append_pydict(const char *nmea_payload, PyObject *dict,
 // 14 is addressed
 
 AIS_STATUS
-ais8_1_15_append_pydict(const char *nmea_payload, PyObject *dict,
-                        const size_t pad) {
-  assert(nmea_payload);
+ais8_1_15_append_pydict(const Ais8_1_15 &msg, PyObject *dict) {
   assert(dict);
-  assert(pad < 6);
-  Ais8_1_15 msg(nmea_payload, pad);
   if (msg.had_error()) {
     return msg.get_error();
   }
 
-  DictSafeSetItem(dict, "air_draught", msg.air_draught);
-  DictSafeSetItem(dict, "spare2", msg.spare2);
+  DictSafeSetItem(dict, "air_draught"_key, msg.air_draught);
+  DictSafeSetItem(dict, "spare2"_key, msg.spare2);
   return AIS_OK;
 }
 
 
 AIS_STATUS
-ais8_1_16_append_pydict(const char *nmea_payload, PyObject *dict,
-                        const size_t pad) {
-  assert(nmea_payload);
+ais8_1_16_append_pydict(const Ais8_1_16 &msg, PyObject *dict) {
   assert(dict);
-  assert(pad < 6);
-  Ais8_1_16 msg(nmea_payload, pad);
   if (msg.had_error()) {
     return msg.get_error();
   }
 
-  DictSafeSetItem(dict, "persons", msg.persons);
-  DictSafeSetItem(dict, "spare2", msg.spare2);
+  DictSafeSetItem(dict, "persons"_key, msg.persons);
+  DictSafeSetItem(dict, "spare2"_key, msg.spare2);
   return AIS_OK;
 }
 
 
 AIS_STATUS
-ais8_1_17_append_pydict(const char *nmea_payload, PyObject *dict,
-                        const size_t pad) {
-  assert(nmea_payload);
+ais8_1_17_append_pydict(const Ais8_1_17 &msg, PyObject *dict) {
   assert(dict);
-  assert(pad < 6);
-  const Ais8_1_17 msg(nmea_payload, pad);
   if (msg.had_error()) {
     return msg.get_error();
   }
@@ -963,16 +898,16 @@ ais8_1_17_append_pydict(const char *nmea_payload, PyObject *dict,
   PyObject *target_list = PyList_New(msg.targets.size());
   for (size_t target_num = 0; target_num < msg.targets.size(); target_num++) {
     PyObject *target = PyDict_New();
-    DictSafeSetItem(target, "type", msg.targets[target_num].type);
-    DictSafeSetItem(target, "id", msg.targets[target_num].id);
-    DictSafeSetItem(target, "spare", msg.targets[target_num].spare);
-    DictSafeSetItem(target, "x", "y", msg.targets[target_num].position);
-    DictSafeSetItem(target, "cog", msg.targets[target_num].cog);
-    DictSafeSetItem(target, "timestamp", msg.targets[target_num].timestamp);
-    DictSafeSetItem(target, "sog", msg.targets[target_num].sog);
+    DictSafeSetItem(target, "type"_key, msg.targets[target_num].type);
+    DictSafeSetItem(target, "id"_key, msg.targets[target_num].id);
+    DictSafeSetItem(target, "spare"_key, msg.targets[target_num].spare);
+    DictSafeSetItem(target, "x"_key, "y"_key, msg.targets[target_num].position);
+    DictSafeSetItem(target, "cog"_key, msg.targets[target_num].cog);
+    DictSafeSetItem(target, "timestamp"_key, msg.targets[target_num].timestamp);
+    DictSafeSetItem(target, "sog"_key, msg.targets[target_num].sog);
     PyList_SetItem(target_list, target_num, target);
   }
-  PyDict_SetItemString(dict, "targets", target_list);
+  DictSafeSetItem(dict, "targets"_key, target_list);
   Py_DECREF(target_list);
 
   return AIS_OK;
@@ -981,28 +916,24 @@ ais8_1_17_append_pydict(const char *nmea_payload, PyObject *dict,
 // 18 is addressed only
 
 AIS_STATUS
-ais8_1_19_append_pydict(const char *nmea_payload, PyObject *dict,
-                        const size_t pad) {
-  assert(nmea_payload);
+ais8_1_19_append_pydict(const Ais8_1_19 &msg, PyObject *dict) {
   assert(dict);
-  assert(pad < 6);
-  Ais8_1_19 msg(nmea_payload, pad);
   if (msg.had_error()) {
     return msg.get_error();
   }
 
-  DictSafeSetItem(dict, "link_id", msg.link_id);
-  DictSafeSetItem(dict, "name", msg.name);
-  DictSafeSetItem(dict, "x", "y", msg.position);
-  DictSafeSetItem(dict, "status", msg.status);
-  DictSafeSetItem(dict, "signal", msg.signal);
-  DictSafeSetItem(dict, "utc_hour_next", msg.utc_hour_next);
-  DictSafeSetItem(dict, "utc_min_next", msg.utc_min_next);
-  DictSafeSetItem(dict, "next_signal", msg.next_signal);
-  DictSafeSetItem(dict, "spare2_0", msg.spare2[0]);
-  DictSafeSetItem(dict, "spare2_1", msg.spare2[1]);
-  DictSafeSetItem(dict, "spare2_2", msg.spare2[2]);
-  DictSafeSetItem(dict, "spare2_3", msg.spare2[3]);
+  DictSafeSetItem(dict, "link_id"_key, msg.link_id);
+  DictSafeSetItem(dict, "name"_key, msg.name);
+  DictSafeSetItem(dict, "x"_key, "y"_key, msg.position);
+  DictSafeSetItem(dict, "status"_key, msg.status);
+  DictSafeSetItem(dict, "signal"_key, msg.signal);
+  DictSafeSetItem(dict, "utc_hour_next"_key, msg.utc_hour_next);
+  DictSafeSetItem(dict, "utc_min_next"_key, msg.utc_min_next);
+  DictSafeSetItem(dict, "next_signal"_key, msg.next_signal);
+  DictSafeSetItem(dict, "spare2_0"_key, msg.spare2[0]);
+  DictSafeSetItem(dict, "spare2_1"_key, msg.spare2[1]);
+  DictSafeSetItem(dict, "spare2_2"_key, msg.spare2[2]);
+  DictSafeSetItem(dict, "spare2_3"_key, msg.spare2[3]);
 
   return AIS_OK;
 }
@@ -1010,86 +941,85 @@ ais8_1_19_append_pydict(const char *nmea_payload, PyObject *dict,
 // 20 is addressed
 
 AIS_STATUS
-ais8_1_21_append_pydict(const char *nmea_payload, PyObject *dict,
-                        const size_t pad) {
-  assert(nmea_payload);
+ais8_1_21_append_pydict(const Ais8_1_21 &msg, PyObject *dict) {
   assert(dict);
-  assert(pad < 6);
-  Ais8_1_21 msg(nmea_payload, pad);
   if (msg.had_error()) {
     return msg.get_error();
   }
 
-  DictSafeSetItem(dict, "x", "y", msg.position);
-  DictSafeSetItem(dict, "utc_day", msg.utc_day);
-  DictSafeSetItem(dict, "utc_hour", msg.utc_hour);
-  DictSafeSetItem(dict, "utc_min", msg.utc_min);
+  DictSafeSetItem(dict, "x"_key, "y"_key, msg.position);
+  DictSafeSetItem(dict, "utc_day"_key, msg.utc_day);
+  DictSafeSetItem(dict, "utc_hour"_key, msg.utc_hour);
+  DictSafeSetItem(dict, "utc_min"_key, msg.utc_min);
 
   if (0 == msg.type_wx_report) {
     // WX obs from ship
-    DictSafeSetItem(dict, "location", msg.location);
-    DictSafeSetItem(dict, "wx", msg.wx[0]);  // TODO(schwehr) Rename present?
-    DictSafeSetItem(dict, "horz_viz", msg.horz_viz);
-    DictSafeSetItem(dict, "humidity", msg.humidity);
-    DictSafeSetItem(dict, "wind_speed", msg.wind_speed);
-    DictSafeSetItem(dict, "wind_dir", msg.wind_dir);
-    DictSafeSetItem(dict, "pressure", msg.pressure);
-    DictSafeSetItem(dict, "pressure_tendency", msg.pressure_tendency);
-    DictSafeSetItem(dict, "air_temp", msg.air_temp);
-    DictSafeSetItem(dict, "water_temp", msg.water_temp);
-    DictSafeSetItem(dict, "wave_period", msg.wave_period);
-    DictSafeSetItem(dict, "wave_height", msg.wave_height);
-    DictSafeSetItem(dict, "wave_dir", msg.wave_dir);
-    DictSafeSetItem(dict, "swell_height", msg.swell_height);
-    DictSafeSetItem(dict, "swell_dir", msg.swell_dir);
-    DictSafeSetItem(dict, "swell_period", msg.swell_period);
-    DictSafeSetItem(dict, "spare2", msg.spare2);
+    DictSafeSetItem(dict, "location"_key, msg.location);
+    // TODO(schwehr) Rename present?
+    DictSafeSetItem(dict, "wx"_key, msg.wx[0]);
+    DictSafeSetItem(dict, "horz_viz"_key, msg.horz_viz);
+    DictSafeSetItem(dict, "humidity"_key, msg.humidity);
+    DictSafeSetItem(dict, "wind_speed"_key, msg.wind_speed);
+    DictSafeSetItem(dict, "wind_dir"_key, msg.wind_dir);
+    DictSafeSetItem(dict, "pressure"_key, msg.pressure);
+    DictSafeSetItem(dict, "pressure_tendency"_key, msg.pressure_tendency);
+    DictSafeSetItem(dict, "air_temp"_key, msg.air_temp);
+    DictSafeSetItem(dict, "water_temp"_key, msg.water_temp);
+    DictSafeSetItem(dict, "wave_period"_key, msg.wave_period);
+    DictSafeSetItem(dict, "wave_height"_key, msg.wave_height);
+    DictSafeSetItem(dict, "wave_dir"_key, msg.wave_dir);
+    DictSafeSetItem(dict, "swell_height"_key, msg.swell_height);
+    DictSafeSetItem(dict, "swell_dir"_key, msg.swell_dir);
+    DictSafeSetItem(dict, "swell_period"_key, msg.swell_period);
+    DictSafeSetItem(dict, "spare2"_key, msg.spare2);
   } else {
     // type == 1
     // WMO OBS from ship
-    DictSafeSetItem(dict, "utc_month", msg.utc_month);
-    DictSafeSetItem(dict, "cog", msg.cog);
-    DictSafeSetItem(dict, "sog", msg.sog);
-    DictSafeSetItem(dict, "heading", msg.heading);
-    DictSafeSetItem(dict, "pressure", msg.pressure);
-    DictSafeSetItem(dict, "rel_pressure", msg.rel_pressure);
-    DictSafeSetItem(dict, "pressure_tendency", msg.pressure_tendency);
-    DictSafeSetItem(dict, "wind_dir", msg.wind_dir);
-    DictSafeSetItem(dict, "wind_speed_ms", msg.wind_speed_ms);
-    DictSafeSetItem(dict, "wind_dir_rel", msg.wind_dir_rel);
-    DictSafeSetItem(dict, "wind_speed_rel", msg.wind_speed_rel);
-    DictSafeSetItem(dict, "wind_gust_speed", msg.wind_gust_speed);
-    DictSafeSetItem(dict, "wind_gust_dir", msg.wind_gust_dir);
-    DictSafeSetItem(dict, "air_temp_raw", msg.air_temp_raw);
-    DictSafeSetItem(dict, "humidity", msg.humidity);
-    DictSafeSetItem(dict, "water_temp_raw", msg.water_temp_raw);
-    DictSafeSetItem(dict, "horz_viz", msg.horz_viz);
+    DictSafeSetItem(dict, "utc_month"_key, msg.utc_month);
+    DictSafeSetItem(dict, "cog"_key, msg.cog);
+    DictSafeSetItem(dict, "sog"_key, msg.sog);
+    DictSafeSetItem(dict, "heading"_key, msg.heading);
+    DictSafeSetItem(dict, "pressure"_key, msg.pressure);
+    DictSafeSetItem(dict, "rel_pressure"_key, msg.rel_pressure);
+    DictSafeSetItem(dict, "pressure_tendency"_key, msg.pressure_tendency);
+    DictSafeSetItem(dict, "wind_dir"_key, msg.wind_dir);
+    DictSafeSetItem(dict, "wind_speed_ms"_key, msg.wind_speed_ms);
+    DictSafeSetItem(dict, "wind_dir_rel"_key, msg.wind_dir_rel);
+    DictSafeSetItem(dict, "wind_speed_rel"_key, msg.wind_speed_rel);
+    DictSafeSetItem(dict, "wind_gust_speed"_key, msg.wind_gust_speed);
+    DictSafeSetItem(dict, "wind_gust_dir"_key, msg.wind_gust_dir);
+    DictSafeSetItem(dict, "air_temp_raw"_key, msg.air_temp_raw);
+    DictSafeSetItem(dict, "humidity"_key, msg.humidity);
+    DictSafeSetItem(dict, "water_temp_raw"_key, msg.water_temp_raw);
+    DictSafeSetItem(dict, "horz_viz"_key, msg.horz_viz);
     // TODO(schwehr): list?
-    DictSafeSetItem(dict, "wx", msg.wx[0]);
-    DictSafeSetItem(dict, "wx_next1", msg.wx[1]);
-    DictSafeSetItem(dict, "wx_next2", msg.wx[2]);
-    DictSafeSetItem(dict, "cloud_total", msg.cloud_total);
-    DictSafeSetItem(dict, "cloud_low", msg.cloud_low);
-    DictSafeSetItem(dict, "cloud_low_type", msg.cloud_low_type);
-    DictSafeSetItem(dict, "cloud_middle_type", msg.cloud_middle_type);
-    DictSafeSetItem(dict, "cloud_high_type", msg.cloud_high_type);
-    DictSafeSetItem(dict, "alt_lowest_cloud_base", msg.alt_lowest_cloud_base);
-    DictSafeSetItem(dict, "wave_period", msg.wave_period);
-    DictSafeSetItem(dict, "wave_height", msg.wave_height);
-    DictSafeSetItem(dict, "swell_dir", msg.swell_dir);
-    DictSafeSetItem(dict, "swell_period", msg.swell_period);
-    DictSafeSetItem(dict, "swell_height", msg.swell_height);
-    DictSafeSetItem(dict, "swell_dir_2", msg.swell_dir_2);
-    DictSafeSetItem(dict, "swell_period_2", msg.swell_period_2);
-    DictSafeSetItem(dict, "swell_height_2", msg.swell_height_2);
-    DictSafeSetItem(dict, "ice_thickness", msg.ice_thickness);
-    DictSafeSetItem(dict, "ice_accretion", msg.ice_accretion);
-    DictSafeSetItem(dict, "ice_accretion_cause", msg.ice_accretion_cause);
-    DictSafeSetItem(dict, "sea_ice_concentration", msg.sea_ice_concentration);
-    DictSafeSetItem(dict, "amt_type_ice", msg.amt_type_ice);
-    DictSafeSetItem(dict, "ice_situation", msg.ice_situation);
-    DictSafeSetItem(dict, "ice_devel", msg.ice_devel);
-    DictSafeSetItem(dict, "bearing_ice_edge", msg.bearing_ice_edge);
+    DictSafeSetItem(dict, "wx"_key, msg.wx[0]);
+    DictSafeSetItem(dict, "wx_next1"_key, msg.wx[1]);
+    DictSafeSetItem(dict, "wx_next2"_key, msg.wx[2]);
+    DictSafeSetItem(dict, "cloud_total"_key, msg.cloud_total);
+    DictSafeSetItem(dict, "cloud_low"_key, msg.cloud_low);
+    DictSafeSetItem(dict, "cloud_low_type"_key, msg.cloud_low_type);
+    DictSafeSetItem(dict, "cloud_middle_type"_key, msg.cloud_middle_type);
+    DictSafeSetItem(dict, "cloud_high_type"_key, msg.cloud_high_type);
+    DictSafeSetItem(dict, "alt_lowest_cloud_base"_key,
+                    msg.alt_lowest_cloud_base);
+    DictSafeSetItem(dict, "wave_period"_key, msg.wave_period);
+    DictSafeSetItem(dict, "wave_height"_key, msg.wave_height);
+    DictSafeSetItem(dict, "swell_dir"_key, msg.swell_dir);
+    DictSafeSetItem(dict, "swell_period"_key, msg.swell_period);
+    DictSafeSetItem(dict, "swell_height"_key, msg.swell_height);
+    DictSafeSetItem(dict, "swell_dir_2"_key, msg.swell_dir_2);
+    DictSafeSetItem(dict, "swell_period_2"_key, msg.swell_period_2);
+    DictSafeSetItem(dict, "swell_height_2"_key, msg.swell_height_2);
+    DictSafeSetItem(dict, "ice_thickness"_key, msg.ice_thickness);
+    DictSafeSetItem(dict, "ice_accretion"_key, msg.ice_accretion);
+    DictSafeSetItem(dict, "ice_accretion_cause"_key, msg.ice_accretion_cause);
+    DictSafeSetItem(dict, "sea_ice_concentration"_key,
+                    msg.sea_ice_concentration);
+    DictSafeSetItem(dict, "amt_type_ice"_key, msg.amt_type_ice);
+    DictSafeSetItem(dict, "ice_situation"_key, msg.ice_situation);
+    DictSafeSetItem(dict, "ice_devel"_key, msg.ice_devel);
+    DictSafeSetItem(dict, "bearing_ice_edge"_key, msg.bearing_ice_edge);
   }
 
   return AIS_OK;
@@ -1097,23 +1027,21 @@ ais8_1_21_append_pydict(const char *nmea_payload, PyObject *dict,
 
 
 AIS_STATUS
-ais8_1_22_append_pydict(const char *nmea_payload, PyObject *dict,
-                        const size_t pad) {
-  Ais8_1_22 msg(nmea_payload, pad);
+ais8_1_22_append_pydict(const Ais8_1_22 &msg, PyObject *dict) {
   if (msg.had_error()) {
     return msg.get_error();
   }
 
-  DictSafeSetItem(dict, "link_id", msg.link_id);
-  DictSafeSetItem(dict, "notice_type", msg.notice_type);
-  DictSafeSetItem(dict, "notice_type_str",
+  DictSafeSetItem(dict, "link_id"_key, msg.link_id);
+  DictSafeSetItem(dict, "notice_type"_key, msg.notice_type);
+  DictSafeSetItem(dict, "notice_type_str"_key,
                   ais8_1_22_notice_names[msg.notice_type]);
 
-  DictSafeSetItem(dict, "month", msg.month);
-  DictSafeSetItem(dict, "day", msg.day);
-  DictSafeSetItem(dict, "hour", msg.hour);
-  DictSafeSetItem(dict, "minute", msg.minute);
-  DictSafeSetItem(dict, "duration_minutes", msg.minute);
+  DictSafeSetItem(dict, "month"_key, msg.month);
+  DictSafeSetItem(dict, "day"_key, msg.day);
+  DictSafeSetItem(dict, "hour"_key, msg.hour);
+  DictSafeSetItem(dict, "minute"_key, msg.minute);
+  DictSafeSetItem(dict, "duration_minutes"_key, msg.minute);
 
   PyObject *sub_area_list = PyList_New(msg.sub_areas.size());
 
@@ -1127,15 +1055,15 @@ ais8_1_22_append_pydict(const char *nmea_payload, PyObject *dict,
             dynamic_cast<Ais8_1_22_Circle*>(msg.sub_areas[i].get());
         assert(c != nullptr);
 
-        DictSafeSetItem(sub_area, "sub_area_type", AIS8_1_22_SHAPE_CIRCLE);
+        DictSafeSetItem(sub_area, "sub_area_type"_key, AIS8_1_22_SHAPE_CIRCLE);
         if (c->radius_m == 0)
-          DictSafeSetItem(sub_area, "sub_area_type_str", "point");
+          DictSafeSetItem(sub_area, "sub_area_type_str"_key, "point");
         else
-          DictSafeSetItem(sub_area, "sub_area_type_str", "circle");
+          DictSafeSetItem(sub_area, "sub_area_type_str"_key, "circle");
 
-        DictSafeSetItem(sub_area, "x", "y", c->position);
-        DictSafeSetItem(sub_area, "precision", c->precision);
-        DictSafeSetItem(sub_area, "radius", c->radius_m);
+        DictSafeSetItem(sub_area, "x"_key, "y"_key, c->position);
+        DictSafeSetItem(sub_area, "precision"_key, c->precision);
+        DictSafeSetItem(sub_area, "radius"_key, c->radius_m);
         // TODO(schwehr): spare?
         PyList_SetItem(sub_area_list, i, sub_area);
       }
@@ -1147,14 +1075,14 @@ ais8_1_22_append_pydict(const char *nmea_payload, PyObject *dict,
             dynamic_cast<Ais8_1_22_Rect*>(msg.sub_areas[i].get());
         assert(c != nullptr);
 
-        DictSafeSetItem(sub_area, "sub_area_type", AIS8_1_22_SHAPE_RECT);
-        DictSafeSetItem(sub_area, "sub_area_type_str", "rect");
+        DictSafeSetItem(sub_area, "sub_area_type"_key, AIS8_1_22_SHAPE_RECT);
+        DictSafeSetItem(sub_area, "sub_area_type_str"_key, "rect");
 
-        DictSafeSetItem(sub_area, "x", "y", c->position);
-        DictSafeSetItem(sub_area, "precision", c->precision);
-        DictSafeSetItem(sub_area, "e_dim_m", c->e_dim_m);
-        DictSafeSetItem(sub_area, "n_dim_m", c->n_dim_m);
-        DictSafeSetItem(sub_area, "orient_deg", c->orient_deg);
+        DictSafeSetItem(sub_area, "x"_key, "y"_key, c->position);
+        DictSafeSetItem(sub_area, "precision"_key, c->precision);
+        DictSafeSetItem(sub_area, "e_dim_m"_key, c->e_dim_m);
+        DictSafeSetItem(sub_area, "n_dim_m"_key, c->n_dim_m);
+        DictSafeSetItem(sub_area, "orient_deg"_key, c->orient_deg);
         // TODO(schwehr): spare?
         PyList_SetItem(sub_area_list, i, sub_area);
       }
@@ -1166,14 +1094,14 @@ ais8_1_22_append_pydict(const char *nmea_payload, PyObject *dict,
             dynamic_cast<Ais8_1_22_Sector*>(msg.sub_areas[i].get());
         assert(c != nullptr);
 
-        DictSafeSetItem(sub_area, "sub_area_type", AIS8_1_22_SHAPE_SECTOR);
-        DictSafeSetItem(sub_area, "sub_area_type_str", "sector");
+        DictSafeSetItem(sub_area, "sub_area_type"_key, AIS8_1_22_SHAPE_SECTOR);
+        DictSafeSetItem(sub_area, "sub_area_type_str"_key, "sector");
 
-        DictSafeSetItem(sub_area, "x", "y", c->position);
-        DictSafeSetItem(sub_area, "precision", c->precision);
-        DictSafeSetItem(sub_area, "radius", c->radius_m);
-        DictSafeSetItem(sub_area, "left_bound_deg", c->left_bound_deg);
-        DictSafeSetItem(sub_area, "right_bound_deg", c->right_bound_deg);
+        DictSafeSetItem(sub_area, "x"_key, "y"_key, c->position);
+        DictSafeSetItem(sub_area, "precision"_key, c->precision);
+        DictSafeSetItem(sub_area, "radius"_key, c->radius_m);
+        DictSafeSetItem(sub_area, "left_bound_deg"_key, c->left_bound_deg);
+        DictSafeSetItem(sub_area, "right_bound_deg"_key, c->right_bound_deg);
         // TODO(schwehr): spare?
         PyList_SetItem(sub_area_list, i, sub_area);
       }
@@ -1185,8 +1113,9 @@ ais8_1_22_append_pydict(const char *nmea_payload, PyObject *dict,
             dynamic_cast<Ais8_1_22_Polyline*>(msg.sub_areas[i].get());
         assert(polyline != nullptr);
 
-        DictSafeSetItem(sub_area, "sub_area_type", AIS8_1_22_SHAPE_POLYLINE);
-        DictSafeSetItem(sub_area, "sub_area_type_str", "polyline");
+        DictSafeSetItem(sub_area, "sub_area_type"_key,
+                        AIS8_1_22_SHAPE_POLYLINE);
+        DictSafeSetItem(sub_area, "sub_area_type_str"_key, "polyline");
         assert(polyline->angles.size() == polyline->dists_m.size());
         PyObject *angle_list = PyList_New(polyline->angles.size());
         PyObject *dist_list = PyList_New(polyline->angles.size());
@@ -1198,8 +1127,8 @@ ais8_1_22_append_pydict(const char *nmea_payload, PyObject *dict,
                          PyFloat_FromDouble(polyline->dists_m[pt_num]));
         }
 
-        DictSafeSetItem(sub_area, "angles", angle_list);
-        DictSafeSetItem(sub_area, "dists_m", dist_list);
+        DictSafeSetItem(sub_area, "angles"_key, angle_list);
+        DictSafeSetItem(sub_area, "dists_m"_key, dist_list);
         Py_DECREF(angle_list);
         Py_DECREF(dist_list);
 
@@ -1214,8 +1143,8 @@ ais8_1_22_append_pydict(const char *nmea_payload, PyObject *dict,
             dynamic_cast<Ais8_1_22_Polygon*>(msg.sub_areas[i].get());
         assert(polygon != nullptr);
 
-        DictSafeSetItem(sub_area, "sub_area_type", AIS8_1_22_SHAPE_POLYGON);
-        DictSafeSetItem(sub_area, "sub_area_type_str", "polygon");
+        DictSafeSetItem(sub_area, "sub_area_type"_key, AIS8_1_22_SHAPE_POLYGON);
+        DictSafeSetItem(sub_area, "sub_area_type_str"_key, "polygon");
         assert(polygon->angles.size() == polygon->dists_m.size());
         PyObject *angle_list = PyList_New(polygon->angles.size());
         PyObject *dist_list = PyList_New(polygon->angles.size());
@@ -1227,8 +1156,8 @@ ais8_1_22_append_pydict(const char *nmea_payload, PyObject *dict,
                          PyFloat_FromDouble(polygon->dists_m[pt_num]));
         }
 
-        DictSafeSetItem(sub_area, "angles", angle_list);
-        DictSafeSetItem(sub_area, "dists_m", dist_list);
+        DictSafeSetItem(sub_area, "angles"_key, angle_list);
+        DictSafeSetItem(sub_area, "dists_m"_key, dist_list);
         Py_DECREF(angle_list);
         Py_DECREF(dist_list);
 
@@ -1244,10 +1173,10 @@ ais8_1_22_append_pydict(const char *nmea_payload, PyObject *dict,
             dynamic_cast<Ais8_1_22_Text*>(msg.sub_areas[i].get());
         assert(text != nullptr);
 
-        DictSafeSetItem(sub_area, "sub_area_type", AIS8_1_22_SHAPE_TEXT);
-        DictSafeSetItem(sub_area, "sub_area_type_str", "text");
+        DictSafeSetItem(sub_area, "sub_area_type"_key, AIS8_1_22_SHAPE_TEXT);
+        DictSafeSetItem(sub_area, "sub_area_type_str"_key, "text");
 
-        DictSafeSetItem(sub_area, "text", text->text);
+        DictSafeSetItem(sub_area, "text"_key, text->text);
         PyList_SetItem(sub_area_list, i, sub_area);
       }
       break;
@@ -1256,7 +1185,7 @@ ais8_1_22_append_pydict(const char *nmea_payload, PyObject *dict,
       {}  // TODO(schwehr): Mark an unknown subarea or raise an exception.
     }
   }
-  DictSafeSetItem(dict, "sub_areas", sub_area_list);
+  DictSafeSetItem(dict, "sub_areas"_key, sub_area_list);
   Py_DECREF(sub_area_list);
 
   return AIS_OK;
@@ -1267,19 +1196,15 @@ ais8_1_22_append_pydict(const char *nmea_payload, PyObject *dict,
 
 // IMO Circ 289 - Extended ship static and voyage-related
 AIS_STATUS
-ais8_1_24_append_pydict(const char *nmea_payload, PyObject *dict,
-                        const size_t pad) {
-  assert(nmea_payload);
+ais8_1_24_append_pydict(const Ais8_1_24 &msg, PyObject *dict) {
   assert(dict);
-  assert(pad < 6);
-  Ais8_1_24 msg(nmea_payload, pad);
   if (msg.had_error()) {
     return msg.get_error();
   }
 
-  DictSafeSetItem(dict, "link_id", msg.link_id);
-  DictSafeSetItem(dict, "air_draught", msg.air_draught);
-  DictSafeSetItem(dict, "last_port", msg.last_port);
+  DictSafeSetItem(dict, "link_id"_key, msg.link_id);
+  DictSafeSetItem(dict, "air_draught"_key, msg.air_draught);
+  DictSafeSetItem(dict, "last_port"_key, msg.last_port);
 
   PyObject *port_list = PyList_New(2);
   PyList_SetItem(port_list, 0, PyUnicode_FromString(msg.next_ports[0].c_str()));
@@ -1290,22 +1215,22 @@ ais8_1_24_append_pydict(const char *nmea_payload, PyObject *dict,
     PyObject *solas = PyLong_FromLong(msg.solas_status[solas_num]);
     PyList_SetItem(solas_list, solas_num, solas);
   }
-  DictSafeSetItem(dict, "port_list", port_list);
+  DictSafeSetItem(dict, "port_list"_key, port_list);
   Py_DECREF(port_list);
-  DictSafeSetItem(dict, "solas", solas_list);
+  DictSafeSetItem(dict, "solas"_key, solas_list);
   Py_DECREF(solas_list);
-  DictSafeSetItem(dict, "ice_class", msg.ice_class);
-  DictSafeSetItem(dict, "shaft_power", msg.shaft_power);
-  DictSafeSetItem(dict, "vhf", msg.vhf);
-  DictSafeSetItem(dict, "lloyds_ship_type", msg.lloyds_ship_type);
-  DictSafeSetItem(dict, "gross_tonnage", msg.gross_tonnage);
-  DictSafeSetItem(dict, "laden_ballast", msg.laden_ballast);
-  DictSafeSetItem(dict, "heavy_oil", msg.heavy_oil);
-  DictSafeSetItem(dict, "light_oil", msg.light_oil);
-  DictSafeSetItem(dict, "diesel", msg.diesel);
-  DictSafeSetItem(dict, "bunker_oil", msg.bunker_oil);
-  DictSafeSetItem(dict, "persons", msg.persons);
-  DictSafeSetItem(dict, "spare2", msg.spare2);
+  DictSafeSetItem(dict, "ice_class"_key, msg.ice_class);
+  DictSafeSetItem(dict, "shaft_power"_key, msg.shaft_power);
+  DictSafeSetItem(dict, "vhf"_key, msg.vhf);
+  DictSafeSetItem(dict, "lloyds_ship_type"_key, msg.lloyds_ship_type);
+  DictSafeSetItem(dict, "gross_tonnage"_key, msg.gross_tonnage);
+  DictSafeSetItem(dict, "laden_ballast"_key, msg.laden_ballast);
+  DictSafeSetItem(dict, "heavy_oil"_key, msg.heavy_oil);
+  DictSafeSetItem(dict, "light_oil"_key, msg.light_oil);
+  DictSafeSetItem(dict, "diesel"_key, msg.diesel);
+  DictSafeSetItem(dict, "bunker_oil"_key, msg.bunker_oil);
+  DictSafeSetItem(dict, "persons"_key, msg.persons);
+  DictSafeSetItem(dict, "spare2"_key, msg.spare2);
 
   return AIS_OK;
 }
@@ -1318,11 +1243,11 @@ ais8_1_26_append_pydict_sensor_hdr(PyObject *dict,
                                    Ais8_1_26_SensorReport* rpt) {
   assert(dict);
   assert(rpt);
-  DictSafeSetItem(dict, "report_type", rpt->report_type);
-  DictSafeSetItem(dict, "utc_day", rpt->utc_day);
-  DictSafeSetItem(dict, "utc_hr", rpt->utc_hr);
-  DictSafeSetItem(dict, "utc_min", rpt->utc_min);
-  DictSafeSetItem(dict, "site_id", rpt->site_id);
+  DictSafeSetItem(dict, "report_type"_key, rpt->report_type);
+  DictSafeSetItem(dict, "utc_day"_key, rpt->utc_day);
+  DictSafeSetItem(dict, "utc_hr"_key, rpt->utc_hr);
+  DictSafeSetItem(dict, "utc_min"_key, rpt->utc_min);
+  DictSafeSetItem(dict, "site_id"_key, rpt->site_id);
 
   return AIS_OK;
 }
@@ -1330,18 +1255,14 @@ ais8_1_26_append_pydict_sensor_hdr(PyObject *dict,
 
 // IMO Circ 289 - Environmental
 AIS_STATUS
-ais8_1_26_append_pydict(const char *nmea_payload, PyObject *dict,
-                        const size_t pad) {
-  assert(nmea_payload);
+ais8_1_26_append_pydict(const Ais8_1_26 &msg, PyObject *dict) {
   assert(dict);
-  assert(pad < 6);
-  const Ais8_1_26 msg(nmea_payload, pad);
   if (msg.had_error()) {
     return msg.get_error();
   }
 
   PyObject *rpt_list = PyList_New(msg.reports.size());
-  DictSafeSetItem(dict, "reports", rpt_list);
+  DictSafeSetItem(dict, "reports"_key, rpt_list);
 
   for (size_t rpt_num = 0; rpt_num < msg.reports.size(); rpt_num++) {
     PyObject *rpt_dict = PyDict_New();
@@ -1354,73 +1275,80 @@ ais8_1_26_append_pydict(const char *nmea_payload, PyObject *dict,
         Ais8_1_26_Location *rpt =
             reinterpret_cast<Ais8_1_26_Location *>(msg.reports[rpt_num]);
         ais8_1_26_append_pydict_sensor_hdr(rpt_dict, rpt);
-        DictSafeSetItem(rpt_dict, "x", "y", rpt->position);
-        DictSafeSetItem(rpt_dict, "z", rpt->z);
-        DictSafeSetItem(rpt_dict, "owner", rpt->owner);
-        DictSafeSetItem(rpt_dict, "timeout", rpt->timeout);
-        DictSafeSetItem(rpt_dict, "spare", rpt->spare);
+        DictSafeSetItem(rpt_dict, "x"_key, "y"_key, rpt->position);
+        DictSafeSetItem(rpt_dict, "z"_key, rpt->z);
+        DictSafeSetItem(rpt_dict, "owner"_key, rpt->owner);
+        DictSafeSetItem(rpt_dict, "timeout"_key, rpt->timeout);
+        DictSafeSetItem(rpt_dict, "spare"_key, rpt->spare);
       }
       break;
     case AIS8_1_26_SENSOR_STATION:
       {
         Ais8_1_26_Station *rpt =
             reinterpret_cast<Ais8_1_26_Station *>(msg.reports[rpt_num]);
-        DictSafeSetItem(rpt_dict, "name", rpt->name);
-        DictSafeSetItem(rpt_dict, "spare", rpt->spare);
+        DictSafeSetItem(rpt_dict, "name"_key, rpt->name);
+        DictSafeSetItem(rpt_dict, "spare"_key, rpt->spare);
       }
       break;
     case AIS8_1_26_SENSOR_WIND:
       {
         Ais8_1_26_Wind *rpt =
             reinterpret_cast<Ais8_1_26_Wind *>(msg.reports[rpt_num]);
-        DictSafeSetItem(rpt_dict, "wind_speed", rpt->wind_speed);
-        DictSafeSetItem(rpt_dict, "wind_gust", rpt->wind_gust);
-        DictSafeSetItem(rpt_dict, "wind_dir", rpt->wind_dir);
-        DictSafeSetItem(rpt_dict, "wind_gust_dir", rpt->wind_gust_dir);
-        DictSafeSetItem(rpt_dict, "sensor_type", rpt->sensor_type);
-        DictSafeSetItem(rpt_dict, "wind_forecast", rpt->wind_forecast);
+        DictSafeSetItem(rpt_dict, "wind_speed"_key, rpt->wind_speed);
+        DictSafeSetItem(rpt_dict, "wind_gust"_key, rpt->wind_gust);
+        DictSafeSetItem(rpt_dict, "wind_dir"_key, rpt->wind_dir);
+        DictSafeSetItem(rpt_dict, "wind_gust_dir"_key, rpt->wind_gust_dir);
+        DictSafeSetItem(rpt_dict, "sensor_type"_key, rpt->sensor_type);
+        DictSafeSetItem(rpt_dict, "wind_forecast"_key, rpt->wind_forecast);
         DictSafeSetItem(
-            rpt_dict, "wind_gust_forecast", rpt->wind_gust_forecast);
-        DictSafeSetItem(rpt_dict, "wind_dir_forecast", rpt->wind_dir_forecast);
-        DictSafeSetItem(rpt_dict, "utc_day_forecast", rpt->utc_day_forecast);
-        DictSafeSetItem(rpt_dict, "utc_hour_forecast", rpt->utc_hour_forecast);
-        DictSafeSetItem(rpt_dict, "utc_min_forecast", rpt->utc_min_forecast);
-        DictSafeSetItem(rpt_dict, "duration", rpt->duration);
-        DictSafeSetItem(rpt_dict, "spare", rpt->spare);
+            rpt_dict, "wind_gust_forecast"_key, rpt->wind_gust_forecast);
+        DictSafeSetItem(rpt_dict, "wind_dir_forecast"_key,
+                        rpt->wind_dir_forecast);
+        DictSafeSetItem(rpt_dict, "utc_day_forecast"_key,
+                        rpt->utc_day_forecast);
+        DictSafeSetItem(rpt_dict, "utc_hour_forecast"_key,
+                        rpt->utc_hour_forecast);
+        DictSafeSetItem(rpt_dict, "utc_min_forecast"_key,
+                        rpt->utc_min_forecast);
+        DictSafeSetItem(rpt_dict, "duration"_key, rpt->duration);
+        DictSafeSetItem(rpt_dict, "spare"_key, rpt->spare);
       }
       break;
     case AIS8_1_26_SENSOR_WATER_LEVEL:
       {
         Ais8_1_26_WaterLevel *rpt =
             reinterpret_cast<Ais8_1_26_WaterLevel *>(msg.reports[rpt_num]);
-        DictSafeSetItem(rpt_dict, "type", rpt->type);
-        DictSafeSetItem(rpt_dict, "level", rpt->level);
-        DictSafeSetItem(rpt_dict, "trend", rpt->trend);
-        DictSafeSetItem(rpt_dict, "vdatum", rpt->vdatum);
-        DictSafeSetItem(rpt_dict, "sensor_type", rpt->sensor_type);
-        DictSafeSetItem(rpt_dict, "forecast_type", rpt->forecast_type);
-        DictSafeSetItem(rpt_dict, "level_forecast", rpt->level_forecast);
-        DictSafeSetItem(rpt_dict, "utc_day_forecast", rpt->utc_day_forecast);
-        DictSafeSetItem(rpt_dict, "utc_hour_forecast", rpt->utc_hour_forecast);
-        DictSafeSetItem(rpt_dict, "utc_min_forecast", rpt->utc_min_forecast);
-        DictSafeSetItem(rpt_dict, "duration", rpt->duration);
-        DictSafeSetItem(rpt_dict, "spare", rpt->spare);
+        DictSafeSetItem(rpt_dict, "type"_key, rpt->type);
+        DictSafeSetItem(rpt_dict, "level"_key, rpt->level);
+        DictSafeSetItem(rpt_dict, "trend"_key, rpt->trend);
+        DictSafeSetItem(rpt_dict, "vdatum"_key, rpt->vdatum);
+        DictSafeSetItem(rpt_dict, "sensor_type"_key, rpt->sensor_type);
+        DictSafeSetItem(rpt_dict, "forecast_type"_key, rpt->forecast_type);
+        DictSafeSetItem(rpt_dict, "level_forecast"_key, rpt->level_forecast);
+        DictSafeSetItem(rpt_dict, "utc_day_forecast"_key,
+                        rpt->utc_day_forecast);
+        DictSafeSetItem(rpt_dict, "utc_hour_forecast"_key,
+                        rpt->utc_hour_forecast);
+        DictSafeSetItem(rpt_dict, "utc_min_forecast"_key,
+                        rpt->utc_min_forecast);
+        DictSafeSetItem(rpt_dict, "duration"_key, rpt->duration);
+        DictSafeSetItem(rpt_dict, "spare"_key, rpt->spare);
       }
       break;
     case AIS8_1_26_SENSOR_CURR_2D:
       {
         Ais8_1_26_Curr2D *rpt =
             reinterpret_cast<Ais8_1_26_Curr2D *>(msg.reports[rpt_num]);
-        DictSafeSetItem(rpt_dict, "type", rpt->type);
-        DictSafeSetItem(rpt_dict, "spare", rpt->spare);
+        DictSafeSetItem(rpt_dict, "type"_key, rpt->type);
+        DictSafeSetItem(rpt_dict, "spare"_key, rpt->spare);
 
         PyObject *curr_list = PyList_New(3);
-        DictSafeSetItem(dict, "currents", curr_list);
+        DictSafeSetItem(dict, "currents"_key, curr_list);
         for (size_t idx = 0; idx < 3; idx++) {
           PyObject *curr_dict = PyDict_New();
-          DictSafeSetItem(curr_dict, "speed", rpt->currents[idx].speed);
-          DictSafeSetItem(curr_dict, "dir", rpt->currents[idx].dir);
-          DictSafeSetItem(curr_dict, "depth", rpt->currents[idx].depth);
+          DictSafeSetItem(curr_dict, "speed"_key, rpt->currents[idx].speed);
+          DictSafeSetItem(curr_dict, "dir"_key, rpt->currents[idx].dir);
+          DictSafeSetItem(curr_dict, "depth"_key, rpt->currents[idx].depth);
           PyList_SetItem(curr_list, idx, curr_dict);
         }
         Py_DECREF(curr_list);
@@ -1430,19 +1358,19 @@ ais8_1_26_append_pydict(const char *nmea_payload, PyObject *dict,
       {
         Ais8_1_26_Curr3D *rpt =
             reinterpret_cast<Ais8_1_26_Curr3D *>(msg.reports[rpt_num]);
-        DictSafeSetItem(rpt_dict, "type", rpt->type);
-        DictSafeSetItem(rpt_dict, "spare", rpt->spare);
+        DictSafeSetItem(rpt_dict, "type"_key, rpt->type);
+        DictSafeSetItem(rpt_dict, "spare"_key, rpt->spare);
 
         PyObject *curr_list = PyList_New(3);
-        DictSafeSetItem(dict, "currents", curr_list);
+        DictSafeSetItem(dict, "currents"_key, curr_list);
         for (size_t idx = 0; idx < 2; idx++) {
           // ERROR: no way to specify negative direction
           PyObject *curr_dict = PyDict_New();
           PyList_SetItem(curr_list, idx, curr_dict);
-          DictSafeSetItem(curr_dict, "north", rpt->currents[idx].north);
-          DictSafeSetItem(curr_dict, "east", rpt->currents[idx].east);
-          DictSafeSetItem(curr_dict, "up", rpt->currents[idx].up);
-          DictSafeSetItem(curr_dict, "depth", rpt->currents[idx].depth);
+          DictSafeSetItem(curr_dict, "north"_key, rpt->currents[idx].north);
+          DictSafeSetItem(curr_dict, "east"_key, rpt->currents[idx].east);
+          DictSafeSetItem(curr_dict, "up"_key, rpt->currents[idx].up);
+          DictSafeSetItem(curr_dict, "depth"_key, rpt->currents[idx].depth);
         }
         Py_DECREF(curr_list);
       }
@@ -1451,18 +1379,18 @@ ais8_1_26_append_pydict(const char *nmea_payload, PyObject *dict,
       {
         Ais8_1_26_HorzFlow *rpt =
             reinterpret_cast<Ais8_1_26_HorzFlow *>(msg.reports[rpt_num]);
-        DictSafeSetItem(rpt_dict, "spare", rpt->spare);
+        DictSafeSetItem(rpt_dict, "spare"_key, rpt->spare);
 
         PyObject *curr_list = PyList_New(3);
-        DictSafeSetItem(dict, "currents", curr_list);
+        DictSafeSetItem(dict, "currents"_key, curr_list);
         for (size_t idx = 0; idx < 2; idx++) {
           PyObject *curr_dict = PyDict_New();
           PyList_SetItem(curr_list, idx, curr_dict);
-          DictSafeSetItem(curr_dict, "bearing", rpt->currents[idx].bearing);
-          DictSafeSetItem(curr_dict, "dist", rpt->currents[idx].dist);
-          DictSafeSetItem(curr_dict, "speed", rpt->currents[idx].speed);
-          DictSafeSetItem(curr_dict, "dir", rpt->currents[idx].dir);
-          DictSafeSetItem(curr_dict, "level", rpt->currents[idx].level);
+          DictSafeSetItem(curr_dict, "bearing"_key, rpt->currents[idx].bearing);
+          DictSafeSetItem(curr_dict, "dist"_key, rpt->currents[idx].dist);
+          DictSafeSetItem(curr_dict, "speed"_key, rpt->currents[idx].speed);
+          DictSafeSetItem(curr_dict, "dir"_key, rpt->currents[idx].dir);
+          DictSafeSetItem(curr_dict, "level"_key, rpt->currents[idx].level);
         }
         Py_DECREF(curr_list);
       }
@@ -1471,67 +1399,74 @@ ais8_1_26_append_pydict(const char *nmea_payload, PyObject *dict,
       {
         Ais8_1_26_SeaState *rpt =
             reinterpret_cast<Ais8_1_26_SeaState *>(msg.reports[rpt_num]);
-        DictSafeSetItem(rpt_dict, "swell_height", rpt->swell_height);
-        DictSafeSetItem(rpt_dict, "swell_period", rpt->swell_period);
-        DictSafeSetItem(rpt_dict, "swell_dir", rpt->swell_dir);
-        DictSafeSetItem(rpt_dict, "sea_state", rpt->sea_state);
-        DictSafeSetItem(rpt_dict, "swell_sensor_type", rpt->swell_sensor_type);
-        DictSafeSetItem(rpt_dict, "water_temp", rpt->water_temp);
-        DictSafeSetItem(rpt_dict, "water_temp_depth", rpt->water_temp_depth);
-        DictSafeSetItem(rpt_dict, "water_sensor_type", rpt->water_sensor_type);
-        DictSafeSetItem(rpt_dict, "wave_height", rpt->wave_height);
-        DictSafeSetItem(rpt_dict, "wave_period", rpt->wave_period);
-        DictSafeSetItem(rpt_dict, "wave_dir", rpt->wave_dir);
-        DictSafeSetItem(rpt_dict, "wave_sensor_type", rpt->wave_sensor_type);
-        DictSafeSetItem(rpt_dict, "salinity", rpt->salinity);
+        DictSafeSetItem(rpt_dict, "swell_height"_key, rpt->swell_height);
+        DictSafeSetItem(rpt_dict, "swell_period"_key, rpt->swell_period);
+        DictSafeSetItem(rpt_dict, "swell_dir"_key, rpt->swell_dir);
+        DictSafeSetItem(rpt_dict, "sea_state"_key, rpt->sea_state);
+        DictSafeSetItem(rpt_dict, "swell_sensor_type"_key,
+                        rpt->swell_sensor_type);
+        DictSafeSetItem(rpt_dict, "water_temp"_key, rpt->water_temp);
+        DictSafeSetItem(rpt_dict, "water_temp_depth"_key,
+                        rpt->water_temp_depth);
+        DictSafeSetItem(rpt_dict, "water_sensor_type"_key,
+                        rpt->water_sensor_type);
+        DictSafeSetItem(rpt_dict, "wave_height"_key, rpt->wave_height);
+        DictSafeSetItem(rpt_dict, "wave_period"_key, rpt->wave_period);
+        DictSafeSetItem(rpt_dict, "wave_dir"_key, rpt->wave_dir);
+        DictSafeSetItem(rpt_dict, "wave_sensor_type"_key,
+                        rpt->wave_sensor_type);
+        DictSafeSetItem(rpt_dict, "salinity"_key, rpt->salinity);
       }
       break;
     case AIS8_1_26_SENSOR_SALINITY:
       {
         Ais8_1_26_Salinity *rpt =
             reinterpret_cast<Ais8_1_26_Salinity *>(msg.reports[rpt_num]);
-        DictSafeSetItem(rpt_dict, "water_temp", rpt->water_temp);
-        DictSafeSetItem(rpt_dict, "conductivity", rpt->conductivity);
-        DictSafeSetItem(rpt_dict, "pressure", rpt->pressure);
-        DictSafeSetItem(rpt_dict, "salinity", rpt->salinity);
-        DictSafeSetItem(rpt_dict, "salinity_type", rpt->salinity_type);
-        DictSafeSetItem(rpt_dict, "sensor_type", rpt->sensor_type);
-        DictSafeSetItem(rpt_dict, "spare0", rpt->spare[0]);
-        DictSafeSetItem(rpt_dict, "spare1", rpt->spare[1]);
+        DictSafeSetItem(rpt_dict, "water_temp"_key, rpt->water_temp);
+        DictSafeSetItem(rpt_dict, "conductivity"_key, rpt->conductivity);
+        DictSafeSetItem(rpt_dict, "pressure"_key, rpt->pressure);
+        DictSafeSetItem(rpt_dict, "salinity"_key, rpt->salinity);
+        DictSafeSetItem(rpt_dict, "salinity_type"_key, rpt->salinity_type);
+        DictSafeSetItem(rpt_dict, "sensor_type"_key, rpt->sensor_type);
+        DictSafeSetItem(rpt_dict, "spare0"_key, rpt->spare[0]);
+        DictSafeSetItem(rpt_dict, "spare1"_key, rpt->spare[1]);
       }
       break;
     case AIS8_1_26_SENSOR_WX:
       {
         Ais8_1_26_Wx *rpt =
             reinterpret_cast<Ais8_1_26_Wx *>(msg.reports[rpt_num]);
-        DictSafeSetItem(rpt_dict, "air_temp", rpt->air_temp);
-        DictSafeSetItem(rpt_dict, "air_temp_sensor_type",
+        DictSafeSetItem(rpt_dict, "air_temp"_key, rpt->air_temp);
+        DictSafeSetItem(rpt_dict, "air_temp_sensor_type"_key,
                         rpt->air_temp_sensor_type);
-        DictSafeSetItem(rpt_dict, "precip", rpt->precip);
-        DictSafeSetItem(rpt_dict, "horz_vis", rpt->horz_vis);
-        DictSafeSetItem(rpt_dict, "dew_point", rpt->dew_point);
-        DictSafeSetItem(rpt_dict, "dew_point_type", rpt->dew_point_type);
-        DictSafeSetItem(rpt_dict, "air_pressure", rpt->air_pressure);
-        DictSafeSetItem(rpt_dict, "air_pressure_trend",
+        DictSafeSetItem(rpt_dict, "precip"_key, rpt->precip);
+        DictSafeSetItem(rpt_dict, "horz_vis"_key, rpt->horz_vis);
+        DictSafeSetItem(rpt_dict, "dew_point"_key, rpt->dew_point);
+        DictSafeSetItem(rpt_dict, "dew_point_type"_key, rpt->dew_point_type);
+        DictSafeSetItem(rpt_dict, "air_pressure"_key, rpt->air_pressure);
+        DictSafeSetItem(rpt_dict, "air_pressure_trend"_key,
                         rpt->air_pressure_trend);
-        DictSafeSetItem(rpt_dict, "air_pressor_type", rpt->air_pressor_type);
-        DictSafeSetItem(rpt_dict, "salinity", rpt->salinity);
-        DictSafeSetItem(rpt_dict, "spare", rpt->spare);
+        DictSafeSetItem(rpt_dict, "air_pressor_type"_key,
+                        rpt->air_pressor_type);
+        DictSafeSetItem(rpt_dict, "salinity"_key, rpt->salinity);
+        DictSafeSetItem(rpt_dict, "spare"_key, rpt->spare);
       }
       break;
     case AIS8_1_26_SENSOR_AIR_DRAUGHT:
       {
         Ais8_1_26_AirDraught *rpt =
             reinterpret_cast<Ais8_1_26_AirDraught *>(msg.reports[rpt_num]);
-        DictSafeSetItem(rpt_dict, "draught", rpt->draught);
-        DictSafeSetItem(rpt_dict, "gap", rpt->gap);
-        DictSafeSetItem(rpt_dict, "forecast_gap", rpt->forecast_gap);
-        DictSafeSetItem(rpt_dict, "int trend", rpt->trend);
+        DictSafeSetItem(rpt_dict, "draught"_key, rpt->draught);
+        DictSafeSetItem(rpt_dict, "gap"_key, rpt->gap);
+        DictSafeSetItem(rpt_dict, "forecast_gap"_key, rpt->forecast_gap);
+        DictSafeSetItem(rpt_dict, "int trend"_key, rpt->trend);
         DictSafeSetItem(
-            rpt_dict, "int utc_day_forecast", rpt->utc_day_forecast);
-        DictSafeSetItem(rpt_dict, "utc_hour_forecast", rpt->utc_hour_forecast);
-        DictSafeSetItem(rpt_dict, "utc_min_forecast", rpt->utc_min_forecast);
-        DictSafeSetItem(rpt_dict, "spare", rpt->spare);
+            rpt_dict, "int utc_day_forecast"_key, rpt->utc_day_forecast);
+        DictSafeSetItem(rpt_dict, "utc_hour_forecast"_key,
+                        rpt->utc_hour_forecast);
+        DictSafeSetItem(rpt_dict, "utc_min_forecast"_key,
+                        rpt->utc_min_forecast);
+        DictSafeSetItem(rpt_dict, "spare"_key, rpt->spare);
       }
       break;
     case AIS8_1_26_SENSOR_RESERVED_11:  // FALLTHROUGH
@@ -1551,24 +1486,20 @@ ais8_1_26_append_pydict(const char *nmea_payload, PyObject *dict,
 
 // IMO Circ 289 - Route information
 AIS_STATUS
-ais8_1_27_append_pydict(const char *nmea_payload, PyObject *dict,
-                        const size_t pad) {
-  assert(nmea_payload);
+ais8_1_27_append_pydict(const Ais8_1_27 &msg, PyObject *dict) {
   assert(dict);
-  assert(pad < 6);
-  Ais8_1_27 msg(nmea_payload, pad);
   if (msg.had_error()) {
     return msg.get_error();
   }
 
-  DictSafeSetItem(dict, "link_id", msg.link_id);
-  DictSafeSetItem(dict, "sender_type", msg.sender_type);
-  DictSafeSetItem(dict, "route_type", msg.route_type);
-  DictSafeSetItem(dict, "utc_month", msg.utc_month);
-  DictSafeSetItem(dict, "utc_day", msg.utc_day);
-  DictSafeSetItem(dict, "utc_hour", msg.utc_hour);
-  DictSafeSetItem(dict, "utc_min", msg.utc_min);
-  DictSafeSetItem(dict, "duration", msg.duration);
+  DictSafeSetItem(dict, "link_id"_key, msg.link_id);
+  DictSafeSetItem(dict, "sender_type"_key, msg.sender_type);
+  DictSafeSetItem(dict, "route_type"_key, msg.route_type);
+  DictSafeSetItem(dict, "utc_month"_key, msg.utc_month);
+  DictSafeSetItem(dict, "utc_day"_key, msg.utc_day);
+  DictSafeSetItem(dict, "utc_hour"_key, msg.utc_hour);
+  DictSafeSetItem(dict, "utc_min"_key, msg.utc_min);
+  DictSafeSetItem(dict, "duration"_key, msg.duration);
 
   PyObject *waypoint_list = PyList_New(msg.waypoints.size());
   for (size_t point_num = 0; point_num < msg.waypoints.size(); point_num++) {
@@ -1580,7 +1511,7 @@ ais8_1_27_append_pydict(const char *nmea_payload, PyObject *dict,
         waypoint, 1, PyFloat_FromDouble(msg.waypoints[point_num].lat_deg));
     PyList_SetItem(waypoint_list, point_num, waypoint);
   }
-  PyDict_SetItemString(dict, "waypoints", waypoint_list);
+  DictSafeSetItem(dict, "waypoints"_key, waypoint_list);
   Py_DECREF(waypoint_list);
 
   return AIS_OK;
@@ -1591,18 +1522,14 @@ ais8_1_27_append_pydict(const char *nmea_payload, PyObject *dict,
 
 // IMO Circ 289 - Text description
 AIS_STATUS
-ais8_1_29_append_pydict(const char *nmea_payload, PyObject *dict,
-                        const size_t pad) {
-  assert(nmea_payload);
+ais8_1_29_append_pydict(const Ais8_1_29 &msg, PyObject *dict) {
   assert(dict);
-  assert(pad < 6);
-  Ais8_1_29 msg(nmea_payload, pad);
   if (msg.had_error()) {
     return msg.get_error();
   }
 
-  DictSafeSetItem(dict, "link_id", msg.link_id);
-  DictSafeSetItem(dict, "text", msg.text);
+  DictSafeSetItem(dict, "link_id"_key, msg.link_id);
+  DictSafeSetItem(dict, "text"_key, msg.text);
 
   return AIS_OK;
 }
@@ -1611,55 +1538,51 @@ ais8_1_29_append_pydict(const char *nmea_payload, PyObject *dict,
 // no 30 broadcast
 
 AIS_STATUS
-ais8_1_31_append_pydict(const char *nmea_payload, PyObject *dict,
-                        const size_t pad) {
-  assert(nmea_payload);
+ais8_1_31_append_pydict(const Ais8_1_31 &msg, PyObject *dict) {
   assert(dict);
-  assert(pad < 6);
-  Ais8_1_31 msg(nmea_payload, pad);
   if (msg.had_error()) {
     return msg.get_error();
   }
 
-  DictSafeSetItem(dict, "x", "y", msg.position);
-  DictSafeSetItem(dict, "position_accuracy", msg.position_accuracy);
-  DictSafeSetItem(dict, "utc_day", msg.utc_day);
-  DictSafeSetItem(dict, "utc_hour", msg.utc_hour);
-  DictSafeSetItem(dict, "utc_min", msg.utc_min);
-  DictSafeSetItem(dict, "wind_ave", msg.wind_ave);
-  DictSafeSetItem(dict, "wind_gust", msg.wind_gust);
-  DictSafeSetItem(dict, "wind_dir", msg.wind_dir);
-  DictSafeSetItem(dict, "wind_gust_dir", msg.wind_gust_dir);
-  DictSafeSetItem(dict, "air_temp", msg.air_temp);
-  DictSafeSetItem(dict, "rel_humid", msg.rel_humid);
-  DictSafeSetItem(dict, "dew_point", msg.dew_point);
-  DictSafeSetItem(dict, "air_pres", msg.air_pres);
-  DictSafeSetItem(dict, "air_pres_trend", msg.air_pres_trend);
-  DictSafeSetItem(dict, "horz_vis", msg.horz_vis);
-  DictSafeSetItem(dict, "water_level", msg.water_level);
-  DictSafeSetItem(dict, "water_level_trend", msg.water_level_trend);
+  DictSafeSetItem(dict, "x"_key, "y"_key, msg.position);
+  DictSafeSetItem(dict, "position_accuracy"_key, msg.position_accuracy);
+  DictSafeSetItem(dict, "utc_day"_key, msg.utc_day);
+  DictSafeSetItem(dict, "utc_hour"_key, msg.utc_hour);
+  DictSafeSetItem(dict, "utc_min"_key, msg.utc_min);
+  DictSafeSetItem(dict, "wind_ave"_key, msg.wind_ave);
+  DictSafeSetItem(dict, "wind_gust"_key, msg.wind_gust);
+  DictSafeSetItem(dict, "wind_dir"_key, msg.wind_dir);
+  DictSafeSetItem(dict, "wind_gust_dir"_key, msg.wind_gust_dir);
+  DictSafeSetItem(dict, "air_temp"_key, msg.air_temp);
+  DictSafeSetItem(dict, "rel_humid"_key, msg.rel_humid);
+  DictSafeSetItem(dict, "dew_point"_key, msg.dew_point);
+  DictSafeSetItem(dict, "air_pres"_key, msg.air_pres);
+  DictSafeSetItem(dict, "air_pres_trend"_key, msg.air_pres_trend);
+  DictSafeSetItem(dict, "horz_vis"_key, msg.horz_vis);
+  DictSafeSetItem(dict, "water_level"_key, msg.water_level);
+  DictSafeSetItem(dict, "water_level_trend"_key, msg.water_level_trend);
 
   // TODO(schwehr): make this a list of dicts
-  DictSafeSetItem(dict, "surf_cur_speed", msg.surf_cur_speed);
-  DictSafeSetItem(dict, "surf_cur_dir", msg.surf_cur_dir);
-  DictSafeSetItem(dict, "cur_speed_2", msg.cur_speed_2);
-  DictSafeSetItem(dict, "cur_dir_2", msg.cur_dir_2);
-  DictSafeSetItem(dict, "cur_depth_2", msg.cur_depth_2);
-  DictSafeSetItem(dict, "cur_speed_3", msg.cur_speed_3);
-  DictSafeSetItem(dict, "cur_dir_3", msg.cur_dir_3);
-  DictSafeSetItem(dict, "cur_depth_3", msg.cur_depth_3);
-
-  DictSafeSetItem(dict, "wave_height", msg.wave_height);
-  DictSafeSetItem(dict, "wave_period", msg.wave_period);
-  DictSafeSetItem(dict, "wave_dir", msg.wave_dir);
-  DictSafeSetItem(dict, "swell_height", msg.swell_height);
-  DictSafeSetItem(dict, "swell_period", msg.swell_period);
-  DictSafeSetItem(dict, "swell_dir", msg.swell_dir);
-  DictSafeSetItem(dict, "sea_state", msg.sea_state);
-  DictSafeSetItem(dict, "water_temp", msg.water_temp);
-  DictSafeSetItem(dict, "precip_type", msg.precip_type);
-  DictSafeSetItem(dict, "salinity", msg.salinity);
-  DictSafeSetItem(dict, "ice", msg.ice);
+  DictSafeSetItem(dict, "surf_cur_speed"_key, msg.surf_cur_speed);
+  DictSafeSetItem(dict, "surf_cur_dir"_key, msg.surf_cur_dir);
+  DictSafeSetItem(dict, "cur_speed_2"_key, msg.cur_speed_2);
+  DictSafeSetItem(dict, "cur_dir_2"_key, msg.cur_dir_2);
+  DictSafeSetItem(dict, "cur_depth_2"_key, msg.cur_depth_2);
+  DictSafeSetItem(dict, "cur_speed_3"_key, msg.cur_speed_3);
+  DictSafeSetItem(dict, "cur_dir_3"_key, msg.cur_dir_3);
+  DictSafeSetItem(dict, "cur_depth_3"_key, msg.cur_depth_3);
+
+  DictSafeSetItem(dict, "wave_height"_key, msg.wave_height);
+  DictSafeSetItem(dict, "wave_period"_key, msg.wave_period);
+  DictSafeSetItem(dict, "wave_dir"_key, msg.wave_dir);
+  DictSafeSetItem(dict, "swell_height"_key, msg.swell_height);
+  DictSafeSetItem(dict, "swell_period"_key, msg.swell_period);
+  DictSafeSetItem(dict, "swell_dir"_key, msg.swell_dir);
+  DictSafeSetItem(dict, "sea_state"_key, msg.sea_state);
+  DictSafeSetItem(dict, "water_temp"_key, msg.water_temp);
+  DictSafeSetItem(dict, "precip_type"_key, msg.precip_type);
+  DictSafeSetItem(dict, "salinity"_key, msg.salinity);
+  DictSafeSetItem(dict, "ice"_key, msg.ice);
 
   return AIS_OK;
 }
@@ -1670,27 +1593,23 @@ ais8_1_31_append_pydict(const char *nmea_payload, PyObject *dict,
 // DAC 200 - River Information System
 // Inland ship static and voyage related data
 AIS_STATUS
-ais8_200_10_append_pydict(const char *nmea_payload, PyObject *dict,
-                          const size_t pad) {
-  assert(nmea_payload);
+ais8_200_10_append_pydict(const Ais8_200_10 &msg, PyObject *dict) {
   assert(dict);
-  assert(pad < 6);
-  Ais8_200_10 msg(nmea_payload, pad);
   if (msg.had_error()) {
     return msg.get_error();
   }
 
-  DictSafeSetItem(dict, "eu_id", msg.eu_id);
-  DictSafeSetItem(dict, "length", msg.length);
-  DictSafeSetItem(dict, "beam", msg.beam);
-  DictSafeSetItem(dict, "ship_type", msg.ship_type);
-  DictSafeSetItem(dict, "haz_cargo", msg.haz_cargo);
-  DictSafeSetItem(dict, "draught", msg.draught);
-  DictSafeSetItem(dict, "loaded", msg.loaded);
-  DictSafeSetItem(dict, "speed_qual", msg.speed_qual);
-  DictSafeSetItem(dict, "course_qual", msg.course_qual);
-  DictSafeSetItem(dict, "heading_qual", msg.heading_qual);
-  DictSafeSetItem(dict, "spare2", msg.spare2);
+  DictSafeSetItem(dict, "eu_id"_key, msg.eu_id);
+  DictSafeSetItem(dict, "length"_key, msg.length);
+  DictSafeSetItem(dict, "beam"_key, msg.beam);
+  DictSafeSetItem(dict, "ship_type"_key, msg.ship_type);
+  DictSafeSetItem(dict, "haz_cargo"_key, msg.haz_cargo);
+  DictSafeSetItem(dict, "draught"_key, msg.draught);
+  DictSafeSetItem(dict, "loaded"_key, msg.loaded);
+  DictSafeSetItem(dict, "speed_qual"_key, msg.speed_qual);
+  DictSafeSetItem(dict, "course_qual"_key, msg.course_qual);
+  DictSafeSetItem(dict, "heading_qual"_key, msg.heading_qual);
+  DictSafeSetItem(dict, "spare2"_key, msg.spare2);
 
   return AIS_OK;
 }
@@ -1698,28 +1617,24 @@ ais8_200_10_append_pydict(const char *nmea_payload, PyObject *dict,
 // River Information System
 // ETA report
 AIS_STATUS
-ais8_200_21_append_pydict(const char *nmea_payload, PyObject *dict,
-                          const size_t pad) {
-  assert(nmea_payload);
+ais8_200_21_append_pydict(const Ais8_200_21 &msg, PyObject *dict) {
   assert(dict);
-  assert(pad < 6);
-  Ais8_200_21 msg(nmea_payload, pad);
   if (msg.had_error()) {
     return msg.get_error();
   }
 
-  DictSafeSetItem(dict, "country", msg.country);
-  DictSafeSetItem(dict, "location", msg.location);
-  DictSafeSetItem(dict, "section", msg.section);
-  DictSafeSetItem(dict, "terminal", msg.terminal);
-  DictSafeSetItem(dict, "hectometre", msg.hectometre);
-  DictSafeSetItem(dict, "eta_month", msg.eta_month);
-  DictSafeSetItem(dict, "eta_day", msg.eta_day);
-  DictSafeSetItem(dict, "eta_hour", msg.eta_hour);
-  DictSafeSetItem(dict, "eta_minute", msg.eta_minute);
-  DictSafeSetItem(dict, "tugboats", msg.tugboats);
-  DictSafeSetItem(dict, "air_draught", msg.air_draught);
-  DictSafeSetItem(dict, "spare2", msg.spare2);
+  DictSafeSetItem(dict, "country"_key, msg.country);
+  DictSafeSetItem(dict, "location"_key, msg.location);
+  DictSafeSetItem(dict, "section"_key, msg.section);
+  DictSafeSetItem(dict, "terminal"_key, msg.terminal);
+  DictSafeSetItem(dict, "hectometre"_key, msg.hectometre);
+  DictSafeSetItem(dict, "eta_month"_key, msg.eta_month);
+  DictSafeSetItem(dict, "eta_day"_key, msg.eta_day);
+  DictSafeSetItem(dict, "eta_hour"_key, msg.eta_hour);
+  DictSafeSetItem(dict, "eta_minute"_key, msg.eta_minute);
+  DictSafeSetItem(dict, "tugboats"_key, msg.tugboats);
+  DictSafeSetItem(dict, "air_draught"_key, msg.air_draught);
+  DictSafeSetItem(dict, "spare2"_key, msg.spare2);
 
   return AIS_OK;
 }
@@ -1727,27 +1642,23 @@ ais8_200_21_append_pydict(const char *nmea_payload, PyObject *dict,
 // River Information System
 // RTA report
 AIS_STATUS
-ais8_200_22_append_pydict(const char *nmea_payload, PyObject *dict,
-                          const size_t pad) {
-  assert(nmea_payload);
+ais8_200_22_append_pydict(const Ais8_200_22 &msg, PyObject *dict) {
   assert(dict);
-  assert(pad < 6);
-  Ais8_200_22 msg(nmea_payload, pad);
   if (msg.had_error()) {
     return msg.get_error();
   }
 
-  DictSafeSetItem(dict, "country", msg.country);
-  DictSafeSetItem(dict, "location", msg.location);
-  DictSafeSetItem(dict, "section", msg.section);
-  DictSafeSetItem(dict, "terminal", msg.terminal);
-  DictSafeSetItem(dict, "hectometre", msg.hectometre);
-  DictSafeSetItem(dict, "rta_month", msg.rta_month);
-  DictSafeSetItem(dict, "rta_day", msg.rta_day);
-  DictSafeSetItem(dict, "rta_hour", msg.rta_hour);
-  DictSafeSetItem(dict, "rta_minute", msg.rta_minute);
-  DictSafeSetItem(dict, "lock_status", msg.lock_status);
-  DictSafeSetItem(dict, "spare2", msg.spare2);
+  DictSafeSetItem(dict, "country"_key, msg.country);
+  DictSafeSetItem(dict, "location"_key, msg.location);
+  DictSafeSetItem(dict, "section"_key, msg.section);
+  DictSafeSetItem(dict, "terminal"_key, msg.terminal);
+  DictSafeSetItem(dict, "hectometre"_key, msg.hectometre);
+  DictSafeSetItem(dict, "rta_month"_key, msg.rta_month);
+  DictSafeSetItem(dict, "rta_day"_key, msg.rta_day);
+  DictSafeSetItem(dict, "rta_hour"_key, msg.rta_hour);
+  DictSafeSetItem(dict, "rta_minute"_key, msg.rta_minute);
+  DictSafeSetItem(dict, "lock_status"_key, msg.lock_status);
+  DictSafeSetItem(dict, "spare2"_key, msg.spare2);
 
   return AIS_OK;
 }
@@ -1755,34 +1666,30 @@ ais8_200_22_append_pydict(const char *nmea_payload, PyObject *dict,
 // River Information System
 // EMMA warning
 AIS_STATUS
-ais8_200_23_append_pydict(const char *nmea_payload, PyObject *dict,
-                          const size_t pad) {
-  assert(nmea_payload);
+ais8_200_23_append_pydict(const Ais8_200_23 &msg, PyObject *dict) {
   assert(dict);
-  assert(pad < 6);
-  Ais8_200_23 msg(nmea_payload, pad);
   if (msg.had_error()) {
     return msg.get_error();
   }
 
-  DictSafeSetItem(dict, "utc_year_start", msg.utc_year_start);
-  DictSafeSetItem(dict, "utc_month_start", msg.utc_month_start);
-  DictSafeSetItem(dict, "utc_day_start", msg.utc_day_start);
-  DictSafeSetItem(dict, "utc_year_end", msg.utc_year_end);
-  DictSafeSetItem(dict, "utc_month_end", msg.utc_month_end);
-  DictSafeSetItem(dict, "utc_day_end", msg.utc_day_end);
-  DictSafeSetItem(dict, "utc_hour_start", msg.utc_hour_start);
-  DictSafeSetItem(dict, "utc_min_start", msg.utc_min_start);
-  DictSafeSetItem(dict, "utc_hour_end", msg.utc_hour_end);
-  DictSafeSetItem(dict, "utc_min_end", msg.utc_min_end);
-  DictSafeSetItem(dict, "x1", "y1", msg.position1);
-  DictSafeSetItem(dict, "x2", "y2", msg.position2);
-  DictSafeSetItem(dict, "type", msg.type);
-  DictSafeSetItem(dict, "min", msg.min);
-  DictSafeSetItem(dict, "max", msg.max);
-  DictSafeSetItem(dict, "classification", msg.classification);
-  DictSafeSetItem(dict, "wind_dir", msg.wind_dir);
-  DictSafeSetItem(dict, "spare2", msg.spare2);
+  DictSafeSetItem(dict, "utc_year_start"_key, msg.utc_year_start);
+  DictSafeSetItem(dict, "utc_month_start"_key, msg.utc_month_start);
+  DictSafeSetItem(dict, "utc_day_start"_key, msg.utc_day_start);
+  DictSafeSetItem(dict, "utc_year_end"_key, msg.utc_year_end);
+  DictSafeSetItem(dict, "utc_month_end"_key, msg.utc_month_end);
+  DictSafeSetItem(dict, "utc_day_end"_key, msg.utc_day_end);
+  DictSafeSetItem(dict, "utc_hour_start"_key, msg.utc_hour_start);
+  DictSafeSetItem(dict, "utc_min_start"_key, msg.utc_min_start);
+  DictSafeSetItem(dict, "utc_hour_end"_key, msg.utc_hour_end);
+  DictSafeSetItem(dict, "utc_min_end"_key, msg.utc_min_end);
+  DictSafeSetItem(dict, "x1"_key, "y1"_key, msg.position1);
+  DictSafeSetItem(dict, "x2"_key, "y2"_key, msg.position2);
+  DictSafeSetItem(dict, "type"_key, msg.type);
+  DictSafeSetItem(dict, "min"_key, msg.min);
+  DictSafeSetItem(dict, "max"_key, msg.max);
+  DictSafeSetItem(dict, "classification"_key, msg.classification);
+  DictSafeSetItem(dict, "wind_dir"_key, msg.wind_dir);
+  DictSafeSetItem(dict, "spare2"_key, msg.spare2);
 
   return AIS_OK;
 }
@@ -1791,28 +1698,24 @@ ais8_200_23_append_pydict(const char *nmea_payload, PyObject *dict,
 // EU River Information System (RIS)
 // Water level
 AIS_STATUS
-ais8_200_24_append_pydict(const char *nmea_payload, PyObject *dict,
-                          const size_t pad) {
-  assert(nmea_payload);
+ais8_200_24_append_pydict(const Ais8_200_24 &msg, PyObject *dict) {
   assert(dict);
-  assert(pad < 6);
-  const Ais8_200_24 msg(nmea_payload, pad);
   if (msg.had_error()) {
     return msg.get_error();
   }
 
-  DictSafeSetItem(dict, "country", msg.country);
+  DictSafeSetItem(dict, "country"_key, msg.country);
 
   PyObject *id_list = PyList_New(4);
   for (size_t i = 0; i < 4; i++)
     PyList_SetItem(id_list, i, PyLong_FromLong(msg.gauge_ids[i]));
-  DictSafeSetItem(dict, "gauge_ids", id_list);
+  DictSafeSetItem(dict, "gauge_ids"_key, id_list);
   Py_DECREF(id_list);
 
   PyObject *level_list = PyList_New(4);
   for (size_t i = 0; i < 4; i++)
     PyList_SetItem(level_list, i, PyFloat_FromDouble(msg.levels[i]));
-  DictSafeSetItem(dict, "levels", level_list);
+  DictSafeSetItem(dict, "levels"_key, level_list);
   Py_DECREF(level_list);
 
   return AIS_OK;
@@ -1822,23 +1725,19 @@ ais8_200_24_append_pydict(const char *nmea_payload, PyObject *dict,
 // River Information System
 // Signal status
 AIS_STATUS
-ais8_200_40_append_pydict(const char *nmea_payload, PyObject *dict,
-                          const size_t pad) {
-  assert(nmea_payload);
+ais8_200_40_append_pydict(const Ais8_200_40 &msg, PyObject *dict) {
   assert(dict);
-  assert(pad < 6);
-  Ais8_200_40 msg(nmea_payload, pad);
   if (msg.had_error()) {
     return msg.get_error();
   }
 
-  DictSafeSetItem(dict, "x", "y", msg.position);
-  DictSafeSetItem(dict, "form", msg.form);
-  DictSafeSetItem(dict, "dir", msg.dir);
-  DictSafeSetItem(dict, "stream_dir", msg.stream_dir);
-  DictSafeSetItem(dict, "status_raw", msg.status_raw);
+  DictSafeSetItem(dict, "x"_key, "y"_key, msg.position);
+  DictSafeSetItem(dict, "form"_key, msg.form);
+  DictSafeSetItem(dict, "dir"_key, msg.dir);
+  DictSafeSetItem(dict, "stream_dir"_key, msg.stream_dir);
+  DictSafeSetItem(dict, "status_raw"_key, msg.status_raw);
   // TODO(schwehr): extract status components
-  DictSafeSetItem(dict, "spare2", msg.spare2);
+  DictSafeSetItem(dict, "spare2"_key, msg.spare2);
 
   return AIS_OK;
 }
@@ -1847,47 +1746,43 @@ ais8_200_40_append_pydict(const char *nmea_payload, PyObject *dict,
 // River Information System
 // Number of persons on board
 AIS_STATUS
-ais8_200_55_append_pydict(const char *nmea_payload, PyObject *dict,
-                          const size_t pad) {
-  assert(nmea_payload);
+ais8_200_55_append_pydict(const Ais8_200_55 &msg, PyObject *dict) {
   assert(dict);
-  assert(pad < 6);
-  Ais8_200_55 msg(nmea_payload, pad);
   if (msg.had_error()) {
     return msg.get_error();
   }
 
-  DictSafeSetItem(dict, "crew", msg.crew);
-  DictSafeSetItem(dict, "passengers", msg.passengers);
-  DictSafeSetItem(dict, "yet_more_personnel", msg.yet_more_personnel);
+  DictSafeSetItem(dict, "crew"_key, msg.crew);
+  DictSafeSetItem(dict, "passengers"_key, msg.passengers);
+  DictSafeSetItem(dict, "yet_more_personnel"_key, msg.yet_more_personnel);
 
   PyObject *spare2_list = PyList_New(3);
   for (size_t i = 0; i < 3; i++)
     PyList_SetItem(spare2_list, 0,  PyLong_FromLong(msg.spare2[i]));
-  DictSafeSetItem(dict, "spare2", spare2_list);
+  DictSafeSetItem(dict, "spare2"_key, spare2_list);
   Py_DECREF(spare2_list);
 
   return AIS_OK;
 }
 
 void
-ais8_367_22_append_pydict(const char *nmea_payload, PyObject *dict,
-                          const size_t pad) {
-  Ais8_367_22 msg(nmea_payload, pad);  // TODO(schwehr): check for errors
+ais8_367_22_append_pydict(const Ais8_367_22 &msg, PyObject *dict) {
+  // TODO(schwehr): check for errors
 
-  DictSafeSetItem(dict, "version", msg.version);
-  DictSafeSetItem(dict, "link_id", msg.link_id);
-  DictSafeSetItem(dict, "notice_type", msg.notice_type);
+  DictSafeSetItem(dict, "version"_key, msg.version);
+  DictSafeSetItem(dict, "link_id"_key, msg.link_id);
+  DictSafeSetItem(dict, "notice_type"_key, msg.notice_type);
   // TODO(schwehr): are 8:1:22 and 8:367:22 tables the same?
-  DictSafeSetItem(dict, "notice_type_str",
+  DictSafeSetItem(dict, "notice_type_str"_key,
                   ais8_1_22_notice_names[msg.notice_type]);
 
-  DictSafeSetItem(dict, "month", msg.month);  // This is UTC, not local time.
-  DictSafeSetItem(dict, "day", msg.day);
-  DictSafeSetItem(dict, "hour", msg.hour);
-  DictSafeSetItem(dict, "minute", msg.minute);
+  // This is UTC, not local time.
+  DictSafeSetItem(dict, "month"_key, msg.month);
+  DictSafeSetItem(dict, "day"_key, msg.day);
+  DictSafeSetItem(dict, "hour"_key, msg.hour);
+  DictSafeSetItem(dict, "minute"_key, msg.minute);
 
-  DictSafeSetItem(dict, "durations_minutes", msg.duration_minutes);
+  DictSafeSetItem(dict, "durations_minutes"_key, msg.duration_minutes);
 
   PyObject *sub_area_list = PyList_New(msg.sub_areas.size());
 
@@ -1901,15 +1796,16 @@ ais8_367_22_append_pydict(const char *nmea_payload, PyObject *dict,
             dynamic_cast<Ais8_367_22_Circle*>(msg.sub_areas[i].get());
         assert(c != nullptr);
 
-        DictSafeSetItem(sub_area, "sub_area_type", AIS8_366_22_SHAPE_CIRCLE);
+        DictSafeSetItem(sub_area, "sub_area_type"_key,
+                        AIS8_366_22_SHAPE_CIRCLE);
         if (c->radius_m == 0)
-          DictSafeSetItem(sub_area, "sub_area_type_str", "point");
+          DictSafeSetItem(sub_area, "sub_area_type_str"_key, "point");
         else
-          DictSafeSetItem(sub_area, "sub_area_type_str", "circle");
+          DictSafeSetItem(sub_area, "sub_area_type_str"_key, "circle");
 
-        DictSafeSetItem(sub_area, "x", "y", c->position);
-        DictSafeSetItem(sub_area, "precision", c->precision);
-        DictSafeSetItem(sub_area, "radius", c->radius_m);
+        DictSafeSetItem(sub_area, "x"_key, "y"_key, c->position);
+        DictSafeSetItem(sub_area, "precision"_key, c->precision);
+        DictSafeSetItem(sub_area, "radius"_key, c->radius_m);
         PyList_SetItem(sub_area_list, i, sub_area);
       }
       break;
@@ -1920,14 +1816,14 @@ ais8_367_22_append_pydict(const char *nmea_payload, PyObject *dict,
             dynamic_cast<Ais8_367_22_Rect*>(msg.sub_areas[i].get());
         assert(c != nullptr);
 
-        DictSafeSetItem(sub_area, "sub_area_type", AIS8_366_22_SHAPE_RECT);
-        DictSafeSetItem(sub_area, "sub_area_type_str", "rect");
+        DictSafeSetItem(sub_area, "sub_area_type"_key, AIS8_366_22_SHAPE_RECT);
+        DictSafeSetItem(sub_area, "sub_area_type_str"_key, "rect");
 
-        DictSafeSetItem(sub_area, "x", "y", c->position);
-        DictSafeSetItem(sub_area, "precision", c->precision);
-        DictSafeSetItem(sub_area, "e_dim_m", c->e_dim_m);
-        DictSafeSetItem(sub_area, "n_dim_m", c->n_dim_m);
-        DictSafeSetItem(sub_area, "orient_deg", c->orient_deg);
+        DictSafeSetItem(sub_area, "x"_key, "y"_key, c->position);
+        DictSafeSetItem(sub_area, "precision"_key, c->precision);
+        DictSafeSetItem(sub_area, "e_dim_m"_key, c->e_dim_m);
+        DictSafeSetItem(sub_area, "n_dim_m"_key, c->n_dim_m);
+        DictSafeSetItem(sub_area, "orient_deg"_key, c->orient_deg);
 
         PyList_SetItem(sub_area_list, i, sub_area);
       }
@@ -1939,14 +1835,15 @@ ais8_367_22_append_pydict(const char *nmea_payload, PyObject *dict,
             dynamic_cast<Ais8_367_22_Sector*>(msg.sub_areas[i].get());
         assert(c != nullptr);
 
-        DictSafeSetItem(sub_area, "sub_area_type", AIS8_366_22_SHAPE_SECTOR);
-        DictSafeSetItem(sub_area, "sub_area_type_str", "sector");
+        DictSafeSetItem(sub_area, "sub_area_type"_key,
+                        AIS8_366_22_SHAPE_SECTOR);
+        DictSafeSetItem(sub_area, "sub_area_type_str"_key, "sector");
 
-        DictSafeSetItem(sub_area, "x", "y", c->position);
-        DictSafeSetItem(sub_area, "precision", c->precision);
-        DictSafeSetItem(sub_area, "radius", c->radius_m);
-        DictSafeSetItem(sub_area, "left_bound_deg", c->left_bound_deg);
-        DictSafeSetItem(sub_area, "right_bound_deg", c->right_bound_deg);
+        DictSafeSetItem(sub_area, "x"_key, "y"_key, c->position);
+        DictSafeSetItem(sub_area, "precision"_key, c->precision);
+        DictSafeSetItem(sub_area, "radius"_key, c->radius_m);
+        DictSafeSetItem(sub_area, "left_bound_deg"_key, c->left_bound_deg);
+        DictSafeSetItem(sub_area, "right_bound_deg"_key, c->right_bound_deg);
 
         PyList_SetItem(sub_area_list, i, sub_area);
       }
@@ -1959,11 +1856,12 @@ ais8_367_22_append_pydict(const char *nmea_payload, PyObject *dict,
             dynamic_cast<Ais8_367_22_Poly*>(msg.sub_areas[i].get());
         assert(poly != nullptr);
 
-        DictSafeSetItem(sub_area, "sub_area_type", msg.sub_areas[i]->getType());
+        DictSafeSetItem(sub_area, "sub_area_type"_key,
+                        msg.sub_areas[i]->getType());
         if (msg.sub_areas[i]->getType() == AIS8_366_22_SHAPE_POLYLINE)
-          DictSafeSetItem(sub_area, "sub_area_type_str", "polyline");
+          DictSafeSetItem(sub_area, "sub_area_type_str"_key, "polyline");
         else
-          DictSafeSetItem(sub_area, "sub_area_type_str", "polygon");
+          DictSafeSetItem(sub_area, "sub_area_type_str"_key, "polygon");
         assert(poly->angles.size() == poly->dists_m.size());
         PyObject *angle_list = PyList_New(poly->angles.size());
         PyObject *dist_list = PyList_New(poly->angles.size());
@@ -1975,8 +1873,8 @@ ais8_367_22_append_pydict(const char *nmea_payload, PyObject *dict,
                          PyFloat_FromDouble(poly->dists_m[pt_num]));
         }
 
-        DictSafeSetItem(sub_area, "angles", angle_list);
-        DictSafeSetItem(sub_area, "dists_m", dist_list);
+        DictSafeSetItem(sub_area, "angles"_key, angle_list);
+        DictSafeSetItem(sub_area, "dists_m"_key, dist_list);
         Py_DECREF(angle_list);
         Py_DECREF(dist_list);
 
@@ -1991,10 +1889,10 @@ ais8_367_22_append_pydict(const char *nmea_payload, PyObject *dict,
             dynamic_cast<Ais8_367_22_Text*>(msg.sub_areas[i].get());
         assert(text != nullptr);
 
-        DictSafeSetItem(sub_area, "sub_area_type", AIS8_366_22_SHAPE_TEXT);
-        DictSafeSetItem(sub_area, "sub_area_type_str", "text");
+        DictSafeSetItem(sub_area, "sub_area_type"_key, AIS8_366_22_SHAPE_TEXT);
+        DictSafeSetItem(sub_area, "sub_area_type_str"_key, "text");
 
-        DictSafeSetItem(sub_area, "text", text->text);
+        DictSafeSetItem(sub_area, "text"_key, text->text);
 
         PyList_SetItem(sub_area_list, i, sub_area);
       }
@@ -2004,161 +1902,149 @@ ais8_367_22_append_pydict(const char *nmea_payload, PyObject *dict,
       {}  // TODO(schwehr): Mark an unknown subarea or raise an exception.
     }
   }
-  DictSafeSetItem(dict, "sub_areas", sub_area_list);
+  DictSafeSetItem(dict, "sub_areas"_key, sub_area_list);
   Py_DECREF(sub_area_list);
 }
 
 AIS_STATUS
-ais8_367_23_append_pydict(const char *nmea_payload, PyObject *dict,
-                          const size_t pad) {
-  assert(nmea_payload);
+ais8_367_23_append_pydict(const Ais8_367_23 &msg, PyObject *dict) {
   assert(dict);
-  assert(pad < 6);
-  Ais8_367_23 msg(nmea_payload, pad);
   if (msg.had_error()) {
     return msg.get_error();
   }
 
-  DictSafeSetItem(dict, "version", msg.version);
+  DictSafeSetItem(dict, "version"_key, msg.version);
 
   if (msg.utc_day != 0) {
-    DictSafeSetItem(dict, "utc_day", msg.utc_day);
+    DictSafeSetItem(dict, "utc_day"_key, msg.utc_day);
   } else {
-    DictSafeSetItem(dict, "utc_day", Py_None);
+    DictSafeSetItem(dict, "utc_day"_key, Py_None);
   }
 
   if (msg.utc_hour <= 23) {
-    DictSafeSetItem(dict, "utc_hour", msg.utc_hour);
+    DictSafeSetItem(dict, "utc_hour"_key, msg.utc_hour);
   } else {
-    DictSafeSetItem(dict, "utc_hour", Py_None);
+    DictSafeSetItem(dict, "utc_hour"_key, Py_None);
   }
 
   if (msg.utc_min <= 59) {
-    DictSafeSetItem(dict, "utc_min", msg.utc_min);
+    DictSafeSetItem(dict, "utc_min"_key, msg.utc_min);
   } else {
-    DictSafeSetItem(dict, "utc_min", Py_None);
+    DictSafeSetItem(dict, "utc_min"_key, Py_None);
   }
 
-  DictSafeSetItem(dict, "x", "y", msg.position);
+  DictSafeSetItem(dict, "x"_key, "y"_key, msg.position);
 
   if (msg.pressure <= (402 + 799)) {
-    DictSafeSetItem(dict, "pressure", msg.pressure);
+    DictSafeSetItem(dict, "pressure"_key, msg.pressure);
   } else {
     // Raw value was 403 (N/A), or reserved value.
-    DictSafeSetItem(dict, "pressure", Py_None);
+    DictSafeSetItem(dict, "pressure"_key, Py_None);
   }
 
   if (msg.air_temp_raw >= -600 && msg.air_temp_raw <= 600) {
-    DictSafeSetItem(dict, "air_temp", msg.air_temp);
+    DictSafeSetItem(dict, "air_temp"_key, msg.air_temp);
   } else {
-    DictSafeSetItem(dict, "air_temp", Py_None);
+    DictSafeSetItem(dict, "air_temp"_key, Py_None);
   }
 
   if (msg.wind_speed <= 121) {
-    DictSafeSetItem(dict, "wind_speed", msg.wind_speed);
+    DictSafeSetItem(dict, "wind_speed"_key, msg.wind_speed);
   } else {
     // Raw value was 122 (N/A) or reserved value.
-    DictSafeSetItem(dict, "wind_speed", Py_None);
+    DictSafeSetItem(dict, "wind_speed"_key, Py_None);
   }
 
   if (msg.wind_gust <= 121) {
-    DictSafeSetItem(dict, "wind_gust", msg.wind_gust);
+    DictSafeSetItem(dict, "wind_gust"_key, msg.wind_gust);
   } else {
     // Raw value was 122 (N/A) or reserved value.
-    DictSafeSetItem(dict, "wind_gust", Py_None);
+    DictSafeSetItem(dict, "wind_gust"_key, Py_None);
   }
 
   if (msg.wind_dir <= 359) {
-    DictSafeSetItem(dict, "wind_dir", msg.wind_dir);
+    DictSafeSetItem(dict, "wind_dir"_key, msg.wind_dir);
   } else {
     // Raw value was 360 (N/A), or reserved value.
-    DictSafeSetItem(dict, "wind_dir", Py_None);
+    DictSafeSetItem(dict, "wind_dir"_key, Py_None);
   }
 
   return AIS_OK;
 }
 
 AIS_STATUS
-ais8_367_24_append_pydict(const char *nmea_payload, PyObject *dict,
-                        const size_t pad) {
-  assert(nmea_payload);
+ais8_367_24_append_pydict(const Ais8_367_24 &msg, PyObject *dict) {
   assert(dict);
-  assert(pad < 6);
-  Ais8_367_24 msg(nmea_payload, pad);
   if (msg.had_error()) {
     return msg.get_error();
   }
 
-  DictSafeSetItem(dict, "version", msg.version);
+  DictSafeSetItem(dict, "version"_key, msg.version);
 
   if (msg.utc_hour <= 23) {
-    DictSafeSetItem(dict, "utc_hour", msg.utc_hour);
+    DictSafeSetItem(dict, "utc_hour"_key, msg.utc_hour);
   } else {
-    DictSafeSetItem(dict, "utc_hour", Py_None);
+    DictSafeSetItem(dict, "utc_hour"_key, Py_None);
   }
 
   if (msg.utc_min <= 59) {
-    DictSafeSetItem(dict, "utc_min", msg.utc_min);
+    DictSafeSetItem(dict, "utc_min"_key, msg.utc_min);
   } else {
-    DictSafeSetItem(dict, "utc_min", Py_None);
+    DictSafeSetItem(dict, "utc_min"_key, Py_None);
   }
 
-  DictSafeSetItem(dict, "x", "y", msg.position);
+  DictSafeSetItem(dict, "x"_key, "y"_key, msg.position);
 
   if (msg.pressure <= (403 + 799)) {
-    DictSafeSetItem(dict, "pressure", msg.pressure);
+    DictSafeSetItem(dict, "pressure"_key, msg.pressure);
   } else {
     // Raw value was 403 (N/A), or reserved value.
-    DictSafeSetItem(dict, "pressure", Py_None);
+    DictSafeSetItem(dict, "pressure"_key, Py_None);
   }
 
   return AIS_OK;
 }
 
 AIS_STATUS
-ais8_367_25_append_pydict(const char *nmea_payload, PyObject *dict,
-                        const size_t pad) {
-  assert(nmea_payload);
+ais8_367_25_append_pydict(const Ais8_367_25 &msg, PyObject *dict) {
   assert(dict);
-  assert(pad < 6);
-  Ais8_367_25 msg(nmea_payload, pad);
   if (msg.had_error()) {
     return msg.get_error();
   }
 
-  DictSafeSetItem(dict, "version", msg.version);
+  DictSafeSetItem(dict, "version"_key, msg.version);
 
   if (msg.utc_hour <= 23) {
-    DictSafeSetItem(dict, "utc_hour", msg.utc_hour);
+    DictSafeSetItem(dict, "utc_hour"_key, msg.utc_hour);
   } else {
-    DictSafeSetItem(dict, "utc_hour", Py_None);
+    DictSafeSetItem(dict, "utc_hour"_key, Py_None);
   }
 
   if (msg.utc_min <= 59) {
-    DictSafeSetItem(dict, "utc_min", msg.utc_min);
+    DictSafeSetItem(dict, "utc_min"_key, msg.utc_min);
   } else {
-    DictSafeSetItem(dict, "utc_min", Py_None);
+    DictSafeSetItem(dict, "utc_min"_key, Py_None);
   }
 
   if (msg.pressure <= (799 + 402)) {
-    DictSafeSetItem(dict, "pressure", msg.pressure);
+    DictSafeSetItem(dict, "pressure"_key, msg.pressure);
   } else {
     // Raw value was 403 (N/A), or reserved value.
-    DictSafeSetItem(dict, "pressure", Py_None);
+    DictSafeSetItem(dict, "pressure"_key, Py_None);
   }
 
   if (msg.wind_speed <= 121) {
-    DictSafeSetItem(dict, "wind_speed", msg.wind_speed);
+    DictSafeSetItem(dict, "wind_speed"_key, msg.wind_speed);
   } else {
     // Raw value was 122 (N/A) or reserved value.
-    DictSafeSetItem(dict, "wind_speed", Py_None);
+    DictSafeSetItem(dict, "wind_speed"_key, Py_None);
   }
 
   if (msg.wind_dir <= 359) {
-    DictSafeSetItem(dict, "wind_dir", msg.wind_dir);
+    DictSafeSetItem(dict, "wind_dir"_key, msg.wind_dir);
   } else {
     // Raw value was 360 (N/A), or reserved value.
-    DictSafeSetItem(dict, "wind_dir", Py_None);
+    DictSafeSetItem(dict, "wind_dir"_key, Py_None);
   }
 
   return AIS_OK;
@@ -2169,44 +2055,40 @@ ais8_367_33_append_pydict_sensor_hdr(PyObject *dict,
                                      Ais8_367_33_SensorReport* rpt) {
   assert(dict);
   assert(rpt);
-  DictSafeSetItem(dict, "report_type", rpt->report_type);
+  DictSafeSetItem(dict, "report_type"_key, rpt->report_type);
 
   if (rpt->utc_day != 0) {
-    DictSafeSetItem(dict, "utc_day", rpt->utc_day);
+    DictSafeSetItem(dict, "utc_day"_key, rpt->utc_day);
   } else {
-    DictSafeSetItem(dict, "utc_day", Py_None);
+    DictSafeSetItem(dict, "utc_day"_key, Py_None);
   }
 
   if (rpt->utc_hr <= 23) {
-    DictSafeSetItem(dict, "utc_hr", rpt->utc_hr);
+    DictSafeSetItem(dict, "utc_hr"_key, rpt->utc_hr);
   } else {
-    DictSafeSetItem(dict, "utc_hr", Py_None);
+    DictSafeSetItem(dict, "utc_hr"_key, Py_None);
   }
 
   if (rpt->utc_min <= 59) {
-    DictSafeSetItem(dict, "utc_min", rpt->utc_min);
+    DictSafeSetItem(dict, "utc_min"_key, rpt->utc_min);
   } else {
-    DictSafeSetItem(dict, "utc_min", Py_None);
+    DictSafeSetItem(dict, "utc_min"_key, Py_None);
   }
 
-  DictSafeSetItem(dict, "site_id", rpt->site_id);
+  DictSafeSetItem(dict, "site_id"_key, rpt->site_id);
 
   return AIS_OK;
 }
 
 AIS_STATUS
-ais8_367_33_append_pydict(const char *nmea_payload, PyObject *dict,
-                          const size_t pad) {
-  assert(nmea_payload);
+ais8_367_33_append_pydict(const Ais8_367_33 &msg, PyObject *dict) {
   assert(dict);
-  assert(pad < 6);
-  const Ais8_367_33 msg(nmea_payload, pad);
   if (msg.had_error()) {
     return msg.get_error();
   }
 
   PyObject *rpt_list = PyList_New(msg.reports.size());
-  DictSafeSetItem(dict, "reports", rpt_list);
+  DictSafeSetItem(dict, "reports"_key, rpt_list);
 
   for (size_t rpt_num = 0; rpt_num < msg.reports.size(); rpt_num++) {
     PyObject *rpt_dict = PyDict_New();
@@ -2221,17 +2103,17 @@ ais8_367_33_append_pydict(const char *nmea_payload, PyObject *dict,
         assert(rpt != nullptr);
         ais8_367_33_append_pydict_sensor_hdr(rpt_dict, rpt);
 
-        DictSafeSetItem(rpt_dict, "x", "y", rpt->position);
+        DictSafeSetItem(rpt_dict, "x"_key, "y"_key, rpt->position);
 
         if (rpt->altitude_raw >= -2000 && rpt->altitude_raw <= 2001) {
-          DictSafeSetItem(rpt_dict, "altitude", rpt->altitude);
+          DictSafeSetItem(rpt_dict, "altitude"_key, rpt->altitude);
         } else {
-          DictSafeSetItem(rpt_dict, "altitude", Py_None);
+          DictSafeSetItem(rpt_dict, "altitude"_key, Py_None);
         }
 
-        DictSafeSetItem(rpt_dict, "owner", rpt->owner);
-        DictSafeSetItem(rpt_dict, "timeout", rpt->timeout);
-        DictSafeSetItem(rpt_dict, "spare2", rpt->spare2);
+        DictSafeSetItem(rpt_dict, "owner"_key, rpt->owner);
+        DictSafeSetItem(rpt_dict, "timeout"_key, rpt->timeout);
+        DictSafeSetItem(rpt_dict, "spare2"_key, rpt->spare2);
       }
       break;
     case AIS8_367_33_SENSOR_STATION:
@@ -2241,8 +2123,8 @@ ais8_367_33_append_pydict(const char *nmea_payload, PyObject *dict,
         assert(rpt != nullptr);
         ais8_367_33_append_pydict_sensor_hdr(rpt_dict, rpt);
 
-        DictSafeSetItem(rpt_dict, "name", rpt->name);
-        DictSafeSetItem(rpt_dict, "spare2", rpt->spare2);
+        DictSafeSetItem(rpt_dict, "name"_key, rpt->name);
+        DictSafeSetItem(rpt_dict, "spare2"_key, rpt->spare2);
       }
       break;
     case AIS8_367_33_SENSOR_WIND:
@@ -2253,69 +2135,74 @@ ais8_367_33_append_pydict(const char *nmea_payload, PyObject *dict,
         ais8_367_33_append_pydict_sensor_hdr(rpt_dict, rpt);
 
         if (rpt->wind_speed >= 0 && rpt->wind_speed <= 121) {
-          DictSafeSetItem(rpt_dict, "wind_speed", rpt->wind_speed);
+          DictSafeSetItem(rpt_dict, "wind_speed"_key, rpt->wind_speed);
         } else {
-          DictSafeSetItem(rpt_dict, "wind_speed", Py_None);
+          DictSafeSetItem(rpt_dict, "wind_speed"_key, Py_None);
         }
 
         if (rpt->wind_gust >= 0 && rpt->wind_gust <= 121) {
-          DictSafeSetItem(rpt_dict, "wind_gust", rpt->wind_gust);
+          DictSafeSetItem(rpt_dict, "wind_gust"_key, rpt->wind_gust);
         } else {
-          DictSafeSetItem(rpt_dict, "wind_gust", Py_None);
+          DictSafeSetItem(rpt_dict, "wind_gust"_key, Py_None);
         }
 
         if (rpt->wind_dir >= 0 && rpt->wind_dir <= 359) {
-          DictSafeSetItem(rpt_dict, "wind_dir", rpt->wind_dir);
+          DictSafeSetItem(rpt_dict, "wind_dir"_key, rpt->wind_dir);
         } else {
-          DictSafeSetItem(rpt_dict, "wind_dir", Py_None);
+          DictSafeSetItem(rpt_dict, "wind_dir"_key, Py_None);
         }
 
         if (rpt->wind_gust_dir >= 0 && rpt->wind_gust_dir <= 359) {
-          DictSafeSetItem(rpt_dict, "wind_gust_dir", rpt->wind_gust_dir);
+          DictSafeSetItem(rpt_dict, "wind_gust_dir"_key, rpt->wind_gust_dir);
         } else {
-          DictSafeSetItem(rpt_dict, "wind_gust_dir", Py_None);
+          DictSafeSetItem(rpt_dict, "wind_gust_dir"_key, Py_None);
         }
 
-        DictSafeSetItem(rpt_dict, "sensor_type", rpt->sensor_type);
+        DictSafeSetItem(rpt_dict, "sensor_type"_key, rpt->sensor_type);
 
         if (rpt->wind_forecast >= 0 && rpt->wind_forecast <= 121) {
-          DictSafeSetItem(rpt_dict, "wind_forecast", rpt->wind_forecast);
+          DictSafeSetItem(rpt_dict, "wind_forecast"_key, rpt->wind_forecast);
         } else {
-          DictSafeSetItem(rpt_dict, "wind_forecast", Py_None);
+          DictSafeSetItem(rpt_dict, "wind_forecast"_key, Py_None);
         }
 
         if (rpt->wind_gust_forecast >= 0 && rpt->wind_gust_forecast <= 121) {
-          DictSafeSetItem(rpt_dict, "wind_gust_forecast", rpt->wind_gust_forecast);
+          DictSafeSetItem(rpt_dict, "wind_gust_forecast"_key,
+                          rpt->wind_gust_forecast);
         } else {
-          DictSafeSetItem(rpt_dict, "wind_gust_forecast", Py_None);
+          DictSafeSetItem(rpt_dict, "wind_gust_forecast"_key, Py_None);
         }
 
         if (rpt->wind_dir_forecast >= 0 && rpt->wind_dir_forecast <= 359) {
-          DictSafeSetItem(rpt_dict, "wind_dir_forecast", rpt->wind_dir_forecast);
+          DictSafeSetItem(rpt_dict, "wind_dir_forecast"_key,
+                          rpt->wind_dir_forecast);
         } else {
-          DictSafeSetItem(rpt_dict, "wind_dir_forecast", Py_None);
+          DictSafeSetItem(rpt_dict, "wind_dir_forecast"_key, Py_None);
         }
 
         if (rpt->utc_day_forecast != 0) {
-          DictSafeSetItem(rpt_dict, "utc_day_forecast", rpt->utc_day_forecast);
+          DictSafeSetItem(rpt_dict, "utc_day_forecast"_key,
+                          rpt->utc_day_forecast);
         } else {
-          DictSafeSetItem(rpt_dict, "utc_day_forecast", Py_None);
+          DictSafeSetItem(rpt_dict, "utc_day_forecast"_key, Py_None);
         }
 
         if (rpt->utc_hour_forecast >= 0 && rpt->utc_hour_forecast <= 23) {
-          DictSafeSetItem(rpt_dict, "utc_hour_forecast", rpt->utc_hour_forecast);
+          DictSafeSetItem(rpt_dict, "utc_hour_forecast"_key,
+                          rpt->utc_hour_forecast);
         } else {
-          DictSafeSetItem(rpt_dict, "utc_hour_forecast", Py_None);
+          DictSafeSetItem(rpt_dict, "utc_hour_forecast"_key, Py_None);
         }
 
         if (rpt->utc_min_forecast >= 0 && rpt->utc_min_forecast <= 59) {
-          DictSafeSetItem(rpt_dict, "utc_min_forecast", rpt->utc_min_forecast);
+          DictSafeSetItem(rpt_dict, "utc_min_forecast"_key,
+                          rpt->utc_min_forecast);
         } else {
-          DictSafeSetItem(rpt_dict, "utc_min_forecast", Py_None);
+          DictSafeSetItem(rpt_dict, "utc_min_forecast"_key, Py_None);
         }
 
-        DictSafeSetItem(rpt_dict, "duration", rpt->duration);
-        DictSafeSetItem(rpt_dict, "spare2", rpt->spare2);
+        DictSafeSetItem(rpt_dict, "duration"_key, rpt->duration);
+        DictSafeSetItem(rpt_dict, "spare2"_key, rpt->spare2);
       }
       break;
     case AIS8_367_33_SENSOR_WATER_LEVEL:
@@ -2324,30 +2211,33 @@ ais8_367_33_append_pydict(const char *nmea_payload, PyObject *dict,
             dynamic_cast<Ais8_367_33_WaterLevel *>(msg.reports[rpt_num].get());
         assert(rpt != nullptr);
         ais8_367_33_append_pydict_sensor_hdr(rpt_dict, rpt);
-        DictSafeSetItem(rpt_dict, "type", rpt->type);
+        DictSafeSetItem(rpt_dict, "type"_key, rpt->type);
 
         if (rpt->level != 32768) {
-          DictSafeSetItem(rpt_dict, "level", rpt->level);
+          DictSafeSetItem(rpt_dict, "level"_key, rpt->level);
         } else {
-          DictSafeSetItem(rpt_dict, "level", Py_None);
+          DictSafeSetItem(rpt_dict, "level"_key, Py_None);
         }
 
-        DictSafeSetItem(rpt_dict, "trend", rpt->trend);
-        DictSafeSetItem(rpt_dict, "vdatum", rpt->vdatum);
-        DictSafeSetItem(rpt_dict, "sensor_type", rpt->sensor_type);
-        DictSafeSetItem(rpt_dict, "forecast_type", rpt->forecast_type);
+        DictSafeSetItem(rpt_dict, "trend"_key, rpt->trend);
+        DictSafeSetItem(rpt_dict, "vdatum"_key, rpt->vdatum);
+        DictSafeSetItem(rpt_dict, "sensor_type"_key, rpt->sensor_type);
+        DictSafeSetItem(rpt_dict, "forecast_type"_key, rpt->forecast_type);
 
         if (rpt->level_forecast != 32768) {
-          DictSafeSetItem(rpt_dict, "level_forecast", rpt->level_forecast);
+          DictSafeSetItem(rpt_dict, "level_forecast"_key, rpt->level_forecast);
         } else {
-          DictSafeSetItem(rpt_dict, "level_forecast", Py_None);
+          DictSafeSetItem(rpt_dict, "level_forecast"_key, Py_None);
         }
 
-        DictSafeSetItem(rpt_dict, "utc_day_forecast", rpt->utc_day_forecast);
-        DictSafeSetItem(rpt_dict, "utc_hour_forecast", rpt->utc_hour_forecast);
-        DictSafeSetItem(rpt_dict, "utc_min_forecast", rpt->utc_min_forecast);
-        DictSafeSetItem(rpt_dict, "duration", rpt->duration);
-        DictSafeSetItem(rpt_dict, "spare2", rpt->spare2);
+        DictSafeSetItem(rpt_dict, "utc_day_forecast"_key,
+                        rpt->utc_day_forecast);
+        DictSafeSetItem(rpt_dict, "utc_hour_forecast"_key,
+                        rpt->utc_hour_forecast);
+        DictSafeSetItem(rpt_dict, "utc_min_forecast"_key,
+                        rpt->utc_min_forecast);
+        DictSafeSetItem(rpt_dict, "duration"_key, rpt->duration);
+        DictSafeSetItem(rpt_dict, "spare2"_key, rpt->spare2);
       }
       break;
     case AIS8_367_33_SENSOR_CURR_2D:
@@ -2356,30 +2246,30 @@ ais8_367_33_append_pydict(const char *nmea_payload, PyObject *dict,
             dynamic_cast<Ais8_367_33_Curr2D *>(msg.reports[rpt_num].get());
         assert(rpt != nullptr);
         ais8_367_33_append_pydict_sensor_hdr(rpt_dict, rpt);
-        DictSafeSetItem(rpt_dict, "type", rpt->type);
-        DictSafeSetItem(rpt_dict, "spare2", rpt->spare2);
+        DictSafeSetItem(rpt_dict, "type"_key, rpt->type);
+        DictSafeSetItem(rpt_dict, "spare2"_key, rpt->spare2);
 
         PyObject *curr_list = PyList_New(3);
-        DictSafeSetItem(rpt_dict, "currents", curr_list);
+        DictSafeSetItem(rpt_dict, "currents"_key, curr_list);
         for (size_t idx = 0; idx < 3; idx++) {
           PyObject *curr_dict = PyDict_New();
 
           if (rpt->currents[idx].speed_raw <= 246) {
-            DictSafeSetItem(curr_dict, "speed", rpt->currents[idx].speed);
+            DictSafeSetItem(curr_dict, "speed"_key, rpt->currents[idx].speed);
           } else {
-            DictSafeSetItem(curr_dict, "speed", Py_None);
+            DictSafeSetItem(curr_dict, "speed"_key, Py_None);
           }
 
           if (rpt->currents[idx].dir <= 359) {
-            DictSafeSetItem(curr_dict, "dir", rpt->currents[idx].dir);
+            DictSafeSetItem(curr_dict, "dir"_key, rpt->currents[idx].dir);
           } else {
-            DictSafeSetItem(curr_dict, "dir", Py_None);
+            DictSafeSetItem(curr_dict, "dir"_key, Py_None);
           }
 
           if (rpt->currents[idx].depth <= 361) {
-            DictSafeSetItem(curr_dict, "depth", rpt->currents[idx].depth);
+            DictSafeSetItem(curr_dict, "depth"_key, rpt->currents[idx].depth);
           } else {
-            DictSafeSetItem(curr_dict, "depth", Py_None);
+            DictSafeSetItem(curr_dict, "depth"_key, Py_None);
           }
 
           PyList_SetItem(curr_list, idx, curr_dict);
@@ -2392,37 +2282,37 @@ ais8_367_33_append_pydict(const char *nmea_payload, PyObject *dict,
             dynamic_cast<Ais8_367_33_Curr3D *>(msg.reports[rpt_num].get());
         assert(rpt != nullptr);
         ais8_367_33_append_pydict_sensor_hdr(rpt_dict, rpt);
-        DictSafeSetItem(rpt_dict, "type", rpt->type);
-        DictSafeSetItem(rpt_dict, "spare2", rpt->spare2);
+        DictSafeSetItem(rpt_dict, "type"_key, rpt->type);
+        DictSafeSetItem(rpt_dict, "spare2"_key, rpt->spare2);
 
         PyObject *curr_list = PyList_New(2);
-        DictSafeSetItem(rpt_dict, "currents", curr_list);
+        DictSafeSetItem(rpt_dict, "currents"_key, curr_list);
         for (size_t idx = 0; idx < 2; idx++) {
           PyObject *curr_dict = PyDict_New();
           PyList_SetItem(curr_list, idx, curr_dict);
 
           if (rpt->currents[idx].north_raw >= -251 && rpt->currents[idx].north_raw <= 251) {
-            DictSafeSetItem(curr_dict, "north", rpt->currents[idx].north);
+            DictSafeSetItem(curr_dict, "north"_key, rpt->currents[idx].north);
           } else {
-            DictSafeSetItem(curr_dict, "north", Py_None);
+            DictSafeSetItem(curr_dict, "north"_key, Py_None);
           }
 
           if (rpt->currents[idx].east_raw >= -251 && rpt->currents[idx].east_raw <= 251) {
-            DictSafeSetItem(curr_dict, "east", rpt->currents[idx].east);
+            DictSafeSetItem(curr_dict, "east"_key, rpt->currents[idx].east);
           } else {
-            DictSafeSetItem(curr_dict, "east", Py_None);
+            DictSafeSetItem(curr_dict, "east"_key, Py_None);
           }
 
           if (rpt->currents[idx].up_raw >= -251 && rpt->currents[idx].up_raw <= 251) {
-            DictSafeSetItem(curr_dict, "up", rpt->currents[idx].up);
+            DictSafeSetItem(curr_dict, "up"_key, rpt->currents[idx].up);
           } else {
-            DictSafeSetItem(curr_dict, "up", Py_None);
+            DictSafeSetItem(curr_dict, "up"_key, Py_None);
           }
 
           if (rpt->currents[idx].depth >= 0 && rpt->currents[idx].depth <= 361) {
-            DictSafeSetItem(curr_dict, "depth", rpt->currents[idx].depth);
+            DictSafeSetItem(curr_dict, "depth"_key, rpt->currents[idx].depth);
           } else {
-            DictSafeSetItem(curr_dict, "depth", Py_None);
+            DictSafeSetItem(curr_dict, "depth"_key, Py_None);
           }
         }
       }
@@ -2433,43 +2323,43 @@ ais8_367_33_append_pydict(const char *nmea_payload, PyObject *dict,
             dynamic_cast<Ais8_367_33_HorzFlow *>(msg.reports[rpt_num].get());
         assert(rpt != nullptr);
         ais8_367_33_append_pydict_sensor_hdr(rpt_dict, rpt);
-        DictSafeSetItem(rpt_dict, "spare2", rpt->spare2);
+        DictSafeSetItem(rpt_dict, "spare2"_key, rpt->spare2);
 
         if (rpt->bearing <= 359) {
-          DictSafeSetItem(rpt_dict, "bearing", rpt->bearing);
+          DictSafeSetItem(rpt_dict, "bearing"_key, rpt->bearing);
         } else {
-            DictSafeSetItem(rpt_dict, "bearing", Py_None);
+            DictSafeSetItem(rpt_dict, "bearing"_key, Py_None);
         }
 
-        DictSafeSetItem(rpt_dict, "type", rpt->type);
+        DictSafeSetItem(rpt_dict, "type"_key, rpt->type);
 
         PyObject *curr_list = PyList_New(2);
-        DictSafeSetItem(rpt_dict, "currents", curr_list);
+        DictSafeSetItem(rpt_dict, "currents"_key, curr_list);
         for (size_t idx = 0; idx < 2; idx++) {
           PyObject *curr_dict = PyDict_New();
 
           if (rpt->currents[idx].dist <= 361) {
-            DictSafeSetItem(curr_dict, "dist", rpt->currents[idx].dist);
+            DictSafeSetItem(curr_dict, "dist"_key, rpt->currents[idx].dist);
            } else {
-            DictSafeSetItem(curr_dict, "dist", Py_None);
+            DictSafeSetItem(curr_dict, "dist"_key, Py_None);
           }
 
           if (rpt->currents[idx].speed_raw <= 246) {
-            DictSafeSetItem(curr_dict, "speed", rpt->currents[idx].speed);
+            DictSafeSetItem(curr_dict, "speed"_key, rpt->currents[idx].speed);
            } else {
-            DictSafeSetItem(curr_dict, "speed", Py_None);
+            DictSafeSetItem(curr_dict, "speed"_key, Py_None);
           }
 
           if (rpt->currents[idx].dir <= 359) {
-            DictSafeSetItem(curr_dict, "dir", rpt->currents[idx].dir);
+            DictSafeSetItem(curr_dict, "dir"_key, rpt->currents[idx].dir);
            } else {
-            DictSafeSetItem(curr_dict, "dir", Py_None);
+            DictSafeSetItem(curr_dict, "dir"_key, Py_None);
           }
 
           if (rpt->currents[idx].level <= 361) {
-            DictSafeSetItem(curr_dict, "level", rpt->currents[idx].level);
+            DictSafeSetItem(curr_dict, "level"_key, rpt->currents[idx].level);
            } else {
-            DictSafeSetItem(curr_dict, "level", Py_None);
+            DictSafeSetItem(curr_dict, "level"_key, Py_None);
           }
 
           PyList_SetItem(curr_list, idx, curr_dict);
@@ -2484,64 +2374,68 @@ ais8_367_33_append_pydict(const char *nmea_payload, PyObject *dict,
         ais8_367_33_append_pydict_sensor_hdr(rpt_dict, rpt);
 
         if (rpt->swell_height_raw <= 246) {
-          DictSafeSetItem(rpt_dict, "swell_height", rpt->swell_height);
+          DictSafeSetItem(rpt_dict, "swell_height"_key, rpt->swell_height);
         } else {
-          DictSafeSetItem(rpt_dict, "swell_height", Py_None);
+          DictSafeSetItem(rpt_dict, "swell_height"_key, Py_None);
         }
 
         if (rpt->swell_period <= 60) {
-          DictSafeSetItem(rpt_dict, "swell_period", rpt->swell_period);
+          DictSafeSetItem(rpt_dict, "swell_period"_key, rpt->swell_period);
         } else {
-          DictSafeSetItem(rpt_dict, "swell_period", Py_None);
+          DictSafeSetItem(rpt_dict, "swell_period"_key, Py_None);
         }
 
         if (rpt->swell_dir <= 359) {
-          DictSafeSetItem(rpt_dict, "swell_dir", rpt->swell_dir);
+          DictSafeSetItem(rpt_dict, "swell_dir"_key, rpt->swell_dir);
         } else {
-          DictSafeSetItem(rpt_dict, "swell_dir", Py_None);
+          DictSafeSetItem(rpt_dict, "swell_dir"_key, Py_None);
         }
 
-        DictSafeSetItem(rpt_dict, "sea_state", rpt->sea_state);
-        DictSafeSetItem(rpt_dict, "swell_sensor_type", rpt->swell_sensor_type);
+        DictSafeSetItem(rpt_dict, "sea_state"_key, rpt->sea_state);
+        DictSafeSetItem(rpt_dict, "swell_sensor_type"_key,
+                        rpt->swell_sensor_type);
 
         if (rpt->water_temp_raw <= 600) {
-          DictSafeSetItem(rpt_dict, "water_temp", rpt->water_temp);
+          DictSafeSetItem(rpt_dict, "water_temp"_key, rpt->water_temp);
         } else {
-          DictSafeSetItem(rpt_dict, "water_temp", Py_None);
+          DictSafeSetItem(rpt_dict, "water_temp"_key, Py_None);
         }
 
         if (rpt->water_temp_depth_raw <= 121) {
-          DictSafeSetItem(rpt_dict, "water_temp_depth", rpt->water_temp_depth);
+          DictSafeSetItem(rpt_dict, "water_temp_depth"_key,
+                          rpt->water_temp_depth);
         } else {
-          DictSafeSetItem(rpt_dict, "water_temp_depth", Py_None);
+          DictSafeSetItem(rpt_dict, "water_temp_depth"_key, Py_None);
         }
 
-        DictSafeSetItem(rpt_dict, "water_sensor_type", rpt->water_sensor_type);
+        DictSafeSetItem(rpt_dict, "water_sensor_type"_key,
+                        rpt->water_sensor_type);
 
         if (rpt->wave_height_raw <= 246) {
-          DictSafeSetItem(rpt_dict, "wave_height", rpt->wave_height);
+          DictSafeSetItem(rpt_dict, "wave_height"_key, rpt->wave_height);
         } else {
-          DictSafeSetItem(rpt_dict, "wave_height", Py_None);
+          DictSafeSetItem(rpt_dict, "wave_height"_key, Py_None);
         }
 
         if (rpt->wave_period <= 60) {
-          DictSafeSetItem(rpt_dict, "wave_period", rpt->wave_period);
+          DictSafeSetItem(rpt_dict, "wave_period"_key, rpt->wave_period);
         } else {
-          DictSafeSetItem(rpt_dict, "wave_period", Py_None);
+          DictSafeSetItem(rpt_dict, "wave_period"_key, Py_None);
         }
 
         if (rpt->wave_dir <= 359) {
-          DictSafeSetItem(rpt_dict, "wave_dir", rpt->wave_dir);
+          DictSafeSetItem(rpt_dict, "wave_dir"_key, rpt->wave_dir);
         } else {
-          DictSafeSetItem(rpt_dict, "wave_dir", Py_None);
+          DictSafeSetItem(rpt_dict, "wave_dir"_key, Py_None);
         }
 
-        DictSafeSetItem(rpt_dict, "wave_sensor_type", rpt->wave_sensor_type);
+        DictSafeSetItem(rpt_dict, "wave_sensor_type"_key,
+                        rpt->wave_sensor_type);
 
         if (rpt->salinity_raw <= 501) {
-          DictSafeSetItem(rpt_dict, "salinity", rpt->salinity);
+          DictSafeSetItem(rpt_dict, "salinity"_key, rpt->salinity);
         } else {
-          DictSafeSetItem(rpt_dict, "salinity", Py_None);
+          DictSafeSetItem(rpt_dict, "salinity"_key, Py_None);
         }
 
       }
@@ -2554,33 +2448,33 @@ ais8_367_33_append_pydict(const char *nmea_payload, PyObject *dict,
         ais8_367_33_append_pydict_sensor_hdr(rpt_dict, rpt);
 
         if (rpt->water_temp_raw <= 600) {
-          DictSafeSetItem(rpt_dict, "water_temp", rpt->water_temp);
+          DictSafeSetItem(rpt_dict, "water_temp"_key, rpt->water_temp);
         } else {
-          DictSafeSetItem(rpt_dict, "water_temp", Py_None);
+          DictSafeSetItem(rpt_dict, "water_temp"_key, Py_None);
         }
 
         if (rpt->conductivity_raw <= 701) {
-          DictSafeSetItem(rpt_dict, "conductivity", rpt->conductivity);
+          DictSafeSetItem(rpt_dict, "conductivity"_key, rpt->conductivity);
         } else {
-          DictSafeSetItem(rpt_dict, "conductivity", Py_None);
+          DictSafeSetItem(rpt_dict, "conductivity"_key, Py_None);
         }
 
         if (rpt->pressure_raw <= 60001) {
-          DictSafeSetItem(rpt_dict, "pressure", rpt->pressure);
+          DictSafeSetItem(rpt_dict, "pressure"_key, rpt->pressure);
         } else {
-          DictSafeSetItem(rpt_dict, "pressure", Py_None);
+          DictSafeSetItem(rpt_dict, "pressure"_key, Py_None);
         }
 
         if (rpt->salinity_raw <= 501) {
-          DictSafeSetItem(rpt_dict, "salinity", rpt->salinity);
+          DictSafeSetItem(rpt_dict, "salinity"_key, rpt->salinity);
         } else {
-          DictSafeSetItem(rpt_dict, "salinity", Py_None);
+          DictSafeSetItem(rpt_dict, "salinity"_key, Py_None);
         }
 
-        DictSafeSetItem(rpt_dict, "salinity_type", rpt->salinity_type);
-        DictSafeSetItem(rpt_dict, "sensor_type", rpt->sensor_type);
-        DictSafeSetItem(rpt_dict, "spare0", rpt->spare2[0]);
-        DictSafeSetItem(rpt_dict, "spare1", rpt->spare2[1]);
+        DictSafeSetItem(rpt_dict, "salinity_type"_key, rpt->salinity_type);
+        DictSafeSetItem(rpt_dict, "sensor_type"_key, rpt->sensor_type);
+        DictSafeSetItem(rpt_dict, "spare0"_key, rpt->spare2[0]);
+        DictSafeSetItem(rpt_dict, "spare1"_key, rpt->spare2[1]);
       }
       break;
     case AIS8_367_33_SENSOR_WX:
@@ -2591,47 +2485,48 @@ ais8_367_33_append_pydict(const char *nmea_payload, PyObject *dict,
         ais8_367_33_append_pydict_sensor_hdr(rpt_dict, rpt);
 
         if (rpt->air_temp_raw >= -600 && rpt->air_temp_raw <= 600) {
-          DictSafeSetItem(rpt_dict, "air_temp", rpt->air_temp);
+          DictSafeSetItem(rpt_dict, "air_temp"_key, rpt->air_temp);
         } else {
-          DictSafeSetItem(rpt_dict, "air_temp", Py_None);
+          DictSafeSetItem(rpt_dict, "air_temp"_key, Py_None);
         }
 
-        DictSafeSetItem(rpt_dict, "air_temp_sensor_type",
+        DictSafeSetItem(rpt_dict, "air_temp_sensor_type"_key,
                         rpt->air_temp_sensor_type);
-        DictSafeSetItem(rpt_dict, "precip", rpt->precip);
+        DictSafeSetItem(rpt_dict, "precip"_key, rpt->precip);
 
         if (rpt->horz_vis_raw <= 241) {
-          DictSafeSetItem(rpt_dict, "horz_vis", rpt->horz_vis);
+          DictSafeSetItem(rpt_dict, "horz_vis"_key, rpt->horz_vis);
         } else {
-          DictSafeSetItem(rpt_dict, "horz_vis", Py_None);
+          DictSafeSetItem(rpt_dict, "horz_vis"_key, Py_None);
         }
 
         // Not sure how to map 702 and 703 to Python.
         if (rpt->dew_point_raw <= 700) {
-          DictSafeSetItem(rpt_dict, "dew_point", rpt->dew_point);
+          DictSafeSetItem(rpt_dict, "dew_point"_key, rpt->dew_point);
         } else {
-          DictSafeSetItem(rpt_dict, "dew_point", Py_None);
+          DictSafeSetItem(rpt_dict, "dew_point"_key, Py_None);
         }
 
-        DictSafeSetItem(rpt_dict, "dew_point_type", rpt->dew_point_type);
+        DictSafeSetItem(rpt_dict, "dew_point_type"_key, rpt->dew_point_type);
 
         if (rpt->air_pressure_raw <= 402) {
-          DictSafeSetItem(rpt_dict, "air_pressure", rpt->air_pressure);
+          DictSafeSetItem(rpt_dict, "air_pressure"_key, rpt->air_pressure);
         } else {
-          DictSafeSetItem(rpt_dict, "air_pressure", Py_None);
+          DictSafeSetItem(rpt_dict, "air_pressure"_key, Py_None);
         }
 
-        DictSafeSetItem(rpt_dict, "air_pressure_trend",
+        DictSafeSetItem(rpt_dict, "air_pressure_trend"_key,
                         rpt->air_pressure_trend);
-        DictSafeSetItem(rpt_dict, "air_pressure_sensor_type", rpt->air_pressure_sensor_type);
+        DictSafeSetItem(rpt_dict, "air_pressure_sensor_type"_key,
+                        rpt->air_pressure_sensor_type);
 
         if (rpt->salinity_raw <= 501) {
-          DictSafeSetItem(rpt_dict, "salinity", rpt->salinity);
+          DictSafeSetItem(rpt_dict, "salinity"_key, rpt->salinity);
         } else {
-          DictSafeSetItem(rpt_dict, "salinity", Py_None);
+          DictSafeSetItem(rpt_dict, "salinity"_key, Py_None);
         }
 
-        DictSafeSetItem(rpt_dict, "spare2", rpt->spare2);
+        DictSafeSetItem(rpt_dict, "spare2"_key, rpt->spare2);
       }
       break;
     case AIS8_367_33_SENSOR_AIR_GAP:
@@ -2642,44 +2537,48 @@ ais8_367_33_append_pydict(const char *nmea_payload, PyObject *dict,
         ais8_367_33_append_pydict_sensor_hdr(rpt_dict, rpt);
 
         if (rpt->air_draught != 0) {
-          DictSafeSetItem(rpt_dict, "air_draught", rpt->air_draught);
+          DictSafeSetItem(rpt_dict, "air_draught"_key, rpt->air_draught);
         } else {
-          DictSafeSetItem(rpt_dict, "air_draught", Py_None);
+          DictSafeSetItem(rpt_dict, "air_draught"_key, Py_None);
         }
 
         if (rpt->air_gap != 0) {
-          DictSafeSetItem(rpt_dict, "air_gap", rpt->air_gap);
+          DictSafeSetItem(rpt_dict, "air_gap"_key, rpt->air_gap);
         } else {
-          DictSafeSetItem(rpt_dict, "air_gap", Py_None);
+          DictSafeSetItem(rpt_dict, "air_gap"_key, Py_None);
         }
 
-        DictSafeSetItem(rpt_dict, "air_gap_trend", rpt->air_gap_trend);
+        DictSafeSetItem(rpt_dict, "air_gap_trend"_key, rpt->air_gap_trend);
 
         if (rpt->predicted_air_gap != 0) {
-          DictSafeSetItem(rpt_dict, "predicted_air_gap", rpt->predicted_air_gap);
+          DictSafeSetItem(rpt_dict, "predicted_air_gap"_key,
+                          rpt->predicted_air_gap);
         } else {
-          DictSafeSetItem(rpt_dict, "predicted_air_gap", Py_None);
+          DictSafeSetItem(rpt_dict, "predicted_air_gap"_key, Py_None);
         }
 
         if (rpt->utc_day_forecast != 0) {
-          DictSafeSetItem(rpt_dict, "utc_day_forecast", rpt->utc_day_forecast);
+          DictSafeSetItem(rpt_dict, "utc_day_forecast"_key,
+                          rpt->utc_day_forecast);
         } else {
-          DictSafeSetItem(rpt_dict, "utc_day_forecast", Py_None);
+          DictSafeSetItem(rpt_dict, "utc_day_forecast"_key, Py_None);
         }
 
         if (rpt->utc_hour_forecast <= 23) {
-          DictSafeSetItem(rpt_dict, "utc_hour_forecast", rpt->utc_hour_forecast);
+          DictSafeSetItem(rpt_dict, "utc_hour_forecast"_key,
+                          rpt->utc_hour_forecast);
         } else {
-          DictSafeSetItem(rpt_dict, "utc_hour_forecast", Py_None);
+          DictSafeSetItem(rpt_dict, "utc_hour_forecast"_key, Py_None);
         }
 
         if (rpt->utc_min_forecast <= 59) {
-          DictSafeSetItem(rpt_dict, "utc_min_forecast", rpt->utc_min_forecast);
+          DictSafeSetItem(rpt_dict, "utc_min_forecast"_key,
+                          rpt->utc_min_forecast);
         } else {
-          DictSafeSetItem(rpt_dict, "utc_min_forecast", Py_None);
+          DictSafeSetItem(rpt_dict, "utc_min_forecast"_key, Py_None);
         }
 
-        DictSafeSetItem(rpt_dict, "spare2", rpt->spare2);
+        DictSafeSetItem(rpt_dict, "spare2"_key, rpt->spare2);
       }
       break;
     case AIS8_367_33_SENSOR_WIND_REPORT_2:
@@ -2690,63 +2589,68 @@ ais8_367_33_append_pydict(const char *nmea_payload, PyObject *dict,
         ais8_367_33_append_pydict_sensor_hdr(rpt_dict, rpt);
 
         if (rpt->wind_speed <= 121) {
-          DictSafeSetItem(rpt_dict, "wind_speed", rpt->wind_speed);
+          DictSafeSetItem(rpt_dict, "wind_speed"_key, rpt->wind_speed);
         } else {
-          DictSafeSetItem(rpt_dict, "wind_speed", Py_None);
+          DictSafeSetItem(rpt_dict, "wind_speed"_key, Py_None);
         }
 
         if (rpt->wind_gust <= 121) {
-          DictSafeSetItem(rpt_dict, "wind_gust", rpt->wind_gust);
+          DictSafeSetItem(rpt_dict, "wind_gust"_key, rpt->wind_gust);
         } else {
-          DictSafeSetItem(rpt_dict, "wind_gust", Py_None);
+          DictSafeSetItem(rpt_dict, "wind_gust"_key, Py_None);
         }
 
         if (rpt->wind_dir <= 359) {
-          DictSafeSetItem(rpt_dict, "wind_dir", rpt->wind_dir);
+          DictSafeSetItem(rpt_dict, "wind_dir"_key, rpt->wind_dir);
         } else {
-          DictSafeSetItem(rpt_dict, "wind_dir", Py_None);
+          DictSafeSetItem(rpt_dict, "wind_dir"_key, Py_None);
         }
 
         if (rpt->averaging_time >= 1 && rpt->averaging_time <= 61) {
-          DictSafeSetItem(rpt_dict, "averaging_time", rpt->averaging_time);
+          DictSafeSetItem(rpt_dict, "averaging_time"_key, rpt->averaging_time);
         } else {
-          DictSafeSetItem(rpt_dict, "averaging_time", Py_None);
+          DictSafeSetItem(rpt_dict, "averaging_time"_key, Py_None);
         }
 
-        DictSafeSetItem(rpt_dict, "sensor_type", rpt->sensor_type);
+        DictSafeSetItem(rpt_dict, "sensor_type"_key, rpt->sensor_type);
 
         if (rpt->wind_speed_forecast <= 121) {
-          DictSafeSetItem(rpt_dict, "wind_speed_forecast", rpt->wind_speed_forecast);
+          DictSafeSetItem(rpt_dict, "wind_speed_forecast"_key,
+                          rpt->wind_speed_forecast);
         } else {
-          DictSafeSetItem(rpt_dict, "wind_speed_forecast", Py_None);
+          DictSafeSetItem(rpt_dict, "wind_speed_forecast"_key, Py_None);
         }
 
         if (rpt->wind_gust_forecast <= 121) {
-          DictSafeSetItem(rpt_dict, "wind_gust_forecast", rpt->wind_gust_forecast);
+          DictSafeSetItem(rpt_dict, "wind_gust_forecast"_key,
+                          rpt->wind_gust_forecast);
         } else {
-          DictSafeSetItem(rpt_dict, "wind_gust_forecast", Py_None);
+          DictSafeSetItem(rpt_dict, "wind_gust_forecast"_key, Py_None);
         }
 
         if (rpt->wind_dir_forecast <= 359) {
-          DictSafeSetItem(rpt_dict, "wind_dir_forecast", rpt->wind_dir_forecast);
+          DictSafeSetItem(rpt_dict, "wind_dir_forecast"_key,
+                          rpt->wind_dir_forecast);
         } else {
-          DictSafeSetItem(rpt_dict, "wind_dir_forecast", Py_None);
+          DictSafeSetItem(rpt_dict, "wind_dir_forecast"_key, Py_None);
         }
 
         if (rpt->utc_hour_forecast <= 23) {
-          DictSafeSetItem(rpt_dict, "utc_hour_forecast", rpt->utc_hour_forecast);
+          DictSafeSetItem(rpt_dict, "utc_hour_forecast"_key,
+                          rpt->utc_hour_forecast);
         } else {
-          DictSafeSetItem(rpt_dict, "utc_hour_forecast", Py_None);
+          DictSafeSetItem(rpt_dict, "utc_hour_forecast"_key, Py_None);
         }
 
         if (rpt->utc_min_forecast <= 59) {
-          DictSafeSetItem(rpt_dict, "utc_min_forecast", rpt->utc_min_forecast);
+          DictSafeSetItem(rpt_dict, "utc_min_forecast"_key,
+                          rpt->utc_min_forecast);
         } else {
-          DictSafeSetItem(rpt_dict, "utc_min_forecast", Py_None);
+          DictSafeSetItem(rpt_dict, "utc_min_forecast"_key, Py_None);
         }
 
-        DictSafeSetItem(rpt_dict, "duration", rpt->duration);
-        DictSafeSetItem(rpt_dict, "spare2", rpt->spare2);
+        DictSafeSetItem(rpt_dict, "duration"_key, rpt->duration);
+        DictSafeSetItem(rpt_dict, "spare2"_key, rpt->spare2);
       }
       break;
     case AIS8_367_33_SENSOR_RESERVED_12:
@@ -2762,12 +2666,10 @@ ais8_367_33_append_pydict(const char *nmea_payload, PyObject *dict,
 
 // AIS Binary broadcast messages.  There will be a huge number of subtypes
 // If we don't know how to decode it, just return the dac, fi
+// sub is the message for the DAC and FI from CreateAisMsg or nullptr if it
+// does not handle them.
 PyObject*
-ais8_to_pydict(const char *nmea_payload, const size_t pad) {
-  assert(nmea_payload);
-  assert(pad < 6);
-
-  Ais8 msg(nmea_payload, pad);
+ais8_to_pydict(const Ais8 &msg, const AisMsg *sub) {
   if (msg.had_error() && msg.get_error() != AIS_UNINITIALIZED) {
     PyErr_Format(ais_py_exception, "Ais8: %s",
                  AIS_STATUS_STRINGS[msg.get_error()]);
@@ -2775,100 +2677,100 @@ ais8_to_pydict(const char *nmea_payload, const size_t pad) {
   }
 
   PyObject *dict = ais_msg_to_pydict(&msg);
-  DictSafeSetItem(dict, "spare", msg.spare);
-  DictSafeSetItem(dict, "dac", msg.dac);
-  DictSafeSetItem(dict, "fi", msg.fi);
+  DictSafeSetItem(dict, "spare"_key, msg.spare);
+  DictSafeSetItem(dict, "dac"_key, msg.dac);
+  DictSafeSetItem(dict, "fi"_key, msg.fi);
 
   AIS_STATUS status = AIS_UNINITIALIZED;
 
-  switch (msg.dac) {
+  switch (sub == nullptr ? -1 : msg.dac) {
   case AIS_DAC_1_INTERNATIONAL:  // IMO.
     switch (msg.fi) {
       // See: ITU-R.M.1371-3 IFM messages Annex 5, Section 5 and IMO Circ 289
     case AIS_FI_8_1_0_TEXT:
-      status = ais8_1_0_append_pydict(nmea_payload, dict, pad);
+      status = ais8_1_0_append_pydict(SubMsg<Ais8_1_0>(sub), dict);
       break;
     case AIS_FI_8_1_11_MET_HYDRO:  // Not to be used after 1 Jan 2013.
-      status = ais8_1_11_append_pydict(nmea_payload, dict, pad);
+      status = ais8_1_11_append_pydict(SubMsg<Ais8_1_11>(sub), dict);
       break;
     case AIS_FI_8_1_13_FAIRWAY_CLOSED:  // Not to be used after 1 Jan 2013.
       // TODO(schwehr): untested - no messages found
-      status = ais8_1_13_append_pydict(nmea_payload, dict, pad);
+      status = ais8_1_13_append_pydict(SubMsg<Ais8_1_13>(sub), dict);
       break;
     case AIS_FI_8_1_15_SHIP_AND_VOYAGE:  // Not after 1 Jan 2013.
       // TODO(schwehr): untested - no messages found
-      status = ais8_1_15_append_pydict(nmea_payload, dict, pad);
+      status = ais8_1_15_append_pydict(SubMsg<Ais8_1_15>(sub), dict);
       break;
       // 16 has conflicting definition in the old 1371-1: VTS targets.
     case AIS_FI_8_1_16_PERSONS_ON_BOARD:  // Not to be used after 1 Jan 2013.
-      status = ais8_1_16_append_pydict(nmea_payload, dict, pad);
+      status = ais8_1_16_append_pydict(SubMsg<Ais8_1_16>(sub), dict);
       break;
       // 17 has conflicting definitions in 1371-1: IFM 17: Ship waypoints
       // and/or route plan report.
     case AIS_FI_8_1_17_VTS_TARGET:  // Not to be used after Jan 2013.
       // TODO(schwehr): Untested. no messages found.
-      status = ais8_1_17_append_pydict(nmea_payload, dict, pad);
+      status = ais8_1_17_append_pydict(SubMsg<Ais8_1_17>(sub), dict);
       break;
       // ITU 1371-1 conflict: IFM 19: Extended ship static and voyage.
     case AIS_FI_8_1_19_TRAFFIC_SIGNAL:
       // TODO(schwehr): Untested. No messages found.
-      status = ais8_1_19_append_pydict(nmea_payload, dict, pad);
-      DictSafeSetItem(dict, "parsed", true);
+      status = ais8_1_19_append_pydict(SubMsg<Ais8_1_19>(sub), dict);
+      DictSafeSetItem(dict, "parsed"_key, true);
       break;
       // 20:  Berthing data.
     case AIS_FI_8_1_21_WEATHER_OBS:
       // TODO(schwehr): untested - no messages found
-      status = ais8_1_21_append_pydict(nmea_payload, dict, pad);
+      status = ais8_1_21_append_pydict(SubMsg<Ais8_1_21>(sub), dict);
       break;
     case AIS_FI_8_1_22_AREA_NOTICE:
-      status = ais8_1_22_append_pydict(nmea_payload, dict, pad);
+      status = ais8_1_22_append_pydict(SubMsg<Ais8_1_22>(sub), dict);
       break;
     case AIS_FI_8_1_24_SHIP_AND_VOYAGE:
-      status = ais8_1_24_append_pydict(nmea_payload, dict, pad);
+      status = ais8_1_24_append_pydict(SubMsg<Ais8_1_24>(sub), dict);
       break;
     case AIS_FI_8_1_26_SENSOR:
-      status = ais8_1_26_append_pydict(nmea_payload, dict, pad);
+      status = ais8_1_26_append_pydict(SubMsg<Ais8_1_26>(sub), dict);
       break;
     case AIS_FI_8_1_27_ROUTE:
-      status = ais8_1_27_append_pydict(nmea_payload, dict, pad);
+      status = ais8_1_27_append_pydict(SubMsg<Ais8_1_27>(sub), dict);
       break;
     case AIS_FI_8_1_29_TEXT:
-      status = ais8_1_29_append_pydict(nmea_payload, dict, pad);
+      status = ais8_1_29_append_pydict(SubMsg<Ais8_1_29>(sub), dict);
       break;
     case AIS_FI_8_1_31_MET_HYDRO:
-      status = ais8_1_31_append_pydict(nmea_payload, dict, pad);
+      status = ais8_1_31_append_pydict(SubMsg<Ais8_1_31>(sub), dict);
       break;
       // ITU 1371-1 only: 3.10 - IFM 40: Number of persons on board.
     default:
-      DictSafeSetItem(dict, "parsed", false);
+      DictSafeSetItem(dict, "parsed"_key, false);
       break;
     }
     break;
   case AIS_DAC_200_RIS:
     switch (msg.fi) {
     case AIS_FI_8_200_10_RIS_SHIP_AND_VOYAGE:
-      status = ais8_200_10_append_pydict(nmea_payload, dict, pad);
+      status = ais8_200_10_append_pydict(SubMsg<Ais8_200_10>(sub), dict);
       break;
     case AIS_FI_8_200_21_RIS_ETA_AT_LOCK_BRIDGE_TERMINAL:
-      status = ais8_200_21_append_pydict(nmea_payload, dict, pad);
+      status = ais8_200_21_append_pydict(SubMsg<Ais8_200_21>(sub), dict);
       break;
     case AIS_FI_8_200_22_RIS_RTA_AT_LOCK_BRIDGE_TERMINAL:
-      status = ais8_200_22_append_pydict(nmea_payload, dict, pad);
+      status = ais8_200_22_append_pydict(SubMsg<Ais8_200_22>(sub), dict);
       break;
     case AIS_FI_8_200_23_RIS_EMMA_WARNING:
-      status = ais8_200_23_append_pydict(nmea_payload, dict, pad);
+      status = ais8_200_23_append_pydict(SubMsg<Ais8_200_23>(sub), dict);
       break;
     case AIS_FI_8_1_24_SHIP_AND_VOYAGE:
-      status = ais8_200_24_append_pydict(nmea_payload, dict, pad);
+      status = ais8_200_24_append_pydict(SubMsg<Ais8_200_24>(sub), dict);
       break;
     case AIS_FI_8_200_40_RIS_ATON_SIGNAL_STATUS:
-      status = ais8_200_40_append_pydict(nmea_payload, dict, pad);
+      status = ais8_200_40_append_pydict(SubMsg<Ais8_200_40>(sub), dict);
       break;
     case AIS_FI_8_200_55_RIS_PERSONS_ON_BOARD:
-      status = ais8_200_55_append_pydict(nmea_payload, dict, pad);
+      status = ais8_200_55_append_pydict(SubMsg<Ais8_200_55>(sub), dict);
       break;
     default:
-      DictSafeSetItem(dict, "parsed", false);
+      DictSafeSetItem(dict, "parsed"_key, false);
       break;
     }
     break;
@@ -2876,27 +2778,27 @@ ais8_to_pydict(const char *nmea_payload, const size_t pad) {
   case 367:  // United states.
     switch (msg.fi) {
     case 22:  // USCG Area Notice 2012 (v5?).
-      ais8_367_22_append_pydict(nmea_payload, dict, pad);
+      ais8_367_22_append_pydict(SubMsg<Ais8_367_22>(sub), dict);
       break;
     case AIS_FI_8_367_23_SSW:
-      status = ais8_367_23_append_pydict(nmea_payload, dict, pad);
+      status = ais8_367_23_append_pydict(SubMsg<Ais8_367_23>(sub), dict);
       break;
     case AIS_FI_8_367_24_SSW_SMALL:
-      status = ais8_367_24_append_pydict(nmea_payload, dict, pad);
+      status = ais8_367_24_append_pydict(SubMsg<Ais8_367_24>(sub), dict);
       break;
     case AIS_FI_8_367_25_SSW_TINY:
-      status = ais8_367_25_append_pydict(nmea_payload, dict, pad);
+      status = ais8_367_25_append_pydict(SubMsg<Ais8_367_25>(sub), dict);
       break;
     case AIS_FI_8_367_33_ENVIRONMENTAL:
-      status = ais8_367_33_append_pydict(nmea_payload, dict, pad);
+      status = ais8_367_33_append_pydict(SubMsg<Ais8_367_33>(sub), dict);
       break;
     default:
-      DictSafeSetItem(dict, "parsed", false);
+      DictSafeSetItem(dict, "parsed"_key, false);
       break;
     }
     break;
   default:
-    DictSafeSetItem(dict, "parsed", false);
+    DictSafeSetItem(dict, "parsed"_key, false);
     // TODO(schwehr): raise exception or return standin?
   }
 
@@ -2912,9 +2814,7 @@ ais8_to_pydict(const char *nmea_payload, const size_t pad) {
 
 // Aircraft position report
 PyObject*
-ais9_to_pydict(const char *nmea_payload, const size_t pad) {
-  assert(nmea_payload);
-  Ais9 msg(nmea_payload, pad);
+ais9_to_pydict(const Ais9 &msg) {
   if (msg.had_error()) {
     PyErr_Format(ais_py_exception, "Ais9: %s",
                  AIS_STATUS_STRINGS[msg.get_error()]);
@@ -2923,43 +2823,28 @@ ais9_to_pydict(const char *nmea_payload, const size_t pad) {
 
   PyObject *dict = ais_msg_to_pydict(&msg);
 
-  DictSafeSetItem(dict, "alt", msg.alt);
-  DictSafeSetItem(dict, "sog", msg.sog);
-
-  DictSafeSetItem(dict, "position_accuracy", msg.position_accuracy);
-  DictSafeSetItem(dict, "x", "y", msg.position);
-
-  DictSafeSetItem(dict, "cog", msg.cog);
-  DictSafeSetItem(dict, "timestamp", msg.timestamp);
-  DictSafeSetItem(dict, "alt_sensor", msg.alt_sensor);
-  DictSafeSetItem(dict, "spare", msg.spare);
-  DictSafeSetItem(dict, "dte", msg.dte);
-  DictSafeSetItem(dict, "spare2", msg.spare2);
-  DictSafeSetItem(dict, "assigned_mode", msg.assigned_mode);
-  DictSafeSetItem(dict, "raim", msg.raim);
-
-  DictSafeSetItem(dict, "sync_state", msg.sync_state);
+  DictSafeSetFields<kAis9Layout>(dict, msg);
 
   if (0 == msg.commstate_flag) {
     // SOTMDA
-    DictSafeSetItem(dict, "slot_timeout", msg.slot_timeout);
+    DictSafeSetItem(dict, "slot_timeout"_key, msg.slot_timeout);
 
     if (msg.received_stations_valid)
-      DictSafeSetItem(dict, "received_stations", msg.received_stations);
+      DictSafeSetItem(dict, "received_stations"_key, msg.received_stations);
     if (msg.slot_number_valid)
-      DictSafeSetItem(dict, "slot_number", msg.slot_number);
+      DictSafeSetItem(dict, "slot_number"_key, msg.slot_number);
     if (msg.utc_valid) {
-      DictSafeSetItem(dict, "utc_hour", msg.utc_hour);
-      DictSafeSetItem(dict, "utc_min", msg.utc_min);
-      DictSafeSetItem(dict, "utc_spare", msg.utc_spare);
+      DictSafeSetItem(dict, "utc_hour"_key, msg.utc_hour);
+      DictSafeSetItem(dict, "utc_min"_key, msg.utc_min);
+      DictSafeSetItem(dict, "utc_spare"_key, msg.utc_spare);
     }
     if (msg.slot_offset_valid)
-      DictSafeSetItem(dict, "slot_offset", msg.slot_offset);
+      DictSafeSetItem(dict, "slot_offset"_key, msg.slot_offset);
   } else {
     // ITDMA
-    DictSafeSetItem(dict, "slot_increment", msg.slot_increment);
-    DictSafeSetItem(dict, "slots_to_allocate", msg.slots_to_allocate);
-    DictSafeSetItem(dict, "keep_flag", msg.keep_flag);
+    DictSafeSetItem(dict, "slot_increment"_key, msg.slot_increment);
+    DictSafeSetItem(dict, "slots_to_allocate"_key, msg.slots_to_allocate);
+    DictSafeSetItem(dict, "keep_flag"_key, msg.keep_flag);
   }
 
   return dict;
@@ -2967,11 +2852,7 @@ ais9_to_pydict(const char *nmea_payload, const size_t pad) {
 
 // 10 - ':' - UTC and date inquiry
 PyObject*
-ais10_to_pydict(const char *nmea_payload, const size_t pad) {
-  assert(nmea_payload);
-  assert(pad < 6);
-
-  Ais10 msg(nmea_payload, pad);
+ais10_to_pydict(const Ais10 &msg) {
   if (msg.had_error()) {
     PyErr_Format(ais_py_exception, "Ais10: %s",
                  AIS_STATUS_STRINGS[msg.get_error()]);
@@ -2980,9 +2861,9 @@ ais10_to_pydict(const char *nmea_payload, const size_t pad) {
 
   PyObject *dict = ais_msg_to_pydict(&msg);
 
-  DictSafeSetItem(dict, "spare", msg.spare);
-  DictSafeSetItem(dict, "dest_mmsi", msg.dest_mmsi);
-  DictSafeSetItem(dict, "spare2", msg.spare2);
+  DictSafeSetItem(dict, "spare"_key, msg.spare);
+  DictSafeSetItem(dict, "dest_mmsi"_key, msg.dest_mmsi);
+  DictSafeSetItem(dict, "spare2"_key, msg.spare2);
 
   return dict;
 }
@@ -2991,9 +2872,7 @@ ais10_to_pydict(const char *nmea_payload, const size_t pad) {
 
 // 12 - '<' - Addressed safety related text
 PyObject*
-ais12_to_pydict(const char *nmea_payload, const size_t pad) {
-  assert(nmea_payload);
-  Ais12 msg(nmea_payload, pad);
+ais12_to_pydict(const Ais12 &msg) {
   if (msg.had_error()) {
     PyErr_Format(ais_py_exception, "Ais12: %s",
                  AIS_STATUS_STRINGS[msg.get_error()]);
@@ -3002,12 +2881,12 @@ ais12_to_pydict(const char *nmea_payload, const size_t pad) {
 
   PyObject *dict = ais_msg_to_pydict(&msg);
 
-  DictSafeSetItem(dict, "seq_num", msg.seq_num);
-  DictSafeSetItem(dict, "dest_mmsi", msg.dest_mmsi);
-  DictSafeSetItem(dict, "retransmitted", msg.retransmitted);
+  DictSafeSetItem(dict, "seq_num"_key, msg.seq_num);
+  DictSafeSetItem(dict, "dest_mmsi"_key, msg.dest_mmsi);
+  DictSafeSetItem(dict, "retransmitted"_key, msg.retransmitted);
 
-  DictSafeSetItem(dict, "spare", msg.spare);
-  DictSafeSetItem(dict, "text", msg.text);
+  DictSafeSetItem(dict, "spare"_key, msg.spare);
+  DictSafeSetItem(dict, "text"_key, msg.text);
 
   return dict;
 }
@@ -3016,9 +2895,7 @@ ais12_to_pydict(const char *nmea_payload, const size_t pad) {
 
 // 14 - '>' - Safety broadcast text
 PyObject*
-ais14_to_pydict(const char *nmea_payload, const size_t pad) {
-  assert(nmea_payload);
-  Ais14 msg(nmea_payload, pad);
+ais14_to_pydict(const Ais14 &msg) {
 
   if (msg.had_error()) {
     PyErr_Format(ais_py_exception, "Ais14: %s",
@@ -3027,18 +2904,16 @@ ais14_to_pydict(const char *nmea_payload, const size_t pad) {
   }
 
   PyObject *dict = ais_msg_to_pydict(&msg);
-  DictSafeSetItem(dict, "spare", msg.spare);
-  DictSafeSetItem(dict, "text", msg.text);
-  DictSafeSetItem(dict, "spare2", msg.spare2);
+  DictSafeSetItem(dict, "spare"_key, msg.spare);
+  DictSafeSetItem(dict, "text"_key, msg.text);
+  DictSafeSetItem(dict, "spare2"_key, msg.spare2);
 
   return dict;
 }
 
 // 15 - '?' - Interrogation
 PyObject*
-ais15_to_pydict(const char *nmea_payload, const size_t pad) {
-  assert(nmea_payload);
-  Ais15 msg(nmea_payload, pad);
+ais15_to_pydict(const Ais15 &msg) {
 
   if (msg.had_error()) {
     PyErr_Format(ais_py_exception, "Ais15: %s",
@@ -3048,29 +2923,27 @@ ais15_to_pydict(const char *nmea_payload, const size_t pad) {
 
   PyObject *dict = ais_msg_to_pydict(&msg);
 
-  DictSafeSetItem(dict, "spare", msg.spare);
-  DictSafeSetItem(dict, "mmsi_1", msg.mmsi_1);
-  DictSafeSetItem(dict, "msg_1_1", msg.msg_1_1);
-  DictSafeSetItem(dict, "slot_offset_1_1", msg.slot_offset_1_1);
+  DictSafeSetItem(dict, "spare"_key, msg.spare);
+  DictSafeSetItem(dict, "mmsi_1"_key, msg.mmsi_1);
+  DictSafeSetItem(dict, "msg_1_1"_key, msg.msg_1_1);
+  DictSafeSetItem(dict, "slot_offset_1_1"_key, msg.slot_offset_1_1);
 
-  DictSafeSetItem(dict, "spare2", msg.spare2);
-  DictSafeSetItem(dict, "dest_msg_1_2", msg.dest_msg_1_2);
-  DictSafeSetItem(dict, "slot_offset_1_2", msg.slot_offset_1_2);
+  DictSafeSetItem(dict, "spare2"_key, msg.spare2);
+  DictSafeSetItem(dict, "dest_msg_1_2"_key, msg.dest_msg_1_2);
+  DictSafeSetItem(dict, "slot_offset_1_2"_key, msg.slot_offset_1_2);
 
-  DictSafeSetItem(dict, "spare3", msg.spare3);
-  DictSafeSetItem(dict, "mmsi_2", msg.mmsi_2);
-  DictSafeSetItem(dict, "msg_2", msg.msg_2);
-  DictSafeSetItem(dict, "slot_offset_2", msg.slot_offset_2);
-  DictSafeSetItem(dict, "spare4", msg.spare4);
+  DictSafeSetItem(dict, "spare3"_key, msg.spare3);
+  DictSafeSetItem(dict, "mmsi_2"_key, msg.mmsi_2);
+  DictSafeSetItem(dict, "msg_2"_key, msg.msg_2);
+  DictSafeSetItem(dict, "slot_offset_2"_key, msg.slot_offset_2);
+  DictSafeSetItem(dict, "spare4"_key, msg.spare4);
 
   return dict;
 }
 
 // 16 - '@' - Assigned mode command
 PyObject*
-ais16_to_pydict(const char *nmea_payload, const size_t pad) {
-  assert(nmea_payload);
-  Ais16 msg(nmea_payload, pad);
+ais16_to_pydict(const Ais16 &msg) {
 
   if (msg.had_error()) {
     PyErr_Format(ais_py_exception, "Ais16: %s",
@@ -3080,16 +2953,16 @@ ais16_to_pydict(const char *nmea_payload, const size_t pad) {
 
   PyObject *dict = ais_msg_to_pydict(&msg);
 
-  DictSafeSetItem(dict, "spare", msg.spare);
-  DictSafeSetItem(dict, "dest_mmsi_a", msg.dest_mmsi_a);
-  DictSafeSetItem(dict, "offset_a", msg.offset_a);
-  DictSafeSetItem(dict, "inc_a", msg.inc_a);
+  DictSafeSetItem(dict, "spare"_key, msg.spare);
+  DictSafeSetItem(dict, "dest_mmsi_a"_key, msg.dest_mmsi_a);
+  DictSafeSetItem(dict, "offset_a"_key, msg.offset_a);
+  DictSafeSetItem(dict, "inc_a"_key, msg.inc_a);
 
-  if (-1 != msg.spare2) DictSafeSetItem(dict, "spare2", msg.spare2);
+  if (-1 != msg.spare2) DictSafeSetItem(dict, "spare2"_key, msg.spare2);
   if (-1 != msg.dest_mmsi_b) {
-    DictSafeSetItem(dict, "dest_mmsi_b", msg.dest_mmsi_b);
-    DictSafeSetItem(dict, "offset_b", msg.offset_b);
-    DictSafeSetItem(dict, "inc_b", msg.inc_b);
+    DictSafeSetItem(dict, "dest_mmsi_b"_key, msg.dest_mmsi_b);
+    DictSafeSetItem(dict, "offset_b"_key, msg.offset_b);
+    DictSafeSetItem(dict, "inc_b"_key, msg.inc_b);
   }
 
   return dict;
@@ -3097,9 +2970,7 @@ ais16_to_pydict(const char *nmea_payload, const size_t pad) {
 
 // 17 - 'A' - GNSS differential - TODO(schwehr): incomplete
 PyObject*
-ais17_to_pydict(const char *nmea_payload, const size_t pad) {
-  assert(nmea_payload);
-  Ais17 msg(nmea_payload, pad);
+ais17_to_pydict(const Ais17 &msg) {
 
   if (msg.had_error()) {
     PyErr_Format(ais_py_exception, "Ais17: %s",
@@ -3109,18 +2980,16 @@ ais17_to_pydict(const char *nmea_payload, const size_t pad) {
 
   PyObject *dict = ais_msg_to_pydict(&msg);
 
-  DictSafeSetItem(dict, "spare", msg.spare);
-  DictSafeSetItem(dict, "x", "y", msg.position);
-  DictSafeSetItem(dict, "spare2", msg.spare2);
+  DictSafeSetItem(dict, "spare"_key, msg.spare);
+  DictSafeSetItem(dict, "x"_key, "y"_key, msg.position);
+  DictSafeSetItem(dict, "spare2"_key, msg.spare2);
 
   return dict;
 }
 
 // 18 - 'B' - Class B position report.
 PyObject*
-ais18_to_pydict(const char *nmea_payload, const size_t pad) {
-  assert(nmea_payload);
-  Ais18 msg(nmea_payload, pad);
+ais18_to_pydict(const Ais18 &msg) {
   if (msg.had_error()) {
     PyErr_Format(ais_py_exception, "Ais18: %s",
                  AIS_STATUS_STRINGS[msg.get_error()]);
@@ -3129,53 +2998,35 @@ ais18_to_pydict(const char *nmea_payload, const size_t pad) {
 
   PyObject *dict = ais_msg_to_pydict(&msg);
 
-  DictSafeSetItem(dict, "spare", msg.spare);
-  DictSafeSetItem(dict, "sog", msg.sog);
-  DictSafeSetItem(dict, "position_accuracy", msg.position_accuracy);
-  DictSafeSetItem(dict, "x", "y", msg.position);
-  DictSafeSetItem(dict, "cog", msg.cog);
-  DictSafeSetItem(dict, "true_heading", msg.true_heading);
-  DictSafeSetItem(dict, "timestamp", msg.timestamp);
-
-  DictSafeSetItem(dict, "spare2", msg.spare2);
-
-  DictSafeSetItem(dict, "unit_flag", msg.unit_flag);
-  DictSafeSetItem(dict, "display_flag", msg.display_flag);
-  DictSafeSetItem(dict, "dsc_flag", msg.dsc_flag);
-  DictSafeSetItem(dict, "band_flag", msg.band_flag);
-  DictSafeSetItem(dict, "m22_flag", msg.m22_flag);
-  DictSafeSetItem(dict, "mode_flag", msg.mode_flag);
+  DictSafeSetFields<kAis18Layout>(dict, msg);
 
-  DictSafeSetItem(dict, "raim", msg.raim);
-
-  DictSafeSetItem(dict, "commstate_flag", msg.commstate_flag);
   if (msg.slot_timeout_valid) {
-    DictSafeSetItem(dict, "slot_timeout", msg.slot_timeout);
+    DictSafeSetItem(dict, "slot_timeout"_key, msg.slot_timeout);
   }
   if (msg.slot_offset_valid) {
-        DictSafeSetItem(dict, "slot_offset", msg.slot_offset);
+        DictSafeSetItem(dict, "slot_offset"_key, msg.slot_offset);
   }
   if (msg.utc_valid) {
-    DictSafeSetItem(dict, "utc_hour", msg.utc_hour);
-    DictSafeSetItem(dict, "utc_min", msg.utc_min);
-    DictSafeSetItem(dict, "utc_spare", msg.utc_spare);
+    DictSafeSetItem(dict, "utc_hour"_key, msg.utc_hour);
+    DictSafeSetItem(dict, "utc_min"_key, msg.utc_min);
+    DictSafeSetItem(dict, "utc_spare"_key, msg.utc_spare);
   }
   if (msg.slot_number_valid) {
-    DictSafeSetItem(dict, "slot_number", msg.slot_number);
+    DictSafeSetItem(dict, "slot_number"_key, msg.slot_number);
   }
   if (msg.received_stations_valid) {
-    DictSafeSetItem(dict, "received_stations", msg.received_stations);
+    DictSafeSetItem(dict, "received_stations"_key, msg.received_stations);
   }
 
   // ITDMA
   if (msg.slot_increment_valid) {
-    DictSafeSetItem(dict, "slot_increment", msg.slot_increment);
-    DictSafeSetItem(dict, "slots_to_allocate", msg.slots_to_allocate);
-    DictSafeSetItem(dict, "keep_flag", msg.keep_flag);
+    DictSafeSetItem(dict, "slot_increment"_key, msg.slot_increment);
+    DictSafeSetItem(dict, "slots_to_allocate"_key, msg.slots_to_allocate);
+    DictSafeSetItem(dict, "keep_flag"_key, msg.keep_flag);
   }
 
   if (msg.commstate_cs_fill_valid) {
-    DictSafeSetItem(dict, "commstate_cs_fill", msg.commstate_cs_fill);
+    DictSafeSetItem(dict, "commstate_cs_fill"_key, msg.commstate_cs_fill);
   }
 
   return dict;
@@ -3183,9 +3034,7 @@ ais18_to_pydict(const char *nmea_payload, const size_t pad) {
 
 // 19 - 'C' - Class B combined position report and ship data
 PyObject*
-ais19_to_pydict(const char *nmea_payload, const size_t pad) {
-  assert(nmea_payload);
-  Ais19 msg(nmea_payload, pad);
+ais19_to_pydict(const Ais19 &msg) {
   if (msg.had_error()) {
     PyErr_Format(ais_py_exception, "Ais19: %s",
                  AIS_STATUS_STRINGS[msg.get_error()]);
@@ -3194,38 +3043,14 @@ ais19_to_pydict(const char *nmea_payload, const size_t pad) {
 
   PyObject *dict = ais_msg_to_pydict(&msg);
 
-  DictSafeSetItem(dict, "spare", msg.spare);
-  DictSafeSetItem(dict, "sog", msg.sog);
-  DictSafeSetItem(dict, "position_accuracy", msg.position_accuracy);
-  DictSafeSetItem(dict, "x", "y", msg.position);
-  DictSafeSetItem(dict, "cog", msg.cog);
-  DictSafeSetItem(dict, "true_heading", msg.true_heading);
-  DictSafeSetItem(dict, "timestamp", msg.timestamp);
-
-  DictSafeSetItem(dict, "spare2", msg.spare2);
-
-  DictSafeSetItem(dict, "name", msg.name);
-  DictSafeSetItem(dict, "type_and_cargo", msg.type_and_cargo);
-  DictSafeSetItem(dict, "dim_a", msg.dim_a);
-  DictSafeSetItem(dict, "dim_b", msg.dim_b);
-  DictSafeSetItem(dict, "dim_c", msg.dim_c);
-  DictSafeSetItem(dict, "dim_d", msg.dim_d);
-  DictSafeSetItem(dict, "fix_type", msg.fix_type);
-
-  DictSafeSetItem(dict, "raim", msg.raim);
-
-  DictSafeSetItem(dict, "dte", msg.dte);
-  DictSafeSetItem(dict, "assigned_mode", msg.assigned_mode);
-  DictSafeSetItem(dict, "spare3", msg.spare3);
+  DictSafeSetFields<kAis19Layout>(dict, msg);
 
   return dict;
 }
 
 // 20 - 'D' - data link management
 PyObject*
-ais20_to_pydict(const char *nmea_payload, const size_t pad) {
-  assert(nmea_payload);
-  Ais20 msg(nmea_payload, pad);
+ais20_to_pydict(const Ais20 &msg) {
   if (msg.had_error()) {
     PyErr_Format(ais_py_exception, "Ais20: %s",
                  AIS_STATUS_STRINGS[msg.get_error()]);
@@ -3233,7 +3058,7 @@ ais20_to_pydict(const char *nmea_payload, const size_t pad) {
   }
 
   PyObject *dict = ais_msg_to_pydict(&msg);
-  DictSafeSetItem(dict, "spare", msg.spare);
+  DictSafeSetItem(dict, "spare"_key, msg.spare);
 
   int list_size = 1;
   if (msg.group_valid_4) list_size = 4;
@@ -3244,41 +3069,41 @@ ais20_to_pydict(const char *nmea_payload, const size_t pad) {
 
   {
     PyObject *reservation = PyDict_New();
-    DictSafeSetItem(reservation, "offset", msg.offset_1);
-    DictSafeSetItem(reservation, "num_slots", msg.num_slots_1);
-    DictSafeSetItem(reservation, "timeout", msg.timeout_1);
-    DictSafeSetItem(reservation, "incr", msg.incr_1);
+    DictSafeSetItem(reservation, "offset"_key, msg.offset_1);
+    DictSafeSetItem(reservation, "num_slots"_key, msg.num_slots_1);
+    DictSafeSetItem(reservation, "timeout"_key, msg.timeout_1);
+    DictSafeSetItem(reservation, "incr"_key, msg.incr_1);
     PyList_SetItem(list, 0, reservation);
   }
 
   if (msg.group_valid_2) {
     PyObject *reservation = PyDict_New();
-    DictSafeSetItem(reservation, "offset", msg.offset_2);
-    DictSafeSetItem(reservation, "num_slots", msg.num_slots_2);
-    DictSafeSetItem(reservation, "timeout", msg.timeout_2);
-    DictSafeSetItem(reservation, "incr", msg.incr_2);
+    DictSafeSetItem(reservation, "offset"_key, msg.offset_2);
+    DictSafeSetItem(reservation, "num_slots"_key, msg.num_slots_2);
+    DictSafeSetItem(reservation, "timeout"_key, msg.timeout_2);
+    DictSafeSetItem(reservation, "incr"_key, msg.incr_2);
     PyList_SetItem(list, 1, reservation);
   }
 
   if (msg.group_valid_3) {
     PyObject *reservation = PyDict_New();
-    DictSafeSetItem(reservation, "offset", msg.offset_3);
-    DictSafeSetItem(reservation, "num_slots", msg.num_slots_3);
-    DictSafeSetItem(reservation, "timeout", msg.timeout_3);
-    DictSafeSetItem(reservation, "incr", msg.incr_3);
+    DictSafeSetItem(reservation, "offset"_key, msg.offset_3);
+    DictSafeSetItem(reservation, "num_slots"_key, msg.num_slots_3);
+    DictSafeSetItem(reservation, "timeout"_key, msg.timeout_3);
+    DictSafeSetItem(reservation, "incr"_key, msg.incr_3);
     PyList_SetItem(list, 2, reservation);
   }
 
   if (msg.group_valid_4) {
     PyObject *reservation = PyDict_New();
-    DictSafeSetItem(reservation, "offset", msg.offset_4);
-    DictSafeSetItem(reservation, "num_slots", msg.num_slots_4);
-    DictSafeSetItem(reservation, "timeout", msg.timeout_4);
-    DictSafeSetItem(reservation, "incr", msg.incr_4);
+    DictSafeSetItem(reservation, "offset"_key, msg.offset_4);
+    DictSafeSetItem(reservation, "num_slots"_key, msg.num_slots_4);
+    DictSafeSetItem(reservation, "timeout"_key, msg.timeout_4);
+    DictSafeSetItem(reservation, "incr"_key, msg.incr_4);
     PyList_SetItem(list, 3, reservation);
   }
 
-  PyDict_SetItemString(dict, "reservations", list);
+  DictSafeSetItem(dict, "reservations"_key, list);
   Py_DECREF(list);
 
   return dict;
@@ -3287,9 +3112,7 @@ ais20_to_pydict(const char *nmea_payload, const size_t pad) {
 
 // 21 - 'E' - ATON Aid to Navigation
 PyObject*
-ais21_to_pydict(const char *nmea_payload, const size_t pad) {
-  assert(nmea_payload);
-  Ais21 msg(nmea_payload, pad);
+ais21_to_pydict(const Ais21 &msg) {
   if (msg.had_error()) {
     PyErr_Format(ais_py_exception, "Ais21: %s",
                  AIS_STATUS_STRINGS[msg.get_error()]);
@@ -3297,32 +3120,15 @@ ais21_to_pydict(const char *nmea_payload, const size_t pad) {
   }
 
   PyObject *dict = ais_msg_to_pydict(&msg);
-  DictSafeSetItem(dict, "spare", msg.spare);
-
-  DictSafeSetItem(dict, "aton_type", msg.aton_type);
-  DictSafeSetItem(dict, "name", msg.name);
-  DictSafeSetItem(dict, "position_accuracy", msg.position_accuracy);
-  DictSafeSetItem(dict, "x", "y", msg.position);
-  DictSafeSetItem(dict, "dim_a", msg.dim_a);
-  DictSafeSetItem(dict, "dim_b", msg.dim_b);
-  DictSafeSetItem(dict, "dim_c", msg.dim_c);
-  DictSafeSetItem(dict, "dim_d", msg.dim_d);
-  DictSafeSetItem(dict, "fix_type", msg.fix_type);
-  DictSafeSetItem(dict, "timestamp", msg.timestamp);
-  DictSafeSetItem(dict, "off_pos", msg.off_pos);
-  DictSafeSetItem(dict, "aton_status", msg.aton_status);
-  DictSafeSetItem(dict, "raim", msg.raim);
-  DictSafeSetItem(dict, "virtual_aton", msg.virtual_aton);
-  DictSafeSetItem(dict, "assigned_mode", msg.assigned_mode);
+  DictSafeSetFields<kAis21Layout>(dict, msg);
+  DictSafeSetFields<kAis21FlagsLayout>(dict, msg);
 
   return dict;
 }
 
 // 22 - 'F' - Channel management
 PyObject*
-ais22_to_pydict(const char *nmea_payload, const size_t pad) {
-  assert(nmea_payload);
-  Ais22 msg(nmea_payload, pad);
+ais22_to_pydict(const Ais22 &msg) {
   if (msg.had_error()) {
     PyErr_Format(ais_py_exception, "Ais22: %s",
                  AIS_STATUS_STRINGS[msg.get_error()]);
@@ -3330,25 +3136,25 @@ ais22_to_pydict(const char *nmea_payload, const size_t pad) {
   }
 
   PyObject *dict = ais_msg_to_pydict(&msg);
-  DictSafeSetItem(dict, "spare", msg.spare);
+  DictSafeSetItem(dict, "spare"_key, msg.spare);
 
-  DictSafeSetItem(dict, "chan_a", msg.chan_a);
-  DictSafeSetItem(dict, "chan_b", msg.chan_b);
-  DictSafeSetItem(dict, "txrx_mode", msg.txrx_mode);
-  DictSafeSetItem(dict, "power_low", msg.power_low);
+  DictSafeSetItem(dict, "chan_a"_key, msg.chan_a);
+  DictSafeSetItem(dict, "chan_b"_key, msg.chan_b);
+  DictSafeSetItem(dict, "txrx_mode"_key, msg.txrx_mode);
+  DictSafeSetItem(dict, "power_low"_key, msg.power_low);
 
   if (msg.pos_valid) {
-    DictSafeSetItem(dict, "x1", "y1", msg.position1);
-    DictSafeSetItem(dict, "x2", "y2", msg.position2);
+    DictSafeSetItem(dict, "x1"_key, "y1"_key, msg.position1);
+    DictSafeSetItem(dict, "x2"_key, "y2"_key, msg.position2);
   } else {
-    DictSafeSetItem(dict, "dest_mmsi_1", msg.dest_mmsi_1);
-    DictSafeSetItem(dict, "dest_mmsi_2", msg.dest_mmsi_2);
+    DictSafeSetItem(dict, "dest_mmsi_1"_key, msg.dest_mmsi_1);
+    DictSafeSetItem(dict, "dest_mmsi_2"_key, msg.dest_mmsi_2);
   }
 
-  DictSafeSetItem(dict, "chan_a_bandwidth", msg.chan_a_bandwidth);
-  DictSafeSetItem(dict, "chan_b_bandwidth", msg.chan_b_bandwidth);
-  DictSafeSetItem(dict, "zone_size", msg.zone_size);
-  DictSafeSetItem(dict, "spare2", msg.spare2);
+  DictSafeSetItem(dict, "chan_a_bandwidth"_key, msg.chan_a_bandwidth);
+  DictSafeSetItem(dict, "chan_b_bandwidth"_key, msg.chan_b_bandwidth);
+  DictSafeSetItem(dict, "zone_size"_key, msg.zone_size);
+  DictSafeSetItem(dict, "spare2"_key, msg.spare2);
 
   return dict;
 }
@@ -3356,9 +3162,7 @@ ais22_to_pydict(const char *nmea_payload, const size_t pad) {
 
 // 23 - 'F' - Group assignment command
 PyObject*
-ais23_to_pydict(const char *nmea_payload, const size_t pad) {
-  assert(nmea_payload);
-  Ais23 msg(nmea_payload, pad);
+ais23_to_pydict(const Ais23 &msg) {
   if (msg.had_error()) {
     PyErr_Format(ais_py_exception, "Ais23: %s",
                  AIS_STATUS_STRINGS[msg.get_error()]);
@@ -3366,28 +3170,26 @@ ais23_to_pydict(const char *nmea_payload, const size_t pad) {
   }
 
   PyObject *dict = ais_msg_to_pydict(&msg);
-  DictSafeSetItem(dict, "spare", msg.spare);
+  DictSafeSetItem(dict, "spare"_key, msg.spare);
 
-  DictSafeSetItem(dict, "x1", "y1", msg.position1);
-  DictSafeSetItem(dict, "x2", "y2", msg.position2);
+  DictSafeSetItem(dict, "x1"_key, "y1"_key, msg.position1);
+  DictSafeSetItem(dict, "x2"_key, "y2"_key, msg.position2);
 
-  DictSafeSetItem(dict, "station_type", msg.station_type);
-  DictSafeSetItem(dict, "type_and_cargo", msg.type_and_cargo);
-  DictSafeSetItem(dict, "spare2", msg.spare2);
+  DictSafeSetItem(dict, "station_type"_key, msg.station_type);
+  DictSafeSetItem(dict, "type_and_cargo"_key, msg.type_and_cargo);
+  DictSafeSetItem(dict, "spare2"_key, msg.spare2);
 
-  DictSafeSetItem(dict, "txrx_mode", msg.txrx_mode);
-  DictSafeSetItem(dict, "interval_raw", msg.interval_raw);
-  DictSafeSetItem(dict, "quiet", msg.quiet);
-  DictSafeSetItem(dict, "spare3", msg.spare3);
+  DictSafeSetItem(dict, "txrx_mode"_key, msg.txrx_mode);
+  DictSafeSetItem(dict, "interval_raw"_key, msg.interval_raw);
+  DictSafeSetItem(dict, "quiet"_key, msg.quiet);
+  DictSafeSetItem(dict, "spare3"_key, msg.spare3);
 
   return dict;
 }
 
 // 24 - 'H' - Static data report
 PyObject*
-ais24_to_pydict(const char *nmea_payload, const size_t pad) {
-  assert(nmea_payload);
-  Ais24 msg(nmea_payload, pad);
+ais24_to_pydict(const Ais24 &msg) {
   if (msg.had_error()) {
     PyErr_Format(ais_py_exception, "Ais24: %s",
                  AIS_STATUS_STRINGS[msg.get_error()]);
@@ -3396,21 +3198,14 @@ ais24_to_pydict(const char *nmea_payload, const size_t pad) {
 
   PyObject *dict = ais_msg_to_pydict(&msg);
 
-  DictSafeSetItem(dict, "part_num", msg.part_num);
+  DictSafeSetItem(dict, "part_num"_key, msg.part_num);
 
   switch (msg.part_num) {
   case 0:  // Part A
-    DictSafeSetItem(dict, "name", msg.name);
+    DictSafeSetItem(dict, "name"_key, msg.name);
     break;
   case 1:  // Part B
-    DictSafeSetItem(dict, "type_and_cargo", msg.type_and_cargo);
-    DictSafeSetItem(dict, "vendor_id", msg.vendor_id);
-    DictSafeSetItem(dict, "callsign", msg.callsign);
-    DictSafeSetItem(dict, "dim_a", msg.dim_a);
-    DictSafeSetItem(dict, "dim_b", msg.dim_b);
-    DictSafeSetItem(dict, "dim_c", msg.dim_c);
-    DictSafeSetItem(dict, "dim_d", msg.dim_d);
-    DictSafeSetItem(dict, "spare", msg.spare);
+    DictSafeSetFields<kAis24PartBLayout>(dict, msg);
     break;
   case 2:  // FALLTHROUGH - not yet defined by ITU
   case 3:  // FALLTHROUGH - not yet defined by ITU
@@ -3427,9 +3222,7 @@ ais24_to_pydict(const char *nmea_payload, const size_t pad) {
 
 // 25 - 'I' - Single slot binary message
 PyObject*
-ais25_to_pydict(const char *nmea_payload, const size_t pad) {
-  assert(nmea_payload);
-  Ais25 msg(nmea_payload, pad);
+ais25_to_pydict(const Ais25 &msg) {
   if (msg.had_error()) {
     PyErr_Format(ais_py_exception, "Ais25: %s",
                  AIS_STATUS_STRINGS[msg.get_error()]);
@@ -3439,10 +3232,11 @@ ais25_to_pydict(const char *nmea_payload, const size_t pad) {
   PyObject *dict = ais_msg_to_pydict(&msg);
 
   // TODO(schwehr) use_app_id
-  if (msg.dest_mmsi_valid) DictSafeSetItem(dict, "dest_mmsi", msg.dest_mmsi);
+  if (msg.dest_mmsi_valid)
+    DictSafeSetItem(dict, "dest_mmsi"_key, msg.dest_mmsi);
   if (msg.use_app_id) {
-    DictSafeSetItem(dict, "dac", msg.dac);
-    DictSafeSetItem(dict, "fi", msg.fi);
+    DictSafeSetItem(dict, "dac"_key, msg.dac);
+    DictSafeSetItem(dict, "fi"_key, msg.fi);
   }
 
   // TODO(schwehr): handle payload
@@ -3452,8 +3246,7 @@ ais25_to_pydict(const char *nmea_payload, const size_t pad) {
 
 // 26 - 'J' - Multi-slot binary message with commstate
 PyObject*
-ais26_to_pydict(const char *nmea_payload, const size_t pad) {
-  Ais26 msg(nmea_payload, pad);
+ais26_to_pydict(const Ais26 &msg) {
   if (msg.had_error()) {
     PyErr_Format(ais_py_exception, "Ais26: %s",
                  AIS_STATUS_STRINGS[msg.get_error()]);
@@ -3462,33 +3255,34 @@ ais26_to_pydict(const char *nmea_payload, const size_t pad) {
 
   PyObject *dict = ais_msg_to_pydict(&msg);
 
-  if (msg.dest_mmsi_valid) DictSafeSetItem(dict, "dest_mmsi", msg.dest_mmsi);
+  if (msg.dest_mmsi_valid)
+    DictSafeSetItem(dict, "dest_mmsi"_key, msg.dest_mmsi);
   if (msg.use_app_id) {
-    DictSafeSetItem(dict, "dac", msg.dac);
-    DictSafeSetItem(dict, "fi", msg.fi);
+    DictSafeSetItem(dict, "dac"_key, msg.dac);
+    DictSafeSetItem(dict, "fi"_key, msg.fi);
   }
 
   // TODO(schwehr): handle payload
 
-  DictSafeSetItem(dict, "sync_state", msg.sync_state);
+  DictSafeSetItem(dict, "sync_state"_key, msg.sync_state);
   if (0 == msg.commstate_flag) {
     // SOTDMA
     if (msg.received_stations_valid)
-      DictSafeSetItem(dict, "received_stations", msg.received_stations);
+      DictSafeSetItem(dict, "received_stations"_key, msg.received_stations);
     if (msg.slot_number_valid)
-      DictSafeSetItem(dict, "slot_number", msg.slot_number);
+      DictSafeSetItem(dict, "slot_number"_key, msg.slot_number);
     if (msg.utc_valid) {
-      DictSafeSetItem(dict, "utc_hour", msg.utc_hour);
-      DictSafeSetItem(dict, "utc_min", msg.utc_min);
-      DictSafeSetItem(dict, "utc_spare", msg.utc_spare);
+      DictSafeSetItem(dict, "utc_hour"_key, msg.utc_hour);
+      DictSafeSetItem(dict, "utc_min"_key, msg.utc_min);
+      DictSafeSetItem(dict, "utc_spare"_key, msg.utc_spare);
     }
     if (msg.slot_offset_valid)
-      DictSafeSetItem(dict, "slot_offset", msg.slot_offset);
+      DictSafeSetItem(dict, "slot_offset"_key, msg.slot_offset);
   } else {
     // ITDMA
-    DictSafeSetItem(dict, "slot_increment", msg.slot_increment);
-    DictSafeSetItem(dict, "slots_to_allocate", msg.slots_to_allocate);
-    DictSafeSetItem(dict, "keep_flag", msg.keep_flag);
+    DictSafeSetItem(dict, "slot_increment"_key, msg.slot_increment);
+    DictSafeSetItem(dict, "slots_to_allocate"_key, msg.slots_to_allocate);
+    DictSafeSetItem(dict, "keep_flag"_key, msg.keep_flag);
   }
   return dict;
 }
@@ -3496,8 +3290,7 @@ ais26_to_pydict(const char *nmea_payload, const size_t pad) {
 
 // 27 - 'K' - Short position report for satellite reception
 PyObject*
-ais27_to_pydict(const char *nmea_payload, const size_t pad) {
-  Ais27 msg(nmea_payload, pad);
+ais27_to_pydict(const Ais27 &msg) {
   if (msg.had_error()) {
     PyErr_Format(ais_py_exception, "Ais27: %s",
                  AIS_STATUS_STRINGS[msg.get_error()]);
@@ -3506,128 +3299,1208 @@ ais27_to_pydict(const char *nmea_payload, const size_t pad) {
 
   PyObject *dict = ais_msg_to_pydict(&msg);
 
-  DictSafeSetItem(dict, "position_accuracy", msg.position_accuracy);
-  DictSafeSetItem(dict, "raim", msg.raim);
-  DictSafeSetItem(dict, "nav_status", msg.nav_status);
-  DictSafeSetItem(dict, "x", "y", msg.position);
-  DictSafeSetItem(dict, "sog", msg.sog);
-  DictSafeSetItem(dict, "cog", msg.cog);
-  DictSafeSetItem(dict, "gnss", msg.gnss);
-  DictSafeSetItem(dict, "spare", msg.spare);
+  DictSafeSetFields<kAis27Layout>(dict, msg);
+  DictSafeSetItem(dict, "gnss"_key, msg.gnss);
+  DictSafeSetItem(dict, "spare"_key, msg.spare);
   return dict;
 }
 
 
+// A payload decoded into messages.  Decoding does not touch any Python
+// objects, so it can run without holding the GIL.  Errors are kept in the
+// messages and only become exceptions in DecodedPayloadToPyDict.
+struct DecodedPayload {
+  // First character of the payload, which gives the message type.
+  char type = '\0';
+  // Nothing is decoded when the fill bits are out of range.
+  bool bad_fill_bits = false;
+  // From CreateAisMsg.  For 6 and 8 this is the message for the DAC and FI,
+  // which is missing if CreateAisMsg does not handle them.  nullptr for
+  // unknown types.
+  std::unique_ptr<AisMsg> msg;
+  // For 6 and 8 without a good msg, the plain Ais6 or Ais8 to report the
+  // header from.
+  std::unique_ptr<AisMsg> header;
+};
+
+// Decodes through CreateAisMsg, so the payload is only parsed once.  Only a
+// 6 or 8 that CreateAisMsg could not decode is parsed again for the header.
+DecodedPayload
+DecodePayload(const char *nmea_payload, const size_t pad) {
+  assert(nmea_payload);
+  DecodedPayload decoded;
+  decoded.type = nmea_payload[0];
+  // The pads of decode_many and friends come from the caller.  Check them
+  // before anything parses the payload, which asserts on the range.
+  if (pad > 5) {
+    decoded.bad_fill_bits = true;
+    return decoded;
+  }
+  decoded.msg = CreateAisMsg(nmea_payload, static_cast<int>(pad));
+  if (decoded.msg != nullptr && !decoded.msg->had_error()) {
+    return decoded;
+  }
+  if (decoded.type == '6') {
+    decoded.header.reset(new Ais6(nmea_payload, pad));
+  } else if (decoded.type == '8') {
+    decoded.header.reset(new Ais8(nmea_payload, pad));
+  }
+  return decoded;
+}
+
+// Needs the GIL.  Returns nullptr with an exception set if the payload did
+// not decode.
+PyObject *
+DecodedPayloadToPyDict(const DecodedPayload &decoded) {
+  if (decoded.bad_fill_bits) {
+    PyErr_Format(ais_py_exception,
+                 "ais.decode: fill bits out of range - %c", decoded.type);
+    return nullptr;
+  }
+  const AisMsg *msg = decoded.msg.get();
+  switch (decoded.type) {
+  case '1':  // FALLTHROUGH
+  case '2':  // FALLTHROUGH
+  case '3':
+    return ais1_2_3_to_pydict(static_cast<const Ais1_2_3 &>(*msg));
+  case '4':  // FALLTHROUGH
+  case ';':
+    return ais4_11_to_pydict(static_cast<const Ais4_11 &>(*msg));
+  case '5':
+    return ais5_to_pydict(static_cast<const Ais5 &>(*msg));
+  case '6':
+    return ais6_to_pydict(
+        static_cast<const Ais6 &>(decoded.header ? *decoded.header : *msg),
+        msg);
+  case '7':  // FALLTHROUGH
+  case '=':
+    return ais7_13_to_pydict(static_cast<const Ais7_13 &>(*msg));
+  case '8':
+    return ais8_to_pydict(
+        static_cast<const Ais8 &>(decoded.header ? *decoded.header : *msg),
+        msg);
+  case '9':
+    return ais9_to_pydict(static_cast<const Ais9 &>(*msg));
+  case ':':
+    return ais10_to_pydict(static_cast<const Ais10 &>(*msg));
+  case '<':
+    return ais12_to_pydict(static_cast<const Ais12 &>(*msg));
+  case '>':
+    return ais14_to_pydict(static_cast<const Ais14 &>(*msg));
+  case '?':
+    return ais15_to_pydict(static_cast<const Ais15 &>(*msg));
+  case '@':
+    return ais16_to_pydict(static_cast<const Ais16 &>(*msg));
+  case 'A':
+    return ais17_to_pydict(static_cast<const Ais17 &>(*msg));
+  case 'B':
+    return ais18_to_pydict(static_cast<const Ais18 &>(*msg));
+  case 'C':
+    return ais19_to_pydict(static_cast<const Ais19 &>(*msg));
+  case 'D':
+    return ais20_to_pydict(static_cast<const Ais20 &>(*msg));
+  case 'E':
+    return ais21_to_pydict(static_cast<const Ais21 &>(*msg));
+  case 'F':
+    return ais22_to_pydict(static_cast<const Ais22 &>(*msg));
+  case 'G':
+    return ais23_to_pydict(static_cast<const Ais23 &>(*msg));
+  case 'H':
+    return ais24_to_pydict(static_cast<const Ais24 &>(*msg));
+  case 'I':
+    return ais25_to_pydict(static_cast<const Ais25 &>(*msg));
+  case 'J':
+    return ais26_to_pydict(static_cast<const Ais26 &>(*msg));
+  case 'K':
+    return ais27_to_pydict(static_cast<const Ais27 &>(*msg));
+
+  case 'L':  // 28 - UNKNOWN
+    PyErr_Format(ais_py_exception, "ais.decode: message 28 (L) not handled");
+    break;
+
+  default:
+    PyErr_Format(ais_py_exception, "ais.decode: unknown message - %c",
+                 decoded.type);
+  }
+
+  return nullptr;
+}
+
+// Returns true if DecodedPayloadToPyDict would raise DecodeError, without
+// building the dict.
+bool
+DecodedPayloadFailed(const DecodedPayload &decoded) {
+  const AisMsg *msg = decoded.msg.get();
+  // For 6 and 8, msg is missing if CreateAisMsg does not handle the DAC and
+  // FI.
+  if (msg == nullptr || msg->had_error()) {
+    return true;
+  }
+  if (decoded.type != '8') {
+    return false;
+  }
+  // ais8_to_pydict never gets a status for 8:367:22.
+  const auto &ais8 = static_cast<const Ais8 &>(*msg);
+  return ais8.dac == 367 && ais8.fi == AIS_FI_8_367_22_AREA_NOTICE;
+}
+
+// Takes the pending exception as an instance for a decode_many result.
+PyObject *
+FetchException() {
+#if PY_VERSION_HEX >= 0x030C0000
+  return PyErr_GetRaisedException();
+#else
+  PyObject *type;
+  PyObject *value;
+  PyObject *traceback;
+  PyErr_Fetch(&type, &value, &traceback);
+  PyErr_NormalizeException(&type, &value, &traceback);
+  Py_XDECREF(type);
+  Py_XDECREF(traceback);
+  return value;
+#endif
+}
+
+// Text from a str or from any object with the buffer protocol, such as
+// bytes, memoryview or mmap.  The text stays valid until the TextArg is
+// destroyed, so it can be used without the GIL.
+class TextArg {
+ public:
+  TextArg() : view_() {}
+  ~TextArg() {
+    if (view_.obj != nullptr) {
+      PyBuffer_Release(&view_);
+    }
+  }
+  TextArg(const TextArg &) = delete;
+  TextArg &operator=(const TextArg &) = delete;
+
+  // Returns false with an exception set if obj is neither.
+  bool Init(PyObject *obj) {
+    if (PyUnicode_Check(obj)) {
+      Py_ssize_t size;
+      const char *data = PyUnicode_AsUTF8AndSize(obj, &size);
+      if (data == nullptr) {
+        return false;
+      }
+      text_ = std::string_view(data, size);
+      terminated_ = true;
+      return true;
+    }
+    if (PyObject_GetBuffer(obj, &view_, PyBUF_SIMPLE) != 0) {
+      return false;
+    }
+    text_ = std::string_view(static_cast<const char *>(view_.buf), view_.len);
+    terminated_ = PyBytes_Check(obj);
+    return true;
+  }
+
+  std::string_view text() const { return text_; }
+
+  // The text with a null at the end.  str and bytes already have one.
+  // Anything else is copied, so call this before releasing the GIL.
+  const char *c_str() {
+    if (terminated_) {
+      return text_.data();
+    }
+    copy_.assign(text_.data(), text_.size());
+    return copy_.c_str();
+  }
+
+ private:
+  Py_buffer view_;
+  std::string_view text_;
+  bool terminated_ = false;
+  std::string copy_;
+};
+
+// Null terminated copies of a sequence of payloads and their pads.  Batches
+// are decoded without holding the GIL, when another thread may change the
+// sequences.
+struct PayloadBatch {
+  std::string text;
+  // Offset of each payload in text or -1 if the item was not usable.
+  std::vector<Py_ssize_t> offsets;
+  std::vector<int> pads;
+
+  Py_ssize_t size() const { return offsets.size(); }
+  const char *payload(Py_ssize_t i) const {
+    return offsets[i] < 0 ? nullptr : text.data() + offsets[i];
+  }
+};
+
+// pads_arg is a sequence of the same length as payloads_arg or Py_None for
+// all zero.  Returns false with an exception set if the arguments are not
+// usable sequences.  Bad items are only marked in batch.
+bool
+CopyPayloads(PyObject *payloads_arg, PyObject *pads_arg, const char *func,
+             PayloadBatch *batch) {
+  // Tuples so that other threads can not change the items under us.
+  PyObject *payloads = PySequence_Tuple(payloads_arg);
+  if (payloads == nullptr) {
+    return false;
+  }
+  PyObject *pads = nullptr;
+  if (pads_arg != Py_None) {
+    pads = PySequence_Tuple(pads_arg);
+    if (pads == nullptr) {
+      Py_DECREF(payloads);
+      return false;
+    }
+  }
+  const Py_ssize_t num = PyTuple_GET_SIZE(payloads);
+  if (pads != nullptr && PyTuple_GET_SIZE(pads) != num) {
+    PyErr_Format(PyExc_ValueError,
+                 "%s: payloads and pads differ in length", func);
+    Py_DECREF(payloads);
+    Py_DECREF(pads);
+    return false;
+  }
+
+  batch->offsets.assign(num, -1);
+  batch->pads.assign(num, 0);
+  for (Py_ssize_t i = 0; i < num; i++) {
+    TextArg payload;
+    if (!payload.Init(PyTuple_GET_ITEM(payloads, i))) {
+      PyErr_Clear();
+      continue;
+    }
+    if (pads != nullptr) {
+      const long pad = PyLong_AsLong(PyTuple_GET_ITEM(pads, i));  // NOLINT
+      if (pad == -1 && PyErr_Occurred()) {
+        PyErr_Clear();
+        continue;
+      }
+      batch->pads[i] = pad;
+    }
+    batch->offsets[i] = batch->text.size();
+    batch->text.append(payload.text());
+    batch->text.push_back('\0');
+  }
+  Py_DECREF(payloads);
+  Py_XDECREF(pads);
+  return true;
+}
+
+// Columns that decode_positions can fill.
+enum PositionColumn {
+  POS_ID,
+  POS_REPEAT_INDICATOR,
+  POS_MMSI,
+  POS_NAV_STATUS,
+  POS_SOG,
+  POS_POSITION_ACCURACY,
+  POS_X,
+  POS_Y,
+  POS_COG,
+  POS_TRUE_HEADING,
+  POS_TIMESTAMP,
+  POS_RAIM,
+  POS_NUM_COLUMNS,
+};
+
+const char *const kPositionColumnNames[POS_NUM_COLUMNS] = {
+  "id",
+  "repeat_indicator",
+  "mmsi",
+  "nav_status",
+  "sog",
+  "position_accuracy",
+  "x",
+  "y",
+  "cog",
+  "true_heading",
+  "timestamp",
+  "raim",
+};
+
+template <typename T>
+void
+SetPositionRow(const T &msg, double *row) {
+  row[POS_ID] = msg.message_id;
+  row[POS_REPEAT_INDICATOR] = msg.repeat_indicator;
+  row[POS_MMSI] = msg.mmsi;
+  row[POS_SOG] = msg.sog;
+  row[POS_POSITION_ACCURACY] = msg.position_accuracy;
+  row[POS_X] = msg.position.lng_deg;
+  row[POS_Y] = msg.position.lat_deg;
+  row[POS_COG] = msg.cog;
+  row[POS_RAIM] = msg.raim;
+}
+
+// Fills row with the values of a position report.  Values that the message
+// type does not have are NaN.  Returns false and leaves row all NaN if the
+// payload is not a position report that decodes.
+bool
+DecodePositionRow(const char *nmea_payload, const size_t pad, double *row) {
+  std::fill(row, row + POS_NUM_COLUMNS, std::nan(""));
+  // The pads come from the caller and parsing asserts on the range.
+  if (pad > 5) {
+    return false;
+  }
+  switch (nmea_payload[0]) {
+  case '1':  // FALLTHROUGH
+  case '2':  // FALLTHROUGH
+  case '3': {
+    const Ais1_2_3 msg(nmea_payload, pad);
+    if (msg.had_error()) {
+      return false;
+    }
+    SetPositionRow(msg, row);
+    row[POS_NAV_STATUS] = msg.nav_status;
+    row[POS_TRUE_HEADING] = msg.true_heading;
+    row[POS_TIMESTAMP] = msg.timestamp;
+    return true;
+  }
+  case 'B': {
+    const Ais18 msg(nmea_payload, pad);
+    if (msg.had_error()) {
+      return false;
+    }
+    SetPositionRow(msg, row);
+    row[POS_TRUE_HEADING] = msg.true_heading;
+    row[POS_TIMESTAMP] = msg.timestamp;
+    return true;
+  }
+  case 'C': {
+    const Ais19 msg(nmea_payload, pad);
+    if (msg.had_error()) {
+      return false;
+    }
+    SetPositionRow(msg, row);
+    row[POS_TRUE_HEADING] = msg.true_heading;
+    row[POS_TIMESTAMP] = msg.timestamp;
+    return true;
+  }
+  case 'K': {
+    const Ais27 msg(nmea_payload, pad);
+    if (msg.had_error()) {
+      return false;
+    }
+    SetPositionRow(msg, row);
+    row[POS_NAV_STATUS] = msg.nav_status;
+    return true;
+  }
+  }
+  return false;
+}
+
+// A writable one dimensional buffer that receives one column.
+struct ColumnBuffer {
+  Py_buffer view;
+  char format;
+};
+
+// Returns the struct format character of a native buffer or '\0' if the
+// type is not one that decode_positions writes.
+char
+ColumnFormat(const Py_buffer &view) {
+  const char *format = view.format == nullptr ? "B" : view.format;
+  if (format[0] == '@' || format[0] == '=' ||
+      format[0] == (PY_LITTLE_ENDIAN ? '<' : '>')) {
+    format++;
+  }
+  if (format[0] == '\0' || format[1] != '\0') {
+    return '\0';
+  }
+  switch (format[0]) {
+  case 'b':
+    return view.itemsize == 1 ? 'b' : '\0';
+  case 'h':
+    return view.itemsize == 2 ? 'h' : '\0';
+  case 'i':  // FALLTHROUGH
+  case 'l':  // FALLTHROUGH
+  case 'q':  // FALLTHROUGH
+  case 'f':  // FALLTHROUGH
+  case 'd':
+    return format[0];
+  }
+  return '\0';
+}
+
+// NaN becomes -1 in integer columns.
+template <typename T>
+void
+SetItem(void *buf, const Py_ssize_t i, const double value) {
+  if constexpr (std::is_integral<T>::value) {
+    static_cast<T *>(buf)[i] = std::isnan(value) ? -1 : static_cast<T>(value);
+  } else {
+    static_cast<T *>(buf)[i] = value;
+  }
+}
+
+void
+SetColumn(const ColumnBuffer &column, const Py_ssize_t i, const double value) {
+  switch (column.format) {
+  case 'b':
+    SetItem<int8_t>(column.view.buf, i, value);
+    break;
+  case 'h':
+    SetItem<int16_t>(column.view.buf, i, value);
+    break;
+  case 'i':
+    SetItem<int>(column.view.buf, i, value);
+    break;
+  case 'l':
+    SetItem<long>(column.view.buf, i, value);  // NOLINT
+    break;
+  case 'q':
+    SetItem<long long>(column.view.buf, i, value);  // NOLINT
+    break;
+  case 'f':
+    SetItem<float>(column.view.buf, i, value);
+    break;
+  case 'd':
+    SetItem<double>(column.view.buf, i, value);
+    break;
+  }
+}
+
+// The C++ side of a _ais.VdmStream.  Lines are reassembled and decoded
+// without the GIL.  mutex serializes the callers and is never held while
+// waiting for the GIL.
+struct VdmStreamState {
+  std::mutex mutex;
+  VdmAssembler assembler;
+  // Text after the last newline passed to AddText.
+  std::string partial;
+  // Null terminated copy of the payload being decoded.
+  std::string payload;
+  // Completed messages that have not been taken by __next__.
+  std::deque<DecodedPayload> decoded;
+
+  // Returns true if the line completed a message or is held for one.  The
+  // assembler handles TAG blocks and USCG metadata.
+  bool AddLine(std::string_view line) {
+    std::string_view body;
+    int fill_bits;
+    VdmLineStatus status;
+    if (!assembler.AddLine(line, &body, &fill_bits, &status)) {
+      return status == VDM_LINE_PARTIAL;
+    }
+    payload.assign(body.data(), body.size());
+    decoded.push_back(DecodePayload(payload.c_str(), fill_bits));
+    return true;
+  }
+
+  // Adds the newline terminated lines in text, carrying a partial last line
+  // over to the next call.  Returns the number of messages completed.
+  size_t AddText(std::string_view text) {
+    const size_t before = decoded.size();
+    const char *pos = text.data();
+    const char *end = pos + text.size();
+    std::string_view line;
+    if (!partial.empty()) {
+      const char *newline =
+          static_cast<const char *>(std::memchr(pos, '\n', end - pos));
+      if (newline == nullptr) {
+        partial.append(pos, end);
+        return 0;
+      }
+      partial.append(pos, newline + 1);
+      pos = newline + 1;
+      const char *partial_pos = partial.data();
+      NextLine(&partial_pos, partial_pos + partial.size(), &line);
+      AddLine(line);
+      partial.clear();
+    }
+    while (NextLine(&pos, end, &line)) {
+      AddLine(line);
+    }
+    partial.assign(pos, end);
+    return decoded.size() - before;
+  }
+
+  // Adds what is left of a last line without a newline.
+  size_t Flush() {
+    const size_t before = decoded.size();
+    if (!partial.empty()) {
+      partial.push_back('\n');
+      const char *pos = partial.data();
+      std::string_view line;
+      NextLine(&pos, pos + partial.size(), &line);
+      AddLine(line);
+      partial.clear();
+    }
+    return decoded.size() - before;
+  }
+};
+
+// Decodes a batch without the GIL and returns a list with a dict or a
+// DecodeError for each payload.  Items that are not usable get a
+// DecodeError with bad_item_message.
+PyObject *
+DecodeBatch(const PayloadBatch &batch, const char *bad_item_message) {
+  const Py_ssize_t num = batch.size();
+  std::vector<DecodedPayload> decoded(num);
+  Py_BEGIN_ALLOW_THREADS
+  for (Py_ssize_t i = 0; i < num; i++) {
+    if (const char *payload = batch.payload(i)) {
+      decoded[i] = DecodePayload(payload, batch.pads[i]);
+    }
+  }
+  Py_END_ALLOW_THREADS
+
+  PyObject *result = PyList_New(num);
+  if (result == nullptr) {
+    return nullptr;
+  }
+  for (Py_ssize_t i = 0; i < num; i++) {
+    PyObject *item;
+    if (batch.payload(i) == nullptr) {
+      PyErr_SetString(ais_py_exception, bad_item_message);
+      item = FetchException();
+    } else {
+      item = DecodedPayloadToPyDict(decoded[i]);
+      if (item == nullptr) {
+        item = FetchException();
+      }
+    }
+    PyList_SET_ITEM(result, i, item);  // Steals ref
+  }
+  return result;
+}
+
+template <typename T>
+void
+GetIndexes(const Py_buffer &view, std::vector<Py_ssize_t> *indexes) {
+  const T *items = static_cast<const T *>(view.buf);
+  indexes->assign(items, items + view.shape[0]);
+}
+
+// Reads a sequence of ints or a one dimensional integer buffer.  Returns
+// false with an exception set if obj is neither.
+bool
+ReadIndexes(PyObject *obj, const char *func, const char *name,
+            std::vector<Py_ssize_t> *indexes) {
+  Py_buffer view;
+  if (PyObject_CheckBuffer(obj) &&
+      PyObject_GetBuffer(obj, &view, PyBUF_FORMAT | PyBUF_ND) == 0) {
+    bool ok = view.ndim == 1;
+    switch (ok ? ColumnFormat(view) : '\0') {
+    case 'b':
+      GetIndexes<int8_t>(view, indexes);
+      break;
+    case 'h':
+      GetIndexes<int16_t>(view, indexes);
+      break;
+    case 'i':
+      GetIndexes<int>(view, indexes);
+      break;
+    case 'l':
+      GetIndexes<long>(view, indexes);  // NOLINT
+      break;
+    case 'q':
+      GetIndexes<long long>(view, indexes);  // NOLINT
+      break;
+    default:
+      ok = false;
+    }
+    PyBuffer_Release(&view);
+    if (!ok) {
+      PyErr_Format(PyExc_ValueError,
+                   "%s: %s must be a one dimensional integer buffer", func,
+                   name);
+    }
+    return ok;
+  }
+  PyErr_Clear();
+
+  PyObject *items = PySequence_Tuple(obj);
+  if (items == nullptr) {
+    return false;
+  }
+  const Py_ssize_t num = PyTuple_GET_SIZE(items);
+  indexes->resize(num);
+  for (Py_ssize_t i = 0; i < num; i++) {
+    (*indexes)[i] = PyLong_AsSsize_t(PyTuple_GET_ITEM(items, i));
+    if ((*indexes)[i] == -1 && PyErr_Occurred()) {
+      Py_DECREF(items);
+      return false;
+    }
+  }
+  Py_DECREF(items);
+  return true;
+}
+
+// Copies the spans of data into a batch.  Spans that are not inside of data
+// are marked bad.  Returns false with an exception set if the arguments are
+// not usable.
+bool
+CopySpans(std::string_view data, PyObject *starts_arg, PyObject *lengths_arg,
+          PyObject *pads_arg, const char *func, PayloadBatch *batch) {
+  std::vector<Py_ssize_t> starts;
+  std::vector<Py_ssize_t> lengths;
+  std::vector<Py_ssize_t> pads;
+  if (!ReadIndexes(starts_arg, func, "starts", &starts) ||
+      !ReadIndexes(lengths_arg, func, "lengths", &lengths) ||
+      (pads_arg != Py_None && !ReadIndexes(pads_arg, func, "pads", &pads))) {
+    return false;
+  }
+  const size_t num = starts.size();
+  if (lengths.size() != num || (pads_arg != Py_None && pads.size() != num)) {
+    PyErr_Format(PyExc_ValueError,
+                 "%s: starts, lengths and pads differ in length", func);
+    return false;
+  }
+
+  batch->offsets.assign(num, -1);
+  batch->pads.assign(num, 0);
+  for (size_t i = 0; i < num; i++) {
+    const Py_ssize_t start = starts[i];
+    const Py_ssize_t length = lengths[i];
+    if (start < 0 || length < 0 ||
+        static_cast<size_t>(start) > data.size() ||
+        static_cast<size_t>(length) > data.size() - start) {
+      continue;
+    }
+    if (!pads.empty()) {
+      batch->pads[i] = pads[i];
+    }
+    batch->offsets[i] = batch->text.size();
+    batch->text.append(data.substr(start, length));
+    batch->text.push_back('\0');
+  }
+  return true;
+}
+
 extern "C" {
 
 static PyObject *
 decode(PyObject *self, PyObject *args) {
-  int _pad;
-  const char *nmea_payload;
+  int _pad = 0;
+  PyObject *payload_arg;
+  TextArg payload;
   // TODO(schwehr): what to do about if no pad bits?  Maybe warn and set to 0?
-  if (!PyArg_ParseTuple(args, "si", &nmea_payload, &_pad)) {
-    _pad = 0;
-    if (!PyArg_ParseTuple(args, "s", &nmea_payload)) {
-      PyErr_Format(ais_py_exception, "ais.decode: expected (str, int)");
-      return nullptr;
-    }
+  if (!PyArg_ParseTuple(args, "O|i", &payload_arg, &_pad) ||
+      !payload.Init(payload_arg)) {
+    PyErr_Format(ais_py_exception, "ais.decode: expected (str, int)");
+    return nullptr;
   }
+  const char *nmea_payload = payload.c_str();
   const size_t pad = _pad;
 
-  // The grand dispatcher
-  switch (nmea_payload[0]) {
-  case '1':  // FALLTHROUGH - Class A Position
-  case '2':  // FALLTHROUGH
-  case '3':
-    return ais1_2_3_to_pydict(nmea_payload, pad);
+  DecodedPayload decoded;
+  Py_BEGIN_ALLOW_THREADS
+  decoded = DecodePayload(nmea_payload, pad);
+  Py_END_ALLOW_THREADS
+  return DecodedPayloadToPyDict(decoded);
+}
 
-  case '4':  // FALLTHROUGH - 4 - Basestation report
-  case ';':  // 11 - UTC date response
-    return ais4_11_to_pydict(nmea_payload, pad);
+// decode_many(payloads, pads=None) -> list
+//
+// Decodes a sequence of payloads with one call.  pads is a sequence of the
+// same length or None for all zero.  Each item of the result is the dict
+// that decode would return or the DecodeError that it would raise.  The
+// payloads are copied and then decoded without holding the GIL.
+static PyObject *
+decode_many(PyObject *self, PyObject *args) {
+  PyObject *payloads_arg;
+  PyObject *pads_arg = Py_None;
+  if (!PyArg_ParseTuple(args, "O|O", &payloads_arg, &pads_arg)) {
+    return nullptr;
+  }
+  PayloadBatch batch;
+  if (!CopyPayloads(payloads_arg, pads_arg, "ais.decode_many", &batch)) {
+    return nullptr;
+  }
+  return DecodeBatch(batch, "ais.decode_many: expected (str, int)");
+}
 
-  case '5':  // 5 - Ship and Cargo
-    return ais5_to_pydict(nmea_payload, pad);
+// decode_spans(data, starts, lengths, pads=None) -> list
+//
+// Like decode_many, but payload i is data[starts[i]:starts[i] + lengths[i]].
+// data is a str or anything with the buffer protocol, such as an mmap of a
+// log file, so no str is made for each payload.  starts and lengths are
+// sequences of ints or integer buffers such as array.array('q') or NumPy
+// arrays.  Spans outside of data give a DecodeError in place.
+static PyObject *
+decode_spans(PyObject *self, PyObject *args) {
+  PyObject *data_arg;
+  PyObject *starts_arg;
+  PyObject *lengths_arg;
+  PyObject *pads_arg = Py_None;
+  if (!PyArg_ParseTuple(args, "OOO|O", &data_arg, &starts_arg, &lengths_arg,
+                        &pads_arg)) {
+    return nullptr;
+  }
+  TextArg data;
+  if (!data.Init(data_arg)) {
+    return nullptr;
+  }
+  PayloadBatch batch;
+  if (!CopySpans(data.text(), starts_arg, lengths_arg, pads_arg,
+                 "ais.decode_spans", &batch)) {
+    return nullptr;
+  }
+  return DecodeBatch(batch, "ais.decode_spans: span is not in data");
+}
 
-  case '6':  // 6 - Addressed binary message
-    return ais6_to_pydict(nmea_payload, pad);
+// decode_positions(payloads, pads, columns) -> int
+//
+// Decodes the position reports 1, 2, 3, 18, 19 and 27 into columns without
+// making a Python object per message.  columns maps names from
+// kPositionColumnNames to writable one dimensional buffers, such as NumPy
+// arrays or array.array, with room for one item per payload.  Integer
+// (b, h, i, l, q) and float (f, d) buffers are accepted for any column.
+// Row i holds payload i.  Rows for other message types or payloads that do
+// not decode have id -1.  Fields that a type does not have are NaN or -1.
+// Returns the number of position reports decoded.
+static PyObject *
+decode_positions(PyObject *self, PyObject *args) {
+  PyObject *payloads_arg;
+  PyObject *pads_arg;
+  PyObject *columns_arg;
+  if (!PyArg_ParseTuple(args, "OOO!", &payloads_arg, &pads_arg,
+                        &PyDict_Type, &columns_arg)) {
+    return nullptr;
+  }
+  PayloadBatch batch;
+  if (!CopyPayloads(payloads_arg, pads_arg, "ais.decode_positions", &batch)) {
+    return nullptr;
+  }
+  const Py_ssize_t num = batch.size();
+
+  std::vector<std::pair<PositionColumn, ColumnBuffer>> columns;
+  bool ok = true;
+  PyObject *key;
+  PyObject *value;
+  Py_ssize_t pos = 0;
+  Py_BEGIN_CRITICAL_SECTION(columns_arg);
+  while (ok && PyDict_Next(columns_arg, &pos, &key, &value)) {
+    const char *name = PyUnicode_Check(key) ? PyUnicode_AsUTF8(key) : nullptr;
+    int column = 0;
+    while (column < POS_NUM_COLUMNS && name != nullptr &&
+           strcmp(name, kPositionColumnNames[column]) != 0) {
+      column++;
+    }
+    if (name == nullptr || column == POS_NUM_COLUMNS) {
+      PyErr_Format(PyExc_KeyError, "ais.decode_positions: unknown column %R",
+                   key);
+      ok = false;
+      break;
+    }
+    ColumnBuffer buffer;
+    if (PyObject_GetBuffer(value, &buffer.view,
+                           PyBUF_WRITABLE | PyBUF_FORMAT | PyBUF_ND) != 0) {
+      ok = false;
+      break;
+    }
+    buffer.format = ColumnFormat(buffer.view);
+    // Added before checking so that the buffer is released.
+    columns.emplace_back(static_cast<PositionColumn>(column), buffer);
+    if (buffer.format == '\0' || buffer.view.ndim != 1 ||
+        buffer.view.shape[0] < num) {
+      PyErr_Format(PyExc_ValueError,
+                   "ais.decode_positions: column %s needs a one dimensional "
+                   "integer or float buffer of at least %zd items",
+                   name, num);
+      ok = false;
+    }
+  }
+  Py_END_CRITICAL_SECTION();
+
+  Py_ssize_t decoded = 0;
+  if (ok) {
+    Py_BEGIN_ALLOW_THREADS
+    double row[POS_NUM_COLUMNS];
+    for (Py_ssize_t i = 0; i < num; i++) {
+      const char *payload = batch.payload(i);
+      if (payload != nullptr &&
+          DecodePositionRow(payload, batch.pads[i], row)) {
+        decoded++;
+      } else {
+        row[POS_ID] = -1;
+      }
+      for (const auto &column : columns) {
+        SetColumn(column.second, i, row[column.first]);
+      }
+    }
+    Py_END_ALLOW_THREADS
+  }
 
-  case '7':  // FALLTHROUGH - 7 - ACK for addressed binary message
-  case '=':  // 13 - ASRM Ack  (safety message)
-    return ais7_13_to_pydict(nmea_payload, pad);
+  for (auto &column : columns) {
+    PyBuffer_Release(&column.second.view);
+  }
+  if (!ok) {
+    return nullptr;
+  }
+  return PyLong_FromSsize_t(decoded);
+}
 
-  case '8':  // 8 - Binary broadcast message (BBM)
-    return ais8_to_pydict(nmea_payload, pad);
+// VdmStream() -> iterator of dicts
+//
+// Reassembles multi-line messages from lines or chunks of text and yields
+// the dict that decode would give for each message.  Messages that do not
+// decode are skipped.
+struct VdmStreamObject {
+  PyObject_HEAD
+  VdmStreamState *state;
+};
 
-  case '9':  // 9 - SAR Position
-    return ais9_to_pydict(nmea_payload, pad);
+static PyObject *
+VdmStreamNew(PyTypeObject *type, PyObject *args, PyObject *kwargs) {
+  static const char *kwlist[] = {nullptr};
+  if (!PyArg_ParseTupleAndKeywords(args, kwargs, ":VdmStream",
+                                   const_cast<char **>(kwlist))) {
+    return nullptr;
+  }
+  auto *self = reinterpret_cast<VdmStreamObject *>(type->tp_alloc(type, 0));
+  if (self == nullptr) {
+    return nullptr;
+  }
+  self->state = new VdmStreamState;
+  return reinterpret_cast<PyObject *>(self);
+}
 
-  case ':':  // 10 - UTC Query
-    return ais10_to_pydict(nmea_payload, pad);
+static void
+VdmStreamDealloc(PyObject *self) {
+  PyTypeObject *type = Py_TYPE(self);
+  delete reinterpret_cast<VdmStreamObject *>(self)->state;
+  type->tp_free(self);
+  Py_DECREF(type);
+}
 
-    // ';' 11 - See 4
+static VdmStreamState *
+GetState(PyObject *self) {
+  return reinterpret_cast<VdmStreamObject *>(self)->state;
+}
 
-  case '<':  // 12 - ASRM
-    return ais12_to_pydict(nmea_payload, pad);
+static PyObject *
+VdmStreamAddLine(PyObject *self, PyObject *line_arg) {
+  TextArg line;
+  if (!line.Init(line_arg)) {
+    return nullptr;
+  }
+  VdmStreamState *state = GetState(self);
+  bool used;
+  Py_BEGIN_ALLOW_THREADS
+  {
+    std::lock_guard<std::mutex> lock(state->mutex);
+    used = state->AddLine(line.text());
+  }
+  Py_END_ALLOW_THREADS
+  return PyBool_FromLong(used);
+}
 
-    // 13 - See 7
+static PyObject *
+VdmStreamFeed(PyObject *self, PyObject *data_arg) {
+  TextArg data;
+  if (!data.Init(data_arg)) {
+    return nullptr;
+  }
+  VdmStreamState *state = GetState(self);
+  size_t completed;
+  Py_BEGIN_ALLOW_THREADS
+  {
+    std::lock_guard<std::mutex> lock(state->mutex);
+    completed = state->AddText(data.text());
+  }
+  Py_END_ALLOW_THREADS
+  return PyLong_FromSize_t(completed);
+}
 
-  case '>':  // 14 - SRBM - Safety broadcast
-    return ais14_to_pydict(nmea_payload, pad);
+static PyObject *
+VdmStreamFlush(PyObject *self, PyObject *unused) {
+  VdmStreamState *state = GetState(self);
+  size_t completed;
+  Py_BEGIN_ALLOW_THREADS
+  {
+    std::lock_guard<std::mutex> lock(state->mutex);
+    completed = state->Flush();
+  }
+  Py_END_ALLOW_THREADS
+  return PyLong_FromSize_t(completed);
+}
 
-  case '?':  // 15 - Interrogation
-    return ais15_to_pydict(nmea_payload, pad);
+static PyObject *
+VdmStreamNext(PyObject *self) {
+  VdmStreamState *state = GetState(self);
+  while (true) {
+    DecodedPayload decoded;
+    {
+      std::lock_guard<std::mutex> lock(state->mutex);
+      if (state->decoded.empty()) {
+        return nullptr;  // StopIteration
+      }
+      decoded = std::move(state->decoded.front());
+      state->decoded.pop_front();
+    }
+    PyObject *dict = DecodedPayloadToPyDict(decoded);
+    if (dict != nullptr || !PyErr_ExceptionMatches(ais_py_exception)) {
+      return dict;
+    }
+    PyErr_Clear();
+  }
+}
 
-  case '@':  // 16 - Assigned mode command
-    return ais16_to_pydict(nmea_payload, pad);
+static Py_ssize_t
+VdmStreamLen(PyObject *self) {
+  VdmStreamState *state = GetState(self);
+  std::lock_guard<std::mutex> lock(state->mutex);
+  return state->decoded.size();
+}
 
-  case 'A':  // 17 - GNSS broadcast
-    return ais17_to_pydict(nmea_payload, pad);
+static PyMethodDef vdm_stream_methods[] = {
+  {"add_line", VdmStreamAddLine, METH_O,
+   "Add one line of str or bytes.  Returns True if the line completed a "
+   "message or is held as part of one"},
+  {"feed", VdmStreamFeed, METH_O,
+   "Add a chunk of newline separated text as str or any bytes-like object. "
+   "A partial last line is kept for the next chunk.  Returns the number of "
+   "messages completed"},
+  {"flush", VdmStreamFlush, METH_NOARGS,
+   "Add the partial last line left by feed"},
+  {nullptr, nullptr, 0, nullptr},  // Sentinel
+};
 
-  case 'B':  // 18 - Position, Class B
-    return ais18_to_pydict(nmea_payload, pad);
+static PyType_Slot vdm_stream_slots[] = {
+  {Py_tp_doc, const_cast<char *>(
+      "VdmStream() -> iterator over the dicts of messages reassembled from "
+      "NMEA VDM lines")},
+  {Py_tp_new, reinterpret_cast<void *>(VdmStreamNew)},
+  {Py_tp_dealloc, reinterpret_cast<void *>(VdmStreamDealloc)},
+  {Py_tp_iter, reinterpret_cast<void *>(PyObject_SelfIter)},
+  {Py_tp_iternext, reinterpret_cast<void *>(VdmStreamNext)},
+  {Py_tp_methods, vdm_stream_methods},
+  {Py_sq_length, reinterpret_cast<void *>(VdmStreamLen)},
+  {0, nullptr},
+};
 
-  case 'C':  // 19 - Position and ship, Class B
-    return ais19_to_pydict(nmea_payload, pad);
+static PyType_Spec vdm_stream_spec = {
+  "_ais.VdmStream",
+  sizeof(VdmStreamObject),
+  0,
+  Py_TPFLAGS_DEFAULT,
+  vdm_stream_slots,
+};
 
-  case 'D':  // 20 - Data link management
-    return ais20_to_pydict(nmea_payload, pad);
+// Message from decode_lazy.  Holds the decoded C++ message and only builds
+// the dict when a field other than id, repeat_indicator or mmsi is asked
+// for.  The dict is then kept for later lookups.
+struct LazyMsgObject {
+  PyObject_HEAD
+  DecodedPayload *decoded;
+  PyObject *dict;  // nullptr until needed.
+};
 
-  case 'E':  // 21 - Aids to navigation report
-    return ais21_to_pydict(nmea_payload, pad);
+PyTypeObject *lazy_msg_type;
 
-  case 'F':  // 22 - Channel Management
-    return ais22_to_pydict(nmea_payload, pad);
+static void
+LazyMsgDealloc(PyObject *self) {
+  PyTypeObject *type = Py_TYPE(self);
+  auto *lazy = reinterpret_cast<LazyMsgObject *>(self);
+  delete lazy->decoded;
+  Py_XDECREF(lazy->dict);
+  type->tp_free(self);
+  Py_DECREF(type);
+}
 
-  case 'G':  // 23 - Group Assignment Command
-    return ais23_to_pydict(nmea_payload, pad);
+// Returns a borrowed reference to the dict, building it if needed.
+static PyObject *
+LazyMsgDict(PyObject *self) {
+  auto *lazy = reinterpret_cast<LazyMsgObject *>(self);
+  PyObject *dict;
+  Py_BEGIN_CRITICAL_SECTION(self);
+  if (lazy->dict == nullptr) {
+    lazy->dict = DecodedPayloadToPyDict(*lazy->decoded);
+  }
+  dict = lazy->dict;
+  Py_END_CRITICAL_SECTION();
+  return dict;
+}
 
-  case 'H':  // 24 - Static data report
-    return ais24_to_pydict(nmea_payload, pad);
+// The fields of the AisMsg base class, which need no dict.  Returns
+// nullptr without an exception for other keys.
+static PyObject *
+LazyMsgHeaderField(PyObject *self, PyObject *key) {
+  if (!PyUnicode_Check(key)) {
+    return nullptr;
+  }
+  const AisMsg &msg = *reinterpret_cast<LazyMsgObject *>(self)->decoded->msg;
+  if (PyUnicode_CompareWithASCIIString(key, "mmsi") == 0) {
+    return PyLong_FromLong(msg.mmsi);
+  }
+  if (PyUnicode_CompareWithASCIIString(key, "id") == 0) {
+    return PyLong_FromLong(msg.message_id);
+  }
+  if (PyUnicode_CompareWithASCIIString(key, "repeat_indicator") == 0) {
+    return PyLong_FromLong(msg.repeat_indicator);
+  }
+  return nullptr;
+}
 
-  case 'I':  // 25 - Single slot binary message - addressed or broadcast
-    // TODO(schwehr): handle payloads
-    return ais25_to_pydict(nmea_payload, pad);
+// Returns a new reference or nullptr with the exception from error set.
+static PyObject *
+LazyMsgField(PyObject *self, PyObject *key, PyObject *error) {
+  if (PyObject *value = LazyMsgHeaderField(self, key)) {
+    return value;
+  }
+  if (PyErr_Occurred()) {
+    return nullptr;
+  }
+  PyObject *dict = LazyMsgDict(self);
+  if (dict == nullptr) {
+    return nullptr;
+  }
+  PyObject *value = PyDict_GetItemWithError(dict, key);
+  if (value == nullptr) {
+    if (!PyErr_Occurred()) {
+      PyErr_SetObject(error, key);
+    }
+    return nullptr;
+  }
+  Py_INCREF(value);
+  return value;
+}
 
-  case 'J':  // 26 - Multi slot binary message with comm state
-    return ais26_to_pydict(nmea_payload, pad);  // TODO(schwehr): payloads
+static PyObject *
+LazyMsgGetItem(PyObject *self, PyObject *key) {
+  return LazyMsgField(self, key, PyExc_KeyError);
+}
 
-  case 'K':  // 27 - Long-range AIS broadcast message
-    return ais27_to_pydict(nmea_payload, pad);
+static PyObject *
+LazyMsgGetAttr(PyObject *self, PyObject *name) {
+  PyObject *value = PyObject_GenericGetAttr(self, name);
+  if (value != nullptr || !PyErr_ExceptionMatches(PyExc_AttributeError)) {
+    return value;
+  }
+  PyErr_Clear();
+  return LazyMsgField(self, name, PyExc_AttributeError);
+}
 
-  case 'L':  // 28 - UNKNOWN
-    PyErr_Format(ais_py_exception, "ais.decode: message 28 (L) not handled");
-    break;
+static int
+LazyMsgContains(PyObject *self, PyObject *key) {
+  PyObject *dict = LazyMsgDict(self);
+  return dict == nullptr ? -1 : PyDict_Contains(dict, key);
+}
 
-  default:
-    PyErr_Format(ais_py_exception, "ais.decode: unknown message - %c",
-                 nmea_payload[0]);
+static Py_ssize_t
+LazyMsgLen(PyObject *self) {
+  PyObject *dict = LazyMsgDict(self);
+  return dict == nullptr ? -1 : PyDict_Size(dict);
+}
+
+static PyObject *
+LazyMsgIter(PyObject *self) {
+  PyObject *dict = LazyMsgDict(self);
+  return dict == nullptr ? nullptr : PyObject_GetIter(dict);
+}
+
+static PyObject *
+LazyMsgRepr(PyObject *self) {
+  PyObject *dict = LazyMsgDict(self);
+  return dict == nullptr ? nullptr : PyUnicode_FromFormat("LazyMsg(%R)", dict);
+}
+
+static PyObject *
+LazyMsgToDict(PyObject *self, PyObject *unused) {
+  PyObject *dict = LazyMsgDict(self);
+  return dict == nullptr ? nullptr : PyDict_Copy(dict);
+}
+
+static PyObject *
+LazyMsgKeys(PyObject *self, PyObject *unused) {
+  PyObject *dict = LazyMsgDict(self);
+  return dict == nullptr ? nullptr : PyDict_Keys(dict);
+}
+
+static PyObject *
+LazyMsgGet(PyObject *self, PyObject *args) {
+  PyObject *key;
+  PyObject *default_value = Py_None;
+  if (!PyArg_ParseTuple(args, "O|O:get", &key, &default_value)) {
+    return nullptr;
+  }
+  PyObject *value = LazyMsgField(self, key, PyExc_KeyError);
+  if (value == nullptr && PyErr_ExceptionMatches(PyExc_KeyError)) {
+    PyErr_Clear();
+    Py_INCREF(default_value);
+    return default_value;
   }
+  return value;
+}
 
-  return nullptr;
+static PyMethodDef lazy_msg_methods[] = {
+  {"to_dict", LazyMsgToDict, METH_NOARGS,
+   "Return a new dict of all the fields, the same as decode gives"},
+  {"keys", LazyMsgKeys, METH_NOARGS, "Return a list of the field names"},
+  {"get", LazyMsgGet, METH_VARARGS,
+   "Return the field or a default if the message does not have it"},
+  {nullptr, nullptr, 0, nullptr},  // Sentinel
+};
+
+static PyType_Slot lazy_msg_slots[] = {
+  {Py_tp_doc, const_cast<char *>(
+      "Message from decode_lazy.  Fields are read with [] or as attributes.")},
+  {Py_tp_dealloc, reinterpret_cast<void *>(LazyMsgDealloc)},
+  {Py_tp_getattro, reinterpret_cast<void *>(LazyMsgGetAttr)},
+  {Py_tp_iter, reinterpret_cast<void *>(LazyMsgIter)},
+  {Py_tp_repr, reinterpret_cast<void *>(LazyMsgRepr)},
+  {Py_tp_methods, lazy_msg_methods},
+  {Py_mp_subscript, reinterpret_cast<void *>(LazyMsgGetItem)},
+  {Py_mp_length, reinterpret_cast<void *>(LazyMsgLen)},
+  {Py_sq_contains, reinterpret_cast<void *>(LazyMsgContains)},
+  {0, nullptr},
+};
+
+static PyType_Spec lazy_msg_spec = {
+  "_ais.LazyMsg",
+  sizeof(LazyMsgObject),
+  0,
+  Py_TPFLAGS_DEFAULT,
+  lazy_msg_slots,
+};
+
+// decode_lazy(payload, pad=0) -> LazyMsg
+//
+// Like decode, but the dict is not built until a field other than id,
+// repeat_indicator or mmsi is read.  Raises the same DecodeError as decode
+// for payloads that do not decode.
+static PyObject *
+decode_lazy(PyObject *self, PyObject *args) {
+  int _pad = 0;
+  PyObject *payload_arg;
+  TextArg payload;
+  if (!PyArg_ParseTuple(args, "O|i", &payload_arg, &_pad) ||
+      !payload.Init(payload_arg)) {
+    PyErr_Format(ais_py_exception, "ais.decode_lazy: expected (str, int)");
+    return nullptr;
+  }
+  const char *nmea_payload = payload.c_str();
+  const size_t pad = _pad;
+
+  auto decoded = std::make_unique<DecodedPayload>();
+  Py_BEGIN_ALLOW_THREADS
+  *decoded = DecodePayload(nmea_payload, pad);
+  Py_END_ALLOW_THREADS
+  if (DecodedPayloadFailed(*decoded)) {
+    // Sets the same exception as decode.
+    return DecodedPayloadToPyDict(*decoded);
+  }
+
+  auto *lazy = reinterpret_cast<LazyMsgObject *>(
+      lazy_msg_type->tp_alloc(lazy_msg_type, 0));
+  if (lazy == nullptr) {
+    return nullptr;
+  }
+  lazy->decoded = decoded.release();
+  lazy->dict = nullptr;
+  return reinterpret_cast<PyObject *>(lazy);
 }
 
 static PyMethodDef ais_methods[] = {
   {"decode", decode, METH_VARARGS, "Return a dictionary for a NMEA string"},
+  {"decode_many", decode_many, METH_VARARGS,
+   "Return a list of dictionaries or DecodeErrors for sequences of NMEA "
+   "strings and pads"},
+  {"decode_spans", decode_spans, METH_VARARGS,
+   "Return a list of dictionaries or DecodeErrors for payloads given as "
+   "offsets and lengths in a buffer such as bytes or mmap"},
+  {"decode_positions", decode_positions, METH_VARARGS,
+   "Decode position reports into columns of buffers such as NumPy arrays"},
+  {"decode_lazy", decode_lazy, METH_VARARGS,
+   "Return a dict-like message that only converts fields when they are used"},
   {nullptr, nullptr, 0, nullptr},  // Sentinel
 };
 
@@ -3650,6 +4523,33 @@ PyMODINIT_FUNC PyInit__ais(void) {
   ais_py_exception = PyErr_NewException(exception_name, nullptr, nullptr);
   Py_INCREF(ais_py_exception);
   PyModule_AddObject(module, exception_short, ais_py_exception);
+
+  PyObject *vdm_stream_type = PyType_FromSpec(&vdm_stream_spec);
+  if (vdm_stream_type == nullptr ||
+      PyModule_AddObject(module, "VdmStream", vdm_stream_type) != 0) {
+    Py_XDECREF(vdm_stream_type);
+    Py_DECREF(module);
+    return nullptr;
+  }
+
+  lazy_msg_type =
+      reinterpret_cast<PyTypeObject *>(PyType_FromSpec(&lazy_msg_spec));
+  if (lazy_msg_type == nullptr) {
+    Py_DECREF(module);
+    return nullptr;
+  }
+  Py_INCREF(lazy_msg_type);
+  if (PyModule_AddObject(module, "LazyMsg",
+                         reinterpret_cast<PyObject *>(lazy_msg_type)) != 0) {
+    Py_DECREF(lazy_msg_type);
+    Py_DECREF(lazy_msg_type);
+    Py_DECREF(module);
+    return nullptr;
+  }
+#ifdef Py_GIL_DISABLED
+  // The decoders share no mutable state and the shared key cache has a lock.
+  PyUnstable_Module_SetGIL(module, Py_MOD_GIL_NOT_USED);
+#endif
   return module;
 }
 
@@ -16,54 +16,147 @@
 
 #include "decode_body.h"
 
+#include <algorithm>
+#include <cstddef>
 #include <memory>
 #include <string>
+#include <string_view>
 
 #include "ais.h"
+#include "ais_alloc.h"
 
 using libais::AisMsg;
 using std::unique_ptr;
 
 namespace libais {
 
-// TODO(schwehr): Switch to make_unique when C++14 is available on Travis-CI.
+// Constructs a message in the allocator or on the heap if it is nullptr.
 template <typename T, typename... Args>
-std::unique_ptr<T> MakeUnique(Args &&... args) {
-  return std::unique_ptr<T>(new T(std::forward<Args>(args)...));
+std::unique_ptr<T> MakeUnique(AisMsgAllocator *allocator, Args &&... args) {
+  return std::unique_ptr<T>(new (allocator) T(std::forward<Args>(args)...));
 }
 
-unique_ptr<AisMsg> CreateAisMsg6(const std::string &body, const int fill_bits) {
-  libais::Ais6 const msg(body.c_str(), fill_bits);
-  switch (msg.dac) {
+namespace {
+
+// Returns bits [start, start + len) of an armored payload or -1 if any of
+// the characters holding them is not valid armoring.
+int ArmoredBits(std::string_view body, const size_t start,
+                const size_t len) {
+  int result = 0;
+  for (size_t bit = start; bit < start + len;) {
+    int val = body[bit / 6] - 48;
+    if (val < 0 || val > 71 || (val > 39 && val < 48)) {
+      return -1;
+    }
+    if (val > 39) {
+      val -= 8;
+    }
+    const size_t offset = bit % 6;
+    const size_t take = std::min(6 - offset, start + len - bit);
+    result = (result << take) |
+             ((val >> (6 - offset - take)) & ((1 << take) - 1));
+    bit += take;
+  }
+  return result;
+}
+
+// Parses the body once and hands the bits to the message constructor.
+template <typename T>
+unique_ptr<AisMsg> MakeFromBody(std::string_view body, const int fill_bits,
+                                AisMsgAllocator *allocator) {
+  AisBitset bits;
+  if (bits.ParseNmeaPayload(body.data(), body.size(), fill_bits) != AIS_OK) {
+    return nullptr;
+  }
+  return MakeUnique<T>(allocator, bits);
+}
+
+// Like MakeFromBody, but a payload that does not parse still gives a message
+// that reports the parse error through get_error().
+template <typename T>
+unique_ptr<AisMsg> MakeFromPayload(std::string_view body, const int fill_bits,
+                                   AisMsgAllocator *allocator) {
+  AisBitset bits;
+  bits.ParseNmeaPayload(body.data(), body.size(), fill_bits);
+  return MakeUnique<T>(allocator, bits);
+}
+
+}  // namespace
+
+bool PeekAisHeader(std::string_view body, const int fill_bits,
+                   int *message_id, int *dac, int *fi) {
+  if (body.empty() || fill_bits < 0 || fill_bits > 5) {
+    return false;
+  }
+  *message_id = ArmoredBits(body, 0, 6);
+  *dac = -1;
+  *fi = -1;
+  if (*message_id < 0) {
+    return false;
+  }
+
+  const int num_bits = body.size() * 6 - fill_bits;
+  switch (*message_id) {
+    case 6:
+      if (num_bits < 88) {
+        return false;
+      }
+      *dac = ArmoredBits(body, 72, 10);
+      *fi = ArmoredBits(body, 82, 6);
+      break;
+    case 8:
+      if (num_bits < 56) {
+        return false;
+      }
+      *dac = ArmoredBits(body, 40, 10);
+      *fi = ArmoredBits(body, 50, 6);
+      break;
+    default:
+      return true;
+  }
+  return *dac >= 0 && *fi >= 0;
+}
+
+unique_ptr<AisMsg> CreateAisMsg6(std::string_view body, const int fill_bits,
+                                 AisMsgAllocator *allocator) {
+  int message_id;
+  int dac;
+  int fi;
+  if (!PeekAisHeader(body, fill_bits, &message_id, &dac, &fi)) {
+    return nullptr;
+  }
+  switch (dac) {
     // International Maritime Organization (IMO).
     case libais::AIS_DAC_1_INTERNATIONAL:
-      switch (msg.fi) {
+      switch (fi) {
         case 0:
-          return MakeUnique<libais::Ais6_1_0>(body.c_str(), fill_bits);
+          return MakeFromBody<libais::Ais6_1_0>(body, fill_bits, allocator);
         case 1:
-          return MakeUnique<libais::Ais6_1_1>(body.c_str(), fill_bits);
+          return MakeFromBody<libais::Ais6_1_1>(body, fill_bits, allocator);
         case 2:
-          return MakeUnique<libais::Ais6_1_2>(body.c_str(), fill_bits);
+          return MakeFromBody<libais::Ais6_1_2>(body, fill_bits, allocator);
         case 3:
-          return MakeUnique<libais::Ais6_1_3>(body.c_str(), fill_bits);
+          return MakeFromBody<libais::Ais6_1_3>(body, fill_bits, allocator);
         case 4:
-          return MakeUnique<libais::Ais6_1_4>(body.c_str(), fill_bits);
+          return MakeFromBody<libais::Ais6_1_4>(body, fill_bits, allocator);
+        case 5:
+          return MakeFromBody<libais::Ais6_1_5>(body, fill_bits, allocator);
         case 12:
-          return MakeUnique<libais::Ais6_1_12>(body.c_str(), fill_bits);
+          return MakeFromBody<libais::Ais6_1_12>(body, fill_bits, allocator);
         case 14:
-          return MakeUnique<libais::Ais6_1_14>(body.c_str(), fill_bits);
+          return MakeFromBody<libais::Ais6_1_14>(body, fill_bits, allocator);
         case 18:
-          return MakeUnique<libais::Ais6_1_18>(body.c_str(), fill_bits);
+          return MakeFromBody<libais::Ais6_1_18>(body, fill_bits, allocator);
         case 20:
-          return MakeUnique<libais::Ais6_1_20>(body.c_str(), fill_bits);
+          return MakeFromBody<libais::Ais6_1_20>(body, fill_bits, allocator);
         case 25:
-          return MakeUnique<libais::Ais6_1_25>(body.c_str(), fill_bits);
+          return MakeFromBody<libais::Ais6_1_25>(body, fill_bits, allocator);
         // TODO(schwehr): 28.
         // TODO(schwehr): 30.
         case 32:
-          return MakeUnique<libais::Ais6_1_32>(body.c_str(), fill_bits);
+          return MakeFromBody<libais::Ais6_1_32>(body, fill_bits, allocator);
         case 40:
-          return MakeUnique<libais::Ais6_1_40>(body.c_str(), fill_bits);
+          return MakeFromBody<libais::Ais6_1_40>(body, fill_bits, allocator);
       }
       // FI not handled.
       break;
@@ -71,83 +164,89 @@ unique_ptr<AisMsg> CreateAisMsg6(const std::string &body, const int fill_bits) {
   return nullptr;
 }
 
-unique_ptr<AisMsg> CreateAisMsg8(const std::string &body, const int fill_bits) {
-  libais::Ais8 const msg(body.c_str(), fill_bits);
-  switch (msg.dac) {
+unique_ptr<AisMsg> CreateAisMsg8(std::string_view body, const int fill_bits,
+                                 AisMsgAllocator *allocator) {
+  int message_id;
+  int dac;
+  int fi;
+  if (!PeekAisHeader(body, fill_bits, &message_id, &dac, &fi)) {
+    return nullptr;
+  }
+  switch (dac) {
     // International Maritime Organization (IMO).
     case libais::AIS_DAC_1_INTERNATIONAL:
-      switch (msg.fi) {
+      switch (fi) {
         case 0:
-          return MakeUnique<libais::Ais8_1_0>(body.c_str(), fill_bits);
+          return MakeFromBody<libais::Ais8_1_0>(body, fill_bits, allocator);
         case 11:
-          return MakeUnique<libais::Ais8_1_11>(body.c_str(), fill_bits);
+          return MakeFromBody<libais::Ais8_1_11>(body, fill_bits, allocator);
         case 13:
-          return MakeUnique<libais::Ais8_1_13>(body.c_str(), fill_bits);
+          return MakeFromBody<libais::Ais8_1_13>(body, fill_bits, allocator);
         case 15:
-          return MakeUnique<libais::Ais8_1_15>(body.c_str(), fill_bits);
+          return MakeFromBody<libais::Ais8_1_15>(body, fill_bits, allocator);
         case 16:
-          return MakeUnique<libais::Ais8_1_16>(body.c_str(), fill_bits);
+          return MakeFromBody<libais::Ais8_1_16>(body, fill_bits, allocator);
         case 17:
-          return MakeUnique<libais::Ais8_1_17>(body.c_str(), fill_bits);
+          return MakeFromBody<libais::Ais8_1_17>(body, fill_bits, allocator);
         case 19:
-          return MakeUnique<libais::Ais8_1_19>(body.c_str(), fill_bits);
+          return MakeFromBody<libais::Ais8_1_19>(body, fill_bits, allocator);
         case 21:
-          return MakeUnique<libais::Ais8_1_21>(body.c_str(), fill_bits);
+          return MakeFromBody<libais::Ais8_1_21>(body, fill_bits, allocator);
         case 22:
-          return MakeUnique<libais::Ais8_1_22>(body.c_str(), fill_bits);
+          return MakeFromBody<libais::Ais8_1_22>(body, fill_bits, allocator);
         case 24:
-          return MakeUnique<libais::Ais8_1_24>(body.c_str(), fill_bits);
+          return MakeFromBody<libais::Ais8_1_24>(body, fill_bits, allocator);
         case 26:
-          return MakeUnique<libais::Ais8_1_26>(body.c_str(), fill_bits);
+          return MakeFromBody<libais::Ais8_1_26>(body, fill_bits, allocator);
         case 27:
-          return MakeUnique<libais::Ais8_1_27>(body.c_str(), fill_bits);
+          return MakeFromBody<libais::Ais8_1_27>(body, fill_bits, allocator);
         case 29:
-          return MakeUnique<libais::Ais8_1_29>(body.c_str(), fill_bits);
+          return MakeFromBody<libais::Ais8_1_29>(body, fill_bits, allocator);
         case 31:
-          return MakeUnique<libais::Ais8_1_31>(body.c_str(), fill_bits);
+          return MakeFromBody<libais::Ais8_1_31>(body, fill_bits, allocator);
       }
       // FI not handled.
       break;
     // European River Information System (RIS).
     case libais::AIS_DAC_200_RIS:
-      switch (msg.fi) {
+      switch (fi) {
         case 10:
           // Inland ship static and voyage related data
-          return MakeUnique<libais::Ais8_200_10>(body.c_str(), fill_bits);
+          return MakeFromBody<libais::Ais8_200_10>(body, fill_bits, allocator);
         case 21:
            // ETA at lock/bridge/terminal
-          return MakeUnique<libais::Ais8_200_21>(body.c_str(), fill_bits);
+          return MakeFromBody<libais::Ais8_200_21>(body, fill_bits, allocator);
         case 22:
           // RTA at lock/bridge/terminal
-          return MakeUnique<libais::Ais8_200_22>(body.c_str(), fill_bits);
+          return MakeFromBody<libais::Ais8_200_22>(body, fill_bits, allocator);
         case 23:
           // EMMA warning
-          return MakeUnique<libais::Ais8_200_23>(body.c_str(), fill_bits);
+          return MakeFromBody<libais::Ais8_200_23>(body, fill_bits, allocator);
         case 24:
            // Water levels
-          return MakeUnique<libais::Ais8_200_24>(body.c_str(), fill_bits);
+          return MakeFromBody<libais::Ais8_200_24>(body, fill_bits, allocator);
         case 40:
            // Signal status
-          return MakeUnique<libais::Ais8_200_40>(body.c_str(), fill_bits);
+          return MakeFromBody<libais::Ais8_200_40>(body, fill_bits, allocator);
         case 55:
            // Number of persons on board
-          return MakeUnique<libais::Ais8_200_55>(body.c_str(), fill_bits);
+          return MakeFromBody<libais::Ais8_200_55>(body, fill_bits, allocator);
       }
       // FI not handled.
       break;
     // TODO(schwehr): 366 US Coast Guard.
     case 367:  // US Coast Guard.
-      switch (msg.fi) {
+      switch (fi) {
         case 22:
-          return MakeUnique<libais::Ais8_367_22>(body.c_str(), fill_bits);
+          return MakeFromBody<libais::Ais8_367_22>(body, fill_bits, allocator);
         case 23:
-          return MakeUnique<libais::Ais8_367_23>(body.c_str(), fill_bits);
+          return MakeFromBody<libais::Ais8_367_23>(body, fill_bits, allocator);
         case 24:
-          return MakeUnique<libais::Ais8_367_24>(body.c_str(), fill_bits);
+          return MakeFromBody<libais::Ais8_367_24>(body, fill_bits, allocator);
         case 25:
-          return MakeUnique<libais::Ais8_367_25>(body.c_str(), fill_bits);
+          return MakeFromBody<libais::Ais8_367_25>(body, fill_bits, allocator);
         case 33:
-          return MakeUnique<libais::Ais8_367_33>(body.c_str(), fill_bits);
+          return MakeFromBody<libais::Ais8_367_33>(body, fill_bits, allocator);
       }
       // FI not handled.
       break;
@@ -155,7 +254,12 @@ unique_ptr<AisMsg> CreateAisMsg8(const std::string &body, const int fill_bits) {
   return nullptr;
 }
 
-unique_ptr<AisMsg> CreateAisMsg(const std::string &body, const int fill_bits) {
+unique_ptr<AisMsg> CreateAisMsg(std::string_view body, const int fill_bits) {
+  return CreateAisMsg(body, fill_bits, nullptr);
+}
+
+unique_ptr<AisMsg> CreateAisMsg(std::string_view body, const int fill_bits,
+                                AisMsgAllocator *allocator) {
   if (body.empty()) {
     return nullptr;
   }
@@ -167,79 +271,79 @@ unique_ptr<AisMsg> CreateAisMsg(const std::string &body, const int fill_bits) {
     case '1':  // FALLTHROUGH
     case '2':  // FALLTHROUGH
     case '3':  // 1-3: Class A position report.
-      return MakeUnique<libais::Ais1_2_3>(body.c_str(), fill_bits);
+      return MakeFromPayload<libais::Ais1_2_3>(body, fill_bits, allocator);
 
     case '4':  // FALLTHROUGH - 4 - Basestation report
     case ';':  // 11 - UTC date response
-      return MakeUnique<libais::Ais4_11>(body.c_str(), fill_bits);
+      return MakeFromPayload<libais::Ais4_11>(body, fill_bits, allocator);
 
     case '5':  // 5 - Ship and Cargo
-      return MakeUnique<libais::Ais5>(body.c_str(), fill_bits);
+      return MakeFromPayload<libais::Ais5>(body, fill_bits, allocator);
 
     case '6':  // 6 - Addressed binary message
-      return CreateAisMsg6(body, fill_bits);
+      return CreateAisMsg6(body, fill_bits, allocator);
 
     case '7':  // FALLTHROUGH - 7 - ACK for addressed binary message
     case '=':  // 13 - ASRM Ack  (safety message)
-      return MakeUnique<libais::Ais7_13>(body.c_str(), fill_bits);
+      return MakeFromPayload<libais::Ais7_13>(body, fill_bits, allocator);
 
     case '8':  // 8 - Binary broadcast message (BBM)
-      return CreateAisMsg8(body, fill_bits);
+      return CreateAisMsg8(body, fill_bits, allocator);
 
     case '9':  // 9 - SAR Position
-      return MakeUnique<libais::Ais9>(body.c_str(), fill_bits);
+      return MakeFromPayload<libais::Ais9>(body, fill_bits, allocator);
 
     case ':':  //  10 - UTC Query
-      return MakeUnique<libais::Ais10>(body.c_str(), fill_bits);
+      return MakeFromPayload<libais::Ais10>(body, fill_bits, allocator);
 
     // ';' 11 - See 4
 
     case '<':  // 12 - Addressed Safety Related Messages (ASRM)
-      return MakeUnique<libais::Ais12>(body.c_str(), fill_bits);
+      return MakeFromPayload<libais::Ais12>(body, fill_bits, allocator);
 
     // '=' 13 - See 7
 
     case '>':  // 14 - Safety Related Broadcast Message (SRBM)
-      return MakeUnique<libais::Ais14>(body.c_str(), fill_bits);
+      return MakeFromPayload<libais::Ais14>(body, fill_bits, allocator);
 
     case '?':  // 15 - Interrogation
-      return MakeUnique<libais::Ais15>(body.c_str(), fill_bits);
+      return MakeFromPayload<libais::Ais15>(body, fill_bits, allocator);
 
     case '@':  // 16 - Assigned mode command
-      return MakeUnique<libais::Ais16>(body.c_str(), fill_bits);
+      return MakeFromPayload<libais::Ais16>(body, fill_bits, allocator);
 
     case 'A':  // 17 - GNSS broadcast
-      return MakeUnique<libais::Ais17>(body.c_str(), fill_bits);
+      return MakeFromPayload<libais::Ais17>(body, fill_bits, allocator);
 
     case 'B':  // 18 - Position, Class B
-      return MakeUnique<libais::Ais18>(body.c_str(), fill_bits);
+      return MakeFromPayload<libais::Ais18>(body, fill_bits, allocator);
 
     case 'C':  // 19 - Position and ship, Class B
-      return MakeUnique<libais::Ais19>(body.c_str(), fill_bits);
+      return MakeFromPayload<libais::Ais19>(body, fill_bits, allocator);
 
     case 'D':  // 20 - Data link management
-      return MakeUnique<libais::Ais20>(body.c_str(), fill_bits);
+      return MakeFromPayload<libais::Ais20>(body, fill_bits, allocator);
 
     case 'E':  // 21 - Aids to navigation report
-      return MakeUnique<libais::Ais21>(body.c_str(), fill_bits);
+      return MakeFromPayload<libais::Ais21>(body, fill_bits, allocator);
 
     case 'F':  // 22 - Channel Management
-      return MakeUnique<libais::Ais22>(body.c_str(), fill_bits);
+      return MakeFromPayload<libais::Ais22>(body, fill_bits, allocator);
 
     case 'G':  // 23 - Group Assignment Command
-      return MakeUnique<libais::Ais23>(body.c_str(), fill_bits);
+      return MakeFromPayload<libais::Ais23>(body, fill_bits, allocator);
 
     case 'H':  // 24 - Static data report
-      return MakeUnique<libais::Ais24>(body.c_str(), fill_bits);
+      return MakeFromPayload<libais::Ais24>(body, fill_bits, allocator);
 
     case 'I':  // 25 - Single slot binary message
-      return MakeUnique<libais::Ais25>(body.c_str(), fill_bits);
+      return MakeFromPayload<libais::Ais25>(body, fill_bits, allocator);
 
     case 'J':  // 26 - Multi slot binary message with comm state
-      return MakeUnique<libais::Ais26>(body.c_str(), fill_bits);
+      return MakeFromPayload<libais::Ais26>(body, fill_bits, allocator);
 
     case 'K':  // 27 - Long-range AIS broadcast message
-      return MakeUnique<libais::Ais27>(body.c_str(), fill_bits);
+      return MakeFromPayload<libais::Ais27>(body, fill_bits, allocator);
 
     default:
       return nullptr;
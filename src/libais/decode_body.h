@@ -19,8 +19,10 @@
 
 #include <memory>
 #include <string>
+#include <string_view>
 
 #include "ais.h"
+#include "ais_alloc.h"
 
 namespace libais {
 
@@ -31,9 +33,25 @@ namespace libais {
 // The fill_bits are the number of pad bits in the last character of the
 // body.  AIS messages are 8-bit aligned and the characters in the armored
 // body are 6-bit aligned.
-std::unique_ptr<libais::AisMsg> CreateAisMsg(const std::string &body,
+std::unique_ptr<libais::AisMsg> CreateAisMsg(std::string_view body,
                                              const int fill_bits);
 
+// Same as above, but the message is placed in allocator, such as an
+// AisMsgPool or AisMsgArena from ais_alloc.h.  The allocator must outlive the
+// returned message.  A nullptr allocator uses the heap.
+std::unique_ptr<libais::AisMsg> CreateAisMsg(std::string_view body,
+                                             int fill_bits,
+                                             AisMsgAllocator *allocator);
+
+// Reads the message id and, for binary messages 6 and 8, the Designated Area
+// Code (DAC) and Function Identifier (FI) straight from the leading armored
+// characters of the body without decoding the rest of it.  dac and fi are
+// set to -1 for all other message types.
+// Returns false if a character holding these fields is not valid armoring or
+// if the body is too short to hold the DAC and FI.
+bool PeekAisHeader(std::string_view body, int fill_bits, int *message_id,
+                   int *dac, int *fi);
+
 }  // namespace libais
 
 #endif  // LIBAIS_DECODE_BODY_H_
@@ -0,0 +1,249 @@
+// Grid index of position reports for box and radius queries.
+
+#include "spatial_index.h"
+
+#include <algorithm>
+#include <cassert>
+#include <cmath>
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+#include "ais.h"
+
+namespace libais {
+
+namespace {
+
+constexpr double kPi = 3.14159265358979323846;
+
+double Radians(const double degrees) { return degrees * kPi / 180; }
+double Degrees(const double radians) { return radians * 180 / kPi; }
+
+bool InRange(const AisPoint &position) {
+  return position.lng_deg >= -180 && position.lng_deg <= 180 &&
+         position.lat_deg >= -90 && position.lat_deg <= 90;
+}
+
+}  // namespace
+
+bool GetPosition(const AisMsg &msg, AisPoint *position) {
+  assert(position);
+  if (msg.had_error()) {
+    return false;
+  }
+  switch (msg.message_id) {
+    case 1:
+    case 2:
+    case 3:
+      *position = static_cast<const Ais1_2_3 &>(msg).position;
+      break;
+    case 4:
+    case 11:
+      *position = static_cast<const Ais4_11 &>(msg).position;
+      break;
+    case 9:
+      *position = static_cast<const Ais9 &>(msg).position;
+      break;
+    case 18:
+      *position = static_cast<const Ais18 &>(msg).position;
+      break;
+    case 19:
+      *position = static_cast<const Ais19 &>(msg).position;
+      break;
+    case 21:
+      *position = static_cast<const Ais21 &>(msg).position;
+      break;
+    case 27:
+      *position = static_cast<const Ais27 &>(msg).position;
+      break;
+    default:
+      return false;
+  }
+  // 181 and 91 are not available.
+  return InRange(*position);
+}
+
+double DistanceMeters(const AisPoint &a, const AisPoint &b) {
+  const double sin_lat = std::sin(Radians(b.lat_deg - a.lat_deg) / 2);
+  const double sin_lng = std::sin(Radians(b.lng_deg - a.lng_deg) / 2);
+  const double h = sin_lat * sin_lat + std::cos(Radians(a.lat_deg)) *
+                                           std::cos(Radians(b.lat_deg)) *
+                                           sin_lng * sin_lng;
+  return 2 * kEarthRadiusMeters * std::asin(std::min(1.0, std::sqrt(h)));
+}
+
+SpatialIndex::SpatialIndex(const double cell_degrees)
+    : cell_degrees_(cell_degrees),
+      columns_(static_cast<int>(std::ceil(360 / cell_degrees))),
+      rows_(static_cast<int>(std::ceil(180 / cell_degrees))) {
+  assert(cell_degrees > 0 && cell_degrees <= 180);
+}
+
+int SpatialIndex::Column(const double lng_deg) const {
+  const int column = static_cast<int>((lng_deg + 180) / cell_degrees_);
+  return std::clamp(column, 0, columns_ - 1);
+}
+
+int SpatialIndex::Row(const double lat_deg) const {
+  const int row = static_cast<int>((lat_deg + 90) / cell_degrees_);
+  return std::clamp(row, 0, rows_ - 1);
+}
+
+bool SpatialIndex::Insert(const AisMsg &msg, const int64_t time) {
+  PositionReport report;
+  if (!GetPosition(msg, &report.position)) {
+    return false;
+  }
+  report.time = time;
+  report.mmsi = msg.mmsi;
+  report.message_id = msg.message_id;
+  return Insert(report);
+}
+
+bool SpatialIndex::Insert(const PositionReport &report) {
+  if (!InRange(report.position)) {
+    return false;
+  }
+  const uint64_t key =
+      static_cast<uint64_t>(Row(report.position.lat_deg)) * columns_ +
+      Column(report.position.lng_deg);
+  cells_[key].reports.push_back(report);
+  size_++;
+  return true;
+}
+
+void SpatialIndex::Expire(const int64_t time) {
+  for (auto it = cells_.begin(); it != cells_.end();) {
+    Cell &cell = it->second;
+    const size_t begin = cell.begin;
+    while (cell.begin < cell.reports.size() &&
+           cell.reports[cell.begin].time < time) {
+      cell.begin++;
+    }
+    size_ -= cell.begin - begin;
+    if (cell.begin == cell.reports.size()) {
+      it = cells_.erase(it);
+      continue;
+    }
+    // Only move the live reports down once they are at most half the cell.
+    if (cell.begin > cell.reports.size() / 2) {
+      cell.reports.erase(cell.reports.begin(),
+                         cell.reports.begin() + cell.begin);
+      cell.begin = 0;
+    }
+    ++it;
+  }
+}
+
+template <typename Match>
+void SpatialIndex::Scan(const double west, const double south,
+                        const double east, const double north,
+                        const int64_t since, Match match) const {
+  if (west > east || south > north) {
+    return;
+  }
+  const int first_column = Column(west);
+  const int last_column = Column(east);
+  const int first_row = Row(south);
+  const int last_row = Row(north);
+
+  auto visit = [&](const Cell &cell) {
+    for (size_t i = cell.begin; i < cell.reports.size(); i++) {
+      const PositionReport &report = cell.reports[i];
+      if (report.time >= since && report.position.lng_deg >= west &&
+          report.position.lng_deg <= east && report.position.lat_deg >= south &&
+          report.position.lat_deg <= north) {
+        match(report);
+      }
+    }
+  };
+
+  const uint64_t span =
+      static_cast<uint64_t>(last_column - first_column + 1) *
+      (last_row - first_row + 1);
+  if (span > cells_.size()) {
+    // A big box.  Walking the cells in use is cheaper than looking up each
+    // cell in the box.
+    for (const auto &entry : cells_) {
+      const int row = static_cast<int>(entry.first / columns_);
+      const int column = static_cast<int>(entry.first % columns_);
+      if (row >= first_row && row <= last_row && column >= first_column &&
+          column <= last_column) {
+        visit(entry.second);
+      }
+    }
+    return;
+  }
+  for (int row = first_row; row <= last_row; row++) {
+    for (int column = first_column; column <= last_column; column++) {
+      const auto it =
+          cells_.find(static_cast<uint64_t>(row) * columns_ + column);
+      if (it != cells_.end()) {
+        visit(it->second);
+      }
+    }
+  }
+}
+
+void SpatialIndex::FindInBox(const AisPoint &south_west,
+                             const AisPoint &north_east, const int64_t since,
+                             std::vector<PositionReport> *found) const {
+  assert(found);
+  auto match = [found](const PositionReport &report) {
+    found->push_back(report);
+  };
+  const double west = south_west.lng_deg;
+  const double east = north_east.lng_deg;
+  const double south = south_west.lat_deg;
+  const double north = north_east.lat_deg;
+  if (west <= east) {
+    Scan(west, south, east, north, since, match);
+  } else {
+    Scan(west, south, 180, north, since, match);
+    Scan(-180, south, east, north, since, match);
+  }
+}
+
+void SpatialIndex::FindInRadius(const AisPoint &center, const double meters,
+                                const int64_t since,
+                                std::vector<PositionReport> *found) const {
+  assert(found);
+  if (meters < 0 || !InRange(center)) {
+    return;
+  }
+  auto match = [&center, meters, found](const PositionReport &report) {
+    if (DistanceMeters(center, report.position) <= meters) {
+      found->push_back(report);
+    }
+  };
+
+  // The bounding box of the circle.  It spans all longitudes when the circle
+  // reaches a pole.
+  const double angle = meters / kEarthRadiusMeters;
+  const double south = center.lat_deg - Degrees(angle);
+  const double north = center.lat_deg + Degrees(angle);
+  if (south <= -90 || north >= 90 || angle >= kPi / 2) {
+    Scan(-180, std::max(south, -90.0), 180, std::min(north, 90.0), since,
+         match);
+    return;
+  }
+  const double delta = Degrees(std::asin(
+      std::min(1.0, std::sin(angle) / std::cos(Radians(center.lat_deg)))));
+  double west = center.lng_deg - delta;
+  double east = center.lng_deg + delta;
+  if (west < -180) {
+    west += 360;
+  }
+  if (east > 180) {
+    east -= 360;
+  }
+  if (west <= east) {
+    Scan(west, south, east, north, since, match);
+  } else {
+    Scan(west, south, 180, north, since, match);
+    Scan(-180, south, east, north, since, match);
+  }
+}
+
+}  // namespace libais
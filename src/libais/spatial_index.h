@@ -0,0 +1,105 @@
+// -*- c++ -*-
+
+// Find the position reports that fell in a region.
+//
+// SpatialIndex buckets reports into a fixed grid of cells that are
+// cell_degrees on a side.  Only cells that hold reports are kept, in a hash
+// map keyed by the row and column of the cell, and each cell keeps its
+// reports in the order they were inserted.  A query looks up the cells that
+// overlap its bounding box and checks the reports in them, so the cost
+// depends on the size of the box and how busy it is rather than on the
+// number of reports in the index.
+//
+// Reports are expected to arrive in roughly time order.  Expire drops the
+// reports older than a time from the front of each cell, so a sliding time
+// window is kept by calling Expire as time moves on.  The queries can also
+// skip reports older than a time without expiring them.
+
+#ifndef LIBAIS_SPATIAL_INDEX_H_
+#define LIBAIS_SPATIAL_INDEX_H_
+
+#include <cstddef>
+#include <cstdint>
+#include <unordered_map>
+#include <vector>
+
+#include "ais.h"
+
+namespace libais {
+
+constexpr double kDefaultCellDegrees = 0.1;
+
+// The mean radius of the Earth used for distances.
+constexpr double kEarthRadiusMeters = 6371008.8;
+
+// Sets position to the location in a message.  Returns false for messages
+// without a location or where it is not available or out of range.  Handles
+// messages 1, 2, 3, 4, 9, 11, 18, 19, 21 and 27.
+bool GetPosition(const AisMsg &msg, AisPoint *position);
+
+// The great circle distance between two points.
+double DistanceMeters(const AisPoint &a, const AisPoint &b);
+
+struct PositionReport {
+  AisPoint position;
+  int64_t time = 0;
+  int mmsi = 0;
+  int message_id = 0;
+};
+
+class SpatialIndex {
+ public:
+  explicit SpatialIndex(double cell_degrees = kDefaultCellDegrees);
+
+  SpatialIndex(const SpatialIndex &) = delete;
+  SpatialIndex &operator=(const SpatialIndex &) = delete;
+
+  // Adds the location in a message received at time.  Returns false if
+  // GetPosition finds no location.
+  bool Insert(const AisMsg &msg, int64_t time);
+  // Returns false if the position is out of range.
+  bool Insert(const PositionReport &report);
+
+  // Drops the reports older than time.
+  void Expire(int64_t time);
+
+  // Appends the reports at or after since that are inside the box with the
+  // corners south_west and north_east, edges included.  The box crosses the
+  // antimeridian when the west edge is east of the east edge.
+  void FindInBox(const AisPoint &south_west, const AisPoint &north_east,
+                 int64_t since, std::vector<PositionReport> *found) const;
+
+  // Appends the reports at or after since that are within meters of center.
+  void FindInRadius(const AisPoint &center, double meters, int64_t since,
+                    std::vector<PositionReport> *found) const;
+
+  // The number of reports in the index.
+  size_t size() const { return size_; }
+  // The number of cells that hold reports.
+  size_t cells() const { return cells_.size(); }
+
+ private:
+  struct Cell {
+    std::vector<PositionReport> reports;
+    size_t begin = 0;  // Reports before this have been expired.
+  };
+
+  int Column(double lng_deg) const;
+  int Row(double lat_deg) const;
+
+  // Calls match on the reports at or after since in the cells that overlap
+  // the box, which must not cross the antimeridian.
+  template <typename Match>
+  void Scan(double west, double south, double east, double north,
+            int64_t since, Match match) const;
+
+  const double cell_degrees_;
+  const int columns_;
+  const int rows_;
+  std::unordered_map<uint64_t, Cell> cells_;
+  size_t size_ = 0;
+};
+
+}  // namespace libais
+
+#endif  // LIBAIS_SPATIAL_INDEX_H_
@@ -0,0 +1,258 @@
+// Parse NMEA 4.0 TAG blocks and join TAG block groups.
+
+#include "tag_block.h"
+
+#include <cassert>
+#include <charconv>
+#include <cstddef>
+#include <cstdint>
+#include <string_view>
+#include <system_error>
+
+namespace libais {
+
+namespace {
+
+// Returns the value of a hex digit or -1 if c is not a hex digit.
+int HexDigit(const char c) {
+  if (c >= '0' && c <= '9') {
+    return c - '0';
+  }
+  if (c >= 'A' && c <= 'F') {
+    return c - 'A' + 10;
+  }
+  if (c >= 'a' && c <= 'f') {
+    return c - 'a' + 10;
+  }
+  return -1;
+}
+
+// Parses a field that must be all decimal digits.
+bool ParseUnsigned(std::string_view field, int64_t *value) {
+  if (field.empty() || field[0] < '0' || field[0] > '9') {
+    return false;
+  }
+  const char *end = field.data() + field.size();
+  const auto result = std::from_chars(field.data(), end, *value);
+  return result.ec == std::errc() && result.ptr == end;
+}
+
+// Parses a time in seconds with an optional decimal fraction.
+bool ParseTime(std::string_view field, double *value) {
+  if (field.empty() || field[0] < '0' || field[0] > '9') {
+    return false;
+  }
+  const char *end = field.data() + field.size();
+  const auto result =
+      std::from_chars(field.data(), end, *value, std::chars_format::fixed);
+  return result.ec == std::errc() && result.ptr == end;
+}
+
+// Parses a group of the form sentence-total-id.
+bool ParseGroup(std::string_view field, TagBlock *tag) {
+  const size_t first = field.find('-');
+  if (first == std::string_view::npos) {
+    return false;
+  }
+  const size_t second = field.find('-', first + 1);
+  if (second == std::string_view::npos) {
+    return false;
+  }
+  int64_t sentence;
+  int64_t total;
+  if (!ParseUnsigned(field.substr(0, first), &sentence) ||
+      !ParseUnsigned(field.substr(first + 1, second - first - 1), &total) ||
+      !ParseUnsigned(field.substr(second + 1), &tag->group_id)) {
+    return false;
+  }
+  if (total < 1 || total > 99 || sentence < 1 || sentence > total) {
+    return false;
+  }
+  tag->group_sentence = static_cast<int>(sentence);
+  tag->group_total = static_cast<int>(total);
+  return true;
+}
+
+bool ParseField(std::string_view field, TagBlock *tag) {
+  if (field.size() < 2 || field[1] != ':') {
+    return false;
+  }
+  const std::string_view value = field.substr(2);
+  switch (field[0]) {
+    case 'c':
+      return ParseTime(value, &tag->time);
+    case 'd':
+      tag->destination = value;
+      return true;
+    case 'g':
+      return ParseGroup(value, tag);
+    case 'n':
+      return ParseUnsigned(value, &tag->line_count);
+    case 'q':
+      if (value.size() != 1) {
+        return false;
+      }
+      tag->quality = value[0];
+      return true;
+    case 'r':
+      return ParseUnsigned(value, &tag->relative_time);
+    case 's':
+      tag->source = value;
+      return true;
+    case 't':
+      tag->text = value;
+      return true;
+    case 'T':
+      tag->text_date = value;
+      return true;
+    default:
+      // Unknown keys are not an error.
+      return true;
+  }
+}
+
+}  // namespace
+
+bool HexChecksumMatches(std::string_view hex, const uint8_t checksum) {
+  if (hex.size() != 2) {
+    return false;
+  }
+  const int high = HexDigit(hex[0]);
+  const int low = HexDigit(hex[1]);
+  if (high < 0 || low < 0) {
+    return false;
+  }
+  return ((high << 4) | low) == checksum;
+}
+
+bool ParseTagBlock(std::string_view line, TagBlock *tag,
+                   std::string_view *sentence) {
+  assert(tag);
+  assert(sentence);
+  if (line.size() < 5 || line[0] != '\\') {
+    return false;
+  }
+
+  // Find the star and closing backslash while computing the checksum.
+  uint8_t checksum = 0;
+  size_t star = 1;
+  for (; star < line.size() && line[star] != '*'; star++) {
+    if (line[star] == '\\') {
+      return false;
+    }
+    checksum ^= static_cast<uint8_t>(line[star]);
+  }
+  const size_t tag_end = star + 3;
+  if (tag_end >= line.size() || line[tag_end] != '\\') {
+    return false;
+  }
+  if (!HexChecksumMatches(line.substr(star + 1, 2), checksum)) {
+    return false;
+  }
+
+  *tag = TagBlock();
+  std::string_view fields = line.substr(1, star - 1);
+  while (!fields.empty()) {
+    const size_t comma = fields.find(',');
+    if (!ParseField(fields.substr(0, comma), tag)) {
+      return false;
+    }
+    if (comma == std::string_view::npos) {
+      break;
+    }
+    fields.remove_prefix(comma + 1);
+  }
+
+  *sentence = line.substr(tag_end + 1);
+  return true;
+}
+
+TagGroupAssembler::TagGroupAssembler(const size_t max_groups)
+    : groups_(max_groups) {
+  assert(max_groups > 0);
+}
+
+size_t TagGroupAssembler::pending() const {
+  size_t count = 0;
+  for (const Group &group : groups_) {
+    if (group.id != -1) {
+      count++;
+    }
+  }
+  return count;
+}
+
+TagGroupAssembler::Group *TagGroupAssembler::Find(const TagBlock &tag) {
+  for (Group &group : groups_) {
+    // Feeds often put the source only on the first line of a group.
+    if (group.id == tag.group_id &&
+        (group.source.empty() || tag.source.empty() ||
+         group.source == tag.source)) {
+      return &group;
+    }
+  }
+  return nullptr;
+}
+
+TagGroupStatus TagGroupAssembler::Add(const TagBlock &tag,
+                                      std::string_view tag_text,
+                                      std::string_view payload,
+                                      const int payload_fill_bits,
+                                      std::string_view *body, int *fill_bits,
+                                      TagBlock *first_tag) {
+  assert(tag.group_id != -1);
+  assert(body);
+  assert(fill_bits);
+  assert(first_tag);
+
+  Group *group = Find(tag);
+  if (tag.group_sentence == 1) {
+    if (group == nullptr) {
+      // Take a free slot or else drop the stalest group.
+      group = &groups_[0];
+      for (Group &candidate : groups_) {
+        if (candidate.id == -1) {
+          group = &candidate;
+          break;
+        }
+        if (candidate.last_used < group->last_used) {
+          group = &candidate;
+        }
+      }
+      if (group->id != -1) {
+        evicted_++;
+      }
+    }
+    group->id = tag.group_id;
+    group->total = tag.group_total;
+    group->next = 1;
+    group->source.assign(tag.source);
+    group->tag_text.assign(tag_text);
+    group->body.clear();
+  } else if (group == nullptr || group->total != tag.group_total ||
+             group->next != tag.group_sentence) {
+    if (group != nullptr) {
+      group->id = -1;
+    }
+    return TAG_GROUP_OUT_OF_ORDER;
+  }
+
+  group->body.append(payload);
+  group->next++;
+  group->last_used = ++clock_;
+  if (group->next <= group->total) {
+    return TAG_GROUP_PARTIAL;
+  }
+
+  // The slot is free for reuse, but keeps its buffers until the next call.
+  group->id = -1;
+  *body = group->body;
+  *fill_bits = payload_fill_bits;
+  std::string_view rest;
+  const bool parsed = ParseTagBlock(group->tag_text, first_tag, &rest);
+  assert(parsed);
+  (void)parsed;
+  return TAG_GROUP_COMPLETE;
+}
+
+}  // namespace libais
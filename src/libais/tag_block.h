@@ -0,0 +1,128 @@
+// -*- c++ -*-
+
+// Parse NMEA 4.0 TAG (Transport, Annotate, and Group) blocks.
+//
+// A TAG block is a prefix on a line that carries receiver metadata for the
+// NMEA sentence that follows it:
+//
+//   \g:1-2-1604,s:rORBCOMM008,c:1418169601*37\!AIVDM,2,1,6,A,53@o...,0*63
+//
+// The fields between the backslashes are comma separated key:value pairs
+// followed by a star and a 2 character hex xor checksum of everything between
+// the leading backslash and the star.  The keys handled here are:
+//
+//   c: Receiver Unix time in seconds.  Some sources send milliseconds or add
+//      a decimal fraction.
+//   d: Destination.
+//   g: Group as sentence-total-id.  Lines with the same group id belong to
+//      the same logical unit, such as a multi-line VDM message.
+//   n: Line count.
+//   q: Quality.  An ORBCOMM specific character code.
+//   r: Relative time.
+//   s: Source or station.
+//   t: Text string.
+//   T: Human readable date.  ORBCOMM specific.
+//
+// Unknown keys are skipped.  Nothing here allocates while parsing.  The
+// string fields of a TagBlock are views into the parsed line.
+//
+// See Also:
+//   ais/tag_block.py
+
+#ifndef LIBAIS_TAG_BLOCK_H_
+#define LIBAIS_TAG_BLOCK_H_
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <string_view>
+#include <vector>
+
+namespace libais {
+
+// The most TAG groups that a TagGroupAssembler holds at once.
+constexpr size_t kMaxTagGroups = 32;
+
+// The fields of one TAG block.  Fields that were not present keep these
+// default values.
+struct TagBlock {
+  double time = -1;  // c
+  std::string_view destination;  // d
+  int group_sentence = 0;  // g
+  int group_total = 0;  // g
+  int64_t group_id = -1;  // g
+  int64_t line_count = -1;  // n
+  char quality = 0;  // q
+  int64_t relative_time = -1;  // r
+  std::string_view source;  // s
+  std::string_view text;  // t
+  std::string_view text_date;  // T
+};
+
+// Parses the TAG block at the start of line.  sentence is set to the rest of
+// the line after the closing backslash.  Returns false if the line does not
+// start with a TAG block, a field is malformed, or the checksum is missing or
+// does not match.  Lower case hex checksums are accepted.
+bool ParseTagBlock(std::string_view line, TagBlock *tag,
+                   std::string_view *sentence);
+
+// Returns true if hex is the 2 character hex form of checksum.  NMEA
+// sentences and TAG blocks both end in such a checksum.  Upper and lower case
+// hex digits are accepted.
+bool HexChecksumMatches(std::string_view hex, uint8_t checksum);
+
+// What TagGroupAssembler did with a sentence.
+enum TagGroupStatus : uint8_t {
+  TAG_GROUP_COMPLETE,  // Finished a group.
+  TAG_GROUP_PARTIAL,  // Held until the rest of the group arrives.
+  TAG_GROUP_OUT_OF_ORDER,  // The earlier parts of its group are missing.
+};
+
+// Joins the VDM payloads of the sentences in a TAG block group.  Groups are
+// matched on the group id.  The sources are also compared when both lines
+// have one, so interleaved groups from different stations do not collide,
+// while later lines without a source still join their group.
+//
+// Memory is bounded.  There are a fixed number of slots and each slot reuses
+// its buffers.  When all the slots are in use, the group that was least
+// recently added to is dropped to make room for a new one.
+class TagGroupAssembler {
+ public:
+  explicit TagGroupAssembler(size_t max_groups = kMaxTagGroups);
+
+  // Adds the payload of one sentence whose TAG block was parsed from
+  // tag_text.  tag must have a group.  When this completes a group, body and
+  // fill_bits are the joined payload and first_tag is the TAG block of the
+  // first sentence in the group.  Those stay valid until the next call.
+  TagGroupStatus Add(const TagBlock &tag, std::string_view tag_text,
+                     std::string_view payload, int payload_fill_bits,
+                     std::string_view *body, int *fill_bits,
+                     TagBlock *first_tag);
+
+  // The number of groups waiting for more sentences.
+  size_t pending() const;
+  // The number of incomplete groups dropped to make room for new ones.
+  uint64_t evicted() const { return evicted_; }
+
+ private:
+  struct Group {
+    int64_t id = -1;  // -1 when the slot is free.
+    int total = 0;
+    int next = 0;  // The sentence number expected next.
+    uint64_t last_used = 0;
+    std::string source;
+    std::string tag_text;  // The TAG block of the first sentence.
+    std::string body;
+  };
+
+  // Returns the slot holding the group or nullptr.
+  Group *Find(const TagBlock &tag);
+
+  std::vector<Group> groups_;
+  uint64_t clock_ = 0;
+  uint64_t evicted_ = 0;
+};
+
+}  // namespace libais
+
+#endif  // LIBAIS_TAG_BLOCK_H_
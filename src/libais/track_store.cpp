@@ -0,0 +1,127 @@
+// Per vessel ring buffers of recent fixes.
+
+#include "track_store.h"
+
+#include <algorithm>
+#include <cassert>
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+#include "ais.h"
+#include "spatial_index.h"
+
+namespace libais {
+
+namespace {
+
+// Copies the ring of one column into out with the oldest entry first.
+template <typename T>
+void Unroll(const std::vector<T> &column, size_t begin, size_t capacity,
+            size_t next, size_t size, std::vector<T> *out) {
+  const auto first = column.begin() + begin;
+  out->resize(size);
+  if (size < capacity) {
+    std::copy(first, first + size, out->begin());
+    return;
+  }
+  const auto end = std::copy(first + next, first + capacity, out->begin());
+  std::copy(first, first + next, end);
+}
+
+}  // namespace
+
+TrackStore::TrackStore(const size_t capacity) : capacity_(capacity) {
+  assert(capacity > 0);
+}
+
+bool TrackStore::Add(const AisMsg &msg, const int64_t time) {
+  AisPoint position;
+  if (!GetPosition(msg, &position)) {
+    return false;
+  }
+  switch (msg.message_id) {
+    case 1:
+    case 2:
+    case 3: {
+      const auto &m = static_cast<const Ais1_2_3 &>(msg);
+      return Add(msg.mmsi, time, position, m.sog, m.cog);
+    }
+    case 18: {
+      const auto &m = static_cast<const Ais18 &>(msg);
+      return Add(msg.mmsi, time, position, m.sog, m.cog);
+    }
+    case 19: {
+      const auto &m = static_cast<const Ais19 &>(msg);
+      return Add(msg.mmsi, time, position, m.sog, m.cog);
+    }
+    case 27: {
+      const auto &m = static_cast<const Ais27 &>(msg);
+      return Add(msg.mmsi, time, position, m.sog, m.cog);
+    }
+    default:
+      return false;
+  }
+}
+
+bool TrackStore::Add(const int mmsi, const int64_t time,
+                     const AisPoint &position, const float sog,
+                     const float cog) {
+  const auto inserted = vessel_index_.emplace(mmsi, rings_.size());
+  const size_t vessel = inserted.first->second;
+  if (inserted.second) {
+    rings_.emplace_back();
+    const size_t size = rings_.size() * capacity_;
+    time_.resize(size);
+    x_.resize(size);
+    y_.resize(size);
+    sog_.resize(size);
+    cog_.resize(size);
+  }
+
+  Ring &ring = rings_[vessel];
+  if (ring.size > 0) {
+    if (time == ring.last_time) {
+      duplicates_++;
+      return false;
+    }
+    if (time < ring.last_time) {
+      out_of_order_++;
+      return false;
+    }
+  }
+
+  const size_t index = vessel * capacity_ + ring.next;
+  time_[index] = time;
+  x_[index] = position.lng_deg;
+  y_[index] = position.lat_deg;
+  sog_[index] = sog;
+  cog_[index] = cog;
+  ring.last_time = time;
+  ring.next = ring.next + 1 == capacity_ ? 0 : ring.next + 1;
+  ring.size = std::min(ring.size + 1, capacity_);
+  return true;
+}
+
+bool TrackStore::GetTrack(const int mmsi, Track *track) const {
+  assert(track);
+  const auto it = vessel_index_.find(mmsi);
+  if (it == vessel_index_.end()) {
+    return false;
+  }
+  const Ring &ring = rings_[it->second];
+  const size_t begin = it->second * capacity_;
+  Unroll(time_, begin, capacity_, ring.next, ring.size, &track->time);
+  Unroll(x_, begin, capacity_, ring.next, ring.size, &track->x);
+  Unroll(y_, begin, capacity_, ring.next, ring.size, &track->y);
+  Unroll(sog_, begin, capacity_, ring.next, ring.size, &track->sog);
+  Unroll(cog_, begin, capacity_, ring.next, ring.size, &track->cog);
+  return true;
+}
+
+size_t TrackStore::TrackSize(const int mmsi) const {
+  const auto it = vessel_index_.find(mmsi);
+  return it == vessel_index_.end() ? 0 : rings_[it->second].size;
+}
+
+}  // namespace libais
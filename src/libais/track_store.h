@@ -0,0 +1,94 @@
+// -*- c++ -*-
+
+// Recent tracks of each vessel from position reports.
+//
+// TrackStore keeps the last capacity fixes of each MMSI in a ring buffer.
+// The rings are stored as structure of arrays: one column each for the
+// time, longitude, latitude, speed and course, with each vessel owning a
+// contiguous run of capacity entries in every column.  So a vessel takes the
+// same memory however long it is heard from, and walking one field of a track
+// touches only that field.
+//
+// A fix is dropped if its time is not after the last fix kept for the
+// vessel.  That removes the copies of a message heard by more than one
+// receiver and reports that arrive out of order.
+
+#ifndef LIBAIS_TRACK_STORE_H_
+#define LIBAIS_TRACK_STORE_H_
+
+#include <cstddef>
+#include <cstdint>
+#include <unordered_map>
+#include <vector>
+
+#include "ais.h"
+
+namespace libais {
+
+constexpr size_t kDefaultTrackCapacity = 256;
+
+// A track with the oldest fix first.
+struct Track {
+  std::vector<int64_t> time;
+  std::vector<double> x;  // Longitude.
+  std::vector<double> y;  // Latitude.
+  std::vector<float> sog;  // Knots.
+  std::vector<float> cog;  // Degrees.
+
+  size_t size() const { return time.size(); }
+};
+
+class TrackStore {
+ public:
+  // Keeps up to capacity fixes per vessel.
+  explicit TrackStore(size_t capacity = kDefaultTrackCapacity);
+
+  TrackStore(const TrackStore &) = delete;
+  TrackStore &operator=(const TrackStore &) = delete;
+
+  // Adds the fix in a message 1, 2, 3, 18, 19 or 27 received at time.
+  // Returns false if the message has no usable position or the fix was
+  // dropped as a duplicate or out of order.
+  bool Add(const AisMsg &msg, int64_t time);
+  bool Add(int mmsi, int64_t time, const AisPoint &position, float sog,
+           float cog);
+
+  // Replaces track with the fixes kept for an MMSI.  Returns false if the
+  // MMSI has not been seen.
+  bool GetTrack(int mmsi, Track *track) const;
+
+  // The number of fixes kept for an MMSI.
+  size_t TrackSize(int mmsi) const;
+
+  size_t capacity() const { return capacity_; }
+  size_t vessels() const { return rings_.size(); }
+  // Fixes with the same time as the last one kept for the vessel.
+  uint64_t duplicates() const { return duplicates_; }
+  // Fixes older than the last one kept for the vessel.
+  uint64_t out_of_order() const { return out_of_order_; }
+
+ private:
+  struct Ring {
+    int64_t last_time = 0;
+    size_t next = 0;  // Where the next fix goes.
+    size_t size = 0;
+  };
+
+  const size_t capacity_;
+  std::unordered_map<int, size_t> vessel_index_;
+  // Vessel i owns entries [i * capacity_, (i + 1) * capacity_) of each
+  // column.
+  std::vector<Ring> rings_;
+  std::vector<int64_t> time_;
+  std::vector<double> x_;
+  std::vector<double> y_;
+  std::vector<float> sog_;
+  std::vector<float> cog_;
+
+  uint64_t duplicates_ = 0;
+  uint64_t out_of_order_ = 0;
+};
+
+}  // namespace libais
+
+#endif  // LIBAIS_TRACK_STORE_H_
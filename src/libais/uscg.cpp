@@ -0,0 +1,136 @@
+// Parse the older US Coast Guard metadata that follows an NMEA sentence.
+
+#include "uscg.h"
+
+#include <cassert>
+#include <charconv>
+#include <cstddef>
+#include <cstdint>
+#include <string_view>
+#include <system_error>
+
+namespace libais {
+
+namespace {
+
+bool IsDigit(const char c) { return c >= '0' && c <= '9'; }
+
+// Parses an integer that fills the whole field.  An empty field is left as
+// missing.
+template <typename T>
+bool ParseInteger(std::string_view field, T *value) {
+  if (field.empty()) {
+    return true;
+  }
+  const char *end = field.data() + field.size();
+  const auto result = std::from_chars(field.data(), end, *value);
+  return result.ec == std::errc() && result.ptr == end;
+}
+
+// Parses a non-negative decimal number that fills the whole field.
+bool ParseDecimal(std::string_view field, double *value) {
+  if (field.empty()) {
+    return true;
+  }
+  if (!IsDigit(field[0])) {
+    return false;
+  }
+  const char *end = field.data() + field.size();
+  const auto result =
+      std::from_chars(field.data(), end, *value, std::chars_format::fixed);
+  return result.ec == std::errc() && result.ptr == end;
+}
+
+// Parses hhmmss.ss into seconds since midnight.
+bool ParseTimeOfDay(std::string_view field, double *value) {
+  if (field.empty()) {
+    return true;
+  }
+  if (field.size() < 6) {
+    return false;
+  }
+  for (size_t i = 0; i < 4; i++) {
+    if (!IsDigit(field[i])) {
+      return false;
+    }
+  }
+  double seconds;
+  if (!ParseDecimal(field.substr(4), &seconds)) {
+    return false;
+  }
+  const int hours = (field[0] - '0') * 10 + (field[1] - '0');
+  const int minutes = (field[2] - '0') * 10 + (field[3] - '0');
+  if (hours > 23 || minutes > 59 || seconds >= 61) {
+    return false;
+  }
+  *value = hours * 3600 + minutes * 60 + seconds;
+  return true;
+}
+
+bool ParseField(std::string_view field, UscgMetadata *metadata) {
+  if (field.empty()) {
+    return true;
+  }
+  if (IsDigit(field[0])) {
+    if (metadata->time >= 0) {
+      return true;
+    }
+    return ParseDecimal(field, &metadata->time);
+  }
+  const std::string_view value = field.substr(1);
+  switch (field[0]) {
+    case 'd':
+      return ParseInteger(value, &metadata->signal_strength);
+    case 's':
+      return ParseInteger(value, &metadata->rssi);
+    case 'S':
+      return ParseInteger(value, &metadata->slot);
+    case 't':
+      return ParseTimeOfDay(value, &metadata->receiver_time);
+    case 'T':
+      return ParseDecimal(value, &metadata->time_of_arrival);
+    case 'x':
+      return ParseInteger(value, &metadata->counter);
+    case 'r':
+    case 'R':
+    case 'b':
+    case 'B':
+    case 'D':
+      metadata->station = field;
+      return true;
+    default:
+      // Unknown letter codes are not an error.
+      return true;
+  }
+}
+
+}  // namespace
+
+bool ParseUscgMetadata(std::string_view line, UscgMetadata *metadata,
+                       std::string_view *sentence) {
+  assert(metadata);
+  assert(sentence);
+  const size_t star = line.find('*');
+  if (star == std::string_view::npos || star + 3 >= line.size() ||
+      line[star + 3] != ',') {
+    return false;
+  }
+
+  *metadata = UscgMetadata();
+  std::string_view fields = line.substr(star + 4);
+  while (true) {
+    const size_t comma = fields.find(',');
+    if (!ParseField(fields.substr(0, comma), metadata)) {
+      return false;
+    }
+    if (comma == std::string_view::npos) {
+      break;
+    }
+    fields.remove_prefix(comma + 1);
+  }
+
+  *sentence = line.substr(0, star + 3);
+  return true;
+}
+
+}  // namespace libais
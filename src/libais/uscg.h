@@ -0,0 +1,63 @@
+// -*- c++ -*-
+
+// Parse the older US Coast Guard metadata that follows an NMEA sentence.
+//
+// The format was never standardized.  It is a comma separated list of
+// fields after the checksum, each starting with a letter code, and ending
+// with the logger's Unix time:
+//
+//   !AIVDM,1,1,,A,35Mqd3POj3rmIpjGSpmeCJaH00Qh,0*34,d-095,S1651,t161344.00,T44.03018211,r3669963,1429287142  // NOLINT
+//
+// The fields handled here are:
+//
+//   d: Signal strength in dBm.
+//   s: Receiver signal strength indicator.
+//   S: Slot number within the minute.
+//   t: Receiver UTC time of day as hhmmss.ss.
+//   T: Time of arrival in seconds within the minute.
+//   x: Counter.
+//   r, R, b, B or D: The station, including this letter.
+//   A number: The logger's Unix time.  Only the first one is kept.  Some
+//     loggers add a second time.
+//
+// Empty fields and unknown letter codes are skipped.  The logger time is
+// often far from the receive time.  TAG blocks (tag_block.h) are the
+// standard replacement for this format.
+//
+// See Also:
+//   ais/uscg.py
+
+#ifndef LIBAIS_USCG_H_
+#define LIBAIS_USCG_H_
+
+#include <cstdint>
+#include <limits>
+#include <string_view>
+
+namespace libais {
+
+// signal_strength when the d field is missing.
+constexpr int16_t kNoSignalStrength = std::numeric_limits<int16_t>::min();
+
+// The USCG metadata of one line.  Fields that were not present keep these
+// default values.  station is a view into the parsed line.
+struct UscgMetadata {
+  double time = -1;  // Logger Unix time.
+  double receiver_time = -1;  // t as seconds since midnight UTC.
+  double time_of_arrival = -1;  // T
+  std::string_view station;  // r, R, b, B or D
+  int32_t counter = -1;  // x
+  int16_t signal_strength = kNoSignalStrength;  // d
+  int16_t rssi = -1;  // s
+  int16_t slot = -1;  // S
+};
+
+// Splits a line into the NMEA sentence, which ends 2 characters after the
+// first '*', and the metadata after it.  Returns false if there is no
+// metadata or a field does not parse.  Does not check the sentence.
+bool ParseUscgMetadata(std::string_view line, UscgMetadata *metadata,
+                       std::string_view *sentence);
+
+}  // namespace libais
+
+#endif  // LIBAIS_USCG_H_
@@ -12,10 +12,8 @@
 // See the License for the specific language governing permissions and
 // limitations under the License.
 
-// Parse NMEA AIS VDM strings without extra metadata.
+// Parse NMEA AIS VDM strings with optional TAG block and USCG metadata.
 //
-// TODO(schwehr): Convert the catch (...) blanket exception catches to the
-//   expected exception.
 // TODO(schwehr): Enable or remove logging messages.
 
 #include "vdm.h"
@@ -24,6 +22,7 @@
 #include <cassert>
 #include <cctype>
 #include <cstdint>
+#include <cstring>
 #include <deque>
 #include <functional>
 #include <iomanip>
@@ -32,11 +31,14 @@
 #include <numeric>
 #include <sstream>
 #include <string>
+#include <string_view>
 #include <utility>
 #include <vector>
 
 #include "ais.h"
 #include "decode_body.h"
+#include "tag_block.h"
+#include "uscg.h"
 
 using libais::AisMsg;
 using std::ostringstream;
@@ -44,12 +46,124 @@ using std::unique_ptr;
 
 namespace libais {
 
-constexpr size_t kNoSequenceNumber = 999999;
+namespace {
 
-uint8_t Checksum(const std::string &line) {
+// Returns the value of a short field of decimal digits or -1 if the field is
+// empty or has anything other than digits.
+int DecimalField(std::string_view field) {
+  if (field.empty() || field.size() > 4) {
+    return -1;
+  }
+  int value = 0;
+  for (const char c : field) {
+    if (c < '0' || c > '9') {
+      return -1;
+    }
+    value = value * 10 + (c - '0');
+  }
+  return value;
+}
+
+// The primes of XXH64.
+constexpr uint64_t kPrime1 = 0x9E3779B185EBCA87ULL;
+constexpr uint64_t kPrime2 = 0xC2B2AE3D27D4EB4FULL;
+constexpr uint64_t kPrime3 = 0x165667B19E3779F9ULL;
+constexpr uint64_t kPrime4 = 0x85EBCA77C2B2AE63ULL;
+constexpr uint64_t kPrime5 = 0x27D4EB2F165667C5ULL;
+
+uint64_t RotateLeft(const uint64_t value, const int bits) {
+  return (value << bits) | (value >> (64 - bits));
+}
+
+uint64_t Read64(const char *data) {
+  uint64_t value;
+  std::memcpy(&value, data, sizeof(value));
+  return value;
+}
+
+uint32_t Read32(const char *data) {
+  uint32_t value;
+  std::memcpy(&value, data, sizeof(value));
+  return value;
+}
+
+uint64_t XxRound(uint64_t acc, const uint64_t input) {
+  acc += input * kPrime2;
+  return RotateLeft(acc, 31) * kPrime1;
+}
+
+uint64_t XxMerge(uint64_t acc, const uint64_t value) {
+  acc ^= XxRound(0, value);
+  return acc * kPrime1 + kPrime4;
+}
+
+// Rounds up to a power of 2 that is at least twice size.
+size_t TableSize(const size_t size) {
+  size_t table_size = 16;
+  while (table_size < size * 2) {
+    table_size *= 2;
+  }
+  return table_size;
+}
+
+}  // namespace
+
+uint8_t Checksum(std::string_view line) {
   return std::accumulate(line.begin(), line.end(), 0, std::bit_xor<uint8_t>());
 }
 
+uint64_t XxHash64(std::string_view data, const uint64_t seed) {
+  const char *pos = data.data();
+  const char *const end = pos + data.size();
+  uint64_t hash;
+  if (data.size() >= 32) {
+    uint64_t v1 = seed + kPrime1 + kPrime2;
+    uint64_t v2 = seed + kPrime2;
+    uint64_t v3 = seed;
+    uint64_t v4 = seed - kPrime1;
+    for (; end - pos >= 32; pos += 32) {
+      v1 = XxRound(v1, Read64(pos));
+      v2 = XxRound(v2, Read64(pos + 8));
+      v3 = XxRound(v3, Read64(pos + 16));
+      v4 = XxRound(v4, Read64(pos + 24));
+    }
+    hash = RotateLeft(v1, 1) + RotateLeft(v2, 7) + RotateLeft(v3, 12) +
+           RotateLeft(v4, 18);
+    hash = XxMerge(hash, v1);
+    hash = XxMerge(hash, v2);
+    hash = XxMerge(hash, v3);
+    hash = XxMerge(hash, v4);
+  } else {
+    hash = seed + kPrime5;
+  }
+  hash += data.size();
+
+  for (; end - pos >= 8; pos += 8) {
+    hash ^= XxRound(0, Read64(pos));
+    hash = RotateLeft(hash, 27) * kPrime1 + kPrime4;
+  }
+  if (end - pos >= 4) {
+    hash ^= Read32(pos) * kPrime1;
+    hash = RotateLeft(hash, 23) * kPrime2 + kPrime3;
+    pos += 4;
+  }
+  for (; pos < end; pos++) {
+    hash ^= static_cast<uint8_t>(*pos) * kPrime5;
+    hash = RotateLeft(hash, 11) * kPrime1;
+  }
+
+  hash ^= hash >> 33;
+  hash *= kPrime2;
+  hash ^= hash >> 29;
+  hash *= kPrime3;
+  hash ^= hash >> 32;
+  return hash;
+}
+
+uint64_t PayloadHash(std::string_view body, const int fill_bits) {
+  return XxHash64(body, fill_bits);
+}
+
 std::string ToHex2(int32_t val) {
   std::ostringstream out;
   out << std::hex << std::setfill('0') << std::setw(2) << val;
@@ -62,37 +176,13 @@ std::string ChecksumHexString(const std::string &base) {
   return checksum;
 }
 
-std::vector<std::string> Split(const std::string &line, char delim) {
-  std::vector<std::string> result;
-  std::stringstream ss(line);
-  while (!ss.eof()) {
-    std::string next;
-    std::getline(ss, next, delim);
-    result.push_back(next);
-  }
-  return result;
-}
-
-bool ValidateChecksum(const std::string &line) {
-  std::vector<std::string> fields = Split(line, '*');
-
-  if (fields.size() != 2 || fields[1].size() != 2) {
-    return false;
-  }
-
-  try {
-    const std::string checksum_str(fields[1]);
-    int32_t const checksum = std::stoi(checksum_str, nullptr, 16);
-
-    int32_t const checksum_calculated = Checksum(line.substr(1, line.size() - 4));
-    if (checksum_calculated != checksum) {
-      return false;
-    }
-  } catch (...) {
+bool ValidateChecksum(std::string_view line) {
+  const size_t star = line.find('*');
+  if (star == std::string_view::npos || star == 0) {
     return false;
   }
-
-  return true;
+  return HexChecksumMatches(line.substr(star + 1),
+                            Checksum(line.substr(1, star - 1)));
 }
 
 std::string ReportErrorLine(const std::string &msg, const std::string &line,
@@ -101,56 +191,95 @@ std::string ReportErrorLine(const std::string &msg, const std::string &line,
          line;
 }
 
-bool GetSentenceSequenceNumbers(const std::string & /* line */,
-                                const int64_t /* line_number */,
-                                const std::vector<std::string> &fields,
-                                int32_t *sentence_total,
-                                int32_t *sentence_number,
-                                int32_t *sequence_number, char *channel) {
-  try {
-    *sentence_total = std::stoi(fields[1]);
-  } catch (...) {
+bool ParseNmeaSentence(std::string_view line, NmeaSentenceView *sentence) {
+  assert(sentence);
+  if (line.size() < 9 || line[0] != '!') {
+    return false;
+  }
+
+  // Find the 6 commas and the star while computing the checksum.
+  static const size_t kNumFields = 7;
+  size_t field_end[kNumFields];
+  size_t num_commas = 0;
+  uint8_t checksum = 0;
+  size_t star = 1;
+  for (; star < line.size() && line[star] != '*'; star++) {
+    const char c = line[star];
+    checksum ^= static_cast<uint8_t>(c);
+    if (c == ',') {
+      if (num_commas == kNumFields - 1) {
+        return false;
+      }
+      field_end[num_commas++] = star;
+    }
+  }
+  if (num_commas != kNumFields - 1 || star == line.size()) {
+    return false;
+  }
+  if (!HexChecksumMatches(line.substr(star + 1), checksum)) {
     return false;
   }
-  if (*sentence_total < 0 || *sentence_total >= kMaxSentences) {
+  field_end[kNumFields - 1] = star;
+
+  auto field = [&line, &field_end](const size_t i) {
+    const size_t begin = i == 0 ? 0 : field_end[i - 1] + 1;
+    return line.substr(begin, field_end[i] - begin);
+  };
+
+  if (field(0).size() != 6) {
     // TODO(schwehr): Test this code path.
     return false;
   }
+  sentence->talker = line.substr(1, 2);
+  sentence->sentence_type = line.substr(3, 3);
 
-  if (fields[2].size() != 1) {
+  sentence->sentence_total = DecimalField(field(1));
+  if (sentence->sentence_total < 0 ||
+      sentence->sentence_total >= kMaxSentences) {
     return false;
   }
-  try {
-    *sentence_number = std::stoi(fields[2]);
-  } catch (...) {
-    // TODO(schwehr): Test this code path.
+
+  const std::string_view number = field(2);
+  if (number.size() != 1) {
     return false;
   }
-  if (*sentence_number < 1 || *sentence_number > *sentence_total) {
+  sentence->sentence_number = DecimalField(number);
+  if (sentence->sentence_number < 1 ||
+      sentence->sentence_number > sentence->sentence_total) {
     return false;
   }
 
-  if (fields[3].empty()) {
-    *sequence_number = kNoSequenceNumber;
+  const std::string_view sequence = field(3);
+  if (sequence.empty()) {
+    sentence->sequence_number = kNoSequenceNumber;
   } else {
-    try {
-      *sequence_number = std::stoi(fields[3]);
-    } catch (...) {
+    const int sequence_number = DecimalField(sequence);
+    if (sequence_number < 0 || sequence_number >= kNumSequenceChannels) {
       return false;
     }
-    if (*sequence_number < 0 || *sequence_number >= kNumSequenceChannels) {
-      // TODO(schwehr): Simplify this block to just return false.
-      if (fields[3] != "") {
-        return false;
-      }
-      *sequence_number = kNoSequenceNumber;
-    }
+    sentence->sequence_number = sequence_number;
+  }
+
+  const std::string_view channel = field(4);
+  if (channel.size() != 1 || (channel[0] != 'A' && channel[0] != 'B')) {
+    return false;
   }
+  sentence->channel = channel[0];
 
-  if (fields[4].size() != 1 || (fields[4][0] != 'A' && fields[4][0] != 'B')) {
+  sentence->body = field(5);
+  if (sentence->body.size() < 1 || sentence->body.size() > 199) {
+    // TODO(schwehr): Test this code path.
+    return false;
+  }
+
+  const std::string_view fill_bits = field(6);
+  if (fill_bits.size() != 1) {
+    return false;
+  }
+  sentence->fill_bits = DecimalField(fill_bits);
+  if (sentence->fill_bits < 0 || sentence->fill_bits > 5) {
     return false;
   }
-  *channel = fields[4][0];
 
   return true;
 }
@@ -162,59 +291,14 @@ std::unique_ptr<T> MakeUnique(Args &&... args) {
 }
 
 // static
-unique_ptr<NmeaSentence> NmeaSentence::Create(const std::string &line,
+unique_ptr<NmeaSentence> NmeaSentence::Create(std::string_view line,
                                               int64_t line_number) {
-  if (line.size() < 9 || line[0] != '!') {
-    return nullptr;
-  }
-
-  std::vector<std::string> fields = Split(line, ',');
-  if (fields.size() != 7) {
-    return nullptr;
-  }
-
-  if (!ValidateChecksum(line)) {
-    return nullptr;
-  }
-
-  if (fields[0].size() != 6) {
-    // TODO(schwehr): Test this code path.
-    return nullptr;
-  }
-
-  const std::string talker(fields[0].substr(1, 2));
-  const std::string sentence_type(fields[0].substr(3));
-
-  int32_t sentence_total;
-  int32_t sentence_number;
-  int32_t sequence_number;
-  char channel;
-  if (!GetSentenceSequenceNumbers(line, line_number, fields, &sentence_total,
-                                  &sentence_number, &sequence_number,
-                                  &channel)) {
+  NmeaSentenceView fields;
+  if (!ParseNmeaSentence(line, &fields)) {
     return nullptr;
   }
 
-  const std::string body(fields[5]);
-  if (body.size() < 1 || body.size() > 199) {
-    // TODO(schwehr): Test this code path.
-    return nullptr;
-  }
-
-  int32_t fill_bits;
-  try {
-    fill_bits = std::stoi(fields[6].substr(0, 1));
-  } catch (...) {
-    // TODO(schwehr): Test this code path.
-    return nullptr;
-  }
-  if (fill_bits < 0 || fill_bits > 5) {
-    return nullptr;
-  }
-
-  return MakeUnique<NmeaSentence>(talker, sentence_type, sentence_total,
-                                  sentence_number, sequence_number, channel,
-                                  body, fill_bits, line_number);
+  return MakeUnique<NmeaSentence>(fields, line_number);
 }
 
 // TODO(schwehr): Is if faster to just use string.append?
@@ -285,9 +369,8 @@ std::string NmeaSentence::ToString() const {
   return "!" + result;
 }
 
-std::string NmeaSentence::ToMd5Digest() const {
-  // TODO(schwehr): md5 digest.
-  return "";
+uint64_t NmeaSentence::ToPayloadHash() const {
+  return PayloadHash(body_, fill_bits_);
 }
 
 bool NmeaSentence::VerifyInSameMessage(const NmeaSentence &sentence) const {
@@ -312,72 +395,291 @@ bool NmeaSentence::VerifyInSameMessage(const NmeaSentence &sentence) const {
   return true;
 }
 
-bool VdmStream::AddLine(const std::string &line) {
+DuplicateFilter::DuplicateFilter(const size_t max_messages,
+                                 const double window_seconds)
+    : generation_size_(std::max<size_t>(max_messages / 2, 1)),
+      generation_seconds_(window_seconds / 2),
+      current_(TableSize(generation_size_)),
+      previous_(TableSize(generation_size_)) {}
+
+bool DuplicateFilter::Contains(const std::vector<uint64_t> &table,
+                               const uint64_t hash) const {
+  const size_t mask = table.size() - 1;
+  for (size_t index = hash & mask;; index = (index + 1) & mask) {
+    if (table[index] == hash) {
+      return true;
+    }
+    if (table[index] == 0) {
+      return false;
+    }
+  }
+}
+
+void DuplicateFilter::Rotate(const double time) {
+  std::swap(current_, previous_);
+  std::fill(current_.begin(), current_.end(), 0);
+  current_size_ = 0;
+  // A rotation on the count for a message without a time keeps the start,
+  // so untimed messages do not restart the time window.
+  if (time >= 0) {
+    current_start_ = time;
+  }
+}
+
+bool DuplicateFilter::Check(uint64_t hash, const double time) {
+  if (hash == 0) {
+    hash = 1;
+  }
+  if (time >= 0) {
+    if (current_start_ < 0) {
+      current_start_ = time;
+    } else if (time - current_start_ >= generation_seconds_) {
+      // Skipping ahead by a whole window empties both generations.
+      if (time - current_start_ >= 2 * generation_seconds_) {
+        Rotate(time);
+      }
+      Rotate(time);
+    }
+  }
+  if (Contains(current_, hash) || Contains(previous_, hash)) {
+    duplicates_++;
+    return true;
+  }
+  if (current_size_ == generation_size_) {
+    Rotate(time);
+  }
+  const size_t mask = current_.size() - 1;
+  size_t index = hash & mask;
+  while (current_[index] != 0) {
+    index = (index + 1) & mask;
+  }
+  current_[index] = hash;
+  current_size_++;
+  return false;
+}
+
+bool VdmStream::AddLine(std::string_view line) {
+  unique_ptr<AisMsg> msg;
+  const VdmLineStatus status = AddSentence(line, &msg);
+  if (msg != nullptr) {
+    messages_.emplace_front(std::move(msg));
+  }
+  return status == VDM_LINE_DECODED || status == VDM_LINE_PARTIAL ||
+         status == VDM_LINE_DUPLICATE;
+}
+
+const char *VdmStream::AddBuffer(const char *begin, const char *end,
+                                 std::vector<unique_ptr<AisMsg>> *messages,
+                                 std::vector<VdmLineStatus> *line_status) {
+  assert(begin <= end);
+  assert(messages);
+  assert(line_status);
+  messages->clear();
+  line_status->clear();
+
+  const char *pos = begin;
+  std::string_view line;
+  while (NextLine(&pos, end, &line)) {
+    unique_ptr<AisMsg> msg;
+    line_status->push_back(AddSentence(line, &msg));
+    if (msg != nullptr) {
+      messages->emplace_back(std::move(msg));
+    }
+  }
+  return pos;
+}
+
+VdmLineStatus VdmStream::AddSentence(std::string_view line,
+                                     unique_ptr<AisMsg> *msg) {
+  std::string_view body;
+  int fill_bits;
+  VdmLineStatus status;
+  if (!assembler_.AddLine(line, &body, &fill_bits, &status)) {
+    return status;
+  }
+  if (duplicates_ != nullptr) {
+    double time = -1;
+    if (assembler_.tag_block() != nullptr) {
+      time = assembler_.tag_block()->time;
+    } else if (assembler_.uscg_metadata() != nullptr) {
+      time = assembler_.uscg_metadata()->time;
+    }
+    if (duplicates_->Check(PayloadHash(body, fill_bits), time)) {
+      return VDM_LINE_DUPLICATE;
+    }
+  }
+  *msg = CreateAisMsg(body, fill_bits, allocator_);
+  if (*msg == nullptr) {
+    return VDM_LINE_UNDECODABLE;
+  }
+  return VDM_LINE_DECODED;
+}
+
+bool NextLine(const char **pos, const char *end, std::string_view *line) {
+  assert(*pos <= end);
+  const char *newline =
+      static_cast<const char *>(std::memchr(*pos, '\n', end - *pos));
+  if (newline == nullptr) {
+    return false;
+  }
+  const char *line_end = newline;
+  if (line_end > *pos && line_end[-1] == '\r') {
+    line_end--;
+  }
+  *line = std::string_view(*pos, line_end - *pos);
+  *pos = newline + 1;
+  return true;
+}
+
+std::string_view StripLineMetadata(std::string_view line) {
+  if (!line.empty() && line[0] == '\\') {
+    const size_t tag_end = line.find('\\', 1);
+    if (tag_end != std::string_view::npos) {
+      line.remove_prefix(tag_end + 1);
+    }
+  }
+  const size_t star = line.find('*');
+  if (star != std::string_view::npos && star + 3 < line.size()) {
+    line = line.substr(0, star + 3);
+  }
+  return line;
+}
+
+bool VdmAssembler::AddGroupSentence(std::string_view tag_text,
+                                    const NmeaSentenceView &fields,
+                                    std::string_view *body, int *fill_bits,
+                                    VdmLineStatus *status) {
+  TagBlock first_tag;
+  switch (tag_groups_.Add(tag_, tag_text, fields.body, fields.fill_bits, body,
+                          fill_bits, &first_tag)) {
+    case TAG_GROUP_PARTIAL:
+      *status = VDM_LINE_PARTIAL;
+      return false;
+    case TAG_GROUP_OUT_OF_ORDER:
+      *status = VDM_LINE_OUT_OF_ORDER;
+      return false;
+    case TAG_GROUP_COMPLETE:
+      break;
+  }
+  tag_ = first_tag;
+  if (body->size() < 2) {
+    *status = VDM_LINE_UNDECODABLE;
+    return false;
+  }
+  return true;
+}
+
+bool VdmAssembler::AddLine(std::string_view line, std::string_view *body,
+                           int *fill_bits, VdmLineStatus *status) {
   line_number_++;
-  auto sentence = NmeaSentence::Create(line, line_number_);
-  if (sentence == nullptr) {
+  has_tag_ = false;
+  std::string_view sentence = line;
+  if (!line.empty() && line[0] == '\\') {
+    if (!ParseTagBlock(line, &tag_, &sentence)) {
+      *status = VDM_LINE_BAD_SENTENCE;
+      return false;
+    }
+    has_tag_ = true;
+  }
+
+  // Anything after the 2 checksum digits is USCG metadata.
+  has_uscg_ = false;
+  if (sentence.size() > 3 && sentence[sentence.size() - 3] != '*') {
+    if (!ParseUscgMetadata(sentence, &uscg_, &sentence)) {
+      *status = VDM_LINE_BAD_SENTENCE;
+      return false;
+    }
+    has_uscg_ = true;
+  }
+
+  NmeaSentenceView fields;
+  if (!ParseNmeaSentence(sentence, &fields)) {
+    *status = VDM_LINE_BAD_SENTENCE;
     return false;
   }
-  size_t const seq = sentence->sequence_number();
-  size_t const tot = sentence->sentence_total();
 
-  if (tot > kMaxSentences) {
-    return false;  // More sentences than allowed.
+  // A group that spans exactly the sentences of one VDM message.  Groups
+  // that also hold other sentence types fall back to the sequence number, as
+  // do later lines of a message whose first line had no group.
+  if (has_tag_ && tag_.group_total > 1 &&
+      tag_.group_total == fields.sentence_total &&
+      tag_.group_sentence == fields.sentence_number) {
+    if (AddGroupSentence(line.substr(0, sentence.data() - line.data()),
+                         fields, body, fill_bits, status)) {
+      return true;
+    }
+    if (*status != VDM_LINE_OUT_OF_ORDER) {
+      return false;
+    }
   }
 
+  // Single line messages are decoded straight out of the line.
+  *body = fields.body;
+  *fill_bits = fields.fill_bits;
+
   // Convert multi-line message to single line.
-  if (tot != 1) {
-    if (tot > 1 && seq > kNumSequenceChannels) {
-      return false;  // Sequence number is too large or empty (kNoSequenceNumber).
+  if (fields.sentence_total != 1) {
+    size_t const seq = fields.sequence_number;
+    size_t const tot = fields.sentence_total;
+    if (seq >= kNumSequenceChannels) {
+      // Sequence number is empty (kNoSequenceNumber).
+      *status = VDM_LINE_BAD_SENTENCE;
+      return false;
     }
 
-    size_t const cnt = sentence->sentence_number();
+    size_t const cnt = fields.sentence_number;
+    auto sentence = MakeUnique<NmeaSentence>(fields, line_number_);
 
     // Beginning of a message.
     if (cnt == 1) {
       incoming_sentences_[seq].clear();
       incoming_sentences_[seq].emplace_back(std::move(sentence));
-
-      return true;
+      *status = VDM_LINE_PARTIAL;
+      return false;
     }
 
     // Middle sentences of a message.
     if (cnt != tot) {
       if (incoming_sentences_[seq].size() + 1 != cnt) {
+        *status = VDM_LINE_OUT_OF_ORDER;
         return false;
       }
       incoming_sentences_[seq].emplace_back(std::move(sentence));
-      return true;
+      *status = VDM_LINE_PARTIAL;
+      return false;
     }
 
     // Got final sentence in a multi-line message.
     if (incoming_sentences_[seq].size() != tot - 1) {
       incoming_sentences_[seq].clear();
+      *status = VDM_LINE_OUT_OF_ORDER;
       return false;
     }
 
-    sentence = sentence->Merge(incoming_sentences_[seq]);
+    merged_ = sentence->Merge(incoming_sentences_[seq]);
     incoming_sentences_[seq].clear();
-    if (sentence == nullptr) {
+    if (merged_ == nullptr) {
+      *status = VDM_LINE_OUT_OF_ORDER;
       return false;
     }
 
-    // Ready to process multi-line message.  Do not return here.
+    // Ready to process multi-line message.
+    *body = merged_->body_view();
+    *fill_bits = merged_->fill_bits();
   }
 
-  if (sentence->body().size() < 2) {
+  if (body->size() < 2) {
+    *status = VDM_LINE_UNDECODABLE;
     return false;
   }
-  unique_ptr<AisMsg> msg =
-      CreateAisMsg(sentence->body(), sentence->fill_bits());
-  if (msg == nullptr) {
-    return false;
-  }
-
-  messages_.emplace_front(std::move(msg));
   return true;
 }
 
+void VdmStream::DropDuplicates(const size_t max_messages,
+                               const double window_seconds) {
+  duplicates_ = MakeUnique<DuplicateFilter>(max_messages, window_seconds);
+}
+
 unique_ptr<AisMsg> VdmStream::PopOldestMessage() {
   if (messages_.empty()) {
     return nullptr;
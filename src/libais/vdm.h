@@ -12,7 +12,7 @@
 // See the License for the specific language governing permissions and
 // limitations under the License.
 
-// Parse NMEA AIS VDM strings without extra metadata.
+// Parse NMEA AIS VDM strings with optional TAG block and USCG metadata.
 //
 // Handles a sequence of AIS VDM NMEA messages.  Messages are composed of
 // 1 to 10 lines.  These lines are connected by a sequence number if there
@@ -63,13 +63,19 @@
 #ifndef LIBAIS_VDM_H_
 #define LIBAIS_VDM_H_
 
+#include <cstddef>
+#include <cstdint>
 #include <deque>
 #include <memory>
 #include <string>
+#include <string_view>
 #include <vector>
 
 // #include "base/logging.h"
 #include "ais.h"
+#include "ais_alloc.h"
+#include "tag_block.h"
+#include "uscg.h"
 
 namespace libais {
 
@@ -80,17 +86,55 @@ static const int kMaxSentences = 10;
 // AIS receivers use the sequence to group multi-line messages.
 static const int kNumSequenceChannels = 10;
 
+// Sequence number of a sentence that left the sequence field empty.
+constexpr size_t kNoSequenceNumber = 999999;
+
 // Computes the xor checksum of a string.
-uint8_t Checksum(const std::string &content);
+uint8_t Checksum(std::string_view content);
 // Convert a number to a two character hex string.
 std::string ToHex2(int32_t val);
 // Returns the 2 upper case character xor checksum of a string.
 std::string ChecksumHexString(const std::string &base);
-bool ValidateChecksum(const std::string &line);
+// Returns true if the line ends with a '*' and 2 hex digits that match the
+// xor of everything between the first character and the '*'.
+bool ValidateChecksum(std::string_view line);
+
+// The 64 bit xxHash (XXH64) of data.  Fast, but not for cryptographic use.
+// The words are read little endian, so big endian hosts get other values.
+uint64_t XxHash64(std::string_view data, uint64_t seed = 0);
+
+// Hashes an armored payload and its fill bits.  The same message heard by
+// more than one receiver has the same hash.
+uint64_t PayloadHash(std::string_view body, int fill_bits);
+
+// The fields of one NMEA AIS VDM line.  The string views point into the
+// buffer that was parsed, which must outlive this struct.
+struct NmeaSentenceView {
+  std::string_view talker;
+  std::string_view sentence_type;
+  int sentence_total = 0;
+  int sentence_number = 0;
+  size_t sequence_number = kNoSequenceNumber;
+  char channel = 0;
+  std::string_view body;
+  int fill_bits = 0;
+};
+
+// Splits a line into its fields and validates the checksum in a single pass
+// over the characters.  Returns false if the line is not a valid VDM line.
+// Does not allocate or throw.
+bool ParseNmeaSentence(std::string_view line, NmeaSentenceView *sentence);
 
 // Manages single lines of NMEA AIS VDM text.
 class NmeaSentence {
  public:
+  // Copies the fields out of a parsed line.
+  NmeaSentence(const NmeaSentenceView &fields, int64_t line_number)
+      : NmeaSentence(std::string(fields.talker),
+                     std::string(fields.sentence_type), fields.sentence_total,
+                     fields.sentence_number, fields.sequence_number,
+                     fields.channel, std::string(fields.body),
+                     fields.fill_bits, line_number) {}
   NmeaSentence(const std::string &talker, const std::string &sentence_type,
                size_t sentence_total, size_t sentence_number, size_t sequence_number,
                char channel, const std::string &body, int fill_bits,
@@ -109,7 +153,7 @@ class NmeaSentence {
   // line of text.  Returns nullptr on failure.  The line_number argument
   // tracks the source location in a file or the count of lines pushed through
   // a channel.
-  static std::unique_ptr<NmeaSentence> Create(const std::string &line,
+  static std::unique_ptr<NmeaSentence> Create(std::string_view line,
                                               int64_t line_number);
 
   // Returns a composite NmeaSentence from multiple prior sentences that make up
@@ -124,10 +168,9 @@ class NmeaSentence {
 
   // Reconstructs the NMEA AIS VDM sentence representation of this instance.
   std::string ToString() const;
-  // Returns the hex digest of the 6-bit encoded body.  Used for detection of
-  // multiple instances of a line in an input stream.
-  // TODO(schwehr): Consider mixing in the VHF channel into the text.
-  std::string ToMd5Digest() const;
+  // Returns the PayloadHash of the 6-bit encoded body and fill bits.  Used for
+  // detection of multiple instances of a line in an input stream.
+  uint64_t ToPayloadHash() const;
 
   // Returns true if another sentence is a part of the same multiline message.
   // The given sentence must have the same channel, sequence number and total
@@ -163,6 +206,8 @@ class NmeaSentence {
   size_t sequence_number() const { return sequence_number_; }
   char channel() const { return channel_; }
   std::string body() const { return body_; }
+  // The body without a copy.  Only valid for the life of the sentence.
+  std::string_view body_view() const { return body_; }
   int fill_bits() const { return fill_bits_; }
 
   int64_t line_number() const { return line_number_; }
@@ -191,34 +236,188 @@ class NmeaSentence {
   const int64_t line_number_;
 };
 
+// What VdmStream did with a line.
+enum VdmLineStatus : uint8_t {
+  VDM_LINE_DECODED,  // Completed a message, which was decoded.
+  VDM_LINE_PARTIAL,  // Held until the rest of its multi-line message arrives.
+  VDM_LINE_BAD_SENTENCE,  // Not a valid NMEA AIS VDM line.
+  VDM_LINE_OUT_OF_ORDER,  // The earlier parts of its message are missing.
+  VDM_LINE_UNDECODABLE,  // Completed a message that libais could not decode.
+  VDM_LINE_DUPLICATE,  // Completed a message that was recently seen.
+};
+
+// The defaults for DuplicateFilter.
+constexpr size_t kDuplicateWindowMessages = 65536;
+constexpr double kDuplicateWindowSeconds = 60;
+
+// Remembers the hashes of recent messages in fixed memory so that copies of
+// a message from overlapping receivers can be dropped.
+//
+// The hashes are kept in two generations, each an open addressing table of
+// fixed size.  New hashes go in the current generation.  Once it holds
+// max_messages / 2 hashes or is window_seconds / 2 old, it becomes the
+// previous generation and the old previous generation is cleared.  So a hash
+// is remembered for at least half of the window and at most all of it.
+class DuplicateFilter {
+ public:
+  explicit DuplicateFilter(size_t max_messages = kDuplicateWindowMessages,
+                           double window_seconds = kDuplicateWindowSeconds);
+
+  // Returns true if hash is in the window.  Otherwise adds it and returns
+  // false.  time is in seconds.  If it is negative, only the message count
+  // moves the window.
+  bool Check(uint64_t hash, double time);
+
+  // The number of times Check returned true.
+  uint64_t duplicates() const { return duplicates_; }
+
+ private:
+  bool Contains(const std::vector<uint64_t> &table, uint64_t hash) const;
+  void Rotate(double time);
+
+  const size_t generation_size_;
+  const double generation_seconds_;
+  // 0 marks an empty entry, so a hash of 0 is stored as 1.
+  std::vector<uint64_t> current_;
+  std::vector<uint64_t> previous_;
+  size_t current_size_ = 0;
+  double current_start_ = -1;
+  uint64_t duplicates_ = 0;
+};
+
+// Finds the next newline terminated line starting at *pos and before end.
+// The line excludes the newline and a '\r' before it.  Advances *pos past
+// the newline.  Returns false and leaves *pos alone if there is no newline.
+bool NextLine(const char **pos, const char *end, std::string_view *line);
+
+// Returns the NMEA sentence within a line, dropping a leading TAG block
+// (\...\) and anything after the 2 checksum digits, such as USCG
+// metadata.  The result is a view into line.  Nothing is validated.
+std::string_view StripLineMetadata(std::string_view line);
+
+// Splits lines into sentences and reassembles multi-line messages, but does
+// not decode them.  Used by VdmStream and ParallelVdmStream.
+//
+// Lines may start with a TAG block (see tag_block.h).  A multi-line message
+// whose sentences are tied together with a TAG block group is joined on the
+// group rather than on the VDM sequence number, so interleaved stations that
+// reuse sequence numbers are not mixed up.  Lines may also end with USCG
+// metadata after the checksum (see uscg.h).  A line with a bad TAG block or
+// USCG metadata is a VDM_LINE_BAD_SENTENCE.
+class VdmAssembler {
+ public:
+  VdmAssembler()
+      : line_number_(0), incoming_sentences_(kNumSequenceChannels) {}
+
+  // Returns true if the line completed a message.  body and fill_bits are
+  // then that message's payload, which is valid until the next call.
+  // Otherwise status is set to why there is nothing to decode.
+  bool AddLine(std::string_view line, std::string_view *body, int *fill_bits,
+               VdmLineStatus *status);
+
+  // The TAG block of the last line or nullptr if it did not have one.  For a
+  // message joined from a TAG block group, this is the TAG block of the
+  // first line of the group.  Valid until the next call to AddLine.
+  const TagBlock *tag_block() const { return has_tag_ ? &tag_ : nullptr; }
+
+  // The USCG metadata of the last line or nullptr if it did not have any.
+  // For a multi-line message, this is from the last line.  Valid until the
+  // next call to AddLine.
+  const UscgMetadata *uscg_metadata() const {
+    return has_uscg_ ? &uscg_ : nullptr;
+  }
+
+  // Incomplete TAG block groups dropped to keep memory bounded.
+  uint64_t evicted_tag_groups() const { return tag_groups_.evicted(); }
+
+ private:
+  // Handles the VDM sentence of a line that has a TAG block group.
+  bool AddGroupSentence(std::string_view tag_text,
+                        const NmeaSentenceView &fields, std::string_view *body,
+                        int *fill_bits, VdmLineStatus *status);
+
+  // Line number starts at 0 and is incremented to 1 with the first line.
+  int64_t line_number_;
+
+  bool has_tag_ = false;
+  TagBlock tag_;
+  TagGroupAssembler tag_groups_;
+  bool has_uscg_ = false;
+  UscgMetadata uscg_;
+
+  // The most recently merged multi-line message.
+  std::unique_ptr<NmeaSentence> merged_;
+  // Sentences for each sequence number that have yet to get all the required
+  // parts to be complete.
+  std::vector<std::vector<std::unique_ptr<NmeaSentence>>> incoming_sentences_;
+};
+
 // This class processes a sequence of lines to find the AIS messages across
 // lines.  AIS messages come in groups of 1 or more lines.  Its job is
 // to return decoded AIS messages as libais::AisMsg instances as they are found
 // in the stream.
 // Sentences are assembled into messages and output in FIFO order.
+// See vdm_parallel.h to decode a single stream on more than one core.
 class VdmStream {
  public:
-  VdmStream() : line_number_(0), incoming_sentences_(kNumSequenceChannels) {}
+  VdmStream() : VdmStream(nullptr) {}
+  // Decoded messages are placed in allocator, which must outlive them.
+  // See ais_alloc.h.
+  explicit VdmStream(AisMsgAllocator *allocator) : allocator_(allocator) {}
 
   // Returns true if the sentence was used or false if the line was ignored.
   // A line will be ignored if it is not a valid VDM line or if it is a later
-  // part of a multi-line message but missing one or more initial lines.
-  bool AddLine(const std::string &line);  // Was push
+  // part of a multi-line message but missing one or more initial lines.  A
+  // line that completes a duplicate message is used even though no message is
+  // queued.
+  bool AddLine(std::string_view line);  // Was push
+
+  // Adds every newline terminated line in [begin, end).  A '\r' before the
+  // newline is dropped.  Messages completed by these lines are put in
+  // messages in FIFO order rather than in the queue for PopOldestMessage.
+  // line_status gets one entry per line.  Both vectors are cleared first so
+  // that a caller can reuse them and their capacity for the next buffer.
+  //
+  // Returns a pointer to just after the last newline.  Bytes from there to
+  // end are a partial line and are not consumed.  Callers reading in blocks
+  // should carry them over to the front of the next block.
+  const char *AddBuffer(const char *begin, const char *end,
+                        std::vector<std::unique_ptr<libais::AisMsg>> *messages,
+                        std::vector<VdmLineStatus> *line_status);
+
   // Returns nullptr if there are not decoded messages currently available.
   std::unique_ptr<libais::AisMsg> PopOldestMessage();
 
   int size() const { return messages_.size(); }
   bool empty() const { return messages_.empty(); }
 
+  // Drops completed messages whose payload matches a recent one before they
+  // are decoded.  Their lines are VDM_LINE_DUPLICATE.  The time of a message
+  // is from its TAG block or USCG metadata if it has one.  See
+  // DuplicateFilter.  Off until this is called.
+  void DropDuplicates(size_t max_messages = kDuplicateWindowMessages,
+                      double window_seconds = kDuplicateWindowSeconds);
+
+  // The number of duplicate messages dropped.
+  uint64_t duplicates() const {
+    return duplicates_ == nullptr ? 0 : duplicates_->duplicates();
+  }
+
  private:
-  // Line number starts at 0 and is incremented to 1 with the first line.
-  int64_t line_number_;
+  // Handles one line.  Sets msg if the line completed a message that decoded.
+  VdmLineStatus AddSentence(std::string_view line,
+                            std::unique_ptr<libais::AisMsg> *msg);
+
+  VdmAssembler assembler_;
+
+  // Where decoded messages are allocated.  nullptr for the heap.
+  AisMsgAllocator *allocator_;
+
+  // nullptr unless DropDuplicates was called.
+  std::unique_ptr<DuplicateFilter> duplicates_;
 
   // Decoded messages ready for pickup.
   std::deque<std::unique_ptr<libais::AisMsg>> messages_;
-  // Sentences for each sequence number that have yet to get all the required
-  // parts to be complete.
-  std::vector<std::vector<std::unique_ptr<NmeaSentence>>> incoming_sentences_;
 };
 
 }  // namespace libais
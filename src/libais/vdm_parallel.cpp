@@ -0,0 +1,172 @@
+// Decode one NMEA AIS VDM stream on several cores.
+
+#include "vdm_parallel.h"
+
+#include <cassert>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <string_view>
+#include <thread>
+#include <utility>
+
+#include "ais.h"
+#include "decode_body.h"
+#include "vdm.h"
+
+using std::unique_ptr;
+
+namespace libais {
+
+ParallelVdmStream::ParallelVdmStream(const int num_threads,
+                                     const size_t window,
+                                     const size_t batch_size)
+    : window_(window),
+      batch_size_(batch_size),
+      slots_(new Slot[window]),
+      next_seq_(0),
+      next_submit_(0),
+      next_out_(0),
+      stop_(false) {
+  assert(num_threads > 0);
+  assert(batch_size_ > 0);
+  assert(batch_size_ <= window_);
+  for (int i = 0; i < num_threads; i++) {
+    workers_.emplace_back(&ParallelVdmStream::Work, this);
+  }
+}
+
+ParallelVdmStream::~ParallelVdmStream() {
+  {
+    std::lock_guard<std::mutex> lock(mutex_);
+    stop_ = true;
+  }
+  work_cv_.notify_all();
+  for (auto &worker : workers_) {
+    worker.join();
+  }
+}
+
+bool ParallelVdmStream::AddLine(std::string_view line) {
+  std::string_view body;
+  int fill_bits;
+  VdmLineStatus status;
+  if (!assembler_.AddLine(line, &body, &fill_bits, &status)) {
+    return status == VDM_LINE_PARTIAL;
+  }
+  Enqueue(body, fill_bits);
+  Collect(false);
+  return true;
+}
+
+const char *ParallelVdmStream::AddBuffer(const char *begin, const char *end) {
+  assert(begin <= end);
+  const char *pos = begin;
+  std::string_view line;
+  while (NextLine(&pos, end, &line)) {
+    AddLine(line);
+  }
+  Submit();
+  return pos;
+}
+
+unique_ptr<AisMsg> ParallelVdmStream::PopOldestMessage() {
+  if (messages_.empty()) {
+    Submit();
+    Collect(false);
+    if (messages_.empty()) {
+      return nullptr;
+    }
+  }
+  unique_ptr<AisMsg> msg(std::move(messages_.front()));
+  messages_.pop_front();
+  return msg;
+}
+
+void ParallelVdmStream::Flush() {
+  Submit();
+  while (next_out_ != next_seq_) {
+    Collect(true);
+  }
+}
+
+void ParallelVdmStream::Enqueue(std::string_view body, const int fill_bits) {
+  if (next_seq_ - next_out_ == window_) {
+    Collect(true);
+  }
+  Slot &slot = slots_[next_seq_ % window_];
+  // Reuses the capacity left over from the last payload in the slot.
+  slot.body.assign(body.data(), body.size());
+  slot.fill_bits = fill_bits;
+  slot.done.store(false, std::memory_order_relaxed);
+  next_seq_++;
+  if (next_seq_ - next_submit_ >= batch_size_) {
+    Submit();
+  }
+}
+
+void ParallelVdmStream::Submit() {
+  if (next_submit_ == next_seq_) {
+    return;
+  }
+  {
+    std::lock_guard<std::mutex> lock(mutex_);
+    batches_.push_back(Batch{next_submit_, next_seq_});
+  }
+  next_submit_ = next_seq_;
+  work_cv_.notify_one();
+}
+
+void ParallelVdmStream::Collect(const bool wait) {
+  if (wait) {
+    assert(next_out_ != next_seq_);
+    // The oldest payload might still be in the partial batch.
+    Submit();
+    const Slot &oldest = slots_[next_out_ % window_];
+    if (!oldest.done.load(std::memory_order_acquire)) {
+      std::unique_lock<std::mutex> lock(mutex_);
+      done_cv_.wait(lock, [&oldest] {
+        return oldest.done.load(std::memory_order_acquire);
+      });
+    }
+  }
+
+  while (next_out_ != next_submit_) {
+    Slot &slot = slots_[next_out_ % window_];
+    if (!slot.done.load(std::memory_order_acquire)) {
+      break;
+    }
+    if (slot.msg != nullptr) {
+      messages_.emplace_back(std::move(slot.msg));
+    }
+    next_out_++;
+  }
+}
+
+void ParallelVdmStream::Work() {
+  while (true) {
+    Batch batch;
+    {
+      std::unique_lock<std::mutex> lock(mutex_);
+      work_cv_.wait(lock, [this] { return stop_ || !batches_.empty(); });
+      if (batches_.empty()) {
+        return;  // Stopping.
+      }
+      batch = batches_.front();
+      batches_.pop_front();
+    }
+
+    for (uint64_t seq = batch.begin; seq != batch.end; seq++) {
+      Slot &slot = slots_[seq % window_];
+      slot.msg = CreateAisMsg(slot.body, slot.fill_bits);
+      slot.done.store(true, std::memory_order_release);
+    }
+
+    // Taking the lock orders the done flags before a waiter's check.
+    { std::lock_guard<std::mutex> lock(mutex_); }
+    done_cv_.notify_one();
+  }
+}
+
+}  // namespace libais
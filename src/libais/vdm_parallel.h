@@ -0,0 +1,128 @@
+// -*- c++ -*-
+
+// Decode one NMEA AIS VDM stream on several cores.
+//
+// ParallelVdmStream has the same interface as VdmStream.  The calling thread
+// splits lines into sentences and reassembles multi-line messages, which is
+// cheap.  It hands the payloads to a pool of worker threads that run
+// CreateAisMsg, which is where most of the time goes.
+//
+// Messages come out of PopOldestMessage in the same order that VdmStream
+// would give them.  Payloads wait in a reorder window of fixed size.  When
+// the window is full, AddLine blocks until the oldest payload has been
+// decoded, so memory stays bounded when the workers fall behind.
+//
+// Payloads are passed to the workers in batches to keep locking off of the
+// per-message path.  PopOldestMessage, AddBuffer and Flush send a partial
+// batch, so a caller that stops adding lines still gets all of its messages.
+//
+// A ParallelVdmStream must only be used from one thread at a time.  The
+// messages are allocated on the heap, since AisMsgAllocator is not thread
+// safe.
+
+#ifndef LIBAIS_VDM_PARALLEL_H_
+#define LIBAIS_VDM_PARALLEL_H_
+
+#include <atomic>
+#include <condition_variable>
+#include <cstddef>
+#include <cstdint>
+#include <deque>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <string_view>
+#include <thread>
+#include <vector>
+
+#include "ais.h"
+#include "vdm.h"
+
+namespace libais {
+
+class ParallelVdmStream {
+ public:
+  // num_threads is the number of decoding threads, not counting the caller.
+  // window is the most payloads in flight at once.  batch_size is how many
+  // payloads a worker takes at a time and must not be larger than window.
+  explicit ParallelVdmStream(int num_threads, size_t window = 16384,
+                             size_t batch_size = 64);
+  ~ParallelVdmStream();
+
+  ParallelVdmStream(const ParallelVdmStream &) = delete;
+  ParallelVdmStream &operator=(const ParallelVdmStream &) = delete;
+
+  // Returns true if the sentence was used or false if the line was ignored.
+  // Decoding happens later, so unlike VdmStream a line that completes a
+  // message that does not decode still returns true.
+  bool AddLine(std::string_view line);
+
+  // Adds every newline terminated line in [begin, end) as with
+  // VdmStream::AddBuffer, but the messages come out of PopOldestMessage.
+  // Returns a pointer to just after the last newline.
+  const char *AddBuffer(const char *begin, const char *end);
+
+  // Returns the oldest message if it has been decoded.  Does not wait, so
+  // nullptr does not mean that no more messages are coming.
+  std::unique_ptr<libais::AisMsg> PopOldestMessage();
+
+  // Waits until every line added so far has been decoded.
+  void Flush();
+
+  // Number of decoded messages ready for PopOldestMessage.
+  int size() const { return messages_.size(); }
+  bool empty() const { return messages_.empty(); }
+
+ private:
+  // One payload in the reorder window.
+  struct Slot {
+    std::string body;
+    int fill_bits = 0;
+    std::unique_ptr<libais::AisMsg> msg;
+    // Set by a worker once msg holds the result.
+    std::atomic<bool> done{false};
+  };
+
+  // Payloads [begin, end) by sequence number.
+  struct Batch {
+    uint64_t begin;
+    uint64_t end;
+  };
+
+  // Puts a payload in the next slot, waiting for room if needed.
+  void Enqueue(std::string_view body, int fill_bits);
+  // Gives the payloads not yet handed out to the workers.
+  void Submit();
+  // Moves decoded messages at the front of the window to messages_.  If
+  // wait is true, waits for at least the oldest one.
+  void Collect(bool wait);
+  // Worker thread loop.
+  void Work();
+
+  const size_t window_;
+  const size_t batch_size_;
+  std::unique_ptr<Slot[]> slots_;
+
+  // Only touched by the thread using the stream.
+  VdmAssembler assembler_;
+  // Sequence number for the next payload.
+  uint64_t next_seq_;
+  // Oldest payload not yet handed to the workers.
+  uint64_t next_submit_;
+  // Oldest payload still in the window.
+  uint64_t next_out_;
+  std::deque<std::unique_ptr<libais::AisMsg>> messages_;
+
+  // Guards batches_ and stop_.  Workers also take it to signal done_cv_.
+  std::mutex mutex_;
+  std::condition_variable work_cv_;
+  std::condition_variable done_cv_;
+  std::deque<Batch> batches_;
+  bool stop_;
+
+  std::vector<std::thread> workers_;
+};
+
+}  // namespace libais
+
+#endif  // LIBAIS_VDM_PARALLEL_H_
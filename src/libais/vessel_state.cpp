@@ -0,0 +1,254 @@
+// The latest known state of each vessel, keyed by MMSI.
+
+#include "vessel_state.h"
+
+#include <algorithm>
+#include <array>
+#include <atomic>
+#include <cassert>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <string>
+#include <thread>
+
+#include "ais.h"
+
+namespace libais {
+
+namespace {
+
+// Copies AIS text without the trailing '@' and space padding, truncating to
+// fit with a nul.
+template <size_t N>
+void CopyText(const std::string &text, std::array<char, N> *out) {
+  size_t size = std::min(text.size(), N - 1);
+  while (size > 0 && (text[size - 1] == '@' || text[size - 1] == ' ')) {
+    size--;
+  }
+  std::memcpy(out->data(), text.data(), size);
+  std::fill(out->begin() + size, out->end(), '\0');
+}
+
+void SetPosition(const AisMsg &msg, const AisPoint &position, float sog,
+                 float cog, int true_heading, int64_t time,
+                 VesselState *state) {
+  state->position_time = time;
+  state->position_message_id = msg.message_id;
+  state->x = position.lng_deg;
+  state->y = position.lat_deg;
+  state->sog = sog;
+  state->cog = cog;
+  state->true_heading = true_heading;
+}
+
+void SetDimensions(int dim_a, int dim_b, int dim_c, int dim_d,
+                   VesselState *state) {
+  state->dim_a = dim_a;
+  state->dim_b = dim_b;
+  state->dim_c = dim_c;
+  state->dim_d = dim_d;
+}
+
+void SetStatic(const AisMsg &msg, int64_t time, VesselState *state) {
+  state->static_time = time;
+  state->static_message_id = msg.message_id;
+}
+
+// Returns false if the message has no vessel state.
+bool Merge(const AisMsg &msg, int64_t time, VesselState *state) {
+  switch (msg.message_id) {
+    case 1:
+    case 2:
+    case 3: {
+      const auto &m = static_cast<const Ais1_2_3 &>(msg);
+      SetPosition(msg, m.position, m.sog, m.cog, m.true_heading, time, state);
+      state->nav_status = m.nav_status;
+      return true;
+    }
+    case 5: {
+      const auto &m = static_cast<const Ais5 &>(msg);
+      SetStatic(msg, time, state);
+      state->imo_num = m.imo_num;
+      CopyText(m.callsign, &state->callsign);
+      CopyText(m.name, &state->name);
+      state->type_and_cargo = m.type_and_cargo;
+      SetDimensions(m.dim_a, m.dim_b, m.dim_c, m.dim_d, state);
+      state->draught = m.draught;
+      CopyText(m.destination, &state->destination);
+      return true;
+    }
+    case 18: {
+      const auto &m = static_cast<const Ais18 &>(msg);
+      SetPosition(msg, m.position, m.sog, m.cog, m.true_heading, time, state);
+      return true;
+    }
+    case 19: {
+      const auto &m = static_cast<const Ais19 &>(msg);
+      SetPosition(msg, m.position, m.sog, m.cog, m.true_heading, time, state);
+      SetStatic(msg, time, state);
+      CopyText(m.name, &state->name);
+      state->type_and_cargo = m.type_and_cargo;
+      SetDimensions(m.dim_a, m.dim_b, m.dim_c, m.dim_d, state);
+      return true;
+    }
+    case 24: {
+      const auto &m = static_cast<const Ais24 &>(msg);
+      if (m.part_num == 0) {
+        CopyText(m.name, &state->name);
+      } else if (m.part_num == 1) {
+        state->type_and_cargo = m.type_and_cargo;
+        CopyText(m.callsign, &state->callsign);
+        SetDimensions(m.dim_a, m.dim_b, m.dim_c, m.dim_d, state);
+      } else {
+        return false;
+      }
+      SetStatic(msg, time, state);
+      return true;
+    }
+    case 27: {
+      const auto &m = static_cast<const Ais27 &>(msg);
+      SetPosition(msg, m.position, m.sog, m.cog, 511, time, state);
+      state->nav_status = m.nav_status;
+      return true;
+    }
+    default:
+      return false;
+  }
+}
+
+size_t Capacity(const size_t max_vessels) {
+  size_t capacity = 16;
+  while (capacity * 3 < max_vessels * 4) {
+    capacity *= 2;
+  }
+  return capacity;
+}
+
+int Log2(size_t value) {
+  int bits = 0;
+  while (value > 1) {
+    value >>= 1;
+    bits++;
+  }
+  return bits;
+}
+
+}  // namespace
+
+VesselStateTable::VesselStateTable(const size_t max_vessels)
+    : max_vessels_(max_vessels),
+      capacity_(Capacity(max_vessels)),
+      shift_(64 - Log2(capacity_)),
+      keys_(new std::atomic<int32_t>[capacity_]),
+      slots_(new Slot[capacity_]) {
+  for (size_t i = 0; i < capacity_; i++) {
+    keys_[i].store(0, std::memory_order_relaxed);
+  }
+}
+
+size_t VesselStateTable::Find(const int mmsi) const {
+  // Fibonacci hashing spreads the sequential MMSIs of a fleet.
+  size_t index =
+      (static_cast<uint64_t>(static_cast<uint32_t>(mmsi)) *
+       0x9E3779B97F4A7C15ULL) >> shift_;
+  for (size_t probes = 0; probes < capacity_; probes++) {
+    const int32_t key = keys_[index].load(std::memory_order_acquire);
+    if (key == mmsi || key == 0) {
+      return index;
+    }
+    index = (index + 1) & (capacity_ - 1);
+  }
+  return capacity_;
+}
+
+void VesselStateTable::Read(const size_t index, VesselState *state) const {
+  const Slot &slot = slots_[index];
+  uint64_t words[kWords];
+  while (true) {
+    const uint32_t before = slot.sequence.load(std::memory_order_acquire);
+    if (before & 1) {
+      // The writer is part way through the slot.
+      std::this_thread::yield();
+      continue;
+    }
+    for (size_t i = 0; i < kWords; i++) {
+      words[i] = slot.words[i].load(std::memory_order_relaxed);
+    }
+    std::atomic_thread_fence(std::memory_order_acquire);
+    if (slot.sequence.load(std::memory_order_relaxed) == before) {
+      break;
+    }
+  }
+  std::memcpy(static_cast<void *>(state), words, sizeof(VesselState));
+}
+
+void VesselStateTable::ReadOwn(const size_t index, VesselState *state) const {
+  const Slot &slot = slots_[index];
+  uint64_t words[kWords];
+  for (size_t i = 0; i < kWords; i++) {
+    words[i] = slot.words[i].load(std::memory_order_relaxed);
+  }
+  std::memcpy(static_cast<void *>(state), words, sizeof(VesselState));
+}
+
+void VesselStateTable::Write(const size_t index, const VesselState &state) {
+  Slot &slot = slots_[index];
+  uint64_t words[kWords] = {};
+  std::memcpy(words, &state, sizeof(VesselState));
+  const uint32_t sequence = slot.sequence.load(std::memory_order_relaxed);
+  slot.sequence.store(sequence + 1, std::memory_order_relaxed);
+  std::atomic_thread_fence(std::memory_order_release);
+  for (size_t i = 0; i < kWords; i++) {
+    slot.words[i].store(words[i], std::memory_order_relaxed);
+  }
+  slot.sequence.store(sequence + 2, std::memory_order_release);
+}
+
+bool VesselStateTable::Update(const AisMsg &msg, const int64_t time) {
+  if (msg.mmsi == 0 || msg.had_error()) {
+    return false;
+  }
+  const size_t index = Find(msg.mmsi);
+  if (index == capacity_) {
+    return false;
+  }
+
+  VesselState state;
+  const bool is_new = keys_[index].load(std::memory_order_relaxed) == 0;
+  if (is_new) {
+    if (size() >= max_vessels_) {
+      return false;
+    }
+    state.mmsi = msg.mmsi;
+  } else {
+    ReadOwn(index, &state);
+  }
+  if (!Merge(msg, time, &state)) {
+    return false;
+  }
+  Write(index, state);
+
+  if (is_new) {
+    // Readers only find the slot once it holds the state.
+    keys_[index].store(msg.mmsi, std::memory_order_release);
+    size_.fetch_add(1, std::memory_order_relaxed);
+  }
+  return true;
+}
+
+bool VesselStateTable::Get(const int mmsi, VesselState *state) const {
+  assert(state);
+  if (mmsi == 0) {
+    return false;
+  }
+  const size_t index = Find(mmsi);
+  if (index == capacity_ ||
+      keys_[index].load(std::memory_order_acquire) != mmsi) {
+    return false;
+  }
+  Read(index, state);
+  return true;
+}
+
+}  // namespace libais
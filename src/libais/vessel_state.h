@@ -0,0 +1,145 @@
+// -*- c++ -*-
+
+// The latest known state of each vessel, keyed by MMSI.
+//
+// VesselStateTable merges the position reports (1, 2, 3, 18, 19 and 27)
+// and static data (5, 19 and 24 parts A and B) of each MMSI into one
+// VesselState.  Messages of other types are ignored.
+//
+// The table is open addressing with linear probing.  The MMSIs are kept in
+// their own array, so a probe walks 16 keys per cache line before it touches
+// a VesselState.  Slots are never freed, so the capacity is fixed when the
+// table is made.
+//
+// One thread at a time may call Update.  Any number of threads may call Get
+// and ForEach at the same time as the writer.  Each slot has a sequence lock:
+// the writer makes the sequence odd while it changes the slot, and readers
+// copy the slot and retry if the sequence was odd or changed under them.
+// Readers never block the writer and the writer never waits for readers.
+
+#ifndef LIBAIS_VESSEL_STATE_H_
+#define LIBAIS_VESSEL_STATE_H_
+
+#include <array>
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <string_view>
+#include <type_traits>
+
+#include "ais.h"
+
+namespace libais {
+
+// Fields not yet heard from a vessel keep these values, which are the
+// "not available" values from ITU-R M.1371 where there is one.  Text is
+// nul terminated with the trailing '@' and space padding removed.
+struct VesselState {
+  // Set by Update to the time argument of the last message of each kind.
+  int64_t position_time = -1;
+  int64_t static_time = -1;
+
+  // Position report.
+  double x = 181;  // Longitude.
+  double y = 91;  // Latitude.
+  float sog = 102.3F;  // Knots.
+  float cog = 360;  // Degrees.
+  int16_t true_heading = 511;
+  uint8_t nav_status = 15;
+  uint8_t position_message_id = 0;
+
+  // Static data.
+  int32_t imo_num = 0;
+  float draught = 0;
+  int16_t dim_a = 0;
+  int16_t dim_b = 0;
+  int16_t dim_c = 0;
+  int16_t dim_d = 0;
+  uint8_t type_and_cargo = 0;
+  uint8_t static_message_id = 0;
+  std::array<char, 21> name{};
+  std::array<char, 8> callsign{};
+  std::array<char, 21> destination{};
+
+  int32_t mmsi = 0;
+
+  std::string_view name_view() const { return name.data(); }
+  std::string_view callsign_view() const { return callsign.data(); }
+  std::string_view destination_view() const { return destination.data(); }
+};
+
+static_assert(std::is_trivially_copyable<VesselState>::value,
+              "VesselState is copied word by word");
+
+class VesselStateTable {
+ public:
+  // Holds up to max_vessels MMSIs.  The table is sized so that it is at most
+  // 3/4 full.
+  explicit VesselStateTable(size_t max_vessels);
+
+  VesselStateTable(const VesselStateTable &) = delete;
+  VesselStateTable &operator=(const VesselStateTable &) = delete;
+
+  // Merges a decoded message into the state of its MMSI.  time is stored as
+  // the position_time or static_time and is not otherwise used.  Returns
+  // false if the message type carries no vessel state, the MMSI is 0, or the
+  // table is full.  Only one thread may call Update at a time.
+  bool Update(const AisMsg &msg, int64_t time = 0);
+
+  // Copies the state of an MMSI.  Returns false if it has not been seen.
+  bool Get(int mmsi, VesselState *state) const;
+
+  // Calls fn with a consistent copy of each vessel's state.  Vessels added
+  // while this runs may or may not be visited.
+  template <typename Fn>
+  void ForEach(Fn fn) const {
+    VesselState state;
+    for (size_t i = 0; i < capacity_; i++) {
+      if (keys_[i].load(std::memory_order_acquire) != 0) {
+        Read(i, &state);
+        fn(static_cast<const VesselState &>(state));
+      }
+    }
+  }
+
+  // The number of MMSIs in the table.
+  size_t size() const { return size_.load(std::memory_order_relaxed); }
+  size_t max_vessels() const { return max_vessels_; }
+
+ private:
+  static constexpr size_t kWords =
+      (sizeof(VesselState) + sizeof(uint64_t) - 1) / sizeof(uint64_t);
+
+  // A VesselState stored as words that readers can load while the writer
+  // stores them.
+  struct alignas(64) Slot {
+    std::atomic<uint32_t> sequence{0};
+    std::atomic<uint64_t> words[kWords];
+  };
+
+  // Returns the slot holding an MMSI, else the empty slot where it would
+  // go, else capacity_ if every slot was probed.
+  size_t Find(int mmsi) const;
+
+  // Copies a slot under its sequence lock.
+  void Read(size_t index, VesselState *state) const;
+  // Only for the writer, which does not need the sequence lock to read.
+  void ReadOwn(size_t index, VesselState *state) const;
+  void Write(size_t index, const VesselState &state);
+
+  const size_t max_vessels_;
+  // A power of 2.
+  const size_t capacity_;
+  // Shift for the top bits of a 64 bit hash to index capacity_ slots.
+  const int shift_;
+  // The MMSI in each slot or 0 if the slot is empty.  Only set once the slot
+  // holds a state for the MMSI.
+  std::unique_ptr<std::atomic<int32_t>[]> keys_;
+  std::unique_ptr<Slot[]> slots_;
+  std::atomic<size_t> size_{0};
+};
+
+}  // namespace libais
+
+#endif  // LIBAIS_VESSEL_STATE_H_
@@ -0,0 +1,131 @@
+// Test pairing up parts A and B of message 24.
+
+#include "ais24_assembler.h"
+
+#include <memory>
+#include <string>
+
+#include "ais.h"
+#include "gtest/gtest.h"
+
+namespace libais {
+namespace {
+
+std::unique_ptr<Ais24> Init(const std::string &nmea_string, int mmsi) {
+  const std::string body(GetBody(nmea_string));
+  const int pad = GetPad(nmea_string);
+  std::unique_ptr<Ais24> msg(new Ais24(body.c_str(), pad));
+  if (!msg || msg->had_error()) {
+    return nullptr;
+  }
+  msg->mmsi = mmsi;
+  return msg;
+}
+
+std::unique_ptr<Ais24> PartA(int mmsi) {
+  return Init("!AIVDM,1,1,,A,H44cj<0DdvlHhuB222222222220,2*46", mmsi);
+}
+
+std::unique_ptr<Ais24> PartB(int mmsi) {
+  return Init("!AIVDM,1,1,,A,H02IDPDm3?=1B00@9<?D00081110,0*6D", mmsi);
+}
+
+TEST(Ais24AssemblerTest, Pair) {
+  Ais24Assembler assembler(360);
+  Ais24Static record;
+  EXPECT_EQ(0, assembler.pending());
+  const size_t empty_memory = assembler.memory_used();
+
+  ASSERT_FALSE(assembler.Add(*PartA(1), 10, &record));
+  EXPECT_EQ(1, assembler.pending());
+  EXPECT_LT(empty_memory, assembler.memory_used());
+
+  ASSERT_TRUE(assembler.Add(*PartB(1), 11, &record));
+  EXPECT_EQ(1, record.mmsi);
+  EXPECT_EQ("EKO-FLOT            ", record.name);
+  EXPECT_EQ(10, record.part_a_time);
+  EXPECT_EQ(53, record.type_and_cargo);
+  EXPECT_EQ("COMAR@@", record.vendor_id);
+  EXPECT_EQ("PILOT@@", record.callsign);
+  EXPECT_EQ(1, record.dim_a);
+  EXPECT_EQ(1, record.dim_d);
+  EXPECT_EQ(11, record.part_b_time);
+
+  EXPECT_EQ(0, assembler.pending());
+  EXPECT_EQ(1, assembler.completed());
+  EXPECT_EQ(0, assembler.unmatched_part_a());
+  EXPECT_EQ(0, assembler.unmatched_part_b());
+
+  // The next pair starts over, and B may come first.
+  ASSERT_FALSE(assembler.Add(*PartB(1), 20, &record));
+  ASSERT_FALSE(assembler.Add(*PartB(1), 21, &record));
+  ASSERT_TRUE(assembler.Add(*PartA(1), 22, &record));
+  EXPECT_EQ(22, record.part_a_time);
+  EXPECT_EQ(21, record.part_b_time);
+  EXPECT_EQ(2, assembler.completed());
+  EXPECT_EQ(0, assembler.unmatched_part_b());
+}
+
+TEST(Ais24AssemblerTest, Interleaved) {
+  Ais24Assembler assembler(360);
+  Ais24Static record;
+  ASSERT_FALSE(assembler.Add(*PartA(1), 0, &record));
+  ASSERT_FALSE(assembler.Add(*PartA(2), 0, &record));
+  ASSERT_FALSE(assembler.Add(*PartB(3), 0, &record));
+  EXPECT_EQ(3, assembler.pending());
+  ASSERT_TRUE(assembler.Add(*PartB(2), 1, &record));
+  EXPECT_EQ(2, record.mmsi);
+  ASSERT_TRUE(assembler.Add(*PartA(3), 1, &record));
+  EXPECT_EQ(3, record.mmsi);
+  EXPECT_EQ(1, assembler.pending());
+}
+
+TEST(Ais24AssemblerTest, Ttl) {
+  Ais24Assembler assembler(360);
+  Ais24Static record;
+  ASSERT_FALSE(assembler.Add(*PartA(1), 0, &record));
+  ASSERT_FALSE(assembler.Add(*PartB(2), 100, &record));
+  assembler.Expire(359);
+  EXPECT_EQ(2, assembler.pending());
+
+  // The part A for 1 is too old to pair with this part B.
+  ASSERT_FALSE(assembler.Add(*PartB(1), 360, &record));
+  EXPECT_EQ(1, assembler.unmatched_part_a());
+  EXPECT_EQ(2, assembler.pending());
+
+  assembler.Expire(1000);
+  EXPECT_EQ(0, assembler.pending());
+  EXPECT_EQ(1, assembler.unmatched_part_a());
+  EXPECT_EQ(2, assembler.unmatched_part_b());
+  EXPECT_EQ(0, assembler.evicted());
+  EXPECT_EQ(0, assembler.completed());
+}
+
+TEST(Ais24AssemblerTest, Bounded) {
+  Ais24Assembler assembler(360, 2);
+  Ais24Static record;
+  ASSERT_FALSE(assembler.Add(*PartA(1), 0, &record));
+  ASSERT_FALSE(assembler.Add(*PartA(2), 0, &record));
+  // Touching 1 makes 2 the least recently added to.
+  ASSERT_FALSE(assembler.Add(*PartA(1), 1, &record));
+  ASSERT_FALSE(assembler.Add(*PartB(3), 2, &record));
+  EXPECT_EQ(2, assembler.pending());
+  EXPECT_EQ(1, assembler.evicted());
+  EXPECT_EQ(1, assembler.unmatched_part_a());
+
+  EXPECT_TRUE(assembler.Add(*PartB(1), 3, &record));
+  EXPECT_EQ(1, record.mmsi);
+  EXPECT_FALSE(assembler.Add(*PartB(2), 4, &record));
+}
+
+TEST(Ais24AssemblerTest, Ignored) {
+  Ais24Assembler assembler(360);
+  Ais24Static record;
+  std::unique_ptr<Ais24> msg = PartA(1);
+  msg->part_num = 2;
+  EXPECT_FALSE(assembler.Add(*msg, 0, &record));
+  EXPECT_EQ(0, assembler.pending());
+}
+
+}  // namespace
+}  // namespace libais
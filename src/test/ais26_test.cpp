@@ -50,5 +50,13 @@ TEST(Ais26Test, b69511642_TooFewBits_Addressed_UseAppId) {
   EXPECT_TRUE(msg->had_error());
 }
 
+TEST(Ais26Test, TooFewBits_Addressed) {
+  // An addressed message that ends before the destination MMSI.
+  // !AIVDM,1,1,,B,JNCMFjqG4P,4*55
+  std::unique_ptr<Ais26> msg(new Ais26("JNCMFjqG4P", 4));
+  EXPECT_FALSE(msg->dest_mmsi_valid);
+  EXPECT_TRUE(msg->had_error());
+}
+
 }  // namespace
 }  // namespace libais
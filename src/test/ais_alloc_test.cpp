@@ -0,0 +1,123 @@
+// Test the pool and arena allocators for decoded messages.
+
+#include "ais_alloc.h"
+
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "ais.h"
+#include "decode_body.h"
+#include "vdm.h"
+#include "gtest/gtest.h"
+
+namespace libais {
+namespace {
+
+TEST(AisMsgPoolTest, ReusesFreedMemory) {
+  AisMsgPool pool(4);
+  void *a = pool.Allocate(100);
+  void *b = pool.Allocate(100);
+  EXPECT_NE(a, b);
+  EXPECT_EQ(2, pool.num_live());
+  const size_t reserved = pool.bytes_reserved();
+
+  pool.Deallocate(a, 100);
+  EXPECT_EQ(1, pool.num_live());
+  // Same size class comes back off of the free list.
+  EXPECT_EQ(a, pool.Allocate(97));
+  EXPECT_EQ(reserved, pool.bytes_reserved());
+
+  // A different size class gets its own slab.
+  void *c = pool.Allocate(400);
+  EXPECT_LT(reserved, pool.bytes_reserved());
+
+  // Too large to pool.
+  void *d = pool.Allocate(100000);
+
+  pool.Deallocate(a, 100);
+  pool.Deallocate(b, 100);
+  pool.Deallocate(c, 400);
+  pool.Deallocate(d, 100000);
+  EXPECT_EQ(0, pool.num_live());
+}
+
+TEST(AisMsgArenaTest, ResetReusesBlocks) {
+  AisMsgArena arena(256);
+  void *first = arena.Allocate(100);
+  arena.Allocate(100);
+  // Does not fit in the remaining 32 bytes of the first block.
+  arena.Allocate(100);
+  EXPECT_EQ(512, arena.bytes_reserved());
+  // Larger than a block.
+  arena.Allocate(1000);
+  EXPECT_EQ(4, arena.num_live());
+
+  for (int i = 0; i < 4; i++) {
+    arena.Deallocate(nullptr, 0);
+  }
+  arena.Reset();
+  EXPECT_EQ(first, arena.Allocate(10));
+  EXPECT_EQ(512, arena.bytes_reserved());
+  arena.Deallocate(first, 10);
+}
+
+TEST(CreateAisMsgTest, Pool) {
+  AisMsgPool pool;
+  {
+    auto msg = CreateAisMsg("15N1u<PP1FJuvSRHOE6QIwwh0HQ6", 0, &pool);
+    ASSERT_NE(nullptr, msg);
+    EXPECT_EQ(1, msg->message_id);
+    EXPECT_EQ(1, pool.num_live());
+
+    auto msg5 = CreateAisMsg(
+        "53eaFL02?;fwTPm7V219E@R1@PE8E<622222221@9hG1A7?@NCPSlm3kc5DhH888888888"
+        "0",
+        2, &pool);
+    ASSERT_NE(nullptr, msg5);
+    EXPECT_EQ(5, msg5->message_id);
+    EXPECT_EQ(2, pool.num_live());
+  }
+  EXPECT_EQ(0, pool.num_live());
+}
+
+TEST(CreateAisMsgTest, Arena) {
+  AisMsgArena arena;
+  std::vector<std::unique_ptr<AisMsg>> msgs;
+  for (int i = 0; i < 100; i++) {
+    msgs.push_back(CreateAisMsg("K8VSqb9LdU28WP7h", 0, &arena));
+    ASSERT_NE(nullptr, msgs.back());
+    EXPECT_EQ(27, msgs.back()->message_id);
+  }
+  EXPECT_EQ(100, arena.num_live());
+  msgs.clear();
+  EXPECT_EQ(0, arena.num_live());
+  arena.Reset();
+}
+
+TEST(CreateAisMsgTest, HeapByDefault) {
+  std::unique_ptr<AisMsg> msg(new Ais1_2_3("15N1u<PP1FJuvSRHOE6QIwwh0HQ6", 0));
+  EXPECT_EQ(1, msg->message_id);
+  msg.reset(new (nullptr) Ais27("K8VSqb9LdU28WP7h", 0));
+  EXPECT_EQ(27, msg->message_id);
+}
+
+TEST(VdmStreamTest, Pool) {
+  AisMsgPool pool;
+  VdmStream stream(&pool);
+  EXPECT_TRUE(stream.AddLine("!SAVDM,1,1,,B,K8VSqb9LdU28WP7h,0*4C"));
+  EXPECT_TRUE(stream.AddLine("!SAVDM,1,1,,B,K8VSqb9LdU28WP8P,0*7B"));
+  EXPECT_EQ(2, pool.num_live());
+  auto msg = stream.PopOldestMessage();
+  ASSERT_NE(nullptr, msg);
+  EXPECT_EQ(27, msg->message_id);
+  msg.reset();
+  EXPECT_EQ(1, pool.num_live());
+  msg = stream.PopOldestMessage();
+  ASSERT_NE(nullptr, msg);
+  msg.reset();
+  EXPECT_EQ(0, pool.num_live());
+}
+
+}  // namespace
+}  // namespace libais
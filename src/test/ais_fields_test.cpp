@@ -0,0 +1,113 @@
+// Test the field tables and DecodeFields.
+
+#include "ais_fields.h"
+
+#include <string>
+#include <tuple>
+
+#include "ais.h"
+#include "gtest/gtest.h"
+
+namespace libais {
+namespace {
+
+// Layouts that AisLayoutIsContiguous must reject.
+constexpr auto kGap = std::make_tuple(
+    AisUnsigned(&Ais27::nav_status, 40, 4, "nav_status"),
+    AisUnsigned(&Ais27::sog, 45, 6, "sog"));
+static_assert(!AisLayoutIsContiguous(kGap, 40, 51), "gap");
+
+constexpr auto kOverlap = std::make_tuple(
+    AisUnsigned(&Ais27::nav_status, 40, 4, "nav_status"),
+    AisUnsigned(&Ais27::sog, 43, 6, "sog"));
+static_assert(!AisLayoutIsContiguous(kOverlap, 40, 49), "overlap");
+
+constexpr auto kWrongEnd = std::make_tuple(
+    AisUnsigned(&Ais27::nav_status, 40, 4, "nav_status"));
+static_assert(AisLayoutIsContiguous(kWrongEnd, 40, 44), "end");
+static_assert(!AisLayoutIsContiguous(kWrongEnd, 40, 45), "end");
+
+constexpr auto kBadPosition =
+    std::make_tuple(AisPosition(&Ais27::position, 44, 36));
+static_assert(!AisLayoutIsContiguous(kBadPosition, 44, 80), "position size");
+
+constexpr auto kBadText =
+    std::make_tuple(AisText(&Ais24::callsign, 90, 40, "callsign"));
+static_assert(!AisLayoutIsContiguous(kBadText, 90, 130), "text size");
+
+constexpr auto kScaledInt =
+    std::make_tuple(AisUnsigned(&Ais27::sog, 79, 6, "sog", 10.0F));
+static_assert(!AisLayoutIsContiguous(kScaledInt, 79, 85), "scaled int");
+
+static_assert(AisLayoutEnd(kAis1_2_3Layout) == 151, "end of Ais1_2_3");
+static_assert(AisLayoutEnd(kAis5Layout) == 424, "end of Ais5");
+static_assert(AisLayoutEnd(kAis19Layout) == 312, "end of Ais19");
+
+TEST(DecodeFieldsTest, MatchesBitsetAccessors) {
+  AisBitset bits;
+  ASSERT_EQ(AIS_OK, bits.ParseNmeaPayload("15N1u<PP1FJuvSRHOE6QIwwh0HQ6", 0));
+
+  Ais1_2_3 expected(bits);
+  bits.SeekTo(38);
+  const int nav_status = bits.ToUnsignedInt(38, 4);
+  const int rot_raw = bits.ToInt(42, 8);
+  const float sog = bits.ToUnsignedInt(50, 10) / 10.0F;
+  const int position_accuracy = bits[60];
+  const AisPoint position = bits.ToAisPoint(61, 55);
+  const float cog = bits.ToUnsignedInt(116, 12) / 10.0F;
+  const int true_heading = bits.ToUnsignedInt(128, 9);
+  const int timestamp = bits.ToUnsignedInt(137, 6);
+  const int special_manoeuvre = bits.ToUnsignedInt(143, 2);
+  const int spare = bits.ToUnsignedInt(145, 3);
+  const bool raim = bits[148];
+  const int sync_state = bits.ToUnsignedInt(149, 2);
+
+  Ais1_2_3 msg(bits);
+  bits.SeekTo(38);
+  DecodeFields(bits, kAis1_2_3Layout, &msg);
+  EXPECT_EQ(151, bits.GetPosition());
+
+  EXPECT_EQ(nav_status, msg.nav_status);
+  EXPECT_EQ(rot_raw, msg.rot_raw);
+  EXPECT_EQ(sog, msg.sog);
+  EXPECT_EQ(position_accuracy, msg.position_accuracy);
+  EXPECT_EQ(position.lng_deg, msg.position.lng_deg);
+  EXPECT_EQ(position.lat_deg, msg.position.lat_deg);
+  EXPECT_EQ(cog, msg.cog);
+  EXPECT_EQ(true_heading, msg.true_heading);
+  EXPECT_EQ(timestamp, msg.timestamp);
+  EXPECT_EQ(special_manoeuvre, msg.special_manoeuvre);
+  EXPECT_EQ(spare, msg.spare);
+  EXPECT_EQ(raim, msg.raim);
+  EXPECT_EQ(sync_state, msg.sync_state);
+  EXPECT_EQ(expected.rot, msg.rot);
+}
+
+// Negative longitude in a 35 bit position.
+TEST(DecodeFieldsTest, ShortPosition) {
+  AisBitset bits;
+  ASSERT_EQ(AIS_OK, bits.ParseNmeaPayload("K815>P8=5EikdUet", 0));
+  Ais27 msg(bits);
+  ASSERT_FALSE(msg.had_error());
+  EXPECT_DOUBLE_EQ(-79.641666666666666, msg.position.lng_deg);
+  EXPECT_DOUBLE_EQ(24.681666666666668, msg.position.lat_deg);
+
+  bits.SeekTo(44);
+  const AisPoint position = bits.ToAisPoint(44, 35);
+  EXPECT_EQ(position.lng_deg, msg.position.lng_deg);
+  EXPECT_EQ(position.lat_deg, msg.position.lat_deg);
+}
+
+// Text fields and a layout that runs to the last bit.
+TEST(DecodeFieldsTest, TextToEnd) {
+  AisBitset bits;
+  ASSERT_EQ(AIS_OK, bits.ParseNmeaPayload("H02IDPDm3?=1B00@9<?D00081110", 0));
+  Ais24 msg(bits);
+  ASSERT_FALSE(msg.had_error());
+  EXPECT_EQ("COMAR@@", msg.vendor_id);
+  EXPECT_EQ("PILOT@@", msg.callsign);
+  EXPECT_EQ(0, bits.GetRemaining());
+}
+
+}  // namespace
+}  // namespace libais
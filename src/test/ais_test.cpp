@@ -13,22 +13,20 @@ namespace {
 
 // Helper class that gives us access to the internal character table and thus
 // let's us test it. Also allows us to easily create an AisBitset out of one
-// of those internal character 6-bitsets.
+// of those internal character 6-bit values.
 class AisBitsetTester : public AisBitset {
  public:
   static AisBitset FromNmeaOrd(int index) {
-    InitNmeaOrd();
     assert(index >= 0 && index < 128);
     AisBitsetTester result;
-    result.initFromBitset6(AisBitset::nmea_ord_[index]);
+    result.initFromValue6(AisBitset::nmea_ord_[index]);
     return result;
   }
 
  protected:
-  void initFromBitset6(const bitset<6>& src) {
-    for (int bit = 0; bit < 6; ++bit) {
-      set(bit, src[bit]);
-    }
+  void initFromValue6(uint8_t value) {
+    assert(value < 64);
+    words_[0] = static_cast<uint64_t>(value) << 58;
     num_chars = 1;
     num_bits = 6;
   }
@@ -205,5 +203,126 @@ TEST(BitsetPositionTest, TestSeek) {
   ASSERT_EQ(20, bitset.GetRemaining());
 }
 
+// Returns bit pos of an armored payload computed one character at a time.
+int ArmoredBit(const std::string &payload, size_t pos) {
+  int val = payload[pos / 6] - 48;
+  if (val > 40) val -= 8;
+  return (val >> (5 - pos % 6)) & 1;
+}
+
+// Tests that fields which straddle the 64-bit storage words decode the same
+// as a bit by bit decode.
+TEST(BitsetExtractTest, CrossesWordBoundaries) {
+  const std::string payload("w0w0Pw1a`W9:ab?>w0w0Pw1a`W9:ab?>w0w0");
+  AisBitset bitset;
+  ASSERT_EQ(AIS_OK, bitset.ParseNmeaPayload(payload.c_str(), 0));
+  const size_t total = payload.size() * 6;
+  for (size_t len = 1; len <= 32; len++) {
+    for (size_t start = 0; start + len <= total; start++) {
+      unsigned int expected = 0;
+      for (size_t i = start; i < start + len; i++) {
+        expected = (expected << 1) | ArmoredBit(payload, i);
+      }
+      bitset.SeekTo(start);
+      ASSERT_EQ(expected, bitset.ToUnsignedInt(start, len))
+          << "start: " << start << " len: " << len;
+      int expected_signed = static_cast<int>(expected);
+      if (len < 32 && ArmoredBit(payload, start)) {
+        expected_signed -= 1 << len;
+      }
+      bitset.SeekTo(start);
+      ASSERT_EQ(expected_signed, bitset.ToInt(start, len))
+          << "start: " << start << " len: " << len;
+    }
+  }
+}
+
+// Tests that a payload with a character outside of the armoring is rejected.
+TEST(BitsetParseTest, BadCharacters) {
+  AisBitset bitset;
+  EXPECT_EQ(AIS_ERR_BAD_NMEA_CHR, bitset.ParseNmeaPayload("12X4", 0));
+  EXPECT_EQ(0, bitset.GetNumChars());
+  EXPECT_EQ(AIS_ERR_BAD_NMEA_CHR, bitset.ParseNmeaPayload("12x4", 0));
+  EXPECT_EQ(AIS_ERR_BAD_NMEA_CHR, bitset.ParseNmeaPayload("12\xff" "4", 0));
+  EXPECT_EQ(AIS_ERR_BAD_NMEA_CHR, bitset.ParseNmeaPayload("/", 0));
+  EXPECT_EQ(AIS_OK, bitset.ParseNmeaPayload("0Ww`", 0));
+}
+
+// Tests every payload length so that each de-armoring block size and tail
+// combination is exercised, and that a bad character anywhere is caught.
+TEST(BitsetParseTest, AllLengths) {
+  const std::string armoring(
+      "0123456789:;<=>?@ABCDEFGHIJKLMNOPQRSTUVW`abcdefghijklmnopqrstuvw");
+  std::string full;
+  for (size_t i = 0; i < 198; i++) {
+    full += armoring[(i * 7 + i / 5) % armoring.size()];
+  }
+  AisBitset bitset;
+  for (size_t size = 1; size <= full.size(); size++) {
+    const std::string payload(full.substr(0, size));
+    ASSERT_EQ(AIS_OK, bitset.ParseNmeaPayload(payload.c_str(), 0));
+    ASSERT_EQ(size, bitset.GetNumChars());
+    for (size_t pos = 0; pos < size * 6; pos++) {
+      ASSERT_EQ(ArmoredBit(payload, pos), bitset[pos])
+          << "size: " << size << " pos: " << pos;
+    }
+
+    for (size_t bad = 0; bad < size; bad++) {
+      std::string broken(payload);
+      broken[bad] = (bad % 2) ? 'x' : '\x80';
+      ASSERT_EQ(AIS_ERR_BAD_NMEA_CHR,
+                bitset.ParseNmeaPayload(broken.c_str(), 0))
+          << "size: " << size << " bad: " << bad;
+      ASSERT_EQ(0, bitset.GetNumChars());
+    }
+  }
+  EXPECT_EQ(AIS_ERR_MSG_TOO_LONG,
+            bitset.ParseNmeaPayload((full + "0").c_str(), 0));
+}
+
+// Tests that a payload that is not null terminated is bounded by its size.
+TEST(BitsetParseTest, PayloadSize) {
+  AisBitset bitset;
+  ASSERT_EQ(AIS_OK, bitset.ParseNmeaPayload("w1X", 2, 0));
+  EXPECT_EQ(12, bitset.GetNumBits());
+  EXPECT_EQ(63, bitset.ToUnsignedInt(0, 6));
+  EXPECT_EQ(1, bitset.ToUnsignedInt(6, 6));
+}
+
+// Decoded messages keep only their fields.  The bitset is scratch space that
+// is dropped at the end of the constructor.  The per-type sizes are recorded
+// in the test XML output (--gtest_output=xml).
+TEST(AisMsgTest, DoesNotRetainBitset) {
+  EXPECT_LT(sizeof(AisMsg), sizeof(AisBitset));
+
+#define LIBAIS_RECORD_SIZE(T) \
+  ::testing::Test::RecordProperty(#T, static_cast<int>(sizeof(T)))
+  LIBAIS_RECORD_SIZE(AisMsg);
+  LIBAIS_RECORD_SIZE(Ais1_2_3);
+  LIBAIS_RECORD_SIZE(Ais4_11);
+  LIBAIS_RECORD_SIZE(Ais5);
+  LIBAIS_RECORD_SIZE(Ais6_1_0);
+  LIBAIS_RECORD_SIZE(Ais7_13);
+  LIBAIS_RECORD_SIZE(Ais8_1_22);
+  LIBAIS_RECORD_SIZE(Ais9);
+  LIBAIS_RECORD_SIZE(Ais10);
+  LIBAIS_RECORD_SIZE(Ais12);
+  LIBAIS_RECORD_SIZE(Ais14);
+  LIBAIS_RECORD_SIZE(Ais15);
+  LIBAIS_RECORD_SIZE(Ais16);
+  LIBAIS_RECORD_SIZE(Ais17);
+  LIBAIS_RECORD_SIZE(Ais18);
+  LIBAIS_RECORD_SIZE(Ais19);
+  LIBAIS_RECORD_SIZE(Ais20);
+  LIBAIS_RECORD_SIZE(Ais21);
+  LIBAIS_RECORD_SIZE(Ais22);
+  LIBAIS_RECORD_SIZE(Ais23);
+  LIBAIS_RECORD_SIZE(Ais24);
+  LIBAIS_RECORD_SIZE(Ais25);
+  LIBAIS_RECORD_SIZE(Ais26);
+  LIBAIS_RECORD_SIZE(Ais27);
+#undef LIBAIS_RECORD_SIZE
+}
+
 }  // namespace
 }  // namespace libais
@@ -13,6 +13,8 @@
 // limitations under the License.
 
 #include "decode_body.h"
+
+#include "ais.h"
 #include "gtest/gtest.h"
 
 namespace libais {
@@ -33,5 +35,71 @@ TEST(CreateAisMsgTest, Valid) {
   EXPECT_EQ(27, msg->message_id);
 }
 
+TEST(CreateAisMsgTest, Binary) {
+  auto msg6 = CreateAisMsg("65Ps:8=:0MjP0420<4U>1@E=B10i>04<fp0", 2);
+  ASSERT_NE(nullptr, msg6);
+  ASSERT_FALSE(msg6->had_error());
+  auto ais6 = dynamic_cast<Ais6_1_0 *>(msg6.get());
+  ASSERT_NE(nullptr, ais6);
+  EXPECT_EQ("AIS TEST PLS ACK.@", ais6->text);
+
+  msg6 = CreateAisMsg("677IKl=HQGw004D0@02000000000", 0);
+  ASSERT_NE(nullptr, msg6);
+  ASSERT_FALSE(msg6->had_error());
+  ASSERT_NE(nullptr, dynamic_cast<Ais6_1_5 *>(msg6.get()));
+
+  auto msg8 = CreateAisMsg("8h3Ovq1KmPA`08b8007P3ct5uAPmtlAkh000", 0);
+  ASSERT_NE(nullptr, msg8);
+  ASSERT_FALSE(msg8->had_error());
+  ASSERT_NE(nullptr, dynamic_cast<Ais8_367_22 *>(msg8.get()));
+
+  // Valid header with a bad character later in the body.
+  EXPECT_EQ(nullptr, CreateAisMsg("8h3Ovq1KmPA`08b8007P3ct5uAPmtlAkh0x0", 0));
+  // Too short to hold the DAC and FI.
+  EXPECT_EQ(nullptr, CreateAisMsg("8h3Ovq1Km", 0));
+}
+
+TEST(PeekAisHeaderTest, Binary) {
+  int message_id;
+  int dac;
+  int fi;
+  ASSERT_TRUE(PeekAisHeader("65Ps:8=:0MjP0420<4U>1@E=B10i>04<fp0", 2,
+                            &message_id, &dac, &fi));
+  EXPECT_EQ(6, message_id);
+  EXPECT_EQ(1, dac);
+  EXPECT_EQ(0, fi);
+
+  ASSERT_TRUE(PeekAisHeader("8h3Ovq1KmPA`08b8007P3ct5uAPmtlAkh000", 0,
+                            &message_id, &dac, &fi));
+  EXPECT_EQ(8, message_id);
+  EXPECT_EQ(367, dac);
+  EXPECT_EQ(22, fi);
+
+  // Only the header characters are checked.
+  ASSERT_TRUE(PeekAisHeader("8h3Ovq1KmPxx", 0, &message_id, &dac, &fi));
+  EXPECT_EQ(367, dac);
+}
+
+TEST(PeekAisHeaderTest, NotBinary) {
+  int message_id;
+  int dac;
+  int fi;
+  ASSERT_TRUE(PeekAisHeader("K8VSqb9LdU28WP7h", 0, &message_id, &dac, &fi));
+  EXPECT_EQ(27, message_id);
+  EXPECT_EQ(-1, dac);
+  EXPECT_EQ(-1, fi);
+}
+
+TEST(PeekAisHeaderTest, Invalid) {
+  int message_id;
+  int dac;
+  int fi;
+  EXPECT_FALSE(PeekAisHeader("", 0, &message_id, &dac, &fi));
+  EXPECT_FALSE(PeekAisHeader("x", 0, &message_id, &dac, &fi));
+  EXPECT_FALSE(PeekAisHeader("K", 6, &message_id, &dac, &fi));
+  EXPECT_FALSE(PeekAisHeader("65Ps:8=:0MjP042", 5, &message_id, &dac, &fi));
+  EXPECT_FALSE(PeekAisHeader("8h3Ovq1Kx", 0, &message_id, &dac, &fi));
+}
+
 }  // namespace
 }  // namespace libais
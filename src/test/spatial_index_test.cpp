@@ -0,0 +1,211 @@
+// Test the grid index of position reports.
+
+#include "spatial_index.h"
+
+#include <algorithm>
+#include <memory>
+#include <random>
+#include <string>
+#include <vector>
+
+#include "ais.h"
+#include "decode_body.h"
+#include "gtest/gtest.h"
+
+namespace libais {
+namespace {
+
+PositionReport Report(double lng_deg, double lat_deg, int64_t time = 0,
+                      int mmsi = 1) {
+  PositionReport report;
+  report.position = AisPoint(lng_deg, lat_deg);
+  report.time = time;
+  report.mmsi = mmsi;
+  report.message_id = 1;
+  return report;
+}
+
+std::vector<int> Mmsis(const std::vector<PositionReport> &reports) {
+  std::vector<int> mmsis;
+  for (const auto &report : reports) {
+    mmsis.push_back(report.mmsi);
+  }
+  std::sort(mmsis.begin(), mmsis.end());
+  return mmsis;
+}
+
+TEST(SpatialIndexTest, GetPosition) {
+  std::unique_ptr<AisMsg> msg = CreateAisMsg("15N1u<PP1FJuvSRHOE6QIwwh0HQ6", 0);
+  ASSERT_NE(nullptr, msg);
+  AisPoint position;
+  ASSERT_TRUE(GetPosition(*msg, &position));
+  EXPECT_DOUBLE_EQ(static_cast<Ais1_2_3 &>(*msg).position.lng_deg,
+                   position.lng_deg);
+
+  static_cast<Ais1_2_3 &>(*msg).position = AisPoint(181, 91);
+  EXPECT_FALSE(GetPosition(*msg, &position));
+
+  msg = CreateAisMsg(
+      "55NBjP01mtGIL@CW;SM<D60P5Ld000000000000P0`<3557l0<50@kk@K5h@00000000000",
+      2);
+  ASSERT_NE(nullptr, msg);
+  EXPECT_FALSE(GetPosition(*msg, &position));
+
+  SpatialIndex index;
+  EXPECT_FALSE(index.Insert(*msg, 0));
+  EXPECT_EQ(0, index.size());
+}
+
+TEST(SpatialIndexTest, DistanceMeters) {
+  EXPECT_DOUBLE_EQ(0, DistanceMeters(AisPoint(10, 20), AisPoint(10, 20)));
+  EXPECT_NEAR(111195, DistanceMeters(AisPoint(0, 0), AisPoint(0, 1)), 1);
+  EXPECT_NEAR(111195, DistanceMeters(AisPoint(179.5, 0), AisPoint(-179.5, 0)),
+              1);
+  EXPECT_NEAR(55597, DistanceMeters(AisPoint(0, 60), AisPoint(1, 60)), 100);
+}
+
+TEST(SpatialIndexTest, Box) {
+  SpatialIndex index;
+  ASSERT_TRUE(index.Insert(Report(-122.4, 37.8, 0, 1)));
+  ASSERT_TRUE(index.Insert(Report(-122.3, 37.7, 0, 2)));
+  ASSERT_TRUE(index.Insert(Report(-70.0, 42.0, 0, 3)));
+  ASSERT_TRUE(index.Insert(Report(180, 90, 0, 4)));
+  ASSERT_TRUE(index.Insert(Report(-180, -90, 0, 5)));
+  EXPECT_FALSE(index.Insert(Report(181, 91)));
+  EXPECT_EQ(5, index.size());
+
+  std::vector<PositionReport> found;
+  index.FindInBox(AisPoint(-123, 37), AisPoint(-122, 38), 0, &found);
+  EXPECT_EQ(std::vector<int>({1, 2}), Mmsis(found));
+
+  // Edges are included.
+  found.clear();
+  index.FindInBox(AisPoint(-122.4, 37.8), AisPoint(-122.4, 37.8), 0, &found);
+  EXPECT_EQ(std::vector<int>({1}), Mmsis(found));
+
+  found.clear();
+  index.FindInBox(AisPoint(-180, -90), AisPoint(180, 90), 0, &found);
+  EXPECT_EQ(std::vector<int>({1, 2, 3, 4, 5}), Mmsis(found));
+
+  // Across the antimeridian.
+  found.clear();
+  index.FindInBox(AisPoint(170, -90), AisPoint(-170, 90), 0, &found);
+  EXPECT_EQ(std::vector<int>({4, 5}), Mmsis(found));
+
+  found.clear();
+  index.FindInBox(AisPoint(0, 0), AisPoint(10, 10), 0, &found);
+  EXPECT_TRUE(found.empty());
+}
+
+TEST(SpatialIndexTest, Radius) {
+  SpatialIndex index;
+  ASSERT_TRUE(index.Insert(Report(0, 0, 0, 1)));
+  ASSERT_TRUE(index.Insert(Report(0, 0.01, 0, 2)));  // 1112 m
+  ASSERT_TRUE(index.Insert(Report(0.01, 0.01, 0, 3)));  // 1573 m
+  ASSERT_TRUE(index.Insert(Report(179.995, 50, 0, 4)));
+  ASSERT_TRUE(index.Insert(Report(-179.995, 50, 0, 5)));
+  ASSERT_TRUE(index.Insert(Report(45, 89.99, 0, 6)));
+  ASSERT_TRUE(index.Insert(Report(-135, 89.99, 0, 7)));
+
+  std::vector<PositionReport> found;
+  index.FindInRadius(AisPoint(0, 0), 1200, 0, &found);
+  EXPECT_EQ(std::vector<int>({1, 2}), Mmsis(found));
+
+  found.clear();
+  index.FindInRadius(AisPoint(0, 0), 1600, 0, &found);
+  EXPECT_EQ(std::vector<int>({1, 2, 3}), Mmsis(found));
+
+  found.clear();
+  index.FindInRadius(AisPoint(180, 50), 1000, 0, &found);
+  EXPECT_EQ(std::vector<int>({4, 5}), Mmsis(found));
+
+  // Over the pole.
+  found.clear();
+  index.FindInRadius(AisPoint(45, 89.99), 2300, 0, &found);
+  EXPECT_EQ(std::vector<int>({6, 7}), Mmsis(found));
+
+  found.clear();
+  index.FindInRadius(AisPoint(0, 0), -1, 0, &found);
+  EXPECT_TRUE(found.empty());
+}
+
+TEST(SpatialIndexTest, Time) {
+  SpatialIndex index;
+  for (int i = 0; i < 10; i++) {
+    ASSERT_TRUE(index.Insert(Report(10.05 + i * 0.001, 10.05, i * 60, i)));
+  }
+  ASSERT_TRUE(index.Insert(Report(-10, -10, 0, 100)));
+  EXPECT_EQ(11, index.size());
+  EXPECT_EQ(2, index.cells());
+
+  std::vector<PositionReport> found;
+  index.FindInBox(AisPoint(9, 9), AisPoint(11, 11), 420, &found);
+  EXPECT_EQ(std::vector<int>({7, 8, 9}), Mmsis(found));
+
+  index.Expire(300);
+  EXPECT_EQ(5, index.size());
+  EXPECT_EQ(1, index.cells());
+  found.clear();
+  index.FindInBox(AisPoint(-180, -90), AisPoint(180, 90), 0, &found);
+  EXPECT_EQ(std::vector<int>({5, 6, 7, 8, 9}), Mmsis(found));
+
+  // Inserting after expiring.
+  ASSERT_TRUE(index.Insert(Report(10, 10, 600, 10)));
+  index.Expire(500);
+  found.clear();
+  index.FindInRadius(AisPoint(10, 10), 10000, 0, &found);
+  EXPECT_EQ(std::vector<int>({9, 10}), Mmsis(found));
+
+  index.Expire(1000);
+  EXPECT_EQ(0, index.size());
+  EXPECT_EQ(0, index.cells());
+}
+
+// The index finds the same reports as checking every report.
+TEST(SpatialIndexTest, MatchesBruteForce) {
+  std::mt19937 random(1234);
+  std::uniform_real_distribution<double> lng(-180, 180);
+  std::uniform_real_distribution<double> lat(-90, 90);
+  std::vector<PositionReport> reports;
+  SpatialIndex index(1);
+  for (int i = 0; i < 20000; i++) {
+    reports.push_back(Report(lng(random), lat(random), 0, i));
+    ASSERT_TRUE(index.Insert(reports.back()));
+  }
+
+  for (int query = 0; query < 50; query++) {
+    const AisPoint center(lng(random), lat(random));
+    const double meters = 1000 * (query + 1) * (query + 1);
+    std::vector<int> expected;
+    for (const auto &report : reports) {
+      if (DistanceMeters(center, report.position) <= meters) {
+        expected.push_back(report.mmsi);
+      }
+    }
+    std::vector<PositionReport> found;
+    index.FindInRadius(center, meters, 0, &found);
+    EXPECT_EQ(expected, Mmsis(found)) << center << " " << meters;
+
+    const AisPoint south_west(lng(random), lat(random));
+    const AisPoint north_east(lng(random), lat(random));
+    expected.clear();
+    for (const auto &report : reports) {
+      const double x = report.position.lng_deg;
+      const double y = report.position.lat_deg;
+      const bool in_lng = south_west.lng_deg <= north_east.lng_deg
+                              ? x >= south_west.lng_deg &&
+                                    x <= north_east.lng_deg
+                              : x >= south_west.lng_deg ||
+                                    x <= north_east.lng_deg;
+      if (in_lng && y >= south_west.lat_deg && y <= north_east.lat_deg) {
+        expected.push_back(report.mmsi);
+      }
+    }
+    found.clear();
+    index.FindInBox(south_west, north_east, 0, &found);
+    EXPECT_EQ(expected, Mmsis(found)) << south_west << " " << north_east;
+  }
+}
+
+}  // namespace
+}  // namespace libais
@@ -0,0 +1,198 @@
+// Test parsing NMEA TAG blocks and joining TAG block groups.
+
+#include "tag_block.h"
+
+#include <string>
+#include <string_view>
+
+#include "vdm.h"
+#include "gtest/gtest.h"
+
+namespace libais {
+namespace {
+
+// Wraps the fields in backslashes with a valid checksum.
+std::string Tag(const std::string &fields) {
+  return "\\" + fields + "*" + ChecksumHexString(fields) + "\\";
+}
+
+TEST(ParseTagBlockTest, OrbcommLine) {
+  const std::string line =
+      "\\g:1-2-1604,s:rORBCOMM008,c:1418169601,T:2014-12-10 00.00.01*37\\"
+      "!AIVDM,2,1,6,A,53@o0E000001Q0CG37U8u<Tp4q@D00000000000018330400000000"
+      "000000,0*63";
+  TagBlock tag;
+  std::string_view sentence;
+  ASSERT_TRUE(ParseTagBlock(line, &tag, &sentence));
+  EXPECT_EQ(1418169601.0, tag.time);
+  EXPECT_EQ(1, tag.group_sentence);
+  EXPECT_EQ(2, tag.group_total);
+  EXPECT_EQ(1604, tag.group_id);
+  EXPECT_EQ("rORBCOMM008", tag.source);
+  EXPECT_EQ("2014-12-10 00.00.01", tag.text_date);
+  EXPECT_EQ(0, tag.quality);
+  EXPECT_EQ(-1, tag.line_count);
+  EXPECT_TRUE(tag.destination.empty());
+  EXPECT_EQ(0, sentence.find("!AIVDM,2,1,6,A,"));
+  // Views into the line.
+  EXPECT_EQ(line.data() + line.find("rORBCOMM008"), tag.source.data());
+}
+
+TEST(ParseTagBlockTest, AllFields) {
+  const std::string line =
+      Tag("c:1425327399.123,d:DEST,g:3-4-98765,n:42,q:u,r:1234,s:STATION,"
+          "t:some text,T:2015-03-02,x:unknown") +
+      "!AIVDM,1,1,,B,13F?Vv700<DJuLEtvep`iToV0<00,0*78";
+  TagBlock tag;
+  std::string_view sentence;
+  ASSERT_TRUE(ParseTagBlock(line, &tag, &sentence));
+  EXPECT_DOUBLE_EQ(1425327399.123, tag.time);
+  EXPECT_EQ("DEST", tag.destination);
+  EXPECT_EQ(3, tag.group_sentence);
+  EXPECT_EQ(4, tag.group_total);
+  EXPECT_EQ(98765, tag.group_id);
+  EXPECT_EQ(42, tag.line_count);
+  EXPECT_EQ('u', tag.quality);
+  EXPECT_EQ(1234, tag.relative_time);
+  EXPECT_EQ("STATION", tag.source);
+  EXPECT_EQ("some text", tag.text);
+  EXPECT_EQ("2015-03-02", tag.text_date);
+  EXPECT_EQ("!AIVDM,1,1,,B,13F?Vv700<DJuLEtvep`iToV0<00,0*78", sentence);
+}
+
+TEST(ParseTagBlockTest, Checksum) {
+  TagBlock tag;
+  std::string_view sentence;
+  EXPECT_TRUE(ParseTagBlock("\\s:a*28\\", &tag, &sentence));
+  EXPECT_TRUE(sentence.empty());
+  // Lower case hex.
+  EXPECT_TRUE(ParseTagBlock("\\s:ab*4a\\x", &tag, &sentence));
+  EXPECT_EQ("x", sentence);
+  EXPECT_FALSE(ParseTagBlock("\\s:a*29\\", &tag, &sentence));
+  EXPECT_FALSE(ParseTagBlock("\\s:a\\", &tag, &sentence));
+  EXPECT_FALSE(ParseTagBlock("\\s:a*2\\", &tag, &sentence));
+  EXPECT_FALSE(ParseTagBlock("\\s:a*288\\", &tag, &sentence));
+  EXPECT_FALSE(ParseTagBlock("\\s:a*28", &tag, &sentence));
+}
+
+TEST(HexChecksumMatchesTest, Digits) {
+  EXPECT_TRUE(HexChecksumMatches("00", 0));
+  EXPECT_TRUE(HexChecksumMatches("4A", 0x4a));
+  EXPECT_TRUE(HexChecksumMatches("4a", 0x4a));
+  EXPECT_TRUE(HexChecksumMatches("fF", 0xff));
+  EXPECT_FALSE(HexChecksumMatches("4B", 0x4a));
+  EXPECT_FALSE(HexChecksumMatches("4G", 0x4a));
+  EXPECT_FALSE(HexChecksumMatches("4", 0x4));
+  EXPECT_FALSE(HexChecksumMatches("04A", 0x4a));
+  EXPECT_FALSE(HexChecksumMatches("", 0));
+}
+
+TEST(ParseTagBlockTest, Junk) {
+  TagBlock tag;
+  std::string_view sentence;
+  EXPECT_FALSE(ParseTagBlock("", &tag, &sentence));
+  EXPECT_FALSE(ParseTagBlock("!AIVDM,1,1,,B,13F?Vv,0*78", &tag, &sentence));
+  EXPECT_FALSE(ParseTagBlock(Tag("c:abc"), &tag, &sentence));
+  EXPECT_FALSE(ParseTagBlock(Tag("c:-1"), &tag, &sentence));
+  EXPECT_FALSE(ParseTagBlock(Tag("g:1-2"), &tag, &sentence));
+  EXPECT_FALSE(ParseTagBlock(Tag("g:3-2-1"), &tag, &sentence));
+  EXPECT_FALSE(ParseTagBlock(Tag("g:0-2-1"), &tag, &sentence));
+  EXPECT_FALSE(ParseTagBlock(Tag("n:1x"), &tag, &sentence));
+  EXPECT_FALSE(ParseTagBlock(Tag("q:uu"), &tag, &sentence));
+  EXPECT_FALSE(ParseTagBlock(Tag("s"), &tag, &sentence));
+  EXPECT_FALSE(ParseTagBlock(Tag("s:a,,t:b"), &tag, &sentence));
+  // A trailing comma is tolerated as in ais/tag_block.py.
+  EXPECT_TRUE(ParseTagBlock(Tag("s:a,"), &tag, &sentence));
+}
+
+// Adds a sentence of a group parsed from fields.
+TagGroupStatus AddToGroup(TagGroupAssembler *groups, const std::string &fields,
+                          std::string_view payload, std::string_view *body,
+                          TagBlock *first_tag) {
+  const std::string tag_text = Tag(fields);
+  TagBlock tag;
+  std::string_view sentence;
+  EXPECT_TRUE(ParseTagBlock(tag_text, &tag, &sentence));
+  int fill_bits = -1;
+  return groups->Add(tag, tag_text, payload, 2, body, &fill_bits, first_tag);
+}
+
+TEST(TagGroupAssemblerTest, Interleaved) {
+  TagGroupAssembler groups;
+  std::string_view body;
+  TagBlock first;
+  EXPECT_EQ(TAG_GROUP_PARTIAL,
+            AddToGroup(&groups, "g:1-2-7,s:a,c:1000000001", "A1", &body,
+                       &first));
+  // Same group id from another source.
+  EXPECT_EQ(TAG_GROUP_PARTIAL,
+            AddToGroup(&groups, "g:1-3-7,s:b", "B1", &body, &first));
+  EXPECT_EQ(TAG_GROUP_PARTIAL,
+            AddToGroup(&groups, "g:2-3-7,s:b", "B2", &body, &first));
+  EXPECT_EQ(2, groups.pending());
+  EXPECT_EQ(TAG_GROUP_COMPLETE,
+            AddToGroup(&groups, "g:2-2-7,s:a", "A2", &body, &first));
+  EXPECT_EQ("A1A2", body);
+  EXPECT_EQ(1000000001.0, first.time);
+  EXPECT_EQ("a", first.source);
+  EXPECT_EQ(TAG_GROUP_COMPLETE,
+            AddToGroup(&groups, "g:3-3-7,s:b", "B3", &body, &first));
+  EXPECT_EQ("B1B2B3", body);
+  EXPECT_EQ(-1, first.time);
+  EXPECT_EQ(0, groups.pending());
+  EXPECT_EQ(0, groups.evicted());
+}
+
+// Only the first line of a group has the source.
+TEST(TagGroupAssemblerTest, SourceOnFirstLine) {
+  TagGroupAssembler groups;
+  std::string_view body;
+  TagBlock first;
+  EXPECT_EQ(TAG_GROUP_PARTIAL,
+            AddToGroup(&groups, "g:1-2-27300,n:636994,s:b003669710", "A1",
+                       &body, &first));
+  EXPECT_EQ(TAG_GROUP_COMPLETE,
+            AddToGroup(&groups, "g:2-2-27300,n:636995", "A2", &body, &first));
+  EXPECT_EQ("A1A2", body);
+  EXPECT_EQ("b003669710", first.source);
+}
+
+TEST(TagGroupAssemblerTest, OutOfOrder) {
+  TagGroupAssembler groups;
+  std::string_view body;
+  TagBlock first;
+  EXPECT_EQ(TAG_GROUP_OUT_OF_ORDER,
+            AddToGroup(&groups, "g:2-2-1", "x", &body, &first));
+  EXPECT_EQ(TAG_GROUP_PARTIAL,
+            AddToGroup(&groups, "g:1-3-1", "x", &body, &first));
+  // Skipped sentence 2.  The group is dropped.
+  EXPECT_EQ(TAG_GROUP_OUT_OF_ORDER,
+            AddToGroup(&groups, "g:3-3-1", "x", &body, &first));
+  EXPECT_EQ(0, groups.pending());
+  EXPECT_EQ(TAG_GROUP_PARTIAL,
+            AddToGroup(&groups, "g:1-3-1", "x", &body, &first));
+  EXPECT_EQ(TAG_GROUP_OUT_OF_ORDER,
+            AddToGroup(&groups, "g:2-2-1", "x", &body, &first));
+}
+
+TEST(TagGroupAssemblerTest, Bounded) {
+  TagGroupAssembler groups(4);
+  std::string_view body;
+  TagBlock first;
+  for (int i = 0; i < 10; i++) {
+    EXPECT_EQ(TAG_GROUP_PARTIAL,
+              AddToGroup(&groups, "g:1-2-" + std::to_string(i), "x", &body,
+                         &first));
+  }
+  EXPECT_EQ(4, groups.pending());
+  EXPECT_EQ(6, groups.evicted());
+  // The oldest groups were dropped.
+  EXPECT_EQ(TAG_GROUP_OUT_OF_ORDER,
+            AddToGroup(&groups, "g:2-2-5", "y", &body, &first));
+  EXPECT_EQ(TAG_GROUP_COMPLETE,
+            AddToGroup(&groups, "g:2-2-6", "y", &body, &first));
+  EXPECT_EQ("xy", body);
+}
+
+}  // namespace
+}  // namespace libais
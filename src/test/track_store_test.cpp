@@ -0,0 +1,100 @@
+// Test keeping the recent track of each vessel.
+
+#include "track_store.h"
+
+#include <memory>
+#include <vector>
+
+#include "ais.h"
+#include "decode_body.h"
+#include "gtest/gtest.h"
+
+namespace libais {
+namespace {
+
+TEST(TrackStoreTest, Empty) {
+  TrackStore store(4);
+  EXPECT_EQ(4, store.capacity());
+  EXPECT_EQ(0, store.vessels());
+  EXPECT_EQ(0, store.TrackSize(1));
+  Track track;
+  EXPECT_FALSE(store.GetTrack(1, &track));
+}
+
+TEST(TrackStoreTest, Messages) {
+  TrackStore store;
+  std::unique_ptr<AisMsg> msg = CreateAisMsg("15N1u<PP1FJuvSRHOE6QIwwh0HQ6", 0);
+  ASSERT_NE(nullptr, msg);
+  ASSERT_TRUE(store.Add(*msg, 100));
+  const auto &m = static_cast<const Ais1_2_3 &>(*msg);
+
+  Track track;
+  ASSERT_TRUE(store.GetTrack(m.mmsi, &track));
+  ASSERT_EQ(1, track.size());
+  EXPECT_EQ(100, track.time[0]);
+  EXPECT_DOUBLE_EQ(m.position.lng_deg, track.x[0]);
+  EXPECT_DOUBLE_EQ(m.position.lat_deg, track.y[0]);
+  EXPECT_FLOAT_EQ(m.sog, track.sog[0]);
+  EXPECT_FLOAT_EQ(m.cog, track.cog[0]);
+
+  // Class B.
+  msg = CreateAisMsg("B5NU=J000=l0BD6l590EkwuUoP06", 0);
+  ASSERT_NE(nullptr, msg);
+  ASSERT_TRUE(store.Add(*msg, 100));
+  EXPECT_EQ(2, store.vessels());
+
+  // No position.
+  static_cast<Ais18 &>(*msg).position = AisPoint(181, 91);
+  EXPECT_FALSE(store.Add(*msg, 200));
+  msg = CreateAisMsg(
+      "55NBjP01mtGIL@CW;SM<D60P5Ld000000000000P0`<3557l0<50@kk@K5h@00000000000",
+      2);
+  ASSERT_NE(nullptr, msg);
+  EXPECT_FALSE(store.Add(*msg, 200));
+  EXPECT_EQ(2, store.vessels());
+}
+
+TEST(TrackStoreTest, DuplicatesAndOutOfOrder) {
+  TrackStore store(4);
+  EXPECT_TRUE(store.Add(1, 10, AisPoint(1, 1), 1, 1));
+  EXPECT_FALSE(store.Add(1, 10, AisPoint(1, 1), 1, 1));
+  EXPECT_TRUE(store.Add(1, 20, AisPoint(2, 2), 2, 2));
+  EXPECT_FALSE(store.Add(1, 15, AisPoint(3, 3), 3, 3));
+  // Other vessels have their own times.
+  EXPECT_TRUE(store.Add(2, 15, AisPoint(3, 3), 3, 3));
+  EXPECT_EQ(1, store.duplicates());
+  EXPECT_EQ(1, store.out_of_order());
+  EXPECT_EQ(2, store.TrackSize(1));
+  EXPECT_EQ(1, store.TrackSize(2));
+
+  Track track;
+  ASSERT_TRUE(store.GetTrack(1, &track));
+  EXPECT_EQ(std::vector<int64_t>({10, 20}), track.time);
+  EXPECT_EQ(std::vector<double>({1, 2}), track.x);
+}
+
+TEST(TrackStoreTest, Wraps) {
+  TrackStore store(3);
+  for (int i = 0; i < 10; i++) {
+    ASSERT_TRUE(store.Add(1, i, AisPoint(i, -i), i, 360 - i));
+    ASSERT_TRUE(store.Add(2, i, AisPoint(-i, i), i, i));
+    Track track;
+    ASSERT_TRUE(store.GetTrack(1, &track));
+    ASSERT_EQ(std::min(i + 1, 3), track.size());
+    for (size_t j = 0; j < track.size(); j++) {
+      const int expected = i + 1 - static_cast<int>(track.size()) + j;
+      EXPECT_EQ(expected, track.time[j]);
+      EXPECT_EQ(expected, track.x[j]);
+      EXPECT_EQ(-expected, track.y[j]);
+      EXPECT_EQ(expected, track.sog[j]);
+      EXPECT_EQ(360 - expected, track.cog[j]);
+    }
+  }
+  Track track;
+  ASSERT_TRUE(store.GetTrack(2, &track));
+  EXPECT_EQ(std::vector<int64_t>({7, 8, 9}), track.time);
+  EXPECT_EQ(std::vector<double>({-7, -8, -9}), track.x);
+}
+
+}  // namespace
+}  // namespace libais
@@ -0,0 +1,99 @@
+// Test parsing the older USCG metadata after an NMEA sentence.
+
+#include "uscg.h"
+
+#include <string>
+#include <string_view>
+
+#include "gtest/gtest.h"
+
+namespace libais {
+namespace {
+
+TEST(ParseUscgMetadataTest, AllFields) {
+  const std::string line =
+      "!AIVDM,1,1,,A,35Mqd3POj3rmIpjGSpmeCJaH00Qh,0*34,d-095,S1651,"
+      "t161344.00,T44.03018211,s27,x123,r3669963,1429287142";
+  UscgMetadata metadata;
+  std::string_view sentence;
+  ASSERT_TRUE(ParseUscgMetadata(line, &metadata, &sentence));
+  EXPECT_EQ("!AIVDM,1,1,,A,35Mqd3POj3rmIpjGSpmeCJaH00Qh,0*34", sentence);
+  EXPECT_EQ(-95, metadata.signal_strength);
+  EXPECT_EQ(1651, metadata.slot);
+  EXPECT_DOUBLE_EQ(16 * 3600 + 13 * 60 + 44, metadata.receiver_time);
+  EXPECT_DOUBLE_EQ(44.03018211, metadata.time_of_arrival);
+  EXPECT_EQ(27, metadata.rssi);
+  EXPECT_EQ(123, metadata.counter);
+  EXPECT_EQ("r3669963", metadata.station);
+  EXPECT_EQ(1429287142.0, metadata.time);
+  // Views into the line.
+  EXPECT_EQ(line.data() + line.find("r3669963"), metadata.station.data());
+}
+
+TEST(ParseUscgMetadataTest, Minimal) {
+  UscgMetadata metadata;
+  std::string_view sentence;
+  ASSERT_TRUE(ParseUscgMetadata(
+      "!ANVDM,1,1,,B,15N6CB0000r86SRFAS:<E@SH08Il,0*43,r08ACERDC,1429287223",
+      &metadata, &sentence));
+  EXPECT_EQ("r08ACERDC", metadata.station);
+  EXPECT_EQ(1429287223.0, metadata.time);
+  EXPECT_EQ(kNoSignalStrength, metadata.signal_strength);
+  EXPECT_EQ(-1, metadata.slot);
+  EXPECT_EQ(-1, metadata.rssi);
+  EXPECT_EQ(-1, metadata.receiver_time);
+  EXPECT_EQ(-1, metadata.time_of_arrival);
+  EXPECT_EQ(-1, metadata.counter);
+
+  // Only a logger time.
+  ASSERT_TRUE(ParseUscgMetadata("!AIVDM,1,1,,A,1,0*00,1429287223.5",
+                                &metadata, &sentence));
+  EXPECT_EQ("!AIVDM,1,1,,A,1,0*00", sentence);
+  EXPECT_TRUE(metadata.station.empty());
+  EXPECT_EQ(1429287223.5, metadata.time);
+}
+
+TEST(ParseUscgMetadataTest, SecondTimeAndUnknownFields) {
+  UscgMetadata metadata;
+  std::string_view sentence;
+  ASSERT_TRUE(ParseUscgMetadata(
+      "!AIVDM,1,1,,A,1,0*00,d-109,S2105,t050056.00,T56.13718694,r003669946,"
+      "1325394060,1325394001",
+      &metadata, &sentence));
+  EXPECT_EQ(-109, metadata.signal_strength);
+  EXPECT_DOUBLE_EQ(5 * 3600 + 56, metadata.receiver_time);
+  EXPECT_EQ(1325394060.0, metadata.time);
+
+  ASSERT_TRUE(ParseUscgMetadata("!AIVDM,1,1,,A,1,0*00,z12,,S,b003665002",
+                                &metadata, &sentence));
+  EXPECT_EQ("b003665002", metadata.station);
+  EXPECT_EQ(-1, metadata.slot);
+}
+
+TEST(ParseUscgMetadataTest, Junk) {
+  UscgMetadata metadata;
+  std::string_view sentence;
+  // No metadata.
+  EXPECT_FALSE(ParseUscgMetadata("", &metadata, &sentence));
+  EXPECT_FALSE(ParseUscgMetadata("!AIVDM,1,1,,A,1,0*00", &metadata,
+                                 &sentence));
+  EXPECT_FALSE(ParseUscgMetadata("!AIVDM,1,1,,A,1,0", &metadata, &sentence));
+  EXPECT_FALSE(ParseUscgMetadata("!AIVDM,1,1,,A,1,0*000,r1", &metadata,
+                                 &sentence));
+  // Bad fields.
+  EXPECT_FALSE(ParseUscgMetadata("!AIVDM,1,1,,A,1,0*00,dx", &metadata,
+                                 &sentence));
+  EXPECT_FALSE(ParseUscgMetadata("!AIVDM,1,1,,A,1,0*00,S99999", &metadata,
+                                 &sentence));
+  EXPECT_FALSE(ParseUscgMetadata("!AIVDM,1,1,,A,1,0*00,t2500", &metadata,
+                                 &sentence));
+  EXPECT_FALSE(ParseUscgMetadata("!AIVDM,1,1,,A,1,0*00,t250000", &metadata,
+                                 &sentence));
+  EXPECT_FALSE(ParseUscgMetadata("!AIVDM,1,1,,A,1,0*00,T-1", &metadata,
+                                 &sentence));
+  EXPECT_FALSE(ParseUscgMetadata("!AIVDM,1,1,,A,1,0*00,12x", &metadata,
+                                 &sentence));
+}
+
+}  // namespace
+}  // namespace libais
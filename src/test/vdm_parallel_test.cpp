@@ -0,0 +1,159 @@
+// Test decoding a VDM stream with a pool of threads.
+
+#include "vdm_parallel.h"
+
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "ais.h"
+#include "vdm.h"
+#include "gtest/gtest.h"
+
+namespace libais {
+namespace {
+
+// Single line, multi-line, bad and out of order lines.
+const std::vector<std::string> kLines = {
+    "!SAVDM,1,1,6,A,15N4uK0P00r<rW:BFp;JJgv`25k`,0*49",
+    "!SAVDM,2,1,1,A,54a=3b027kft?HISV20@thF0<u=@618T<6222216A0b<?4wk0BAm@F@"
+    "DEBC8,0*17",
+    "!SAVDM,1,1,,A,29NS6m1000qE>9f@s=BES4M40@ET,0*53",
+    "!SAVDM,2,2,1,A,88888888880,2*3F",
+    "not a vdm line",
+    "!BSVDM,1,1,,B,36So=l5000o?uF0K>pnpV0Nf0000,0*57",
+    "!AIVDM,3,3,4,A,d0@d0IqhH:Pah:U54PD?75D85Bf00,0*03",
+    "!AIVDM,1,1,,A,4030p:Autt01Dn`erRO<Wno00@<I,0*41",
+    "!AIVDM,3,1,4,A,81mg=5@0EP:4R40807P>0<D1>MNt00000f>FNVfnw7>6>FNU=?"
+    "B5PD5HDPD8,0*26",
+    "!AIVDM,3,2,4,A,1Dd2J09jL08JArJH5P=E<D9@<5P<9>0`bMl42Q0d2Pc2T59CPCE@@?"
+    "C54PD?,0*60",
+    "!AIVDM,3,3,4,A,d0@d0IqhH:Pah:U54PD?75D85Bf00,0*03",
+    "!BSVDM,1,1,,A,B52HIjh00=ksdj6l448=wwQ5WP06,0*68",
+    "!SAVDM,1,1,,B,K8VSqb9LdU28WP8d,0*4F",
+};
+
+struct Decoded {
+  int message_id;
+  int mmsi;
+};
+
+std::vector<Decoded> Drain(VdmStream *stream) {
+  std::vector<Decoded> result;
+  while (auto msg = stream->PopOldestMessage()) {
+    result.push_back({msg->message_id, msg->mmsi});
+  }
+  return result;
+}
+
+std::vector<Decoded> Drain(ParallelVdmStream *stream) {
+  std::vector<Decoded> result;
+  stream->Flush();
+  while (auto msg = stream->PopOldestMessage()) {
+    result.push_back({msg->message_id, msg->mmsi});
+  }
+  return result;
+}
+
+void ExpectSame(const std::vector<Decoded> &expected,
+                const std::vector<Decoded> &actual) {
+  ASSERT_EQ(expected.size(), actual.size());
+  for (size_t i = 0; i < expected.size(); i++) {
+    EXPECT_EQ(expected[i].message_id, actual[i].message_id) << i;
+    EXPECT_EQ(expected[i].mmsi, actual[i].mmsi) << i;
+  }
+}
+
+TEST(ParallelVdmStreamTest, SameOrderAsVdmStream) {
+  const int kRepeat = 500;
+  VdmStream expected_stream;
+  for (int i = 0; i < kRepeat; i++) {
+    for (const auto &line : kLines) {
+      expected_stream.AddLine(line);
+    }
+  }
+  const std::vector<Decoded> expected = Drain(&expected_stream);
+  ASSERT_EQ(kRepeat * 8, expected.size());
+
+  // Small windows and batches make the threads wait on each other.
+  for (const int threads : {1, 2, 4}) {
+    for (const size_t window : {1, 7, 64}) {
+      for (const size_t batch_size : {size_t(1), size_t(3), window}) {
+        if (batch_size > window) {
+          continue;
+        }
+        ParallelVdmStream stream(threads, window, batch_size);
+        std::vector<Decoded> actual;
+        for (int i = 0; i < kRepeat; i++) {
+          for (const auto &line : kLines) {
+            stream.AddLine(line);
+          }
+          // Take some of the messages as they come.
+          if (auto msg = stream.PopOldestMessage()) {
+            actual.push_back({msg->message_id, msg->mmsi});
+          }
+        }
+        const std::vector<Decoded> rest = Drain(&stream);
+        actual.insert(actual.end(), rest.begin(), rest.end());
+        SCOPED_TRACE(testing::Message() << "threads: " << threads
+                                        << " window: " << window
+                                        << " batch: " << batch_size);
+        ExpectSame(expected, actual);
+      }
+    }
+  }
+}
+
+TEST(ParallelVdmStreamTest, AddLineStatus) {
+  ParallelVdmStream stream(2);
+  EXPECT_TRUE(stream.AddLine(kLines[0]));
+  EXPECT_TRUE(stream.AddLine(kLines[1]));
+  EXPECT_FALSE(stream.AddLine("not a vdm line"));
+  // Later part of a message without its start.
+  EXPECT_FALSE(stream.AddLine(kLines[6]));
+  stream.Flush();
+  EXPECT_EQ(1, stream.size());
+  auto msg = stream.PopOldestMessage();
+  ASSERT_NE(nullptr, msg);
+  EXPECT_EQ(367082860, msg->mmsi);
+  EXPECT_EQ(nullptr, stream.PopOldestMessage());
+  EXPECT_TRUE(stream.empty());
+}
+
+TEST(ParallelVdmStreamTest, AddBuffer) {
+  std::string buffer;
+  for (const auto &line : kLines) {
+    buffer += line + "\r\n";
+  }
+  buffer += "!SAVDM,1,1";
+
+  VdmStream expected_stream;
+  std::vector<std::unique_ptr<AisMsg>> messages;
+  std::vector<VdmLineStatus> line_status;
+  expected_stream.AddBuffer(buffer.data(), buffer.data() + buffer.size(),
+                            &messages, &line_status);
+
+  ParallelVdmStream stream(3, 4, 2);
+  const char *end = buffer.data() + buffer.size();
+  const char *rest = stream.AddBuffer(buffer.data(), end);
+  EXPECT_EQ("!SAVDM,1,1", std::string(rest, end));
+  const std::vector<Decoded> actual = Drain(&stream);
+  ASSERT_EQ(messages.size(), actual.size());
+  for (size_t i = 0; i < messages.size(); i++) {
+    EXPECT_EQ(messages[i]->message_id, actual[i].message_id);
+    EXPECT_EQ(messages[i]->mmsi, actual[i].mmsi);
+  }
+}
+
+TEST(ParallelVdmStreamTest, DestroyWithMessagesInFlight) {
+  ParallelVdmStream stream(4, 16, 4);
+  for (int i = 0; i < 100; i++) {
+    for (const auto &line : kLines) {
+      stream.AddLine(line);
+    }
+  }
+  // Should not leak or hang.
+}
+
+}  // namespace
+}  // namespace libais
@@ -22,6 +22,8 @@
 #include <cstdint>
 #include <memory>
 #include <string>
+#include <string_view>
+#include <vector>
 
 #include "ais.h"
 #include "gmock/gmock-matchers.h"
@@ -142,6 +144,65 @@ TEST(NmeaSentenceTest, ReturnNullptrOnJunk) {
                 "!AIVDM,1,1,,B,15MuTpPP00INJMh@vq`00?vJ00S0,0*123", 1));
 }
 
+TEST(ParseNmeaSentenceTest, FieldsAreViewsIntoTheLine) {
+  const std::string line("!BSVDM,2,2,5,A,580CPj88880,2*7C");
+  NmeaSentenceView sentence;
+  ASSERT_TRUE(ParseNmeaSentence(line, &sentence));
+  EXPECT_EQ("BS", sentence.talker);
+  EXPECT_EQ("VDM", sentence.sentence_type);
+  EXPECT_EQ(2, sentence.sentence_total);
+  EXPECT_EQ(2, sentence.sentence_number);
+  EXPECT_EQ(5, sentence.sequence_number);
+  EXPECT_EQ('A', sentence.channel);
+  EXPECT_EQ("580CPj88880", sentence.body);
+  EXPECT_EQ(2, sentence.fill_bits);
+
+  EXPECT_EQ(line.data() + 1, sentence.talker.data());
+  EXPECT_EQ(line.data() + 15, sentence.body.data());
+}
+
+TEST(ParseNmeaSentenceTest, NoSequenceNumber) {
+  NmeaSentenceView sentence;
+  ASSERT_TRUE(
+      ParseNmeaSentence("!SAVDM,1,1,,B,K8VSqb9LdU28WP8P,0*7B", &sentence));
+  EXPECT_EQ(kNoSequenceNumber, sentence.sequence_number);
+  // Lower case hex in the checksum.
+  ASSERT_TRUE(
+      ParseNmeaSentence("!SAVDM,1,1,,B,K8VSqb9LdU28WP8P,0*7b", &sentence));
+}
+
+TEST(ParseNmeaSentenceTest, DoesNotReadPastTheView) {
+  const std::string buffer(
+      "!SAVDM,1,1,,B,K8VSqb9LdU28WP8P,0*7B!SAVDM,1,1,,B,K8VSqb9LdU28WP8P,0*7B");
+  NmeaSentenceView sentence;
+  EXPECT_TRUE(ParseNmeaSentence(std::string_view(buffer.data(), 35),
+                                &sentence));
+  EXPECT_FALSE(ParseNmeaSentence(std::string_view(buffer.data(), 34),
+                                 &sentence));
+  EXPECT_FALSE(ParseNmeaSentence(std::string_view(buffer.data(), 36),
+                                 &sentence));
+}
+
+TEST(ParseNmeaSentenceTest, Junk) {
+  NmeaSentenceView sentence;
+  EXPECT_FALSE(ParseNmeaSentence("", &sentence));
+  EXPECT_FALSE(ParseNmeaSentence("!AIVDM,1,1,,B,,0*", &sentence));
+  // Signs and spaces are not numbers.
+  EXPECT_FALSE(ParseNmeaSentence(
+      "!AIVDM,+1,1,,B,15MuTpPP00INJMh@vq`00?vJ00S0,0*39", &sentence));
+  EXPECT_FALSE(ParseNmeaSentence(
+      "!AIVDM,1,1,,B,15MuTpPP00INJMh@vq`00?vJ00S0, 0*32", &sentence));
+  // Sequence number out of range.
+  EXPECT_FALSE(ParseNmeaSentence(
+      "!AIVDM,2,1,10,B,15MuTpPP00INJMh@vq`00?vJ00S0,0*10", &sentence));
+  // Second star.
+  EXPECT_FALSE(ParseNmeaSentence(
+      "!AIVDM,1,1,,B,15MuTpPP00INJMh@vq`00?vJ00S0,0*12*", &sentence));
+  // Not hex.
+  EXPECT_FALSE(ParseNmeaSentence(
+      "!AIVDM,1,1,,B,15MuTpPP00INJMh@vq`00?vJ00S0,0*1G", &sentence));
+}
+
 TEST(NmeaSentenceTest, SingleLines) {
   // Message 27 - Low bit count position report.
   int64_t line_number = 12;
@@ -158,8 +219,7 @@ TEST(NmeaSentenceTest, SingleLines) {
   EXPECT_EQ(0, sentence->fill_bits());
   EXPECT_EQ(line_number, sentence->line_number());
   ASSERT_EQ(line, sentence->ToString());
-  // TODO(schwehr): Add MD5.
-  // ASSERT_EQ("6e1a4872825054e91ee7cfcfb9cc87e0", sentence->ToMd5Digest());
+  EXPECT_EQ(0x577F6FD58C333D4EULL, sentence->ToPayloadHash());
 
   line_number = 42;
   line =
@@ -178,8 +238,7 @@ TEST(NmeaSentenceTest, SingleLines) {
   EXPECT_EQ(0, sentence->fill_bits());
   EXPECT_EQ(line_number, sentence->line_number());
   ASSERT_EQ(line, sentence->ToString());
-  // TODO(schwehr): Add MD5.
-  // ASSERT_EQ("f61e1ab15c12865196377a8ea4071660", sentence->ToMd5Digest());
+  EXPECT_EQ(0x0A435846B8BD6626ULL, sentence->ToPayloadHash());
 
   line_number = 1234567890123;
   line = "!BSVDM,2,2,5,A,580CPj88880,2*7C";
@@ -195,8 +254,7 @@ TEST(NmeaSentenceTest, SingleLines) {
   EXPECT_EQ(2, sentence->fill_bits());
   EXPECT_EQ(line_number, sentence->line_number());
   EXPECT_EQ(line, sentence->ToString());
-  // TODO(schwehr): Add MD5.
-  // ASSERT_EQ("076754977d78035f5a10ec1bce063a87", sentence->ToMd5Digest());
+  EXPECT_EQ(0xA8EEEE132C6A1345ULL, sentence->ToPayloadHash());
 
   line_number = 3;
   line = "!AIVDM,2,2,8,B,v@,5*2E";
@@ -212,8 +270,7 @@ TEST(NmeaSentenceTest, SingleLines) {
   EXPECT_EQ(5, sentence->fill_bits());
   EXPECT_EQ(line_number, sentence->line_number());
   EXPECT_EQ(line, sentence->ToString());
-  // TODO(schwehr): Add MD5.
-  // ASSERT_EQ("15d2f7a2d21883457ccfc28734a21da3", sentence->ToMd5Digest());
+  EXPECT_EQ(0xCB107FADB5083D05ULL, sentence->ToPayloadHash());
 }
 
 #ifdef BENCHMARK
@@ -282,6 +339,102 @@ TEST(NmeaSentenceTest, VerifyInSameMessage) {
       NmeaSentence("AI", "VDM", 3, 2, 4, 'B', "body1", 0, 8)));
 }
 
+TEST(XxHash64Test, KnownValues) {
+  EXPECT_EQ(0xEF46DB3751D8E999ULL, XxHash64(""));
+  EXPECT_EQ(0xD24EC4F1A98C6E5BULL, XxHash64("a"));
+  EXPECT_EQ(0x44BC2CF5AD770999ULL, XxHash64("abc"));
+  EXPECT_EQ(0xFBCEA83C8A378BF1ULL,
+            XxHash64("Nobody inspects the spammish repetition"));
+  EXPECT_NE(XxHash64("abc"), XxHash64("abc", 1));
+}
+
+TEST(PayloadHashTest, FillBitsAndBody) {
+  const uint64_t hash = PayloadHash("15N4uK0P00r<rW:BFp;JJgv`25k`", 0);
+  EXPECT_EQ(hash, PayloadHash("15N4uK0P00r<rW:BFp;JJgv`25k`", 0));
+  EXPECT_NE(hash, PayloadHash("15N4uK0P00r<rW:BFp;JJgv`25k`", 2));
+  EXPECT_NE(hash, PayloadHash("15N4uK0P00r<rW:BFp;JJgv`25ka", 0));
+
+  // The same message from two receivers.
+  auto a = NmeaSentence::Create(
+      "!SAVDM,1,1,6,A,15N4uK0P00r<rW:BFp;JJgv`25k`,0*49", 1);
+  auto b = NmeaSentence::Create(
+      "!AIVDM,1,1,,B,15N4uK0P00r<rW:BFp;JJgv`25k`,0*66", 2);
+  ASSERT_NE(nullptr, a);
+  ASSERT_NE(nullptr, b);
+  EXPECT_EQ(hash, a->ToPayloadHash());
+  EXPECT_EQ(hash, b->ToPayloadHash());
+}
+
+TEST(DuplicateFilterTest, Count) {
+  DuplicateFilter filter(4, 60);
+  EXPECT_FALSE(filter.Check(1, -1));
+  EXPECT_FALSE(filter.Check(2, -1));
+  EXPECT_TRUE(filter.Check(1, -1));
+  EXPECT_TRUE(filter.Check(2, -1));
+  // 1 and 2 move to the previous generation.
+  EXPECT_FALSE(filter.Check(3, -1));
+  EXPECT_FALSE(filter.Check(4, -1));
+  EXPECT_TRUE(filter.Check(1, -1));
+  // And then are forgotten.
+  EXPECT_FALSE(filter.Check(5, -1));
+  EXPECT_FALSE(filter.Check(1, -1));
+  EXPECT_TRUE(filter.Check(5, -1));
+  EXPECT_EQ(4, filter.duplicates());
+
+  // A hash of 0 is not confused with an empty entry.
+  DuplicateFilter zero;
+  EXPECT_FALSE(zero.Check(0, -1));
+  EXPECT_TRUE(zero.Check(0, -1));
+}
+
+TEST(DuplicateFilterTest, Time) {
+  DuplicateFilter filter(1000, 60);
+  EXPECT_FALSE(filter.Check(1, 100));
+  EXPECT_TRUE(filter.Check(1, 129));
+  EXPECT_FALSE(filter.Check(2, 130));
+  EXPECT_TRUE(filter.Check(1, 159));
+  EXPECT_FALSE(filter.Check(1, 160));
+  // Messages without a time do not move the window.
+  EXPECT_TRUE(filter.Check(2, -1));
+  // A jump of a whole window forgets everything.
+  EXPECT_FALSE(filter.Check(2, 1000));
+  EXPECT_FALSE(filter.Check(1, 1001));
+}
+
+// Messages without a time that fill a generation do not restart the time
+// window of the messages with one.
+TEST(DuplicateFilterTest, MixedTimes) {
+  DuplicateFilter filter(4, 60);
+  EXPECT_FALSE(filter.Check(1, 0));
+  EXPECT_FALSE(filter.Check(2, -1));
+  // Rotates on the count.  1 and 2 move to the previous generation.
+  EXPECT_FALSE(filter.Check(3, -1));
+  EXPECT_TRUE(filter.Check(1, 10));
+  // Half a window after the time window started at 0, 3 moves to the
+  // previous generation and 1 and 2 are forgotten.
+  EXPECT_FALSE(filter.Check(4, 35));
+  EXPECT_FALSE(filter.Check(1, 36));
+  EXPECT_TRUE(filter.Check(3, 36));
+}
+
+TEST(StripLineMetadataTest, TagBlockAndUscg) {
+  const std::string vdm = "!AIVDM,1,1,,B,13F?Vv700<DJuLEtvep`iToV0<00,0*78";
+  EXPECT_EQ(vdm, StripLineMetadata(vdm));
+  EXPECT_EQ(vdm, StripLineMetadata(
+                     "\\s:rORBCOMM104,q:u,c:1418172113,T:2014-12-10 "
+                     "00.41.53*55\\" + vdm));
+  EXPECT_EQ(vdm, StripLineMetadata(
+                     vdm + ",d-109,S2105,t050056.00,T56.13718694,r003669946,"
+                     "1325394060,1325394001"));
+  EXPECT_EQ(vdm, StripLineMetadata("\\c:1418172113*55\\" + vdm + ",1325394060"));
+
+  // Left alone.
+  EXPECT_EQ("", StripLineMetadata(""));
+  EXPECT_EQ("\\", StripLineMetadata("\\"));
+  EXPECT_EQ("\\s:r1*55", StripLineMetadata("\\s:r1*55"));
+  EXPECT_EQ("!AIVDM,1,1,,B,1,0*7", StripLineMetadata("!AIVDM,1,1,,B,1,0*7"));
+}
+
 #ifdef BENCHMARK
 static void BM_VdmStream(const int iters) {
   const std::vector<std::string> single_line_messages = {
@@ -477,5 +630,244 @@ TEST_F(VdmTest, OverRangeSequence) {
   ASSERT_EQ(nullptr, ais_msg);
 }
 
+TEST_F(VdmTest, AddBuffer) {
+  const std::string buffer =
+      "!SAVDM,1,1,6,A,15N4uK0P00r<rW:BFp;JJgv`25k`,0*49\r\n"
+      "not a vdm line\n"
+      "!SAVDM,2,1,1,A,54a=3b027kft?HISV20@thF0<u=@618T<6222216A0b<?4wk0BAm@F@"
+      "DEBC8,0*17\n"
+      "!SAVDM,2,2,1,A,88888888880,2*3F\n"
+      "!AIVDM,3,3,4,A,d0@d0IqhH:Pah:U54PD?75D85Bf00,0*03\n"
+      "!SAVDM,1,1,,B,K8VSqb9LdU28WP8d,0*4F\n"
+      "!SAVDM,1,1,,A,29NS6m";
+
+  std::vector<std::unique_ptr<AisMsg>> messages;
+  std::vector<VdmLineStatus> line_status;
+  const char *end = buffer.data() + buffer.size();
+  const char *rest =
+      stream_.AddBuffer(buffer.data(), end, &messages, &line_status);
+
+  EXPECT_EQ("!SAVDM,1,1,,A,29NS6m", std::string(rest, end));
+  ASSERT_EQ(6, line_status.size());
+  EXPECT_EQ(VDM_LINE_DECODED, line_status[0]);
+  EXPECT_EQ(VDM_LINE_BAD_SENTENCE, line_status[1]);
+  EXPECT_EQ(VDM_LINE_PARTIAL, line_status[2]);
+  EXPECT_EQ(VDM_LINE_DECODED, line_status[3]);
+  EXPECT_EQ(VDM_LINE_OUT_OF_ORDER, line_status[4]);
+  EXPECT_EQ(VDM_LINE_DECODED, line_status[5]);
+
+  ASSERT_EQ(3, messages.size());
+  EXPECT_EQ(1, messages[0]->message_id);
+  EXPECT_EQ(367082860, messages[0]->mmsi);
+  EXPECT_EQ(5, messages[1]->message_id);
+  EXPECT_EQ(311641000, messages[1]->mmsi);
+  EXPECT_EQ(27, messages[2]->message_id);
+
+  // Messages from a buffer do not go through the queue.
+  EXPECT_EQ(nullptr, stream_.PopOldestMessage());
+
+  // The vectors are cleared on reuse.
+  const std::string tail =
+      std::string(rest, end) + "1000qE>9f@s=BES4M40@ET,0*53\n";
+  rest = stream_.AddBuffer(tail.data(), tail.data() + tail.size(), &messages,
+                           &line_status);
+  EXPECT_EQ(tail.data() + tail.size(), rest);
+  ASSERT_EQ(1, line_status.size());
+  EXPECT_EQ(VDM_LINE_DECODED, line_status[0]);
+  ASSERT_EQ(1, messages.size());
+  EXPECT_EQ(2, messages[0]->message_id);
+}
+
+// Wraps fields in a TAG block or VDM sentence with a valid checksum.
+std::string Tag(const std::string &fields) {
+  return "\\" + fields + "*" + ChecksumHexString(fields) + "\\";
+}
+std::string Vdm(const std::string &fields) {
+  return "!" + fields + "*" + ChecksumHexString(fields);
+}
+
+TEST_F(VdmTest, TagBlockGroups) {
+  // Two stations that both use VDM sequence number 1.  The TAG block groups
+  // keep them apart.
+  const std::vector<std::string> lines = {
+      Tag("g:1-2-11,s:a,c:1418169601") +
+          Vdm("AIVDM,2,1,1,A,54a=3b027kft?HISV20@thF0<u=@618T<6222216A0b<?4wk0"
+              "BAm@F@DEBC8,0"),
+      Tag("g:1-2-11,s:b,c:1418169602") +
+          Vdm("AIVDM,2,1,1,A,53@o0E000001Q0CG37U8u<Tp4q@D000000000000183304"
+              "00000000000000,0"),
+      Tag("g:2-2-11,s:a") + Vdm("AIVDM,2,2,1,A,88888888880,2"),
+      Tag("g:2-2-11,s:b") + Vdm("AIVDM,2,2,1,A,00000000008,2"),
+  };
+  for (const std::string &line : lines) {
+    EXPECT_TRUE(stream_.AddLine(line)) << line;
+  }
+  auto ais_msg = stream_.PopOldestMessage();
+  ASSERT_NE(nullptr, ais_msg);
+  EXPECT_EQ(311641000, ais_msg->mmsi);
+  ais_msg = stream_.PopOldestMessage();
+  ASSERT_NE(nullptr, ais_msg);
+  EXPECT_EQ(219005012, ais_msg->mmsi);
+
+  // The source is only on the first line.  From test/nmea_queue_test.py.
+  EXPECT_TRUE(stream_.AddLine(
+      "\\g:1-2-27300,n:636994,s:b003669710,c:1428621738*5F\\!SAVDM,2,1,2,B,"
+      "55Mw@A7J1adAL@?;7WPl58F0U<h4pB222222220t1PN5553fN4g?`4iSp5Rc,0*26"));
+  EXPECT_TRUE(stream_.AddLine(
+      "\\g:2-2-27300,n:636995*15\\!SAVDM,2,2,2,B,iP`88888880,2*5E"));
+  ais_msg = stream_.PopOldestMessage();
+  ASSERT_NE(nullptr, ais_msg);
+  EXPECT_EQ(5, ais_msg->message_id);
+  EXPECT_EQ(nullptr, stream_.PopOldestMessage());
+
+  // The first line has no group, so the later one goes by the sequence number.
+  EXPECT_TRUE(stream_.AddLine(
+      "!SAVDM,2,1,3,B,55Mw@A7J1adAL@?;7WPl58F0U<h4pB222222220t1PN5553fN4g?`4i"
+      "Sp5Rc,0*27"));
+  EXPECT_TRUE(stream_.AddLine(
+      "\\g:2-2-27301,n:636995*14\\!SAVDM,2,2,3,B,iP`88888880,2*5F"));
+  ais_msg = stream_.PopOldestMessage();
+  ASSERT_NE(nullptr, ais_msg);
+  EXPECT_EQ(5, ais_msg->message_id);
+
+  // A bad TAG block checksum rejects the line.
+  EXPECT_FALSE(stream_.AddLine(
+      "\\s:a*00\\!AIVDM,1,1,,B,13F?Vv700<DJuLEtvep`iToV0<00,0*78"));
+}
+
+TEST_F(VdmTest, DropDuplicates) {
+  // Off by default.
+  const std::string line = "!SAVDM,1,1,6,A,15N4uK0P00r<rW:BFp;JJgv`25k`,0*49";
+  EXPECT_TRUE(stream_.AddLine(line));
+  EXPECT_TRUE(stream_.AddLine(line));
+  EXPECT_EQ(2, stream_.size());
+  EXPECT_EQ(0, stream_.duplicates());
+
+  VdmStream stream;
+  stream.DropDuplicates();
+  std::string buffer =
+      line + "\n" + "!AIVDM,1,1,,B,15N4uK0P00r<rW:BFp;JJgv`25k`,0*66\n" +
+      Tag("s:b,c:1418169601") + line + "\n" +
+      "!SAVDM,2,1,1,A,54a=3b027kft?HISV20@thF0<u=@618T<6222216A0b<?4wk0BAm@F@"
+      "DEBC8,0*17\n"
+      "!SAVDM,2,2,1,A,88888888880,2*3F\n"
+      "!SAVDM,2,1,2,B,54a=3b027kft?HISV20@thF0<u=@618T<6222216A0b<?4wk0BAm@F@"
+      "DEBC8,0*17\n"
+      "!SAVDM,2,2,2,B,88888888880,2*3F\n";
+  std::vector<std::unique_ptr<AisMsg>> messages;
+  std::vector<VdmLineStatus> line_status;
+  stream.AddBuffer(buffer.data(), buffer.data() + buffer.size(), &messages,
+                   &line_status);
+  EXPECT_EQ(
+      std::vector<VdmLineStatus>({VDM_LINE_DECODED, VDM_LINE_DUPLICATE,
+                                  VDM_LINE_DUPLICATE, VDM_LINE_PARTIAL,
+                                  VDM_LINE_DECODED, VDM_LINE_PARTIAL,
+                                  VDM_LINE_DUPLICATE}),
+      line_status);
+  ASSERT_EQ(2, messages.size());
+  EXPECT_EQ(1, messages[0]->message_id);
+  EXPECT_EQ(5, messages[1]->message_id);
+  EXPECT_EQ(3, stream.duplicates());
+  EXPECT_TRUE(stream.AddLine(line));
+  EXPECT_EQ(4, stream.duplicates());
+  EXPECT_TRUE(stream.empty());
+}
+
+TEST(VdmAssemblerTest, TagBlock) {
+  VdmAssembler assembler;
+  std::string_view body;
+  int fill_bits;
+  VdmLineStatus status;
+  const std::string single =
+      Tag("s:rORBCOMM104,q:u,c:1418172113") +
+      "!AIVDM,1,1,,B,13F?Vv700<DJuLEtvep`iToV0<00,0*78";
+  ASSERT_TRUE(assembler.AddLine(single, &body, &fill_bits, &status));
+  ASSERT_NE(nullptr, assembler.tag_block());
+  EXPECT_EQ("rORBCOMM104", assembler.tag_block()->source);
+  EXPECT_EQ('u', assembler.tag_block()->quality);
+  EXPECT_EQ("13F?Vv700<DJuLEtvep`iToV0<00", body);
+
+  ASSERT_FALSE(assembler.AddLine(
+      Tag("g:1-2-5,c:1418169601") + Vdm("AIVDM,2,1,6,A,53@o0E00,0"), &body,
+      &fill_bits, &status));
+  EXPECT_EQ(VDM_LINE_PARTIAL, status);
+  ASSERT_TRUE(assembler.AddLine(
+      Tag("g:2-2-5") + Vdm("AIVDM,2,2,6,A,00000000008,2"), &body, &fill_bits,
+      &status));
+  EXPECT_EQ("53@o0E0000000000008", body);
+  EXPECT_EQ(2, fill_bits);
+  // The TAG block of the first line of the group.
+  ASSERT_NE(nullptr, assembler.tag_block());
+  EXPECT_EQ(1418169601.0, assembler.tag_block()->time);
+
+  ASSERT_TRUE(assembler.AddLine(
+      "!AIVDM,1,1,,B,13F?Vv700<DJuLEtvep`iToV0<00,0*78", &body, &fill_bits,
+      &status));
+  EXPECT_EQ(nullptr, assembler.tag_block());
+  EXPECT_EQ(0, assembler.evicted_tag_groups());
+}
+
+TEST(VdmAssemblerTest, UscgMetadata) {
+  VdmAssembler assembler;
+  std::string_view body;
+  int fill_bits;
+  VdmLineStatus status;
+  ASSERT_FALSE(assembler.AddLine(
+      "!AIVDM,2,1,5,A,ENk`sPI17ab7W@6;Q@1@@@@@@@@=MwK3<7v:@00003v,0*4F,d-084,"
+      "S1652,t161344.00,T44.05687473,r003669945,1429287224",
+      &body, &fill_bits, &status));
+  EXPECT_EQ(VDM_LINE_PARTIAL, status);
+  ASSERT_TRUE(assembler.AddLine(
+      "!AIVDM,2,2,5,A,P000,2*71,d-085,S1653,t161344.00,T44.05687473,"
+      "r003669945,1429287225",
+      &body, &fill_bits, &status));
+  EXPECT_EQ("ENk`sPI17ab7W@6;Q@1@@@@@@@@=MwK3<7v:@00003vP000", body);
+  EXPECT_EQ(2, fill_bits);
+  ASSERT_NE(nullptr, assembler.uscg_metadata());
+  EXPECT_EQ(nullptr, assembler.tag_block());
+  // From the last line.
+  EXPECT_EQ(-85, assembler.uscg_metadata()->signal_strength);
+  EXPECT_EQ(1653, assembler.uscg_metadata()->slot);
+  EXPECT_EQ("r003669945", assembler.uscg_metadata()->station);
+  EXPECT_EQ(1429287225.0, assembler.uscg_metadata()->time);
+
+  // Both kinds of metadata.
+  ASSERT_TRUE(assembler.AddLine(
+      "\\c:1418172113*52\\!AIVDM,1,1,,B,13F?Vv700<DJuLEtvep`iToV0<00,0*78,"
+      "b003665002,1418172114",
+      &body, &fill_bits, &status));
+  ASSERT_NE(nullptr, assembler.tag_block());
+  EXPECT_EQ(1418172113.0, assembler.tag_block()->time);
+  ASSERT_NE(nullptr, assembler.uscg_metadata());
+  EXPECT_EQ("b003665002", assembler.uscg_metadata()->station);
+
+  EXPECT_FALSE(assembler.AddLine(
+      "!AIVDM,1,1,,B,13F?Vv700<DJuLEtvep`iToV0<00,0*78,dx,r1,1418172114",
+      &body, &fill_bits, &status));
+  EXPECT_EQ(VDM_LINE_BAD_SENTENCE, status);
+
+  ASSERT_TRUE(assembler.AddLine(
+      "!AIVDM,1,1,,B,13F?Vv700<DJuLEtvep`iToV0<00,0*78", &body, &fill_bits,
+      &status));
+  EXPECT_EQ(nullptr, assembler.uscg_metadata());
+}
+
+TEST_F(VdmTest, AddBufferEmpty) {
+  std::vector<std::unique_ptr<AisMsg>> messages;
+  std::vector<VdmLineStatus> line_status;
+  const std::string buffer = "\n\r\n";
+  EXPECT_EQ(buffer.data() + buffer.size(),
+            stream_.AddBuffer(buffer.data(), buffer.data() + buffer.size(),
+                              &messages, &line_status));
+  ASSERT_EQ(2, line_status.size());
+  EXPECT_EQ(VDM_LINE_BAD_SENTENCE, line_status[0]);
+  EXPECT_EQ(VDM_LINE_BAD_SENTENCE, line_status[1]);
+  EXPECT_TRUE(messages.empty());
+
+  EXPECT_EQ(buffer.data(), stream_.AddBuffer(buffer.data(), buffer.data(),
+                                             &messages, &line_status));
+  EXPECT_TRUE(line_status.empty());
+}
+
 }  // namespace
 }  // namespace libais
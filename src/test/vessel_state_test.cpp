@@ -0,0 +1,208 @@
+// Test merging decoded messages into the latest state of each vessel.
+
+#include "vessel_state.h"
+
+#include <atomic>
+#include <memory>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "ais.h"
+#include "decode_body.h"
+#include "gtest/gtest.h"
+
+namespace libais {
+namespace {
+
+std::unique_ptr<AisMsg> Decode(const std::string &nmea_string) {
+  std::unique_ptr<AisMsg> msg =
+      CreateAisMsg(GetBody(nmea_string), GetPad(nmea_string));
+  if (!msg || msg->had_error()) {
+    return nullptr;
+  }
+  return msg;
+}
+
+TEST(VesselStateTableTest, Empty) {
+  VesselStateTable table(10);
+  EXPECT_EQ(0, table.size());
+  EXPECT_EQ(10, table.max_vessels());
+  VesselState state;
+  EXPECT_FALSE(table.Get(366968860, &state));
+  EXPECT_FALSE(table.Get(0, &state));
+  int visited = 0;
+  table.ForEach([&visited](const VesselState &) { visited++; });
+  EXPECT_EQ(0, visited);
+}
+
+TEST(VesselStateTableTest, PositionThenStatic) {
+  VesselStateTable table(10);
+  std::unique_ptr<AisMsg> position =
+      Decode("!AIVDM,1,1,,B,15N1u<PP1FJuvSRHOE6QIwwh0HQ6,0*1E");
+  ASSERT_NE(nullptr, position);
+  ASSERT_TRUE(table.Update(*position, 100));
+  EXPECT_EQ(1, table.size());
+
+  const auto &m1 = static_cast<const Ais1_2_3 &>(*position);
+  VesselState state;
+  ASSERT_TRUE(table.Get(m1.mmsi, &state));
+  EXPECT_EQ(m1.mmsi, state.mmsi);
+  EXPECT_EQ(100, state.position_time);
+  EXPECT_EQ(-1, state.static_time);
+  EXPECT_EQ(1, state.position_message_id);
+  EXPECT_DOUBLE_EQ(m1.position.lng_deg, state.x);
+  EXPECT_DOUBLE_EQ(m1.position.lat_deg, state.y);
+  EXPECT_FLOAT_EQ(m1.sog, state.sog);
+  EXPECT_FLOAT_EQ(m1.cog, state.cog);
+  EXPECT_EQ(m1.true_heading, state.true_heading);
+  EXPECT_EQ(m1.nav_status, state.nav_status);
+  EXPECT_EQ("", state.name_view());
+
+  // Static data for the same vessel keeps the position.
+  std::unique_ptr<AisMsg> ship = Decode(
+      "!AIVDM,1,1,,A,54a=3b027kft?HISV20@thF0<u=@618T<6222216A0b<?4wk0BAm@F@"
+      "DEBC888888888880,2*00");
+  ASSERT_NE(nullptr, ship);
+  auto &m5 = static_cast<Ais5 &>(*ship);
+  m5.mmsi = m1.mmsi;
+  ASSERT_TRUE(table.Update(m5, 200));
+  EXPECT_EQ(1, table.size());
+
+  ASSERT_TRUE(table.Get(m1.mmsi, &state));
+  EXPECT_EQ(100, state.position_time);
+  EXPECT_EQ(200, state.static_time);
+  EXPECT_EQ(5, state.static_message_id);
+  EXPECT_DOUBLE_EQ(m1.position.lng_deg, state.x);
+  EXPECT_EQ(m5.imo_num, state.imo_num);
+  EXPECT_EQ(m5.type_and_cargo, state.type_and_cargo);
+  EXPECT_EQ(m5.dim_a, state.dim_a);
+  EXPECT_EQ(m5.dim_d, state.dim_d);
+  EXPECT_FLOAT_EQ(m5.draught, state.draught);
+  EXPECT_FALSE(state.name_view().empty());
+  EXPECT_EQ(std::string::npos, state.name_view().find('@'));
+  EXPECT_NE(' ', state.name_view().back());
+  EXPECT_EQ(0, m5.name.find(state.name_view()));
+  EXPECT_EQ(0, m5.callsign.find(state.callsign_view()));
+  EXPECT_EQ(0, m5.destination.find(state.destination_view()));
+}
+
+TEST(VesselStateTableTest, ClassB) {
+  VesselStateTable table(10);
+  std::unique_ptr<AisMsg> position =
+      Decode("!SAVDM,1,1,4,B,B5NU=J000=l0BD6l590EkwuUoP06,0*61");
+  ASSERT_NE(nullptr, position);
+  ASSERT_TRUE(table.Update(*position, 1));
+
+  std::unique_ptr<AisMsg> part_a =
+      Decode("!AIVDM,1,1,,A,H44cj<0DdvlHhuB222222222220,2*46");
+  ASSERT_NE(nullptr, part_a);
+  part_a->mmsi = position->mmsi;
+  ASSERT_TRUE(table.Update(*part_a, 2));
+
+  std::unique_ptr<AisMsg> part_b =
+      Decode("!AIVDM,1,1,,A,H02IDPDm3?=1B00@9<?D00081110,0*6D");
+  ASSERT_NE(nullptr, part_b);
+  part_b->mmsi = position->mmsi;
+  ASSERT_TRUE(table.Update(*part_b, 3));
+
+  VesselState state;
+  ASSERT_TRUE(table.Get(position->mmsi, &state));
+  EXPECT_EQ(18, state.position_message_id);
+  EXPECT_EQ(1, state.position_time);
+  EXPECT_EQ(24, state.static_message_id);
+  EXPECT_EQ(3, state.static_time);
+  EXPECT_EQ("EKO-FLOT", state.name_view());
+  const auto &b = static_cast<const Ais24 &>(*part_b);
+  EXPECT_EQ(b.type_and_cargo, state.type_and_cargo);
+  EXPECT_EQ("PILOT", state.callsign_view());
+  EXPECT_EQ(b.dim_a, state.dim_a);
+}
+
+TEST(VesselStateTableTest, Ignored) {
+  VesselStateTable table(10);
+  // Base station report.
+  std::unique_ptr<AisMsg> msg =
+      Decode("!AIVDM,1,1,,A,403OviQuMGCqWrRO9>E6fE700@GO,0*4D");
+  ASSERT_NE(nullptr, msg);
+  EXPECT_FALSE(table.Update(*msg));
+
+  msg = Decode("!AIVDM,1,1,,B,15N1u<PP1FJuvSRHOE6QIwwh0HQ6,0*1E");
+  ASSERT_NE(nullptr, msg);
+  msg->mmsi = 0;
+  EXPECT_FALSE(table.Update(*msg));
+  EXPECT_EQ(0, table.size());
+}
+
+TEST(VesselStateTableTest, Full) {
+  VesselStateTable table(100);
+  std::unique_ptr<AisMsg> msg =
+      Decode("!AIVDM,1,1,,B,15N1u<PP1FJuvSRHOE6QIwwh0HQ6,0*1E");
+  ASSERT_NE(nullptr, msg);
+  for (int mmsi = 1; mmsi <= 100; mmsi++) {
+    msg->mmsi = mmsi;
+    ASSERT_TRUE(table.Update(*msg, mmsi));
+  }
+  EXPECT_EQ(100, table.size());
+  msg->mmsi = 101;
+  EXPECT_FALSE(table.Update(*msg));
+  // Existing vessels are still updated.
+  msg->mmsi = 50;
+  EXPECT_TRUE(table.Update(*msg, 1000));
+  EXPECT_EQ(100, table.size());
+
+  VesselState state;
+  EXPECT_FALSE(table.Get(101, &state));
+  ASSERT_TRUE(table.Get(50, &state));
+  EXPECT_EQ(1000, state.position_time);
+  ASSERT_TRUE(table.Get(99, &state));
+  EXPECT_EQ(99, state.position_time);
+
+  int64_t sum = 0;
+  table.ForEach([&sum](const VesselState &s) { sum += s.mmsi; });
+  EXPECT_EQ(100 * 101 / 2, sum);
+}
+
+// Readers never see a state that is half way through an update.
+TEST(VesselStateTableTest, ConcurrentReaders) {
+  VesselStateTable table(1000);
+  std::unique_ptr<AisMsg> msg =
+      Decode("!AIVDM,1,1,,B,15N1u<PP1FJuvSRHOE6QIwwh0HQ6,0*1E");
+  ASSERT_NE(nullptr, msg);
+  auto &m = static_cast<Ais1_2_3 &>(*msg);
+
+  std::atomic<bool> done{false};
+  std::atomic<int> torn{0};
+  std::vector<std::thread> readers;
+  for (int i = 0; i < 2; i++) {
+    readers.emplace_back([&table, &done, &torn]() {
+      VesselState state;
+      while (!done.load()) {
+        for (int mmsi = 1; mmsi <= 10; mmsi++) {
+          if (table.Get(mmsi, &state) &&
+              (state.x != state.y || state.position_time != state.x)) {
+            torn++;
+          }
+        }
+      }
+    });
+  }
+
+  int updated = 0;
+  for (int i = 0; i < 100000; i++) {
+    m.mmsi = i % 10 + 1;
+    m.position.lng_deg = i % 180;
+    m.position.lat_deg = i % 180;
+    updated += table.Update(m, i % 180);
+  }
+  done = true;
+  for (auto &reader : readers) {
+    reader.join();
+  }
+  EXPECT_EQ(100000, updated);
+  EXPECT_EQ(0, torn.load());
+  EXPECT_EQ(10, table.size());
+}
+
+}  // namespace
+}  // namespace libais
@@ -2,7 +2,13 @@
 
 """Test the top level decoders with a single message each."""
 
+import array
 import ais
+import math
+import mmap
+import sysconfig
+import tempfile
+import threading
 import unittest
 from . import test_data
 import sys
@@ -27,6 +33,14 @@ class AisTopLevelDecoders(unittest.TestCase):
           'Mismatch for id:%d\n%s\n%s\n  From: %s' % (
               msg['id'], msg, expected, entry['nmea']))
 
+  def testKeysShared(self):
+    """Every decode reuses the same interned key objects."""
+    first = ais.decode('15N1u<PP1FJuvSRHOE6QIwwh0HQ6', 0)
+    second = ais.decode('15N1u<PP1FJuvSRHOE6QIwwh0HQ6', 0)
+    for key_a, key_b in zip(first, second):
+      self.assertIs(key_a, key_b)
+      self.assertIs(sys.intern(key_a), key_a)
+
 
 class Ais6Decoders(unittest.TestCase):
 
@@ -36,5 +50,224 @@ class Ais6Decoders(unittest.TestCase):
     self.assertRaisesRegex(ais.DecodeError, '6:669:11',
                            ais.decode, '6B?n;be:cbapalgc;i6?Ow4', 2)
 
+class DecodeManyTest(unittest.TestCase):
+
+  def testSameAsDecode(self):
+    bodies = []
+    pads = []
+    for entry in test_data.top_level:
+      bodies.append(''.join([line.split(',')[5] for line in entry['nmea']]))
+      pads.append(int(entry['nmea'][-1].split('*')[0][-1]))
+    msgs = ais.decode_many(bodies, pads)
+    self.assertEqual(len(bodies), len(msgs))
+    for body, pad, msg in zip(bodies, pads, msgs):
+      self.assertDictEqual(ais.decode(body, pad), msg)
+
+  def testErrorsInPlace(self):
+    msgs = ais.decode_many(
+        ('15N1u<PP1FJuvSRHOE6QIwwh0HQ6', '6B?n;be:cbapalgc;i6?Ow4', None, 'L'),
+        [0, 2, 0, 0])
+    self.assertEqual(4, len(msgs))
+    self.assertEqual(1, msgs[0]['id'])
+    self.assertIsInstance(msgs[1], ais.DecodeError)
+    self.assertIn('6:669:11', str(msgs[1]))
+    self.assertIsInstance(msgs[2], ais.DecodeError)
+    self.assertIsInstance(msgs[3], ais.DecodeError)
+
+  def testFillBitsOutOfRange(self):
+    payloads = ['15N1u<PP1FJuvSRHOE6QIwwh0HQ6', '6B?n;be:cbapalgc;i6?Ow4',
+                '85Mwp`1Kf3aCnsNvBWLi=wQuNhA5t43N`5nCuI=p<IBfVqnMgPGs']
+    for pad in (-1, 6):
+      msgs = ais.decode_many(payloads, [pad] * len(payloads))
+      for payload, msg in zip(payloads, msgs):
+        self.assertIsInstance(msg, ais.DecodeError)
+        self.assertIn('fill bits out of range - ' + payload[0], str(msg))
+
+  def testDefaultPads(self):
+    msgs = ais.decode_many(['15N1u<PP1FJuvSRHOE6QIwwh0HQ6'])
+    self.assertEqual([ais.decode('15N1u<PP1FJuvSRHOE6QIwwh0HQ6', 0)], msgs)
+    self.assertEqual([], ais.decode_many([], []))
+
+  def testLengthMismatch(self):
+    self.assertRaises(ValueError, ais.decode_many, ['1', '2'], [0])
+    self.assertRaises(TypeError, ais.decode_many, 5)
+
+
+class DecodePositionsTest(unittest.TestCase):
+
+  def testColumns(self):
+    payloads = ['15N1u<PP1FJuvSRHOE6QIwwh0HQ6', 'B52HIjh00=ksdj6l448=wwQ5WP06',
+                '55NBjP01mtGIL@CW;SM<D60P5Ld000000000000P0`<3557l0<50@kk@K5h@'
+                '00000000000', 'K815>P8=5EikdUet', 'bad', None]
+    pads = [0, 0, 2, 0, 0, 0]
+    num = len(payloads)
+    columns = {
+        'id': array.array('b', [0] * num),
+        'mmsi': array.array('l', [0] * num),
+        'x': array.array('d', [0] * num),
+        'y': array.array('d', [0] * num),
+        'sog': array.array('f', [0] * num),
+        'nav_status': array.array('i', [0] * num),
+        'true_heading': array.array('h', [0] * num),
+    }
+    self.assertEqual(3, ais.decode_positions(payloads, pads, columns))
+    self.assertEqual([1, 18, -1, 27, -1, -1], list(columns['id']))
+    for i in (0, 1, 3):
+      msg = ais.decode(payloads[i], pads[i])
+      self.assertEqual(msg['mmsi'], columns['mmsi'][i])
+      self.assertEqual(msg['x'], columns['x'][i])
+      self.assertEqual(msg['y'], columns['y'][i])
+      self.assertAlmostEqual(msg['sog'], columns['sog'][i], places=5)
+      if 'true_heading' in msg:
+        self.assertEqual(msg['true_heading'], columns['true_heading'][i])
+    # Not in type 18 or 27.
+    self.assertEqual(-1, columns['nav_status'][1])
+    self.assertEqual(-1, columns['true_heading'][3])
+    self.assertTrue(math.isnan(columns['x'][2]))
+
+  def testFillBitsOutOfRange(self):
+    payloads = ['15N1u<PP1FJuvSRHOE6QIwwh0HQ6'] * 2
+    columns = {'id': array.array('b', [0, 0])}
+    self.assertEqual(0, ais.decode_positions(payloads, [-1, 6], columns))
+    self.assertEqual([-1, -1], list(columns['id']))
+
+  def testBadColumns(self):
+    payloads = ['15N1u<PP1FJuvSRHOE6QIwwh0HQ6']
+    self.assertRaises(KeyError, ais.decode_positions, payloads, None,
+                      {'speed': array.array('d', [0])})
+    self.assertRaises(ValueError, ais.decode_positions, payloads * 2, None,
+                      {'x': array.array('d', [0])})
+    self.assertRaises(ValueError, ais.decode_positions, payloads, None,
+                      {'mmsi': array.array('B', [0])})
+    # Read only.
+    self.assertRaises(BufferError, ais.decode_positions, payloads, None,
+                      {'x': b'12345678'})
+
+
+class DecodeLazyTest(unittest.TestCase):
+
+  def testSameAsDecode(self):
+    for entry in test_data.top_level:
+      body = ''.join([line.split(',')[5] for line in entry['nmea']])
+      pad = int(entry['nmea'][-1].split('*')[0][-1])
+      msg = ais.decode_lazy(body, pad)
+      self.assertEqual(entry['result']['mmsi'], msg.mmsi)
+      self.assertEqual(entry['result']['id'], msg['id'])
+      self.assertDictEqual(entry['result'], msg.to_dict())
+
+  def testFields(self):
+    expected = ais.decode('15N1u<PP1FJuvSRHOE6QIwwh0HQ6', 0)
+    msg = ais.decode_lazy('15N1u<PP1FJuvSRHOE6QIwwh0HQ6', 0)
+    self.assertEqual(expected['x'], msg.x)
+    self.assertEqual(expected['y'], msg['y'])
+    self.assertIn('sog', msg)
+    self.assertNotIn('dac', msg)
+    self.assertEqual(len(expected), len(msg))
+    self.assertEqual(list(expected), list(msg))
+    self.assertEqual(list(expected.keys()), msg.keys())
+    self.assertEqual(expected['sog'], msg.get('sog'))
+    self.assertIsNone(msg.get('dac'))
+    self.assertEqual(3, msg.get('dac', 3))
+    self.assertRaises(KeyError, lambda: msg['dac'])
+    self.assertRaises(AttributeError, lambda: msg.dac)
+    # Changing the result of to_dict does not change the message.
+    msg.to_dict()['x'] = 0
+    self.assertEqual(expected['x'], msg.x)
+
+  def testErrors(self):
+    for payload, pad in (('6B?n;be:cbapalgc;i6?Ow4', 2), ('L', 0),
+                         ('15N1u<PP1FJuvS', 0)):
+      with self.assertRaises(ais.DecodeError) as expected:
+        ais.decode(payload, pad)
+      with self.assertRaises(ais.DecodeError) as lazy:
+        ais.decode_lazy(payload, pad)
+      self.assertEqual(str(expected.exception), str(lazy.exception))
+
+
+class DecodeBufferTest(unittest.TestCase):
+
+  PAYLOAD = '15N1u<PP1FJuvSRHOE6QIwwh0HQ6'
+
+  def testDecode(self):
+    expected = ais.decode(self.PAYLOAD, 0)
+    data = b'!!' + self.PAYLOAD.encode() + b'!!'
+    self.assertEqual(expected, ais.decode(data[2:-2], 0))
+    self.assertEqual(expected, ais.decode(bytearray(data[2:-2])))
+    self.assertEqual(expected, ais.decode(memoryview(data)[2:-2], 0))
+    self.assertEqual(expected, ais.decode_lazy(data[2:-2]).to_dict())
+    self.assertEqual([expected], ais.decode_many([memoryview(data)[2:-2]]))
+    self.assertRaises(ais.DecodeError, ais.decode, 5)
+
+  def testSpans(self):
+    payloads = [self.PAYLOAD, 'B52HIjh00=ksdj6l448=wwQ5WP06', 'K815>P8=5EikdUet']
+    data = b''
+    starts = []
+    lengths = []
+    for payload in payloads:
+      data += b'junk'
+      starts.append(len(data))
+      lengths.append(len(payload))
+      data += payload.encode()
+    expected = ais.decode_many(payloads)
+    self.assertEqual(expected, ais.decode_spans(data, starts, lengths))
+    self.assertEqual(expected, ais.decode_spans(
+        memoryview(data), array.array('q', starts), array.array('i', lengths),
+        [0, 0, 0]))
+
+    with tempfile.TemporaryFile() as f:
+      f.write(data)
+      f.flush()
+      with mmap.mmap(f.fileno(), 0, access=mmap.ACCESS_READ) as mapped:
+        self.assertEqual(expected, ais.decode_spans(mapped, starts, lengths))
+
+  def testBadSpans(self):
+    data = self.PAYLOAD.encode()
+    msgs = ais.decode_spans(data, [0, -1, 1, 0], [28, 5, 28, -1])
+    self.assertEqual(1, msgs[0]['id'])
+    for msg in msgs[1:]:
+      self.assertIsInstance(msg, ais.DecodeError)
+    self.assertRaises(ValueError, ais.decode_spans, data, [0], [1, 2])
+    self.assertRaises(ValueError, ais.decode_spans, data,
+                      array.array('d', [0]), [28])
+    self.assertRaises(TypeError, ais.decode_spans, data, 0, 28)
+    self.assertRaises(TypeError, ais.decode_spans, 5, [0], [1])
+
+
+class ThreadedDecodeTest(unittest.TestCase):
+
+  def testSameAsOneThread(self):
+    payloads = []
+    for entry in test_data.top_level:
+      body = ''.join([line.split(',')[5] for line in entry['nmea']])
+      pad = int(entry['nmea'][-1].split('*')[0][-1])
+      payloads.append((body, pad))
+    expected = [ais.decode(body, pad) for body, pad in payloads]
+    results = {}
+
+    def Worker(index):
+      msgs = []
+      for _ in range(50):
+        msgs = [ais.decode(body, pad) for body, pad in payloads]
+        msgs += ais.decode_many([body for body, _ in payloads],
+                                [pad for _, pad in payloads])
+      results[index] = msgs
+
+    threads = [threading.Thread(target=Worker, args=(i,)) for i in range(4)]
+    for thread in threads:
+      thread.start()
+    for thread in threads:
+      thread.join()
+    self.assertEqual(4, len(results))
+    for msgs in results.values():
+      self.assertEqual(expected + expected, msgs)
+
+  @unittest.skipUnless(sysconfig.get_config_var('Py_GIL_DISABLED'),
+                       'Needs a free-threaded Python')
+  def testNoGil(self):
+    # Importing a module that does not declare free-threading support
+    # turns the GIL back on.
+    self.assertFalse(sys._is_gil_enabled())
+
+
 if __name__=='__main__':
   unittest.main()
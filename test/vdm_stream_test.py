@@ -0,0 +1,119 @@
+"""Tests for the C++ _ais.VdmStream."""
+
+import functools
+import os
+import unittest
+
+import ais
+
+DATA_DIR = os.path.join(os.path.dirname(__file__), 'data')
+FILENAMES = ('typeexamples.nmea', 'tagblock.nmea', 'test.aivdm')
+
+TWO_LINES = (
+    '!SAVDM,2,1,1,A,54a=3b027kft?HISV20@thF0<u=@618T<6222216A0b<?4wk0BAm@F@'
+    'DEBC8,0*17',
+    '!SAVDM,2,2,1,A,88888888880,2*3F')
+
+
+def Checksum(text):
+  return '%02X' % functools.reduce(lambda a, c: a ^ ord(c), text, 0)
+
+
+def TagLine(tag, vdm):
+  """A TAG block and VDM sentence with valid checksums."""
+  return '\\%s*%s\\!%s*%s' % (tag, Checksum(tag), vdm, Checksum(vdm))
+
+
+def Decoded(filename):
+  """The decoded messages from ais.open without the md5 digests."""
+  msgs = []
+  for msg in ais.open(filename):
+    if 'decoded' in msg:
+      decoded = dict(msg['decoded'])
+      decoded.pop('md5', None)
+      msgs.append(decoded)
+  return msgs
+
+
+class VdmStreamTest(unittest.TestCase):
+
+  def testSameAsOpen(self):
+    for filename in FILENAMES:
+      path = os.path.join(DATA_DIR, filename)
+      stream = ais.VdmStream()
+      with open(path, 'rb') as f:
+        stream.feed(f.read())
+      stream.flush()
+      self.assertEqual(Decoded(path), list(stream), filename)
+
+  def testChunks(self):
+    path = os.path.join(DATA_DIR, 'test.aivdm')
+    with open(path, 'rb') as f:
+      data = f.read()
+    whole = ais.VdmStream()
+    whole.feed(data)
+    expected = list(whole)
+    for size in (1, 7, 100, 4096):
+      stream = ais.VdmStream()
+      msgs = []
+      for start in range(0, len(data), size):
+        stream.feed(memoryview(data)[start:start + size])
+        msgs.extend(stream)
+      stream.flush()
+      msgs.extend(stream)
+      self.assertEqual(expected, msgs, size)
+
+  def testAddLine(self):
+    stream = ais.VdmStream()
+    self.assertFalse(stream.add_line('junk'))
+    self.assertTrue(stream.add_line(TWO_LINES[0]))
+    self.assertEqual(0, len(stream))
+    self.assertTrue(stream.add_line(TWO_LINES[1].encode()))
+    self.assertEqual(1, len(stream))
+    msg = next(stream)
+    self.assertEqual(5, msg['id'])
+    self.assertEqual(ais.decode(TWO_LINES[0].split(',')[5] +
+                                TWO_LINES[1].split(',')[5], 2), msg)
+    self.assertRaises(StopIteration, next, stream)
+    self.assertRaises(TypeError, stream.add_line, 5)
+
+  def testFeedAndFlush(self):
+    stream = ais.VdmStream()
+    self.assertEqual(0, stream.feed(TWO_LINES[0] + '\r\n' + TWO_LINES[1]))
+    self.assertEqual(1, stream.flush())
+    self.assertEqual(0, stream.flush())
+    self.assertEqual([5], [msg['id'] for msg in stream])
+
+  def testSkipsUndecodable(self):
+    stream = ais.VdmStream()
+    # Message 28 is not defined.
+    stream.feed(b'!AIVDM,1,1,,B,LQc5;BEaufpP`rKo,0*36\n'
+                b'!AIVDM,1,1,,B,23?up2001gGRju>Ap:;R2APP08:c,0*0E\n')
+    self.assertEqual(2, len(stream))
+    self.assertEqual([2], [msg['id'] for msg in stream])
+
+  def testTagBlockGroups(self):
+    # Both stations use VDM sequence number 1.  The TAG block groups keep
+    # their sentences apart.
+    first = TWO_LINES[0].split('*')[0][1:]
+    second = TWO_LINES[1].split('*')[0][1:]
+    stream = ais.VdmStream()
+    self.assertTrue(stream.add_line(TagLine('g:1-2-7,s:a', first)))
+    self.assertTrue(stream.add_line(TagLine('g:1-2-7,s:b', first)))
+    self.assertTrue(stream.add_line(TagLine('g:2-2-7,s:a', second)))
+    self.assertTrue(stream.add_line(TagLine('g:2-2-7,s:b', second)))
+    self.assertEqual([311641000, 311641000], [msg['mmsi'] for msg in stream])
+    self.assertFalse(stream.add_line('\\s:a*00\\' + TWO_LINES[0]))
+
+  def testUscgMetadata(self):
+    stream = ais.VdmStream()
+    self.assertTrue(stream.add_line(
+        TWO_LINES[0] + ',d-084,S1652,t161344.00,T44.05687473,r003669945,'
+        '1429287224'))
+    self.assertTrue(stream.add_line(TWO_LINES[1] + ',b003669978,1429287225'))
+    self.assertEqual([311641000], [msg['mmsi'] for msg in stream])
+    self.assertFalse(stream.add_line(TWO_LINES[0] + ',d-84x,1429287224'))
+
+
+if __name__ == '__main__':
+  unittest.main()